@@ -13,6 +13,7 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
+#include "CoinDenseLU.hpp"
 #if COIN_BIG_DOUBLE == 1
 #undef COIN_FACTORIZATION_DENSE_CODE
 #endif
@@ -66,6 +67,7 @@ void CoinDenseFactorization::gutsOfDestructor()
   maximumRows_ = 0;
   maximumSpace_ = 0;
   solveMode_ = 0;
+  factorCode_ = 0;
 }
 void CoinDenseFactorization::gutsOfInitialize()
 {
@@ -87,6 +89,7 @@ void CoinDenseFactorization::gutsOfInitialize()
   pivotRow_ = NULL;
   workArea_ = NULL;
   solveMode_ = 0;
+  factorCode_ = 0;
 }
 //  ~CoinDenseFactorization.  Destructor
 CoinDenseFactorization::~CoinDenseFactorization()
@@ -121,6 +124,7 @@ void CoinDenseFactorization::gutsOfCopy(const CoinDenseFactorization &other)
   maximumRows_ = other.maximumRows_;
   maximumSpace_ = other.maximumSpace_;
   solveMode_ = other.solveMode_;
+  factorCode_ = other.factorCode_;
   numberGoodU_ = other.numberGoodU_;
   maximumPivots_ = other.maximumPivots_;
   numberPivots_ = other.numberPivots_;
@@ -191,34 +195,55 @@ int CoinDenseFactorization::factor()
 {
   numberPivots_ = 0;
   status_ = 0;
+  factorCode_ = 0;
+  if (numberRows_ == numberColumns_) {
 #ifdef COIN_FACTORIZATION_DENSE_CODE
-  if (numberRows_ == numberColumns_ && (solveMode_ % 10) != 0) {
-    int info;
-    COINUTILS_LAPACK_FUNC(dgetrf,DGETRF)(&numberRows_,&numberRows_,
+    if ((solveMode_ % 10) != 0) {
+      int info;
+      COINUTILS_LAPACK_FUNC(dgetrf,DGETRF)(&numberRows_,&numberRows_,
                                     elements_,&numberRows_,pivotRow_,&info);
-    // need to check size of pivots
-    if (!info) {
+      factorCode_ = 2;
+    } else
+#endif
+    {
+      // blocked right looking LU - same format as LAPACK
+      CoinDenseLUFactor(numberRows_, elements_, numberRows_, pivotRow_);
+      factorCode_ = 1;
+    }
+    // need to check size of pivots (as simple code) not just for zero
+    for (numberGoodU_ = 0; numberGoodU_ < numberRows_; numberGoodU_++) {
+      if (fabs(elements_[numberGoodU_ * (numberRows_ + 1)]) <= zeroTolerance_)
+        break;
+    }
+    if (numberGoodU_ == numberRows_) {
       // OK
-      solveMode_ = 1 + 10 * (solveMode_ / 10);
-      numberGoodU_ = numberRows_;
-      CoinZeroN(workArea_, 2 * numberRows_);
-#if 0 //ndef NDEBUG
-      const CoinFactorizationDouble2 * column = elements_;
-      double smallest=COIN_DBL_MAX;
-      for (int i=0;i<numberRows_;i++) {
-	if (fabs(column[i])<smallest)
-	  smallest = fabs(column[i]);
-	column += numberRows_;
-      }
-      if (smallest<1.0e-8)
-	printf("small el %g\n",smallest);
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+      if (factorCode_ == 2)
+        solveMode_ = 1 + 10 * (solveMode_ / 10);
 #endif
+      CoinZeroN(workArea_, 2 * numberRows_);
       return 0;
-    } else {
+    }
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+    if (factorCode_ == 2)
       solveMode_ = 10 * (solveMode_ / 10);
+#endif
+    // singular - get rows of good pivots for makeNonSingular
+    int *permute = pivotRow_ + numberRows_;
+    for (int j = 0; j < numberRows_; j++)
+      permute[j] = j;
+    for (int i = 0; i < numberGoodU_; i++) {
+      int iRow = pivotRow_[i] - 1;
+      int iPivot = permute[i];
+      permute[i] = permute[iRow];
+      permute[iRow] = iPivot;
     }
+    for (int j = 0; j < numberRows_; j++)
+      pivotRow_[permute[j]] = j;
+    factorCode_ = 0;
+    status_ = -1;
+    return status_;
   }
-#endif
   for (int j = 0; j < numberRows_; j++) {
     pivotRow_[j + numberRows_] = j;
   }
@@ -320,9 +345,7 @@ void CoinDenseFactorization::makeNonSingular(int *sequence, int numberColumns)
 // Does post processing on valid factorization - putting variables on correct rows
 void CoinDenseFactorization::postProcess(const int *sequence, int *pivotVariable)
 {
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     for (int i = 0; i < numberRows_; i++) {
       int k = sequence[i];
 #ifdef DENSE_PERMUTE
@@ -336,15 +359,13 @@ void CoinDenseFactorization::postProcess(const int *sequence, int *pivotVariable
     pivotRow_[i + numberRows_] = k;
 #endif
     }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    // lapack
+    // LU factors as from LAPACK
     for (int i = 0; i < numberRows_; i++) {
       int k = sequence[i];
       pivotVariable[i] = k;
     }
   }
-#endif
 }
 /* Replaces one Column to basis,
    returns 0=OK, 1=Probably OK, 2=singular, 3=no room
@@ -371,9 +392,7 @@ int CoinDenseFactorization::replaceColumn(CoinIndexedVector *regionSparse,
   if (fabs(pivotValue) < zeroTolerance_)
     return 2;
   pivotValue = 1.0 / pivotValue;
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     if (regionSparse->packedMode()) {
       for (i = 0; i < numberNonZero; i++) {
         int iRow = regionIndex[i];
@@ -399,9 +418,8 @@ int CoinDenseFactorization::replaceColumn(CoinIndexedVector *regionSparse,
     int realPivotRow = pivotRow_[pivotRow];
     elements[realPivotRow] = pivotValue;
     pivotRow_[2 * numberRows_ + numberPivots_] = realPivotRow;
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    // lapack
+    // LU factors as from LAPACK
     if (regionSparse->packedMode()) {
       for (i = 0; i < numberNonZero; i++) {
         int iRow = regionIndex[i];
@@ -421,7 +439,6 @@ int CoinDenseFactorization::replaceColumn(CoinIndexedVector *regionSparse,
     elements[pivotRow] = pivotValue;
     pivotRow_[2 * numberRows_ + numberPivots_] = pivotRow;
   }
-#endif
   numberPivots_++;
   return 0;
 }
@@ -436,9 +453,7 @@ int CoinDenseFactorization::updateColumn(CoinIndexedVector *regionSparse,
   int *regionIndex = regionSparse2->getIndices();
   int numberNonZero = regionSparse2->getNumElements();
   double *region = regionSparse->denseVector();
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     if (!regionSparse2->packedMode()) {
       if (!noPermute) {
         for (int j = 0; j < numberRows_; j++) {
@@ -460,9 +475,8 @@ int CoinDenseFactorization::updateColumn(CoinIndexedVector *regionSparse,
         region2[j] = 0.0;
       }
     }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    // lapack
+    // LU factors as from LAPACK
     if (!regionSparse2->packedMode()) {
       if (!noPermute) {
         for (int j = 0; j < numberRows_; j++) {
@@ -483,18 +497,14 @@ int CoinDenseFactorization::updateColumn(CoinIndexedVector *regionSparse,
       }
     }
   }
-#endif
   int i;
   CoinFactorizationDouble2 *elements = elements_;
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     // base factorization L
     for (i = 0; i < numberColumns_; i++) {
       double value = region[i];
-      for (int j = i + 1; j < numberRows_; j++) {
-        region[j] -= value * elements[j];
-      }
+      if (value)
+        CoinAxpyN(-value, elements + i + 1, numberRows_ - i - 1, region + i + 1);
       elements += numberRows_;
     }
     elements = elements_ + numberRows_ * numberRows_;
@@ -503,36 +513,37 @@ int CoinDenseFactorization::updateColumn(CoinIndexedVector *regionSparse,
       elements -= numberRows_;
       CoinFactorizationDouble2 value = region[i] * elements[i];
       region[i] = value;
-      for (int j = 0; j < i; j++) {
-        region[j] -= value * elements[j];
-      }
+      if (value)
+        CoinAxpyN(-value, elements, i, region);
     }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    char trans = 'N';
-    int ione = 1;
-    int info;
-    COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberRows_,&ione,
-                     elements_,&numberRows_,pivotRow_,region,&numberRows_,
-                     &info,1);
-  }
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+    if (factorCode_ == 2) {
+      char trans = 'N';
+      int ione = 1;
+      int info;
+      COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberRows_,&ione,
+                       elements_,&numberRows_,pivotRow_,region,&numberRows_,
+                       &info,1);
+    } else
 #endif
+    {
+      CoinDenseLUSolve(false, numberRows_, elements_, numberRows_, pivotRow_,
+        region);
+    }
+  }
   // now updates
   elements = elements_ + numberRows_ * numberRows_;
   for (i = 0; i < numberPivots_; i++) {
     int iPivot = pivotRow_[i + 2 * numberRows_];
     CoinFactorizationDouble2 value = region[iPivot] * elements[iPivot];
-    for (int j = 0; j < numberRows_; j++) {
-      region[j] -= value * elements[j];
-    }
+    CoinAxpyN(-value, elements, numberRows_, region);
     region[iPivot] = value;
     elements += numberRows_;
   }
   // permute back and get nonzeros
   numberNonZero = 0;
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     if (!noPermute) {
       if (!regionSparse2->packedMode()) {
         for (int j = 0; j < numberRows_; j++) {
@@ -574,9 +585,8 @@ int CoinDenseFactorization::updateColumn(CoinIndexedVector *regionSparse,
         }
       }
     }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    // lapack
+    // LU factors as from LAPACK
     if (!noPermute) {
       if (!regionSparse2->packedMode()) {
         for (int j = 0; j < numberRows_; j++) {
@@ -609,7 +619,6 @@ int CoinDenseFactorization::updateColumn(CoinIndexedVector *regionSparse,
       }
     }
   }
-#endif
   regionSparse2->setNumElements(numberNonZero);
   return 0;
 }
@@ -619,20 +628,17 @@ int CoinDenseFactorization::updateTwoColumnsFT(CoinIndexedVector *regionSparse1,
   CoinIndexedVector *regionSparse3,
   bool /*noPermute*/)
 {
-#ifdef COIN_FACTORIZATION_DENSE_CODE
 #if 0
   CoinIndexedVector s2(*regionSparse2);
   CoinIndexedVector s3(*regionSparse3);
   updateColumn(regionSparse1,&s2);
   updateColumn(regionSparse1,&s3);
 #endif
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     updateColumn(regionSparse1, regionSparse2);
     updateColumn(regionSparse1, regionSparse3);
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    // lapack
+    // LU factors as from LAPACK
     assert(numberRows_ == numberColumns_);
     double *region2 = regionSparse2->denseVector();
     int *regionIndex2 = regionSparse2->getIndices();
@@ -670,21 +676,29 @@ int CoinDenseFactorization::updateTwoColumnsFT(CoinIndexedVector *regionSparse1,
     }
     int i;
     CoinFactorizationDouble2 *elements = elements_;
-    char trans = 'N';
-    int itwo = 2;
-    int info;
-    COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberRows_,&itwo,elements_,
-                     &numberRows_,pivotRow_,workArea_,&numberRows_,&info,1);
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+    if (factorCode_ == 2) {
+      char trans = 'N';
+      int itwo = 2;
+      int info;
+      COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberRows_,&itwo,elements_,
+                       &numberRows_,pivotRow_,workArea_,&numberRows_,&info,1);
+    } else
+#endif
+    {
+      CoinDenseLUSolve(false, numberRows_, elements_, numberRows_, pivotRow_,
+        regionW2);
+      CoinDenseLUSolve(false, numberRows_, elements_, numberRows_, pivotRow_,
+        regionW3);
+    }
     // now updates
     elements = elements_ + numberRows_ * numberRows_;
     for (i = 0; i < numberPivots_; i++) {
       int iPivot = pivotRow_[i + 2 * numberRows_];
       CoinFactorizationDouble2 value2 = regionW2[iPivot] * elements[iPivot];
       CoinFactorizationDouble2 value3 = regionW3[iPivot] * elements[iPivot];
-      for (int j = 0; j < numberRows_; j++) {
-        regionW2[j] -= value2 * elements[j];
-        regionW3[j] -= value3 * elements[j];
-      }
+      CoinAxpyN(-value2, elements, numberRows_, regionW2);
+      CoinAxpyN(-value3, elements, numberRows_, regionW3);
       regionW2[iPivot] = value2;
       regionW3[iPivot] = value3;
       elements += numberRows_;
@@ -747,7 +761,6 @@ int CoinDenseFactorization::updateTwoColumnsFT(CoinIndexedVector *regionSparse1,
     printf("======\n");
 #endif
   }
-#endif
   return 0;
 }
 
@@ -763,9 +776,7 @@ int CoinDenseFactorization::updateColumnTranspose(CoinIndexedVector *regionSpars
   int *regionIndex = regionSparse2->getIndices();
   int numberNonZero = regionSparse2->getNumElements();
   double *region = regionSparse->denseVector();
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     if (!regionSparse2->packedMode()) {
       for (int j = 0; j < numberRows_; j++) {
 #ifdef DENSE_PERMUTE
@@ -788,9 +799,8 @@ int CoinDenseFactorization::updateColumnTranspose(CoinIndexedVector *regionSpars
         region2[j] = 0.0;
       }
     }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    // lapack
+    // LU factors as from LAPACK
     if (!regionSparse2->packedMode()) {
       for (int j = 0; j < numberRows_; j++) {
         region[j] = region2[j];
@@ -804,7 +814,6 @@ int CoinDenseFactorization::updateColumnTranspose(CoinIndexedVector *regionSpars
       }
     }
   }
-#endif
   int i;
   CoinFactorizationDouble2 *elements = elements_ + numberRows_ * (numberRows_ + numberPivots_);
   // updates
@@ -812,25 +821,18 @@ int CoinDenseFactorization::updateColumnTranspose(CoinIndexedVector *regionSpars
     elements -= numberRows_;
     int iPivot = pivotRow_[i + 2 * numberRows_];
     CoinFactorizationDouble2 value = region[iPivot]; //*elements[iPivot];
-    for (int j = 0; j < iPivot; j++) {
-      value -= region[j] * elements[j];
-    }
-    for (int j = iPivot + 1; j < numberRows_; j++) {
-      value -= region[j] * elements[j];
-    }
+    value -= CoinDotProductN(region, elements, iPivot);
+    value -= CoinDotProductN(region + iPivot + 1, elements + iPivot + 1,
+      numberRows_ - iPivot - 1);
     region[iPivot] = value * elements[iPivot];
   }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     // base factorization U
     elements = elements_;
     for (i = 0; i < numberColumns_; i++) {
       //CoinFactorizationDouble2 value = region[i]*elements[i];
       CoinFactorizationDouble2 value = region[i];
-      for (int j = 0; j < i; j++) {
-        value -= region[j] * elements[j];
-      }
+      value -= CoinDotProductN(region, elements, i);
       //region[i] = value;
       region[i] = value * elements[i];
       elements += numberRows_;
@@ -840,25 +842,28 @@ int CoinDenseFactorization::updateColumnTranspose(CoinIndexedVector *regionSpars
     for (i = numberColumns_ - 1; i >= 0; i--) {
       elements -= numberRows_;
       CoinFactorizationDouble2 value = region[i];
-      for (int j = i + 1; j < numberRows_; j++) {
-        value -= region[j] * elements[j];
-      }
+      value -= CoinDotProductN(region + i + 1, elements + i + 1,
+        numberRows_ - i - 1);
       region[i] = value;
     }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    char trans = 'T';
-    int ione = 1;
-    int info;
-    COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberRows_,&ione,elements_,
-                     &numberRows_,pivotRow_,region,&numberRows_,&info,1);
-  }
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+    if (factorCode_ == 2) {
+      char trans = 'T';
+      int ione = 1;
+      int info;
+      COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberRows_,&ione,elements_,
+                       &numberRows_,pivotRow_,region,&numberRows_,&info,1);
+    } else
 #endif
+    {
+      CoinDenseLUSolve(true, numberRows_, elements_, numberRows_, pivotRow_,
+        region);
+    }
+  }
   // permute back and get nonzeros
   numberNonZero = 0;
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if ((solveMode_ % 10) == 0) {
-#endif
+  if (!factorCode_) {
     if (!regionSparse2->packedMode()) {
       for (int j = 0; j < numberRows_; j++) {
         int iRow = pivotRow_[j + numberRows_];
@@ -880,9 +885,8 @@ int CoinDenseFactorization::updateColumnTranspose(CoinIndexedVector *regionSpars
         }
       }
     }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   } else {
-    // lapack
+    // LU factors as from LAPACK
     if (!regionSparse2->packedMode()) {
       for (int j = 0; j < numberRows_; j++) {
         double value = region[j];
@@ -903,7 +907,6 @@ int CoinDenseFactorization::updateColumnTranspose(CoinIndexedVector *regionSpars
       }
     }
   }
-#endif
   regionSparse2->setNumElements(numberNonZero);
   return 0;
 }
@@ -334,12 +334,24 @@ public:
       0 - OK
       -99 - needs more memory
       -1 - singular - use numberGoodColumns and redo
+      A square basis is factorized by blocked LU (CoinDenseLU) or by
+      LAPACK if available and solveMode is not 0 (see factorCode).
   */
   virtual int factor();
   /// Does post processing on valid factorization - putting variables on correct rows
   virtual void postProcess(const int *sequence, int *pivotVariable);
   /// Makes a non-singular basis by replacing variables
   virtual void makeNonSingular(int *sequence, int numberColumns);
+  /** How last factorization was done
+      0 - simple code (inverse of pivots stored, rows permuted)
+      1 - built in blocked LU (CoinDenseLUFactor)
+      2 - LAPACK dgetrf
+      Factors from 1 and 2 have the same format.
+  */
+  inline int factorCode() const
+  {
+    return factorCode_;
+  }
   //@}
 
   /**@name general stuff such as number of elements */
@@ -441,6 +453,8 @@ protected:
 protected:
   /**@name data */
   //@{
+  /// How last factorization was done (see factorCode)
+  int factorCode_;
   //@}
 };
 #endif
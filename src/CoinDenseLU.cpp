@@ -0,0 +1,700 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+#include <cmath>
+#include "CoinDenseLU.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinThreadPool.hpp"
+
+// Same conditions as vector kernels in CoinHelperFunctions.cpp
+#if !defined(COIN_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+  && ((defined(__clang__) && __clang_major__ >= 4) \
+    || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 7))
+#define COIN_SIMD_X86
+#include <immintrin.h>
+#define COIN_TARGET_AVX2 __attribute__((target("avx2")))
+#define COIN_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+// Columns in a panel
+#define COIN_DENSE_PANEL 64
+// Rows and columns done by one call of update kernel
+#define COIN_DENSE_ROWS 8
+#define COIN_DENSE_COLUMNS 4
+// Rows of packed L kept in cache while going across columns
+#define COIN_DENSE_ROW_BLOCK 256
+// Do not use threads for fewer trailing columns than this
+#define COIN_DENSE_PARALLEL_COLUMNS 64
+
+// Start of column j (matrix may have more than 2^31 entries)
+static inline double *denseColumn(double *a, int lda, int j)
+{
+  return a + static_cast< size_t >(j) * lda;
+}
+static inline const double *denseColumn(const double *a, int lda, int j)
+{
+  return a + static_cast< size_t >(j) * lda;
+}
+
+//-------------------------------------------------------------------
+// Kernels
+//-------------------------------------------------------------------
+/*
+  c(i,j) -= sum over k of l(i,k)*u(k,j) for an 8 by 4 block where l is
+  packed as l[8*k+i] and u as u[4*k+j] (both padded with zeros).
+*/
+static void
+updateBlockScalar(int depth, const double *l, const double *u, double *c,
+  int ldc, int numberRows, int numberColumns)
+{
+  double sum[COIN_DENSE_COLUMNS][COIN_DENSE_ROWS];
+  for (int j = 0; j < COIN_DENSE_COLUMNS; j++) {
+    for (int i = 0; i < COIN_DENSE_ROWS; i++)
+      sum[j][i] = 0.0;
+  }
+  for (int k = 0; k < depth; k++) {
+    for (int j = 0; j < COIN_DENSE_COLUMNS; j++) {
+      double value = u[COIN_DENSE_COLUMNS * k + j];
+      for (int i = 0; i < COIN_DENSE_ROWS; i++)
+        sum[j][i] += l[COIN_DENSE_ROWS * k + i] * value;
+    }
+  }
+  for (int j = 0; j < numberColumns; j++) {
+    double *column = denseColumn(c, ldc, j);
+    for (int i = 0; i < numberRows; i++)
+      column[i] -= sum[j][i];
+  }
+}
+
+// y[i] -= x[0]*a0[i] + x[1]*a1[i] + x[2]*a2[i] + x[3]*a3[i]
+static void
+update4Scalar(int size, const double *a, int lda, const double *x, double *y)
+{
+  const double *a0 = a;
+  const double *a1 = denseColumn(a, lda, 1);
+  const double *a2 = denseColumn(a, lda, 2);
+  const double *a3 = denseColumn(a, lda, 3);
+  for (int i = 0; i < size; i++)
+    y[i] -= x[0] * a0[i] + x[1] * a1[i] + x[2] * a2[i] + x[3] * a3[i];
+}
+
+// result[j] = sum of a(i,j)*y[i] for four columns
+static void
+dot4Scalar(int size, const double *a, int lda, const double *y, double *result)
+{
+  for (int j = 0; j < 4; j++) {
+    const double *column = denseColumn(a, lda, j);
+    double value = 0.0;
+    for (int i = 0; i < size; i++)
+      value += column[i] * y[i];
+    result[j] = value;
+  }
+}
+
+#ifdef COIN_SIMD_X86
+COIN_TARGET_AVX2 static void
+updateBlockAvx2(int depth, const double *l, const double *u, double *c,
+  int ldc, int numberRows, int numberColumns)
+{
+  __m256d sum00 = _mm256_setzero_pd();
+  __m256d sum01 = _mm256_setzero_pd();
+  __m256d sum10 = _mm256_setzero_pd();
+  __m256d sum11 = _mm256_setzero_pd();
+  __m256d sum20 = _mm256_setzero_pd();
+  __m256d sum21 = _mm256_setzero_pd();
+  __m256d sum30 = _mm256_setzero_pd();
+  __m256d sum31 = _mm256_setzero_pd();
+  for (int k = 0; k < depth; k++) {
+    __m256d l0 = _mm256_loadu_pd(l + COIN_DENSE_ROWS * k);
+    __m256d l1 = _mm256_loadu_pd(l + COIN_DENSE_ROWS * k + 4);
+    const double *uk = u + COIN_DENSE_COLUMNS * k;
+    __m256d value = _mm256_broadcast_sd(uk);
+    sum00 = _mm256_add_pd(sum00, _mm256_mul_pd(l0, value));
+    sum01 = _mm256_add_pd(sum01, _mm256_mul_pd(l1, value));
+    value = _mm256_broadcast_sd(uk + 1);
+    sum10 = _mm256_add_pd(sum10, _mm256_mul_pd(l0, value));
+    sum11 = _mm256_add_pd(sum11, _mm256_mul_pd(l1, value));
+    value = _mm256_broadcast_sd(uk + 2);
+    sum20 = _mm256_add_pd(sum20, _mm256_mul_pd(l0, value));
+    sum21 = _mm256_add_pd(sum21, _mm256_mul_pd(l1, value));
+    value = _mm256_broadcast_sd(uk + 3);
+    sum30 = _mm256_add_pd(sum30, _mm256_mul_pd(l0, value));
+    sum31 = _mm256_add_pd(sum31, _mm256_mul_pd(l1, value));
+  }
+  if (numberRows == COIN_DENSE_ROWS && numberColumns == COIN_DENSE_COLUMNS) {
+    double *c0 = c;
+    double *c1 = denseColumn(c, ldc, 1);
+    double *c2 = denseColumn(c, ldc, 2);
+    double *c3 = denseColumn(c, ldc, 3);
+    _mm256_storeu_pd(c0, _mm256_sub_pd(_mm256_loadu_pd(c0), sum00));
+    _mm256_storeu_pd(c0 + 4, _mm256_sub_pd(_mm256_loadu_pd(c0 + 4), sum01));
+    _mm256_storeu_pd(c1, _mm256_sub_pd(_mm256_loadu_pd(c1), sum10));
+    _mm256_storeu_pd(c1 + 4, _mm256_sub_pd(_mm256_loadu_pd(c1 + 4), sum11));
+    _mm256_storeu_pd(c2, _mm256_sub_pd(_mm256_loadu_pd(c2), sum20));
+    _mm256_storeu_pd(c2 + 4, _mm256_sub_pd(_mm256_loadu_pd(c2 + 4), sum21));
+    _mm256_storeu_pd(c3, _mm256_sub_pd(_mm256_loadu_pd(c3), sum30));
+    _mm256_storeu_pd(c3 + 4, _mm256_sub_pd(_mm256_loadu_pd(c3 + 4), sum31));
+  } else {
+    double sum[COIN_DENSE_COLUMNS][COIN_DENSE_ROWS];
+    _mm256_storeu_pd(sum[0], sum00);
+    _mm256_storeu_pd(sum[0] + 4, sum01);
+    _mm256_storeu_pd(sum[1], sum10);
+    _mm256_storeu_pd(sum[1] + 4, sum11);
+    _mm256_storeu_pd(sum[2], sum20);
+    _mm256_storeu_pd(sum[2] + 4, sum21);
+    _mm256_storeu_pd(sum[3], sum30);
+    _mm256_storeu_pd(sum[3] + 4, sum31);
+    for (int j = 0; j < numberColumns; j++) {
+      double *column = denseColumn(c, ldc, j);
+      for (int i = 0; i < numberRows; i++)
+        column[i] -= sum[j][i];
+    }
+  }
+}
+
+COIN_TARGET_AVX2 static void
+update4Avx2(int size, const double *a, int lda, const double *x, double *y)
+{
+  const double *a0 = a;
+  const double *a1 = denseColumn(a, lda, 1);
+  const double *a2 = denseColumn(a, lda, 2);
+  const double *a3 = denseColumn(a, lda, 3);
+  __m256d x0 = _mm256_set1_pd(x[0]);
+  __m256d x1 = _mm256_set1_pd(x[1]);
+  __m256d x2 = _mm256_set1_pd(x[2]);
+  __m256d x3 = _mm256_set1_pd(x[3]);
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    // same order of operations as scalar code
+    __m256d value = _mm256_mul_pd(x0, _mm256_loadu_pd(a0 + i));
+    value = _mm256_add_pd(value, _mm256_mul_pd(x1, _mm256_loadu_pd(a1 + i)));
+    value = _mm256_add_pd(value, _mm256_mul_pd(x2, _mm256_loadu_pd(a2 + i)));
+    value = _mm256_add_pd(value, _mm256_mul_pd(x3, _mm256_loadu_pd(a3 + i)));
+    _mm256_storeu_pd(y + i, _mm256_sub_pd(_mm256_loadu_pd(y + i), value));
+  }
+  for (; i < size; i++)
+    y[i] -= x[0] * a0[i] + x[1] * a1[i] + x[2] * a2[i] + x[3] * a3[i];
+}
+
+COIN_TARGET_AVX2 static void
+dot4Avx2(int size, const double *a, int lda, const double *y, double *result)
+{
+  const double *a0 = a;
+  const double *a1 = denseColumn(a, lda, 1);
+  const double *a2 = denseColumn(a, lda, 2);
+  const double *a3 = denseColumn(a, lda, 3);
+  __m256d sum0 = _mm256_setzero_pd();
+  __m256d sum1 = _mm256_setzero_pd();
+  __m256d sum2 = _mm256_setzero_pd();
+  __m256d sum3 = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m256d value = _mm256_loadu_pd(y + i);
+    sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(value, _mm256_loadu_pd(a0 + i)));
+    sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(value, _mm256_loadu_pd(a1 + i)));
+    sum2 = _mm256_add_pd(sum2, _mm256_mul_pd(value, _mm256_loadu_pd(a2 + i)));
+    sum3 = _mm256_add_pd(sum3, _mm256_mul_pd(value, _mm256_loadu_pd(a3 + i)));
+  }
+  double part[4][4];
+  _mm256_storeu_pd(part[0], sum0);
+  _mm256_storeu_pd(part[1], sum1);
+  _mm256_storeu_pd(part[2], sum2);
+  _mm256_storeu_pd(part[3], sum3);
+  for (int j = 0; j < 4; j++)
+    result[j] = (part[j][0] + part[j][1]) + (part[j][2] + part[j][3]);
+  for (; i < size; i++) {
+    result[0] += a0[i] * y[i];
+    result[1] += a1[i] * y[i];
+    result[2] += a2[i] * y[i];
+    result[3] += a3[i] * y[i];
+  }
+}
+
+COIN_TARGET_AVX512 static void
+updateBlockAvx512(int depth, const double *l, const double *u, double *c,
+  int ldc, int numberRows, int numberColumns)
+{
+  __m512d sum0 = _mm512_setzero_pd();
+  __m512d sum1 = _mm512_setzero_pd();
+  __m512d sum2 = _mm512_setzero_pd();
+  __m512d sum3 = _mm512_setzero_pd();
+  for (int k = 0; k < depth; k++) {
+    __m512d lk = _mm512_loadu_pd(l + COIN_DENSE_ROWS * k);
+    const double *uk = u + COIN_DENSE_COLUMNS * k;
+    sum0 = _mm512_fmadd_pd(lk, _mm512_set1_pd(uk[0]), sum0);
+    sum1 = _mm512_fmadd_pd(lk, _mm512_set1_pd(uk[1]), sum1);
+    sum2 = _mm512_fmadd_pd(lk, _mm512_set1_pd(uk[2]), sum2);
+    sum3 = _mm512_fmadd_pd(lk, _mm512_set1_pd(uk[3]), sum3);
+  }
+  if (numberRows == COIN_DENSE_ROWS && numberColumns == COIN_DENSE_COLUMNS) {
+    double *c0 = c;
+    double *c1 = denseColumn(c, ldc, 1);
+    double *c2 = denseColumn(c, ldc, 2);
+    double *c3 = denseColumn(c, ldc, 3);
+    _mm512_storeu_pd(c0, _mm512_sub_pd(_mm512_loadu_pd(c0), sum0));
+    _mm512_storeu_pd(c1, _mm512_sub_pd(_mm512_loadu_pd(c1), sum1));
+    _mm512_storeu_pd(c2, _mm512_sub_pd(_mm512_loadu_pd(c2), sum2));
+    _mm512_storeu_pd(c3, _mm512_sub_pd(_mm512_loadu_pd(c3), sum3));
+  } else {
+    double sum[COIN_DENSE_COLUMNS][COIN_DENSE_ROWS];
+    _mm512_storeu_pd(sum[0], sum0);
+    _mm512_storeu_pd(sum[1], sum1);
+    _mm512_storeu_pd(sum[2], sum2);
+    _mm512_storeu_pd(sum[3], sum3);
+    for (int j = 0; j < numberColumns; j++) {
+      double *column = denseColumn(c, ldc, j);
+      for (int i = 0; i < numberRows; i++)
+        column[i] -= sum[j][i];
+    }
+  }
+}
+
+COIN_TARGET_AVX512 static void
+update4Avx512(int size, const double *a, int lda, const double *x, double *y)
+{
+  const double *a0 = a;
+  const double *a1 = denseColumn(a, lda, 1);
+  const double *a2 = denseColumn(a, lda, 2);
+  const double *a3 = denseColumn(a, lda, 3);
+  __m512d x0 = _mm512_set1_pd(x[0]);
+  __m512d x1 = _mm512_set1_pd(x[1]);
+  __m512d x2 = _mm512_set1_pd(x[2]);
+  __m512d x3 = _mm512_set1_pd(x[3]);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m512d value = _mm512_mul_pd(x0, _mm512_loadu_pd(a0 + i));
+    value = _mm512_add_pd(value, _mm512_mul_pd(x1, _mm512_loadu_pd(a1 + i)));
+    value = _mm512_add_pd(value, _mm512_mul_pd(x2, _mm512_loadu_pd(a2 + i)));
+    value = _mm512_add_pd(value, _mm512_mul_pd(x3, _mm512_loadu_pd(a3 + i)));
+    _mm512_storeu_pd(y + i, _mm512_sub_pd(_mm512_loadu_pd(y + i), value));
+  }
+  for (; i < size; i++)
+    y[i] -= x[0] * a0[i] + x[1] * a1[i] + x[2] * a2[i] + x[3] * a3[i];
+}
+
+/* Sum of the eight entries.  Done by hand as _mm512_reduce_add_pd
+   works on undefined registers (and so gives warnings). */
+COIN_TARGET_AVX512 static inline double
+reduceAddAvx512(__m512d v)
+{
+  double part[8];
+  _mm512_storeu_pd(part, v);
+  return ((part[0] + part[1]) + (part[2] + part[3]))
+    + ((part[4] + part[5]) + (part[6] + part[7]));
+}
+
+COIN_TARGET_AVX512 static void
+dot4Avx512(int size, const double *a, int lda, const double *y, double *result)
+{
+  const double *a0 = a;
+  const double *a1 = denseColumn(a, lda, 1);
+  const double *a2 = denseColumn(a, lda, 2);
+  const double *a3 = denseColumn(a, lda, 3);
+  __m512d sum0 = _mm512_setzero_pd();
+  __m512d sum1 = _mm512_setzero_pd();
+  __m512d sum2 = _mm512_setzero_pd();
+  __m512d sum3 = _mm512_setzero_pd();
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m512d value = _mm512_loadu_pd(y + i);
+    sum0 = _mm512_fmadd_pd(value, _mm512_loadu_pd(a0 + i), sum0);
+    sum1 = _mm512_fmadd_pd(value, _mm512_loadu_pd(a1 + i), sum1);
+    sum2 = _mm512_fmadd_pd(value, _mm512_loadu_pd(a2 + i), sum2);
+    sum3 = _mm512_fmadd_pd(value, _mm512_loadu_pd(a3 + i), sum3);
+  }
+  result[0] = reduceAddAvx512(sum0);
+  result[1] = reduceAddAvx512(sum1);
+  result[2] = reduceAddAvx512(sum2);
+  result[3] = reduceAddAvx512(sum3);
+  for (; i < size; i++) {
+    result[0] += a0[i] * y[i];
+    result[1] += a1[i] * y[i];
+    result[2] += a2[i] * y[i];
+    result[3] += a3[i] * y[i];
+  }
+}
+#endif
+
+typedef void (*CoinDenseBlockKernel)(int depth, const double *l,
+  const double *u, double *c, int ldc, int numberRows, int numberColumns);
+
+static CoinDenseBlockKernel blockKernel()
+{
+#ifdef COIN_SIMD_X86
+  int level = CoinSimdLevel();
+  if (level == COIN_SIMD_AVX512)
+    return updateBlockAvx512;
+  else if (level == COIN_SIMD_AVX2)
+    return updateBlockAvx2;
+#endif
+  return updateBlockScalar;
+}
+
+static void update4(int size, const double *a, int lda, const double *x,
+  double *y)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= 8) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512) {
+      update4Avx512(size, a, lda, x, y);
+      return;
+    } else if (level == COIN_SIMD_AVX2) {
+      update4Avx2(size, a, lda, x, y);
+      return;
+    }
+  }
+#endif
+  update4Scalar(size, a, lda, x, y);
+}
+
+static void dot4(int size, const double *a, int lda, const double *y,
+  double *result)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= 8) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512) {
+      dot4Avx512(size, a, lda, y, result);
+      return;
+    } else if (level == COIN_SIMD_AVX2) {
+      dot4Avx2(size, a, lda, y, result);
+      return;
+    }
+  }
+#endif
+  dot4Scalar(size, a, lda, y, result);
+}
+
+//-------------------------------------------------------------------
+// Factorization
+//-------------------------------------------------------------------
+/*
+  Unblocked factorization of columns first to first+number-1 (rows first
+  onwards).  Row interchanges are only done inside the panel.
+*/
+static int factorPanel(int n, double *a, int lda, int *pivot, int first,
+  int number)
+{
+  int info = 0;
+  int last = first + number;
+  for (int j = first; j < last; j++) {
+    double *column = denseColumn(a, lda, j);
+    int pivotRow = j;
+    double largest = fabs(column[j]);
+    for (int i = j + 1; i < n; i++) {
+      if (fabs(column[i]) > largest) {
+        largest = fabs(column[i]);
+        pivotRow = i;
+      }
+    }
+    pivot[j] = pivotRow + 1;
+    if (largest) {
+      if (pivotRow != j) {
+        for (int k = first; k < last; k++) {
+          double *columnK = denseColumn(a, lda, k);
+          double value = columnK[j];
+          columnK[j] = columnK[pivotRow];
+          columnK[pivotRow] = value;
+        }
+      }
+      CoinScaledCopyN(column + j + 1, n - j - 1, 1.0 / column[j],
+        column + j + 1);
+    } else if (!info) {
+      info = j + 1;
+    }
+    for (int k = j + 1; k < last; k++) {
+      double *columnK = denseColumn(a, lda, k);
+      double value = columnK[j];
+      if (value)
+        CoinAxpyN(-value, column + j + 1, n - j - 1, columnK + j + 1);
+    }
+  }
+  return info;
+}
+
+// What one task of trailing update needs
+typedef struct {
+  double *a;
+  const int *pivot;
+  // packed L below panel
+  const double *packedL;
+  int n;
+  int lda;
+  // first column and number of columns in panel
+  int first;
+  int number;
+  int numberColumns;
+  int numberBlocks;
+} CoinDenseTrailingInfo;
+
+/*
+  Does row interchanges, solve with L of panel and update of remaining
+  rows for a range of trailing columns.
+*/
+static void trailingUpdate(void *info, int which)
+{
+  const CoinDenseTrailingInfo *update = reinterpret_cast< const CoinDenseTrailingInfo * >(info);
+  double *a = update->a;
+  int lda = update->lda;
+  int n = update->n;
+  int first = update->first;
+  int number = update->number;
+  int last = first + number;
+  // split in multiples of kernel width
+  int numberGroups = (update->numberColumns + COIN_DENSE_COLUMNS - 1) / COIN_DENSE_COLUMNS;
+  int firstGroup = static_cast< int >((static_cast< CoinInt64 >(numberGroups) * which) / update->numberBlocks);
+  int lastGroup = static_cast< int >((static_cast< CoinInt64 >(numberGroups) * (which + 1)) / update->numberBlocks);
+  int firstColumn = last + firstGroup * COIN_DENSE_COLUMNS;
+  int lastColumn = CoinMin(last + lastGroup * COIN_DENSE_COLUMNS, n);
+  if (firstColumn >= lastColumn)
+    return;
+  const double *COIN_RESTRICT panel = denseColumn(a, lda, first);
+  for (int j = firstColumn; j < lastColumn; j++) {
+    double *COIN_RESTRICT column = denseColumn(a, lda, j);
+    for (int k = first; k < last; k++) {
+      int pivotRow = update->pivot[k] - 1;
+      if (pivotRow != k) {
+        double value = column[k];
+        column[k] = column[pivotRow];
+        column[pivotRow] = value;
+      }
+    }
+    // unit lower triangular solve
+    for (int k = first; k < last; k++) {
+      double value = column[k];
+      if (value) {
+        const double *COIN_RESTRICT columnL = panel + static_cast< size_t >(k - first) * lda;
+        for (int i = k + 1; i < last; i++)
+          column[i] -= value * columnL[i];
+      }
+    }
+  }
+  int numberRows = n - last;
+  if (!numberRows)
+    return;
+  // pack rows of U for these columns
+  int numberColumns = lastColumn - firstColumn;
+  int numberPacked = (numberColumns + COIN_DENSE_COLUMNS - 1) / COIN_DENSE_COLUMNS;
+  double *packedU = new double[numberPacked * number * COIN_DENSE_COLUMNS];
+  for (int iGroup = 0; iGroup < numberPacked; iGroup++) {
+    double *put = packedU + iGroup * number * COIN_DENSE_COLUMNS;
+    for (int jj = 0; jj < COIN_DENSE_COLUMNS; jj++) {
+      int j = firstColumn + iGroup * COIN_DENSE_COLUMNS + jj;
+      if (j < lastColumn) {
+        const double *column = denseColumn(a, lda, j);
+        for (int k = 0; k < number; k++)
+          put[COIN_DENSE_COLUMNS * k + jj] = column[first + k];
+      } else {
+        for (int k = 0; k < number; k++)
+          put[COIN_DENSE_COLUMNS * k + jj] = 0.0;
+      }
+    }
+  }
+  CoinDenseBlockKernel kernel = blockKernel();
+  for (int rowBlock = 0; rowBlock < numberRows; rowBlock += COIN_DENSE_ROW_BLOCK) {
+    int endBlock = CoinMin(rowBlock + COIN_DENSE_ROW_BLOCK, numberRows);
+    for (int iGroup = 0; iGroup < numberPacked; iGroup++) {
+      const double *u = packedU + iGroup * number * COIN_DENSE_COLUMNS;
+      int j = firstColumn + iGroup * COIN_DENSE_COLUMNS;
+      int nColumns = CoinMin(COIN_DENSE_COLUMNS, lastColumn - j);
+      double *column = denseColumn(a, lda, j) + last;
+      for (int iRow = rowBlock; iRow < endBlock; iRow += COIN_DENSE_ROWS) {
+        const double *l = update->packedL + static_cast< size_t >(iRow) * number;
+        kernel(number, l, u, column + iRow, lda,
+          CoinMin(COIN_DENSE_ROWS, numberRows - iRow), nColumns);
+      }
+    }
+  }
+  delete[] packedU;
+}
+
+int CoinDenseLUFactor(int n, double *a, int lda, int *pivot,
+  CoinThreadPool *threadPool)
+{
+  int info = 0;
+  int numberThreads = threadPool ? threadPool->numberThreads() : 1;
+  // rows below first panel rounded up to kernel height
+  int maximumRows = ((n + COIN_DENSE_ROWS - 1) / COIN_DENSE_ROWS) * COIN_DENSE_ROWS;
+  double *packedL = new double[static_cast< size_t >(maximumRows) * CoinMin(n, COIN_DENSE_PANEL)];
+  for (int first = 0; first < n; first += COIN_DENSE_PANEL) {
+    int number = CoinMin(COIN_DENSE_PANEL, n - first);
+    int last = first + number;
+    int returnCode = factorPanel(n, a, lda, pivot, first, number);
+    if (returnCode && !info)
+      info = returnCode;
+    // interchanges to left of panel
+    for (int k = first; k < last; k++) {
+      int pivotRow = pivot[k] - 1;
+      if (pivotRow != k) {
+        for (int j = 0; j < first; j++) {
+          double *column = denseColumn(a, lda, j);
+          double value = column[k];
+          column[k] = column[pivotRow];
+          column[pivotRow] = value;
+        }
+      }
+    }
+    int numberColumns = n - last;
+    if (!numberColumns)
+      break;
+    // pack L below panel
+    int numberRows = n - last;
+    for (int iRow = 0; iRow < numberRows; iRow += COIN_DENSE_ROWS) {
+      double *put = packedL + static_cast< size_t >(iRow) * number;
+      int nRows = CoinMin(COIN_DENSE_ROWS, numberRows - iRow);
+      for (int k = 0; k < number; k++) {
+        const double *column = denseColumn(a, lda, first + k) + last + iRow;
+        int i;
+        for (i = 0; i < nRows; i++)
+          put[i] = column[i];
+        for (; i < COIN_DENSE_ROWS; i++)
+          put[i] = 0.0;
+        put += COIN_DENSE_ROWS;
+      }
+    }
+    CoinDenseTrailingInfo update;
+    update.a = a;
+    update.pivot = pivot;
+    update.packedL = packedL;
+    update.n = n;
+    update.lda = lda;
+    update.first = first;
+    update.number = number;
+    update.numberColumns = numberColumns;
+    if (numberThreads > 1 && numberColumns >= COIN_DENSE_PARALLEL_COLUMNS) {
+      update.numberBlocks = CoinMin(numberThreads,
+        numberColumns / (COIN_DENSE_PARALLEL_COLUMNS / 2));
+      threadPool->run(update.numberBlocks, trailingUpdate, &update);
+    } else {
+      update.numberBlocks = 1;
+      trailingUpdate(&update, 0);
+    }
+  }
+  delete[] packedL;
+  return info;
+}
+
+//-------------------------------------------------------------------
+// Solves
+//-------------------------------------------------------------------
+void CoinDenseLUSolve(bool transpose, int n, const double *a, int lda,
+  const int *pivot, double *b)
+{
+  if (!transpose) {
+    for (int i = 0; i < n; i++) {
+      int pivotRow = pivot[i] - 1;
+      if (pivotRow != i) {
+        double value = b[i];
+        b[i] = b[pivotRow];
+        b[pivotRow] = value;
+      }
+    }
+    // L - unit lower triangular
+    for (int first = 0; first < n; first += 4) {
+      int last = CoinMin(first + 4, n);
+      for (int k = first; k < last; k++) {
+        double value = b[k];
+        if (value) {
+          const double *column = denseColumn(a, lda, k);
+          for (int i = k + 1; i < last; i++)
+            b[i] -= value * column[i];
+        }
+      }
+      if (last == n)
+        break;
+      if (last - first == 4) {
+        if (b[first] || b[first + 1] || b[first + 2] || b[first + 3])
+          update4(n - last, denseColumn(a, lda, first) + last, lda, b + first,
+            b + last);
+      } else {
+        for (int k = first; k < last; k++) {
+          if (b[k])
+            CoinAxpyN(-b[k], denseColumn(a, lda, k) + last, n - last, b + last);
+        }
+      }
+    }
+    // U
+    for (int last = n; last > 0; last -= 4) {
+      int first = CoinMax(last - 4, 0);
+      for (int k = last - 1; k >= first; k--) {
+        const double *column = denseColumn(a, lda, k);
+        double value = b[k] / column[k];
+        b[k] = value;
+        if (value) {
+          for (int i = first; i < k; i++)
+            b[i] -= value * column[i];
+        }
+      }
+      if (!first)
+        break;
+      if (last - first == 4) {
+        if (b[first] || b[first + 1] || b[first + 2] || b[first + 3])
+          update4(first, denseColumn(a, lda, first), lda, b + first, b);
+      } else {
+        for (int k = first; k < last; k++) {
+          if (b[k])
+            CoinAxpyN(-b[k], denseColumn(a, lda, k), first, b);
+        }
+      }
+    }
+  } else {
+    double result[4];
+    // U transpose - forward
+    for (int first = 0; first < n; first += 4) {
+      int last = CoinMin(first + 4, n);
+      if (first) {
+        if (last - first == 4) {
+          dot4(first, denseColumn(a, lda, first), lda, b, result);
+          for (int k = first; k < last; k++)
+            b[k] -= result[k - first];
+        } else {
+          for (int k = first; k < last; k++)
+            b[k] -= CoinDotProductN(denseColumn(a, lda, k), b, first);
+        }
+      }
+      for (int k = first; k < last; k++) {
+        const double *column = denseColumn(a, lda, k);
+        double value = b[k];
+        for (int i = first; i < k; i++)
+          value -= column[i] * b[i];
+        b[k] = value / column[k];
+      }
+    }
+    // L transpose - backward
+    for (int last = n; last > 0; last -= 4) {
+      int first = CoinMax(last - 4, 0);
+      if (last < n) {
+        if (last - first == 4) {
+          dot4(n - last, denseColumn(a, lda, first) + last, lda, b + last,
+            result);
+          for (int k = first; k < last; k++)
+            b[k] -= result[k - first];
+        } else {
+          for (int k = first; k < last; k++)
+            b[k] -= CoinDotProductN(denseColumn(a, lda, k) + last, b + last,
+              n - last);
+        }
+      }
+      for (int k = last - 1; k >= first; k--) {
+        const double *column = denseColumn(a, lda, k);
+        double value = b[k];
+        for (int i = k + 1; i < last; i++)
+          value -= column[i] * b[i];
+        b[k] = value;
+      }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      int pivotRow = pivot[i] - 1;
+      if (pivotRow != i) {
+        double value = b[i];
+        b[i] = b[pivotRow];
+        b[pivotRow] = value;
+      }
+    }
+  }
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
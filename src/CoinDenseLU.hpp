@@ -0,0 +1,43 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinDenseLU_H
+#define CoinDenseLU_H
+
+#include <cstddef>
+#include "CoinUtilsConfig.h"
+
+class CoinThreadPool;
+
+/** \file CoinDenseLU.hpp
+    Dense LU factorization with partial pivoting and the matching solves.
+
+    Storage and pivots are as for LAPACK dgetrf and dgetrs - column major,
+    unit lower triangular L below the diagonal and U on and above it, with
+    row i swapped with row pivot[i]-1 at step i - so factors from one can
+    be used by the other.  The factorization works on panels of columns and
+    does the trailing update on packed blocks which stay in cache; solves
+    work on blocks of four columns.  Inner kernels use AVX2 or AVX-512 as
+    chosen by CoinSimdLevel().
+*/
+//@{
+/** Factorizes the n by n matrix a (leading dimension lda) in place.
+
+    Returns 0 if okay or k if U(k-1,k-1) is exactly zero (as LAPACK
+    info).  If a thread pool is given the trailing updates are split by
+    columns over its threads; factors are the same as with no pool.
+*/
+COINUTILSLIB_EXPORT int
+CoinDenseLUFactor(int n, double *a, int lda, int *pivot,
+  CoinThreadPool *threadPool = NULL);
+/** Solves A x = b (A' x = b if transpose) using factors from
+    CoinDenseLUFactor or dgetrf.  b is overwritten by x. */
+COINUTILSLIB_EXPORT void
+CoinDenseLUSolve(bool transpose, int n, const double *a, int lda,
+  const int *pivot, double *b);
+//@}
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -177,23 +177,101 @@ void CoinDenseVector< T >::gutsOfSetConstant(size_t size, T value)
 }
 
 //#############################################################################
-/** Access the i'th element of the dense vector.  */
+// Reductions - overloads for doubles use vector kernels
+
+namespace {
 template < typename T >
-T &
-  CoinDenseVector< T >::operator[](size_t index)
+T absSum(const T *x, size_t n)
 {
-  assert(index < elements_.size());
-  return elements_[index];
+  T norm = 0;
+  for (size_t i = 0; i < n; i++)
+    norm += std::abs(x[i]);
+  return norm;
+}
+double absSum(const double *x, size_t n)
+{
+  return CoinAbsSumN(x, n);
+}
+template < typename T >
+double sumOfSquares(const T *x, size_t n)
+{
+  double norm = 0.;
+  for (size_t i = 0; i < n; i++)
+    norm += x[i] * x[i];
+  return norm;
+}
+double sumOfSquares(const double *x, size_t n)
+{
+  return CoinSumOfSquaresN(x, n);
+}
+template < typename T >
+T maxAbs(const T *x, size_t n)
+{
+  T norm = 0;
+  for (size_t i = 0; i < n; i++)
+    norm = std::max(norm, std::abs(x[i]));
+  return norm;
+}
+double maxAbs(const double *x, size_t n)
+{
+  return CoinMaxAbsN(x, n);
+}
+template < typename T >
+T sumOf(const T *x, size_t n)
+{
+  double value = 0.0;
+  for (size_t i = 0; i < n; i++)
+    value += x[i];
+  return static_cast< T >(value);
+}
+double sumOf(const double *x, size_t n)
+{
+  return CoinSumN(x, n);
+}
+template < typename T >
+void scaleBy(T *x, size_t n, T factor)
+{
+  for (size_t i = 0; i < n; i++)
+    x[i] *= factor;
+}
+void scaleBy(double *x, size_t n, double factor)
+{
+  CoinScaledCopyN(x, n, factor, x);
+}
 }
 
-/** Access the i'th element of the dense vector.  */
 template < typename T >
-const T &
-  CoinDenseVector< T >::operator[](size_t index) const
+T CoinDenseVector< T >::oneNorm() const
 {
-  assert(index < elements_.size());
-  return elements_[index];
+  return absSum(elements_.data(), elements_.size());
 }
+
+template < typename T >
+double CoinDenseVector< T >::twoNorm() const
+{
+  // std namespace removed because it was causing a compile
+  // problem with Microsoft Visual C++
+  return /*std::*/ sqrt(sumOfSquares(elements_.data(), elements_.size()));
+}
+
+template < typename T >
+T CoinDenseVector< T >::infNorm() const
+{
+  return maxAbs(elements_.data(), elements_.size());
+}
+
+template < typename T >
+T CoinDenseVector< T >::sum() const
+{
+  return sumOf(elements_.data(), elements_.size());
+}
+
+template < typename T >
+void CoinDenseVector< T >::scale(T factor)
+{
+  scaleBy(elements_.data(), elements_.size(), factor);
+}
+
 //#############################################################################
 
 // template class CoinDenseVector<int>; This works but causes warning messages
@@ -26,6 +26,110 @@
 template < typename T >
 void CoinDenseVectorUnitTest(T dummy);
 
+//#############################################################################
+template < typename T >
+class CoinDenseVector;
+
+/** Base of expressions on dense vectors.
+
+    Arithmetic on CoinDenseVector (and on constants) does not work out a
+    result straight away.  Instead it builds a small expression object which
+    knows the size and can give any entry.  The work is done when the
+    expression is assigned to (or used to construct) a CoinDenseVector, in
+    one pass over the entries with no temporary vectors.  So
+    @verbatim
+    x = scale * (b - r) + x;
+    @endverbatim
+    is a single loop.  Expressions keep references to the vectors they use
+    so should not be kept beyond the statement that creates them (for
+    example in an <code>auto</code> variable).
+
+    E is the actual expression class, which has value_type, size() and
+    operator[] (giving a value).
+*/
+template < class E >
+class CoinDenseExpression {
+public:
+  /// The actual expression
+  inline const E &expression() const
+  {
+    return *static_cast< const E * >(this);
+  }
+};
+
+/** How an expression holds its operands - vectors by reference, other
+    (small) expressions by value. */
+template < class E >
+struct CoinDenseOperand {
+  typedef const E type;
+};
+template < typename T >
+struct CoinDenseOperand< CoinDenseVector< T > > {
+  typedef const CoinDenseVector< T > &type;
+};
+
+/// Constant as an expression (so it can be added to vectors etc)
+template < typename T >
+class CoinDenseConstant : public CoinDenseExpression< CoinDenseConstant< T > > {
+public:
+  typedef T value_type;
+  inline CoinDenseConstant(T value, int size)
+    : value_(value)
+    , size_(size)
+  {
+  }
+  inline int size() const { return size_; }
+  inline T operator[](size_t) const { return value_; }
+
+private:
+  T value_;
+  int size_;
+};
+
+/// Entry by entry operation of two expressions of same size
+template < class E1, class E2, class Operation >
+class CoinDenseBinaryExpression
+  : public CoinDenseExpression< CoinDenseBinaryExpression< E1, E2, Operation > > {
+public:
+  typedef typename E1::value_type value_type;
+  inline CoinDenseBinaryExpression(const E1 &left, const E2 &right)
+    : left_(left)
+    , right_(right)
+  {
+    assert(left.size() == right.size());
+  }
+  inline int size() const { return left_.size(); }
+  inline value_type operator[](size_t index) const
+  {
+    return Operation::apply(left_[index], right_[index]);
+  }
+
+private:
+  typename CoinDenseOperand< E1 >::type left_;
+  typename CoinDenseOperand< E2 >::type right_;
+};
+
+/**@name Operations used in dense expressions */
+//@{
+struct CoinDenseAdd {
+  template < typename T >
+  static inline T apply(T a, T b) { return a + b; }
+};
+struct CoinDenseSubtract {
+  template < typename T >
+  static inline T apply(T a, T b) { return a - b; }
+};
+struct CoinDenseMultiply {
+  template < typename T >
+  static inline T apply(T a, T b) { return a * b; }
+};
+struct CoinDenseDivide {
+  template < typename T >
+  static inline T apply(T a, T b) { return a / b; }
+};
+//@}
+
+//#############################################################################
 //#############################################################################
 /** Dense Vector
 
@@ -66,7 +170,11 @@ Here is a sample usage:
 @endverbatim
 */
 template < typename T >
-class CoinDenseVector {
+class CoinDenseVector : public CoinDenseExpression< CoinDenseVector< T > > {
+public:
+  /// Type of elements (for expressions)
+  typedef T value_type;
+
 private:
   /**@name Private member data */
   //@{
@@ -95,10 +203,26 @@ public:
   void clear();
   /** Assignment operator */
   CoinDenseVector &operator=(const CoinDenseVector &);
+  /** Assignment from expression - evaluated in one pass.  The vector
+      may appear in the expression. */
+  template < class E >
+  inline CoinDenseVector &operator=(const CoinDenseExpression< E > &expression)
+  {
+    assign(expression.expression());
+    return *this;
+  }
   /** Member of array operator */
-  T &operator[](size_t index);
+  inline T &operator[](size_t index)
+  {
+    assert(index < elements_.size());
+    return elements_[index];
+  }
   /** Member of array operator */
-  const T &operator[](size_t index) const;
+  inline const T &operator[](size_t index) const
+  {
+    assert(index < elements_.size());
+    return elements_[index];
+  }
 
   /** Set vector size, and elements.
        Size is the length of the elements vector.
@@ -122,46 +246,23 @@ public:
   void append(const CoinDenseVector &);
   //@}
 
-  /**@name norms, sum and scale */
+  /**@name norms, sum and scale
+
+     For doubles these use vector instructions (see CoinSimdLevel) so
+     oneNorm, twoNorm and sum may differ in the last bits from adding in
+     order.
+  */
   //@{
   /// 1-norm of vector
-  inline T oneNorm() const
-  {
-    T norm = 0;
-    for (size_t i = 0; i < elements_.size(); i++)
-      norm += std::abs(elements_[i]);
-    return norm;
-  }
+  T oneNorm() const;
   /// 2-norm of vector
-  inline double twoNorm() const
-  {
-    double norm = 0.;
-    for (size_t i = 0; i < elements_.size(); i++)
-      norm += elements_[i] * elements_[i];
-    // std namespace removed because it was causing a compile
-    // problem with Microsoft Visual C++
-    return /*std::*/ sqrt(norm);
-  }
+  double twoNorm() const;
   /// infinity-norm of vector
-  inline T infNorm() const
-  {
-    T norm = 0;
-    for (size_t i = 0; i < elements_.size(); i++)
-      norm = std::max(norm, std::abs(elements_[i]));
-    return norm;
-  }
-  /// sum of vector elements
-  inline T sum() const
-  {
-    return std::accumulate(elements_.begin(), elements_.end(), 0);
-  }
+  T infNorm() const;
+  /// sum of vector elements (added up in double)
+  T sum() const;
   /// scale vector elements
-  inline void scale(T factor)
-  {
-    for (size_t i = 0; i < elements_.size(); i++)
-      elements_[i] *= factor;
-    return;
-  }
+  void scale(T factor);
   //@}
 
   /**@name Arithmetic operators. */
@@ -174,6 +275,18 @@ public:
   void operator*=(T value);
   /// divide every entry by <code>value</code>
   void operator/=(T value);
+  /// add expression entry by entry (in one pass)
+  template < class E >
+  inline void operator+=(const CoinDenseExpression< E > &expression)
+  {
+    assign(CoinDenseBinaryExpression< CoinDenseVector< T >, E, CoinDenseAdd >(*this, expression.expression()));
+  }
+  /// subtract expression entry by entry (in one pass)
+  template < class E >
+  inline void operator-=(const CoinDenseExpression< E > &expression)
+  {
+    assign(CoinDenseBinaryExpression< CoinDenseVector< T >, E, CoinDenseSubtract >(*this, expression.expression()));
+  }
   //@}
 
   /**@name Constructors and destructors */
@@ -186,6 +299,13 @@ public:
   CoinDenseVector(size_t size, T element = T());
   /** Copy constructors */
   CoinDenseVector(const CoinDenseVector &);
+  /** Constructor from expression - evaluated in one pass */
+  template < class E >
+  inline CoinDenseVector(const CoinDenseExpression< E > &expression)
+    : elements_()
+  {
+    assign(expression.expression());
+  }
 
   /** Destructor */
   ~CoinDenseVector();
@@ -198,6 +318,18 @@ private:
   void gutsOfSetVector(size_t size, const T *elems);
   /// Set all elements to a given value
   void gutsOfSetConstant(size_t size, T value);
+  /// Evaluate expression into elements
+  template < class E >
+  inline void assign(const E &expression)
+  {
+    size_t size = expression.size();
+    // entry i of expression only uses entries i so may use this
+    if (size != elements_.size())
+      elements_.resize(size);
+    T *elements = elements_.data();
+    for (size_t i = 0; i < size; i++)
+      elements[i] = expression[i];
+  }
   //@}
 };
 
@@ -205,191 +337,125 @@ private:
 
 /**@name Arithmetic operators on dense vectors.
 
-   <strong>NOTE</strong>: Because these methods return an object (they can't
-   return a reference, though they could return a pointer...) they are
-   <em>very</em> inefficient...
+   These give expressions (see CoinDenseExpression) which are evaluated
+   without temporaries when assigned to a CoinDenseVector.
  */
 //@{
 /// Return the sum of two dense vectors
-template < typename T >
-inline CoinDenseVector< T > operator+(const CoinDenseVector< T > &op1,
-  const CoinDenseVector< T > &op2)
+template < class E1, class E2 >
+inline CoinDenseBinaryExpression< E1, E2, CoinDenseAdd >
+operator+(const CoinDenseExpression< E1 > &op1, const CoinDenseExpression< E2 > &op2)
 {
-  assert(op1.size() == op2.size());
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  const T *elements2 = op2.getElements();
-  T *elements3 = op3.getElements();
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] + elements2[i];
-  return op3;
+  return CoinDenseBinaryExpression< E1, E2, CoinDenseAdd >(op1.expression(), op2.expression());
 }
 
 /// Return the difference of two dense vectors
-template < typename T >
-inline CoinDenseVector< T > operator-(const CoinDenseVector< T > &op1,
-  const CoinDenseVector< T > &op2)
+template < class E1, class E2 >
+inline CoinDenseBinaryExpression< E1, E2, CoinDenseSubtract >
+operator-(const CoinDenseExpression< E1 > &op1, const CoinDenseExpression< E2 > &op2)
 {
-  assert(op1.size() == op2.size());
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  const T *elements2 = op2.getElements();
-  T *elements3 = op3.getElements();
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] - elements2[i];
-  return op3;
+  return CoinDenseBinaryExpression< E1, E2, CoinDenseSubtract >(op1.expression(), op2.expression());
 }
 
 /// Return the element-wise product of two dense vectors
-template < typename T >
-inline CoinDenseVector< T > operator*(const CoinDenseVector< T > &op1,
-  const CoinDenseVector< T > &op2)
+template < class E1, class E2 >
+inline CoinDenseBinaryExpression< E1, E2, CoinDenseMultiply >
+operator*(const CoinDenseExpression< E1 > &op1, const CoinDenseExpression< E2 > &op2)
 {
-  assert(op1.size() == op2.size());
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  const T *elements2 = op2.getElements();
-  T *elements3 = op3.getElements();
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] * elements2[i];
-  return op3;
+  return CoinDenseBinaryExpression< E1, E2, CoinDenseMultiply >(op1.expression(), op2.expression());
 }
 
 /// Return the element-wise ratio of two dense vectors
-template < typename T >
-inline CoinDenseVector< T > operator/(const CoinDenseVector< T > &op1,
-  const CoinDenseVector< T > &op2)
+template < class E1, class E2 >
+inline CoinDenseBinaryExpression< E1, E2, CoinDenseDivide >
+operator/(const CoinDenseExpression< E1 > &op1, const CoinDenseExpression< E2 > &op2)
 {
-  assert(op1.size() == op2.size());
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  const T *elements2 = op2.getElements();
-  T *elements3 = op3.getElements();
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] / elements2[i];
-  return op3;
+  return CoinDenseBinaryExpression< E1, E2, CoinDenseDivide >(op1.expression(), op2.expression());
 }
 //@}
 
 /**@name Arithmetic operators on dense vector and a constant. 
-   These functions create a dense vector as a result. That dense vector will
-   have the same indices as <code>op1</code> and the specified operation is
-   done entry-wise with the given value. */
+   These give expressions of the same size as the dense vector (or
+   expression) with the operation done entry-wise with the given value. */
 //@{
 /// Return the sum of a dense vector and a constant
-template < typename T >
-inline CoinDenseVector< T > operator+(const CoinDenseVector< T > &op1, T value)
+template < class E >
+inline CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseAdd >
+operator+(const CoinDenseExpression< E > &op1, typename E::value_type value)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] + dvalue;
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseAdd >(expression,
+    CoinDenseConstant< typename E::value_type >(value, expression.size()));
 }
 
 /// Return the difference of a dense vector and a constant
-template < typename T >
-inline CoinDenseVector< T > operator-(const CoinDenseVector< T > &op1, T value)
+template < class E >
+inline CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseSubtract >
+operator-(const CoinDenseExpression< E > &op1, typename E::value_type value)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] - dvalue;
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseSubtract >(expression,
+    CoinDenseConstant< typename E::value_type >(value, expression.size()));
 }
 
 /// Return the element-wise product of a dense vector and a constant
-template < typename T >
-inline CoinDenseVector< T > operator*(const CoinDenseVector< T > &op1, T value)
+template < class E >
+inline CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseMultiply >
+operator*(const CoinDenseExpression< E > &op1, typename E::value_type value)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] * dvalue;
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseMultiply >(expression,
+    CoinDenseConstant< typename E::value_type >(value, expression.size()));
 }
 
 /// Return the element-wise ratio of a dense vector and a constant
-template < typename T >
-inline CoinDenseVector< T > operator/(const CoinDenseVector< T > &op1, T value)
+template < class E >
+inline CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseDivide >
+operator/(const CoinDenseExpression< E > &op1, typename E::value_type value)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] / dvalue;
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< E, CoinDenseConstant< typename E::value_type >, CoinDenseDivide >(expression,
+    CoinDenseConstant< typename E::value_type >(value, expression.size()));
 }
 
 /// Return the sum of a constant and a dense vector
-template < typename T >
-inline CoinDenseVector< T > operator+(T value, const CoinDenseVector< T > &op1)
+template < class E >
+inline CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseAdd >
+operator+(typename E::value_type value, const CoinDenseExpression< E > &op1)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] + dvalue;
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseAdd >(
+    CoinDenseConstant< typename E::value_type >(value, expression.size()), expression);
 }
 
 /// Return the difference of a constant and a dense vector
-template < typename T >
-inline CoinDenseVector< T > operator-(T value, const CoinDenseVector< T > &op1)
+template < class E >
+inline CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseSubtract >
+operator-(typename E::value_type value, const CoinDenseExpression< E > &op1)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = dvalue - elements1[i];
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseSubtract >(
+    CoinDenseConstant< typename E::value_type >(value, expression.size()), expression);
 }
 
 /// Return the element-wise product of a constant and a dense vector
-template < typename T >
-inline CoinDenseVector< T > operator*(T value, const CoinDenseVector< T > &op1)
+template < class E >
+inline CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseMultiply >
+operator*(typename E::value_type value, const CoinDenseExpression< E > &op1)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = elements1[i] * dvalue;
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseMultiply >(
+    CoinDenseConstant< typename E::value_type >(value, expression.size()), expression);
 }
 
 /// Return the element-wise ratio of a a constant and dense vector
-template < typename T >
-inline CoinDenseVector< T > operator/(T value, const CoinDenseVector< T > &op1)
+template < class E >
+inline CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseDivide >
+operator/(typename E::value_type value, const CoinDenseExpression< E > &op1)
 {
-  int size = op1.size();
-  CoinDenseVector< T > op3(size);
-  const T *elements1 = op1.getElements();
-  T *elements3 = op3.getElements();
-  double dvalue = value;
-  for (int i = 0; i < size; i++)
-    elements3[i] = dvalue / elements1[i];
-  return op3;
+  const E &expression = op1.expression();
+  return CoinDenseBinaryExpression< CoinDenseConstant< typename E::value_type >, E, CoinDenseDivide >(
+    CoinDenseConstant< typename E::value_type >(value, expression.size()), expression);
 }
 //@}
 
@@ -20,8 +20,10 @@
 #include <cmath>
 #include "CoinTypes.h"
 #include "CoinIndexedVector.hpp"
+#include "CoinFactorizationStatistics.hpp"
 
 class CoinPackedMatrix;
+class CoinThreadPool;
 /** This deals with Factorization and Updates
 
     This class started with a parallel simplex code I was writing in the
@@ -71,6 +73,30 @@ public:
   */
   int restoreFactorization(const char *file, bool factor = false);
 #endif
+  /** Length in bytes of snapshot of factorization (see writeSnapshot).
+      The snapshot has all of L, U, R etas and any dense part so
+      solves and updates can carry on after restoring with no
+      factorization.
+  */
+  size_t snapshotLength() const;
+  /** Writes snapshot to buffer of snapshotLength bytes (8 byte aligned).
+      There is a header with version, sizes of types and a checksum,
+      then scalars and a directory of where each array is, each array
+      starting on an 8 byte boundary - so a snapshot in shared memory or
+      a mapped file can be used directly by readSnapshot.
+  */
+  void writeSnapshot(char *buffer) const;
+  /** Restores from snapshot written by writeSnapshot (buffer 8 byte aligned).
+      Returns 0 if okay, 1 if not a snapshot or different version,
+      2 if written by build with different types and 3 if checksum
+      wrong or truncated.  If not okay factorization is left empty.
+      Number of threads is not restored - it is a setting of this process.
+  */
+  int readSnapshot(const char *buffer, size_t length);
+  /// Saves snapshot on file - 0 if no error
+  int saveSnapshot(const char *file) const;
+  /// Restores snapshot from file - as readSnapshot or 4 if no file
+  int restoreSnapshot(const char *file);
   /// Debug - sort so can compare
   void sort() const;
   /// = copy
@@ -126,6 +152,22 @@ public:
       and ones thrown out have -1
       returns 0 -okay, -1 singular, -99 memory */
   int factorizePart2(int permutation[], int exactNumberElements);
+  /** As part two but basis differs from last successful factorization
+      only in numberReplaced columns (positions in replaced).  Other columns
+      must be in the same positions.  Sparse pivots of last factorization
+      not on replaced columns are repeated without any search until one
+      has gone or fails pivot tolerance, so L and U up to the first
+      replaced column come out as before and only the trailing part
+      is chosen by Markowitz.
+      Falls back to normal factorization if there is nothing to repeat.
+      returns 0 -okay, -1 singular, -99 memory */
+  int factorizePart2(int permutation[], int exactNumberElements,
+    int numberReplaced, const int replaced[]);
+  /// Number of pivots repeated in last factorization (see factorizePart2)
+  inline int numberRepeatedPivots() const
+  {
+    return numberRepeated_;
+  }
   /// Condition number - product of pivots after factorization
   double conditionNumber() const;
 
@@ -304,11 +346,40 @@ public:
   {
     return denseThreshold_;
   }
-  /// Sets dense threshold
+  /** Sets dense threshold.  Default is 71 if CoinUtils was built with
+      LAPACK, otherwise 0 which means no dense part. */
   inline void setDenseThreshold(int value)
   {
     denseThreshold_ = value;
   }
+  /** Gets how dense part (see setDenseThreshold) is done
+      0 - put back into sparse L and U
+      1 - kept dense and factorized by built in blocked code (CoinDenseLU)
+      2 - kept dense and factorized by LAPACK
+  */
+  inline int denseCode() const
+  {
+    return denseCode_;
+  }
+  /** Sets how dense part is done (see denseCode).  2 is changed to 1 if
+      CoinUtils was built without LAPACK.  Default is 2 if available,
+      otherwise 1 - which only matters once setDenseThreshold has asked
+      for a dense part. */
+  void setDenseCode(int value);
+  /// Number of threads used in factorization
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /** Sets number of threads (including caller) used in factorization.
+      Values less than one mean number of processors.  Default is 1.
+      At present threads update the trailing columns of the dense part
+      (see setDenseThreshold) when that is done by built in code rather
+      than LAPACK (see denseCode), so this only helps if the
+      factorization goes dense.
+      Factors are identical to those found with one thread.
+  */
+  void setNumberThreads(int value);
   /// Pivot tolerance
   inline double pivotTolerance() const
   {
@@ -628,6 +699,21 @@ public:
     CoinIndexedVector *regionSparse2,
     CoinIndexedVector *regionSparse3,
     int type) const;
+  /** Updates numberVectors columns (FTRAN) at once.
+      Each regionSparse2[i] is as regionSparse2 in updateColumn (packed
+      or not) and is overwritten by its result.  If vectors are dense
+      enough to be done by column they are done in blocks, so L, R and U
+      are gone through once per block rather than once per vector.
+      Otherwise they are done one at a time.  regionSparse starts as
+      zero and is zero at end.
+  */
+  void updateColumns(CoinIndexedVector *regionSparse,
+    int numberVectors,
+    CoinIndexedVector **regionSparse2) const;
+  /** Updates numberVectors columns (BTRAN) at once - as updateColumns */
+  void updateColumnsTranspose(CoinIndexedVector *regionSparse,
+    int numberVectors,
+    CoinIndexedVector **regionSparse2) const;
   /** makes a row copy of L for speed and to allow very sparse problems */
   void goSparse();
   /**  get sparse threshold */
@@ -637,6 +723,90 @@ public:
   }
   /**  set sparse threshold */
   void sparseThreshold(int value);
+  /** Whether sparse solves cache reach information.
+
+      If on, the set of pivots reached from each starting pivot in L (and
+      its row copy) and in the R eta file is found by depth first search
+      the first time that pivot starts a sparse solve and kept until the
+      next factorization.  Worthwhile when many very sparse solves start
+      from the same rows.  As the cache is filled during solves, solves
+      must not then be done at the same time on one factorization.
+  */
+  void setReachCaching(bool yes);
+  /// Whether sparse solves cache reach information
+  inline bool reachCaching() const
+  {
+    return reachCaching_;
+  }
+  /// Number of sparse solve starts found in reach cache
+  inline double reachCacheHits() const
+  {
+    return reachCacheHits_;
+  }
+  /// Number of sparse solve starts which needed a search
+  inline double reachCacheMisses() const
+  {
+    return reachCacheMisses_;
+  }
+  /** Number of times a part of a solve used a method.
+      which - 0 FTRAN L, 1 FTRAN U, 2 BTRAN U, 3 BTRAN R, 4 BTRAN L.
+      method - 0 densish, 1 sparsish, 2 sparse (R has no sparsish).
+  */
+  inline double numberSolveMethod(int which, int method) const
+  {
+    return statistics_.numberMethod(which, method);
+  }
+  /// Counts and times of factorizations, solves and updates
+  inline const CoinFactorizationStatistics &statistics() const
+  {
+    return statistics_;
+  }
+  /// Counts and times - e.g. to reset or switch on timing of solves
+  inline CoinFactorizationStatistics &statistics()
+  {
+    return statistics_;
+  }
+  /** Mixed precision solves.
+
+      If numberRefinements is positive then from the next factorization
+      float copies of the L, U and R elements are kept and updateColumn
+      and updateColumnTranspose solve right hand sides which are not
+      sparse (see sparseThreshold) by column with those.  Each solution
+      then gets up to numberRefinements steps of iterative refinement
+      with the residual computed in double against a copy of the basis
+      (kept up to date by updateColumnFT, updateTwoColumnsFT and
+      replaceColumn).  Sparse right hand sides, updateColumnFT and all
+      other solves stay in double, as does any dense part.
+      Zero (the default) switches off.
+
+      This is for accuracy experiments rather than speed.  The double
+      factors are still kept, so memory goes up, and each refinement
+      step is a float solve plus a product with the basis.  The
+      *DenseFloat timings in CoinUtilsBenchmark are over twice those of
+      the double solves on the generated problems.
+  */
+  void setFloatFactors(int numberRefinements);
+  /// Number of refinement steps if using float copies (0 if not)
+  inline int floatFactors() const
+  {
+    return floatFactors_;
+  }
+  /** Residual of last refined solve - largest absolute value of
+      b - Bx (or c - B'y) relative to that of right hand side */
+  inline double lastResidual() const
+  {
+    return lastResidual_;
+  }
+  /// Largest residual of a refined solve since statistics reset
+  inline double largestResidual() const
+  {
+    return largestResidual_;
+  }
+  /// Number of refinement steps done since statistics reset
+  inline double numberRefinementSteps() const
+  {
+    return numberRefinementSteps_;
+  }
   //@}
   /// *** Below this user may not want to know about
 
@@ -737,6 +907,9 @@ protected:
   /** Does sparse phase of factorization (for larger problems)
       return code is <0 error, 0= finished */
   int factorSparseLarge();
+  /** Next pivot of last factorization to repeat (see factorizePart2).
+      Returns false (and stops repeating) if not acceptable now */
+  bool repeatPivot(int &pivotRow, int &pivotColumn, int &pivotRowPosition);
   /** Does dense phase of factorization
       return code is <0 error, 0= finished */
   int factorDense();
@@ -831,6 +1004,12 @@ protected:
   void cleanup();
   /// Sets up all array pointers
   void setupPointers();
+  /// Addresses of scalars kept in snapshot (last three done by caller)
+  void snapshotScalars(int **intValue, double **doubleValue) const;
+  /// Extent of row copy of U (for snapshot)
+  int snapshotRowExtent() const;
+  /// Addresses and lengths in bytes of arrays kept in snapshot
+  void snapshotSections(char **address, size_t *length, int rowExtent) const;
 
   /// Updates part of column (FTRANL)
   void updateColumnL(CoinIndexedVector *region, int *COIN_RESTRICT indexIn) const;
@@ -912,6 +1091,42 @@ protected:
   void updateColumnTransposeLSparsish(CoinIndexedVector *region) const;
   /// Updates part of column transpose (BTRANL) when sparse (by Row)
   void updateColumnTransposeLSparse(CoinIndexedVector *region) const;
+  /** Reach of pivot for sparse solves as length then pivots in reverse
+      of order to do.  type 0 is L, 1 row copy of L and 2 R etas.
+      Cached if there is room. */
+  const int *reachOf(int type, int pivot) const;
+  /// Forgets cached reaches
+  void clearReachCache();
+  /** Solves dense part for updateColumns - block has numberVectors
+      values for each row and room after for copy of dense part */
+  void updateDenseColumns(bool transpose, int numberVectors,
+    double *block) const;
+  /** Whether updateColumn and updateColumnTranspose use float copies
+      for right hand side with numberNonZero entries (not if sparse) */
+  inline bool usingFloatFactors(int numberNonZero) const
+  {
+    return floatFactors_ && basisValid_ && doForrestTomlin_
+      && !(sparseThreshold_ > 0 && numberNonZero < sparseThreshold_);
+  }
+  /// Makes float copies of L, R and U
+  void makeFloatFactors() const;
+  /** Solves with float copies - in and out are dense (rows and pivot
+      sequence as for updateColumn) and work has room for
+      numberRowsExtra_+numberDense_ */
+  void updateColumnFloat(bool transpose, const double *in, double *out,
+    double *work) const;
+  /// Solve using float copies then refinement against basis
+  int updateColumnRefined(bool transpose,
+    CoinIndexedVector *regionSparse2) const;
+  /// Copies columns of basis from U before factorizing
+  void saveBasis();
+  /// Puts saved basis columns in pivot sequence after factorizing
+  void sequenceBasis();
+  /** Keeps incoming column from updateColumnFT (packed or not) for
+      replaceColumn */
+  void saveIncomingColumn(const CoinIndexedVector *column);
+  /// Makes sure basis copy has room for another numberRows_ elements
+  void basisSpace();
 
 public:
   /** Replaces one Column to basis for PFI
@@ -1621,6 +1836,15 @@ protected:
   /// Dense threshold
   int denseThreshold_;
 
+  /// How dense part is done
+  int denseCode_;
+
+  /// Number of threads
+  int numberThreads_;
+
+  /// Threads for factorization (created when needed)
+  CoinThreadPool *threadPool_;
+
   /// First work area
   CoinFactorizationDoubleArrayWithLength workArea_;
 
@@ -1678,6 +1902,68 @@ protected:
 
   /// Sparse regions
   mutable CoinIntArrayWithLength sparse_;
+  /// Whether sparse solves cache reaches
+  bool reachCaching_;
+  /// Start of cached reach in reachList_ for L, row copy and R (-1 none)
+  mutable CoinIntArrayWithLength reachStart_;
+  /// Cached reaches
+  mutable CoinIntArrayWithLength reachList_;
+  /// Number used in reachList_
+  mutable int reachListSize_;
+  /// Work area for finding reaches
+  mutable CoinIntArrayWithLength reachWork_;
+  /// Number of times a cached reach was used
+  mutable double reachCacheHits_;
+  /// Number of times a reach had to be found
+  mutable double reachCacheMisses_;
+  /// Counts and times (including methods used in each part of solve)
+  mutable CoinFactorizationStatistics statistics_;
+  /// Work area for updateColumns (values for each row together)
+  mutable CoinDoubleArrayWithLength multipleRegion_;
+  /// Number of refinement steps if float copies used (0 off)
+  int floatFactors_;
+  /// Float copy of L and R elements (R after L as in elementL_)
+  mutable CoinFloatArrayWithLength elementLFloat_;
+  /// Float copy of U elements
+  mutable CoinFloatArrayWithLength elementUFloat_;
+  /// Whether float copies match double ones
+  mutable bool floatFactorsValid_;
+  /// Whether copy of basis is correct
+  bool basisValid_;
+  /// Start of each basis column (in pivot sequence) in basis copy
+  CoinIntArrayWithLength basisStart_;
+  /// Length of each basis column
+  CoinIntArrayWithLength basisLength_;
+  /// Row indices of basis copy
+  CoinIntArrayWithLength basisIndex_;
+  /// Elements of basis copy
+  CoinDoubleArrayWithLength basisElement_;
+  /// Number used in basis copy
+  int basisSize_;
+  /// Length of incoming column (at end of basis copy) or -1
+  int incomingLength_;
+  /// Work area for refined solves
+  mutable CoinDoubleArrayWithLength refineRegion_;
+  /// Residual of last refined solve
+  mutable double lastResidual_;
+  /// Largest residual of refined solves
+  mutable double largestResidual_;
+  /// Number of refinement steps
+  mutable double numberRefinementSteps_;
+  /// Row and column of each sparse pivot (for repeating)
+  CoinIntArrayWithLength pivotHistory_;
+  /// Number of sparse pivots in pivotHistory_
+  int numberHistory_;
+  /// Rows when pivotHistory_ was made
+  int historyRows_;
+  /// Columns when pivotHistory_ was made
+  int historyColumns_;
+  /// Next pivot in pivotHistory_ to repeat
+  int repeatNext_;
+  /// End of pivots to repeat (0 if not repeating)
+  int repeatEnd_;
+  /// Number of pivots repeated in last factorization
+  int numberRepeated_;
 #if ABOCA_LITE_FACTORIZATION
   /// Offset to second version of sparse
   int sparseOffset_;
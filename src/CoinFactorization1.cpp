@@ -16,6 +16,7 @@
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
 #include "CoinTime.hpp"
+#include "CoinThreadPool.hpp"
 #include <stdio.h>
 /*
   Somehow with some BLAS we get multithreaded by default
@@ -33,6 +34,39 @@ void openblas_set_num_threads(int num_threads);
 CoinFactorization::CoinFactorization()
 {
   persistenceFlag_ = 0;
+  numberThreads_ = 1;
+  threadPool_ = NULL;
+  reachCaching_ = false;
+  // keep track of sizes
+  reachStart_.switchOn();
+  reachList_.switchOn();
+  reachWork_.switchOn();
+  multipleRegion_.switchOn();
+  elementLFloat_.switchOn();
+  elementUFloat_.switchOn();
+  basisStart_.switchOn();
+  basisLength_.switchOn();
+  basisIndex_.switchOn();
+  basisElement_.switchOn();
+  refineRegion_.switchOn();
+  pivotHistory_.switchOn();
+  reachListSize_ = 0;
+  reachCacheHits_ = 0.0;
+  reachCacheMisses_ = 0.0;
+  floatFactors_ = 0;
+  floatFactorsValid_ = false;
+  basisValid_ = false;
+  basisSize_ = 0;
+  incomingLength_ = -1;
+  lastResidual_ = 0.0;
+  largestResidual_ = 0.0;
+  numberRefinementSteps_ = 0.0;
+  numberHistory_ = 0;
+  historyRows_ = 0;
+  historyColumns_ = 0;
+  repeatNext_ = 0;
+  repeatEnd_ = 0;
+  numberRepeated_ = 0;
   gutsOfInitialize(7);
 }
 
@@ -40,6 +74,39 @@ CoinFactorization::CoinFactorization()
 CoinFactorization::CoinFactorization(const CoinFactorization &other)
 {
   persistenceFlag_ = 0;
+  numberThreads_ = 1;
+  threadPool_ = NULL;
+  reachCaching_ = false;
+  // keep track of sizes
+  reachStart_.switchOn();
+  reachList_.switchOn();
+  reachWork_.switchOn();
+  multipleRegion_.switchOn();
+  elementLFloat_.switchOn();
+  elementUFloat_.switchOn();
+  basisStart_.switchOn();
+  basisLength_.switchOn();
+  basisIndex_.switchOn();
+  basisElement_.switchOn();
+  refineRegion_.switchOn();
+  pivotHistory_.switchOn();
+  reachListSize_ = 0;
+  reachCacheHits_ = 0.0;
+  reachCacheMisses_ = 0.0;
+  floatFactors_ = 0;
+  floatFactorsValid_ = false;
+  basisValid_ = false;
+  basisSize_ = 0;
+  incomingLength_ = -1;
+  lastResidual_ = 0.0;
+  largestResidual_ = 0.0;
+  numberRefinementSteps_ = 0.0;
+  numberHistory_ = 0;
+  historyRows_ = 0;
+  historyColumns_ = 0;
+  repeatNext_ = 0;
+  repeatEnd_ = 0;
+  numberRepeated_ = 0;
   gutsOfInitialize(3);
   persistenceFlag_ = other.persistenceFlag_;
   gutsOfCopy(other);
@@ -218,10 +285,12 @@ void CoinFactorization::gutsOfInitialize(int type)
     numberTrials_ = 4;
     relaxCheck_ = 1.0;
 #if COIN_FACTORIZATION_DENSE_CODE
-    denseThreshold_ = 31;
     denseThreshold_ = 71;
+    denseCode_ = 2;
 #else
+    // no dense part unless asked for by setDenseThreshold
     denseThreshold_ = 0;
+    denseCode_ = 1;
 #endif
     biasLU_ = 2;
     doForrestTomlin_ = true;
@@ -542,10 +611,63 @@ int CoinFactorization::factorizePart2(int permutation[], int exactNumberElements
   return status_;
 }
 
+/* As part two but only numberReplaced columns differ from last successful
+   factorization.  Repeats its sparse pivots (less those on replaced
+   columns) until one is no longer acceptable. */
+int CoinFactorization::factorizePart2(int permutation[], int exactNumberElements,
+  int numberReplaced, const int replaced[])
+{
+  numberRepeated_ = 0;
+  if (numberHistory_ && historyRows_ == numberRows_ && historyColumns_ == numberColumns_) {
+    char *mark = new char[numberColumns_];
+    CoinZeroN(mark, numberColumns_);
+    int i;
+    for (i = 0; i < numberReplaced; i++) {
+      int iColumn = replaced[i];
+      if (iColumn >= 0 && iColumn < numberColumns_)
+        mark[iColumn] = 1;
+    }
+    int *COIN_RESTRICT history = pivotHistory_.array();
+    for (i = 0; i < numberHistory_; i++) {
+      if (mark[history[2 * i + 1]])
+        history[2 * i] = -1; // leave out
+    }
+    delete[] mark;
+    repeatNext_ = 0;
+    repeatEnd_ = numberHistory_;
+  }
+  int returnCode = factorizePart2(permutation, exactNumberElements);
+  repeatNext_ = 0;
+  repeatEnd_ = 0;
+  return returnCode;
+}
+
 //  ~CoinFactorization.  Destructor
 CoinFactorization::~CoinFactorization()
 {
   gutsOfDestructor(2);
+  delete threadPool_;
+}
+// Sets how dense part is done
+void CoinFactorization::setDenseCode(int value)
+{
+  assert(value >= 0 && value <= 2);
+#ifndef COIN_FACTORIZATION_DENSE_CODE
+  if (value == 2)
+    value = 1;
+#endif
+  denseCode_ = value;
+}
+// Sets number of threads
+void CoinFactorization::setNumberThreads(int value)
+{
+  if (value < 1)
+    value = CoinThreadPool::numberProcessors();
+  if (value != numberThreads_) {
+    numberThreads_ = value;
+    delete threadPool_;
+    threadPool_ = NULL;
+  }
 }
 
 //  show_self.  Debug show object
@@ -1044,6 +1166,12 @@ int endLengthU2 = 0;
 //Does most of factorization
 int CoinFactorization::factor()
 {
+  clearReachCache();
+  floatFactorsValid_ = false;
+  if (floatFactors_)
+    saveBasis();
+  else
+    basisValid_ = false;
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   int nUse = numberUpdate + numberUpdateTranspose + numberUpdateFT + 2 * numberUpdateTwoFT + numberReplace;
   double dUse = timeInUpdate + timeInUpdateTranspose + timeInUpdateFT + timeInUpdateTwoFT + timeInReplace;
@@ -1091,6 +1219,14 @@ int CoinFactorization::factor()
 #endif
   int *COIN_RESTRICT lastColumn = lastColumnArray_;
   int *COIN_RESTRICT lastRow = lastRowArray_;
+  statistics_.startFactorization(totalElements_);
+  // sparse pivots are remembered so they can be repeated (see factorizePart2)
+  pivotHistory_.conditionalNew(2 * numberRows_);
+  numberHistory_ = 0;
+  historyRows_ = numberRows_;
+  historyColumns_ = numberColumns_;
+  if (!repeatEnd_)
+    numberRepeated_ = 0;
   //sparse
   status_ = factorSparse();
   switch (status_) {
@@ -1162,6 +1298,7 @@ int CoinFactorization::factor()
     break;
     // dense
   case 2:
+    statistics_.startDense(numberRows_ - numberGoodU_);
     status_ = factorDense();
     if (!status_)
       break;
@@ -1181,7 +1318,13 @@ int CoinFactorization::factor()
     }
     numberCompressions_ = 0;
     cleanup();
+    if (floatFactors_)
+      sequenceBasis();
+  } else {
+    basisValid_ = false;
+    numberHistory_ = 0;
   }
+  statistics_.endFactorization(status_, status_ ? 0 : factorElements_);
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   timeInFactorize = CoinCpuTime() - timeStart;
   printf("%d slacks, startU %d, endL %d, endU %d + %d dense (squared)\n",
@@ -13,6 +13,8 @@
 #include "CoinIndexedVector.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinFinite.hpp"
+#include "CoinThreadPool.hpp"
+#include "CoinDenseLU.hpp"
 #if COIN_FACTORIZATION_DENSE_CODE == 1
 // using simple lapack interface
 
@@ -60,6 +62,47 @@ int CoinFactorization::factorSparse()
     returnCode = factorSparseLarge();
   return returnCode;
 }
+/* Next pivot of last factorization to repeat.
+   Entries with negative row are replaced columns - skipped.
+   Gives up on rest if row already pivoted, element has gone or
+   it now fails pivot tolerance */
+bool CoinFactorization::repeatPivot(int &pivotRow, int &pivotColumn,
+  int &pivotRowPosition)
+{
+  const int *COIN_RESTRICT history = pivotHistory_.array();
+  while (repeatNext_ < repeatEnd_ && history[2 * repeatNext_] < 0)
+    repeatNext_++;
+  if (repeatNext_ < repeatEnd_) {
+    int iRow = history[2 * repeatNext_];
+    int iColumn = history[2 * repeatNext_ + 1];
+    const int *COIN_RESTRICT lastRow = lastRowArray_;
+    const int *COIN_RESTRICT numberInColumn = numberInColumnArray_;
+    if (iRow < numberRows_ && iColumn < numberColumns_ && lastRow[iRow] != -2 && numberInColumn[iColumn] > 0) {
+      const int *COIN_RESTRICT indexRowU = indexRowUArray_;
+      const CoinFactorizationDouble *COIN_RESTRICT elementU = elementUArray_;
+      int start = startColumnUArray_[iColumn];
+      int end = start + numberInColumn[iColumn];
+      // largest is first
+      double minimumValue = fabs(elementU[start]) * pivotTolerance_;
+      for (int i = start; i < end; i++) {
+        if (indexRowU[i] == iRow) {
+          if (fabs(elementU[i]) >= minimumValue && elementU[i]) {
+            pivotRow = iRow;
+            pivotColumn = iColumn;
+            pivotRowPosition = i;
+            repeatNext_++;
+            numberRepeated_++;
+            return true;
+          }
+          break;
+        }
+      }
+    }
+  }
+  // do rest by search
+  repeatEnd_ = repeatNext_;
+  return false;
+}
 //  factorSparse.  Does sparse phase of factorization
 //return code is <0 error, 0= finished
 int CoinFactorization::factorSparseSmall()
@@ -200,7 +243,10 @@ int CoinFactorization::factorSparseSmall()
     int trials = 0;
     int *COIN_RESTRICT pivotColumn = pivotColumnArray_;
 
-    if (count == 1 && firstCount[1] >= 0 && !biasLU_) {
+    if (repeatNext_ < repeatEnd_ && repeatPivot(iPivotRow, iPivotColumn, pivotRowPosition)) {
+      // same pivot as last time - no search
+      look = -1;
+    } else if (count == 1 && firstCount[1] >= 0 && !biasLU_) {
       //do column singletons first to put more in U
       while (look >= 0) {
         if (look < numberRows_) {
@@ -336,6 +382,7 @@ int CoinFactorization::factorSparseSmall()
       assert(iPivotRow < numberRows_);
       int numberDoRow = numberInRow[iPivotRow] - 1;
       int numberDoColumn = numberInColumn[iPivotColumn] - 1;
+      statistics_.pivot(numberDoRow, numberDoColumn);
 
       totalElements_ -= (numberDoRow + numberDoColumn + 1);
       if (numberDoColumn > 0) {
@@ -405,6 +452,11 @@ int CoinFactorization::factorSparseSmall()
       }
       assert(nextRow_.array()[iPivotRow] == numberGoodU_);
       pivotColumn[numberGoodU_] = iPivotColumn;
+      // remember for next time (never overtakes pivots being repeated)
+      int *COIN_RESTRICT history = pivotHistory_.array() + 2 * numberHistory_;
+      history[0] = iPivotRow;
+      history[1] = iPivotColumn;
+      numberHistory_++;
       numberGoodU_++;
       // This should not need to be trapped here - but be safe
       if (numberGoodU_ == numberRows_)
@@ -503,6 +555,39 @@ int CoinFactorization::factorSparseSmall()
   return status;
 }
 
+/*
+  Dense elimination step split over threads.  Each task updates a
+  contiguous range of trailing columns using the scaled pivot column
+  so the arithmetic is the same as with one thread.
+*/
+// Do not bother with threads for less work than this
+#define COIN_DENSE_PARALLEL_WORK 16384
+typedef struct {
+  const double *pivotColumn;
+  double *firstColumn;
+  int iDense;
+  int numberDense;
+  int numberColumns;
+  int numberBlocks;
+} CoinDenseUpdateInfo;
+
+static void denseUpdateBlock(void *info, int which)
+{
+  const CoinDenseUpdateInfo *update = reinterpret_cast< const CoinDenseUpdateInfo * >(info);
+  const double *COIN_RESTRICT element = update->pivotColumn;
+  int numberDense = update->numberDense;
+  int iDense = update->iDense;
+  int first = static_cast< int >((static_cast< CoinInt64 >(update->numberColumns) * which) / update->numberBlocks);
+  int last = static_cast< int >((static_cast< CoinInt64 >(update->numberColumns) * (which + 1)) / update->numberBlocks);
+  double *COIN_RESTRICT element2 = update->firstColumn + first * numberDense;
+  for (int jDense = first; jDense < last; jDense++) {
+    CoinFactorizationDouble value = element2[iDense];
+    for (int iRow = iDense + 1; iRow < numberDense; iRow++)
+      element2[iRow] -= value * element[iRow];
+    element2 += numberDense;
+  }
+}
+
 //:method factorDense.  Does dense phase of factorization
 //return code is <0 error, 0= finished
 int CoinFactorization::factorDense()
@@ -597,11 +682,24 @@ int CoinFactorization::factorDense()
       numberGoodU_++;
     }
   }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
-  if (denseThreshold_ /*>0*/) {
+  CoinThreadPool *threadPool = NULL;
+  if (numberThreads_ > 1 && numberDense_ > 1) {
+    if (!threadPool_)
+      threadPool_ = new CoinThreadPool(numberThreads_);
+    threadPool = threadPool_;
+  }
+  if (denseThreshold_ /*>0*/ && denseCode_) {
     assert(numberGoodU_ == numberRows_);
     numberGoodL_ = numberRows_;
     //now factorize
+    if (denseCode_ == 1) {
+      // built in - same layout and pivots as LAPACK
+      if (CoinDenseLUFactor(numberDense_, denseAreaAddress_, numberDense_,
+            densePermute_, threadPool))
+        status = -1;
+      return status;
+    }
+#ifdef COIN_FACTORIZATION_DENSE_CODE
     //dgef(denseAreaAddress_,&numberDense_,&numberDense_,densePermute_);
 #if COIN_FACTORIZATION_DENSE_CODE == 1
     int info;
@@ -618,16 +716,18 @@ int CoinFactorization::factorDense()
 #elif COIN_FACTORIZATION_DENSE_CODE == 3
     status = LAPACKE_dgetrf(LAPACK_COL_MAJOR, numberDense_, numberDense_,
       denseAreaAddress_, numberDense_, densePermute_);
+#endif
 #endif
     return status;
   }
-#endif
   //abort();
   numberGoodU_ = numberRows_ - numberDense_;
   int base = numberGoodU_;
   int iDense;
-  int numberToDo = -denseThreshold_;
-  denseThreshold_ = 0;
+  // all columns left are done here (negative threshold just said how many)
+  int numberToDo = numberDense_;
+  if (denseThreshold_ < 0)
+    denseThreshold_ = 0;
   double tolerance = zeroTolerance_;
   tolerance = 1.0e-30;
   int *COIN_RESTRICT nextColumn = nextColumnArray_;
@@ -723,19 +823,32 @@ int CoinFactorization::factorDense()
       numberInColumnPlus[iColumn] += start - startColumnU[iColumn];
       startColumnU[iColumn] = start;
       // update other columns
-      double *COIN_RESTRICT element2 = element + numberDense_;
-      for (jDense = iDense + 1; jDense < numberToDo; jDense++) {
-        CoinFactorizationDouble value = element2[iDense];
-        for (iRow = iDense + 1; iRow < numberDense_; iRow++) {
-          //double oldValue=element2[iRow];
-          element2[iRow] -= value * element[iRow];
-          //if (oldValue&&!element2[iRow]) {
-          //printf("Updated element for column %d, row %d old %g",
-          //   pivotColumnConst[base+jDense],densePermute_[iRow],oldValue);
-          //printf(" new %g\n",element2[iRow]);
-          //}
+      int numberColumnsLeft = numberToDo - iDense - 1;
+      if (threadPool && numberColumnsLeft > 1
+        && numberColumnsLeft * (numberDense_ - iDense - 1) > COIN_DENSE_PARALLEL_WORK) {
+        CoinDenseUpdateInfo info;
+        info.pivotColumn = element;
+        info.firstColumn = element + numberDense_;
+        info.iDense = iDense;
+        info.numberDense = numberDense_;
+        info.numberColumns = numberColumnsLeft;
+        info.numberBlocks = CoinMin(threadPool->numberThreads(), numberColumnsLeft);
+        threadPool->run(info.numberBlocks, denseUpdateBlock, &info);
+      } else {
+        double *COIN_RESTRICT element2 = element + numberDense_;
+        for (jDense = iDense + 1; jDense < numberToDo; jDense++) {
+          CoinFactorizationDouble value = element2[iDense];
+          for (iRow = iDense + 1; iRow < numberDense_; iRow++) {
+            //double oldValue=element2[iRow];
+            element2[iRow] -= value * element[iRow];
+            //if (oldValue&&!element2[iRow]) {
+            //printf("Updated element for column %d, row %d old %g",
+            //   pivotColumnConst[base+jDense],densePermute_[iRow],oldValue);
+            //printf(" new %g\n",element2[iRow]);
+            //}
+          }
+          element2 += numberDense_;
         }
-        element2 += numberDense_;
       }
       numberGoodU_++;
     } else {
@@ -1186,7 +1299,10 @@ int CoinFactorization::factorSparseLarge()
     int trials = 0;
     int *COIN_RESTRICT pivotColumn = pivotColumnArray_;
 
-    if (count == 1 && firstCount[1] >= 0 && !biasLU_) {
+    if (repeatNext_ < repeatEnd_ && repeatPivot(iPivotRow, iPivotColumn, pivotRowPosition)) {
+      // same pivot as last time - no search
+      look = -1;
+    } else if (count == 1 && firstCount[1] >= 0 && !biasLU_) {
       //do column singletons first to put more in U
       while (look >= 0) {
         if (look < numberRows_) {
@@ -1322,6 +1438,7 @@ int CoinFactorization::factorSparseLarge()
       if (iPivotRow >= 0) {
         int numberDoRow = numberInRow[iPivotRow] - 1;
         int numberDoColumn = numberInColumn[iPivotColumn] - 1;
+        statistics_.pivot(numberDoRow, numberDoColumn);
 
         totalElements_ -= (numberDoRow + numberDoColumn + 1);
         if (numberDoColumn > 0) {
@@ -1392,6 +1509,11 @@ int CoinFactorization::factorSparseLarge()
         }
         assert(nextRow_.array()[iPivotRow] == numberGoodU_);
         pivotColumn[numberGoodU_] = iPivotColumn;
+        // remember for next time (never overtakes pivots being repeated)
+        int *COIN_RESTRICT history = pivotHistory_.array() + 2 * numberHistory_;
+        history[0] = iPivotRow;
+        history[1] = iPivotColumn;
+        numberHistory_++;
         numberGoodU_++;
         // This should not need to be trapped here - but be safe
         if (numberGoodU_ == numberRows_)
@@ -16,6 +16,7 @@
 #include "CoinIndexedVector.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinTime.hpp"
+#include "CoinDenseLU.hpp"
 #include <stdio.h>
 #include <iostream>
 #if COIN_FACTORIZATION_DENSE_CODE == 1
@@ -94,6 +95,8 @@ int CoinFactorization::updateColumn(CoinIndexedVector *regionSparse,
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX = CoinCpuTime();
 #endif
+  if (!noPermute && usingFloatFactors(regionSparse2->getNumElements()))
+    return updateColumnRefined(false, regionSparse2);
   //permute and move indices into index array
   int *COIN_RESTRICT regionIndex = regionSparse->getIndices();
   int numberNonZero;
@@ -232,10 +235,614 @@ void CoinFactorization::permuteBack(CoinIndexedVector *regionSparse,
   outVector->setNumElements(number);
   regionSparse->setNumElements(0);
 }
+// Vectors done together by updateColumns
+#define COIN_MULTIPLE_VECTORS 8
+/* Updates several columns (FTRAN) from regionSparse2[i].
+   Done one at a time if sparse, otherwise in blocks of
+   COIN_MULTIPLE_VECTORS with values for each row together so each
+   column of L, R and U is loaded once per block */
+void CoinFactorization::updateColumns(CoinIndexedVector *regionSparse,
+  int numberVectors,
+  CoinIndexedVector **regionSparse2) const
+{
+  if (!numberVectors)
+    return;
+  // Guess at number at end
+  double average = 0.0;
+  for (int iVector = 0; iVector < numberVectors; iVector++)
+    average += regionSparse2[iVector]->getNumElements();
+  average /= numberVectors;
+  double newNumber = average * std::max(ftranAverageAfterL_, 1.0)
+    * std::max(ftranAverageAfterR_, 1.0) * std::max(ftranAverageAfterU_, 1.0);
+  if (numberVectors == 1 || !doForrestTomlin_ || (sparseThreshold_ > 0 && newNumber < sparseThreshold_)) {
+    for (int iVector = 0; iVector < numberVectors; iVector++)
+      updateColumn(regionSparse, regionSparse2[iVector]);
+    return;
+  }
+  double tolerance = zeroTolerance_;
+  double *COIN_RESTRICT block = multipleRegion_.conditionalNew(COIN_MULTIPLE_VECTORS * (numberRowsExtra_ + numberDense_));
+  const int *permute = permuteArray_;
+  const int *permuteBack = pivotColumnBack();
+  for (int iFirst = 0; iFirst < numberVectors; iFirst += COIN_MULTIPLE_VECTORS) {
+    // short last block is padded with zero vectors
+    const int k = COIN_MULTIPLE_VECTORS;
+    int numberInBlock = std::min(numberVectors - iFirst, k);
+    CoinIndexedVector **vectors = regionSparse2 + iFirst;
+    CoinZeroN(block, k * numberRowsExtra_);
+    //permute and move into block
+    int smallestIndex = numberRowsExtra_;
+    for (int v = 0; v < numberInBlock; v++) {
+      int numberNonZero = vectors[v]->getNumElements();
+      const int *COIN_RESTRICT index = vectors[v]->getIndices();
+      double *COIN_RESTRICT array = vectors[v]->denseVector();
+      bool packed = vectors[v]->packedMode();
+      for (int j = 0; j < numberNonZero; j++) {
+        int iRow = index[j];
+        double value;
+        if (packed) {
+          value = array[j];
+          array[j] = 0.0;
+        } else {
+          value = array[iRow];
+          array[iRow] = 0.0;
+        }
+        iRow = permute[iRow];
+        block[iRow * k + v] = value;
+        smallestIndex = std::min(smallestIndex, iRow);
+      }
+    }
+    //  ******* L
+    CoinFactorizationDouble pivotValue[COIN_MULTIPLE_VECTORS];
+    {
+      const int *COIN_RESTRICT startColumn = startColumnLArray_;
+      const int *COIN_RESTRICT indexRow = indexRowLArray_;
+      const CoinFactorizationDouble *COIN_RESTRICT element = elementLArray_;
+      int last = numberRows_ - numberDense_;
+      for (int i = std::max(smallestIndex, baseL_); i < last; i++) {
+        double *COIN_RESTRICT thisPivot = block + i * k;
+        bool nonZero = false;
+        for (int v = 0; v < k; v++) {
+          pivotValue[v] = thisPivot[v];
+          if (fabs(pivotValue[v]) > tolerance)
+            nonZero = true;
+          else
+            thisPivot[v] = pivotValue[v] = 0.0;
+        }
+        if (nonZero) {
+          for (int j = startColumn[i]; j < startColumn[i + 1]; j++) {
+            double *COIN_RESTRICT put = block + indexRow[j] * k;
+            CoinFactorizationDouble value = element[j];
+            for (int v = 0; v < k; v++)
+              put[v] -= value * pivotValue[v];
+          }
+        }
+      }
+      if (numberDense_)
+        updateDenseColumns(false, k, block);
+    }
+    //  ******* R
+    if (numberR_) {
+      const int *COIN_RESTRICT startColumn = startColumnRArray_ - numberRows_;
+      const int *COIN_RESTRICT indexRow = indexRowR_;
+      const CoinFactorizationDouble *COIN_RESTRICT element = elementR_;
+      for (int i = numberRows_; i < numberRowsExtra_; i++) {
+        //move using permute_ (stored in inverse fashion)
+        double *COIN_RESTRICT get = block + permute[i] * k;
+        for (int v = 0; v < k; v++) {
+          pivotValue[v] = get[v];
+          get[v] = 0.0;
+        }
+        for (int j = startColumn[i]; j < startColumn[i + 1]; j++) {
+          const double *COIN_RESTRICT other = block + indexRow[j] * k;
+          CoinFactorizationDouble value = element[j];
+          for (int v = 0; v < k; v++)
+            pivotValue[v] -= value * other[v];
+        }
+        double *COIN_RESTRICT put = block + i * k;
+        for (int v = 0; v < k; v++)
+          put[v] = (fabs(pivotValue[v]) > tolerance) ? pivotValue[v] : 0.0;
+      }
+    }
+    //  ******* U
+    {
+      const int *COIN_RESTRICT startColumn = startColumnUArray_;
+      const int *COIN_RESTRICT indexRow = indexRowUArray_;
+      const CoinFactorizationDouble *COIN_RESTRICT element = elementUArray_;
+      const int *COIN_RESTRICT numberInColumn = numberInColumnArray_;
+      const CoinFactorizationDouble *COIN_RESTRICT pivotRegion = pivotRegionArray_;
+      for (int i = numberU_ - 1; i >= numberSlacks_; i--) {
+        double *COIN_RESTRICT thisPivot = block + i * k;
+        bool nonZero = false;
+        for (int v = 0; v < k; v++) {
+          pivotValue[v] = thisPivot[v];
+          if (fabs(pivotValue[v]) > tolerance)
+            nonZero = true;
+          else
+            pivotValue[v] = 0.0;
+        }
+        if (nonZero) {
+          int start = startColumn[i];
+          int end = start + numberInColumn[i];
+          for (int j = start; j < end; j++) {
+            double *COIN_RESTRICT put = block + indexRow[j] * k;
+            CoinFactorizationDouble value = element[j];
+            for (int v = 0; v < k; v++)
+              put[v] -= value * pivotValue[v];
+          }
+        }
+        CoinFactorizationDouble multiplier = pivotRegion[i];
+        for (int v = 0; v < k; v++)
+          thisPivot[v] = pivotValue[v] * multiplier;
+      }
+      // now do slacks
+#ifndef COIN_FAST_CODE
+      if (slackValue_ == -1.0) {
+#endif
+        for (int i = 0; i < numberSlacks_ * k; i++)
+          block[i] = -block[i];
+#ifndef COIN_FAST_CODE
+      }
+#endif
+    }
+    // permute back
+    int number[COIN_MULTIPLE_VECTORS];
+    for (int v = 0; v < numberInBlock; v++)
+      number[v] = 0;
+    for (int i = 0; i < numberRowsExtra_; i++) {
+      const double *COIN_RESTRICT thisRow = block + i * k;
+      for (int v = 0; v < numberInBlock; v++) {
+        double value = thisRow[v];
+        if (fabs(value) > tolerance) {
+          int iRow = permuteBack[i];
+          int *COIN_RESTRICT outIndex = vectors[v]->getIndices();
+          double *COIN_RESTRICT out = vectors[v]->denseVector();
+          if (vectors[v]->packedMode()) {
+            outIndex[number[v]] = iRow;
+            out[number[v]++] = value;
+          } else {
+            outIndex[number[v]++] = iRow;
+            out[iRow] = value;
+          }
+        }
+      }
+    }
+    for (int v = 0; v < numberInBlock; v++)
+      vectors[v]->setNumElements(number[v]);
+  }
+}
+/* Updates several columns (BTRAN) from regionSparse2[i] - as
+   updateColumns but U and L done by dot products */
+void CoinFactorization::updateColumnsTranspose(CoinIndexedVector *regionSparse,
+  int numberVectors,
+  CoinIndexedVector **regionSparse2) const
+{
+  if (!numberVectors)
+    return;
+  // Guess at number at end
+  double average = 0.0;
+  for (int iVector = 0; iVector < numberVectors; iVector++)
+    average += regionSparse2[iVector]->getNumElements();
+  average /= numberVectors;
+  double newNumber = average * std::max(btranAverageAfterU_, 1.0)
+    * std::max(btranAverageAfterR_, 1.0) * std::max(btranAverageAfterL_, 1.0);
+  if (numberVectors == 1 || !doForrestTomlin_ || (sparseThreshold_ > 0 && newNumber < sparseThreshold_)) {
+    for (int iVector = 0; iVector < numberVectors; iVector++)
+      updateColumnTranspose(regionSparse, regionSparse2[iVector]);
+    return;
+  }
+  double tolerance = zeroTolerance_;
+  double *COIN_RESTRICT block = multipleRegion_.conditionalNew(COIN_MULTIPLE_VECTORS * (numberRowsExtra_ + numberDense_));
+  const int *pivotColumn = pivotColumnArray_;
+  const int *permuteBack = pivotColumnBack();
+  const CoinFactorizationDouble *COIN_RESTRICT pivotRegion = pivotRegionArray_;
+  for (int iFirst = 0; iFirst < numberVectors; iFirst += COIN_MULTIPLE_VECTORS) {
+    // short last block is padded with zero vectors
+    const int k = COIN_MULTIPLE_VECTORS;
+    int numberInBlock = std::min(numberVectors - iFirst, k);
+    CoinIndexedVector **vectors = regionSparse2 + iFirst;
+    CoinZeroN(block, k * numberRowsExtra_);
+    //permute and move into block applying pivot region
+    int smallestIndex = numberRowsExtra_;
+    for (int v = 0; v < numberInBlock; v++) {
+      int numberNonZero = vectors[v]->getNumElements();
+      const int *COIN_RESTRICT index = vectors[v]->getIndices();
+      double *COIN_RESTRICT array = vectors[v]->denseVector();
+      bool packed = vectors[v]->packedMode();
+      for (int j = 0; j < numberNonZero; j++) {
+        int iRow = index[j];
+        double value;
+        if (packed) {
+          value = array[j];
+          array[j] = 0.0;
+        } else {
+          value = array[iRow];
+          array[iRow] = 0.0;
+        }
+        iRow = pivotColumn[iRow];
+        block[iRow * k + v] = value * pivotRegion[iRow];
+        smallestIndex = std::min(smallestIndex, iRow);
+      }
+    }
+    //  ******* U
+    CoinFactorizationDouble pivotValue[COIN_MULTIPLE_VECTORS];
+    {
+      const int *COIN_RESTRICT startColumn = startColumnUArray_;
+      const int *COIN_RESTRICT indexRow = indexRowUArray_;
+      const CoinFactorizationDouble *COIN_RESTRICT element = elementUArray_;
+      const int *COIN_RESTRICT numberInColumn = numberInColumnArray_;
+      for (int i = smallestIndex * k; i < numberSlacks_ * k; i++) {
+        if (fabs(block[i]) <= tolerance)
+          block[i] = 0.0;
+      }
+      for (int i = std::max(numberSlacks_, smallestIndex); i < numberU_; i++) {
+        double *COIN_RESTRICT thisPivot = block + i * k;
+        for (int v = 0; v < k; v++)
+          pivotValue[v] = thisPivot[v];
+        int start = startColumn[i];
+        int end = start + numberInColumn[i];
+        for (int j = start; j < end; j++) {
+          const double *COIN_RESTRICT other = block + indexRow[j] * k;
+          CoinFactorizationDouble value = element[j];
+          for (int v = 0; v < k; v++)
+            pivotValue[v] -= value * other[v];
+        }
+        for (int v = 0; v < k; v++)
+          thisPivot[v] = (fabs(pivotValue[v]) > tolerance) ? pivotValue[v] : 0.0;
+      }
+    }
+    //  ******* R
+    if (numberRowsExtra_ > numberRows_) {
+      const int *COIN_RESTRICT startColumn = startColumnRArray_ - numberRows_;
+      const int *COIN_RESTRICT indexRow = indexRowR_;
+      const CoinFactorizationDouble *COIN_RESTRICT element = elementR_;
+      const int *permute = permuteArray_;
+      for (int i = numberRowsExtra_ - 1; i >= numberRows_; i--) {
+        double *COIN_RESTRICT thisPivot = block + i * k;
+        bool nonZero = false;
+        for (int v = 0; v < k; v++) {
+          pivotValue[v] = thisPivot[v];
+          thisPivot[v] = 0.0;
+          if (pivotValue[v])
+            nonZero = true;
+        }
+        if (nonZero) {
+          for (int j = startColumn[i]; j < startColumn[i + 1]; j++) {
+            double *COIN_RESTRICT put = block + indexRow[j] * k;
+            CoinFactorizationDouble value = element[j];
+            for (int v = 0; v < k; v++)
+              put[v] -= value * pivotValue[v];
+          }
+          double *COIN_RESTRICT put = block + permute[i] * k;
+          for (int v = 0; v < k; v++) {
+            if (pivotValue[v])
+              put[v] = pivotValue[v];
+          }
+        }
+      }
+    }
+    //  ******* L
+    {
+      if (numberDense_)
+        updateDenseColumns(true, k, block);
+      const int *COIN_RESTRICT startColumn = startColumnLArray_;
+      const int *COIN_RESTRICT indexRow = indexRowLArray_;
+      const CoinFactorizationDouble *COIN_RESTRICT element = elementLArray_;
+      int last = baseL_ + numberL_;
+      for (int i = last - 1; i >= baseL_; i--) {
+        double *COIN_RESTRICT thisPivot = block + i * k;
+        for (int v = 0; v < k; v++)
+          pivotValue[v] = thisPivot[v];
+        for (int j = startColumn[i]; j < startColumn[i + 1]; j++) {
+          const double *COIN_RESTRICT other = block + indexRow[j] * k;
+          CoinFactorizationDouble value = element[j];
+          for (int v = 0; v < k; v++)
+            pivotValue[v] -= value * other[v];
+        }
+        for (int v = 0; v < k; v++)
+          thisPivot[v] = (fabs(pivotValue[v]) > tolerance) ? pivotValue[v] : 0.0;
+      }
+    }
+    // permute back
+    int number[COIN_MULTIPLE_VECTORS];
+    for (int v = 0; v < numberInBlock; v++)
+      number[v] = 0;
+    for (int i = 0; i < numberRows_; i++) {
+      const double *COIN_RESTRICT thisRow = block + i * k;
+      for (int v = 0; v < numberInBlock; v++) {
+        double value = thisRow[v];
+        if (fabs(value) > tolerance) {
+          int iRow = permuteBack[i];
+          int *COIN_RESTRICT outIndex = vectors[v]->getIndices();
+          double *COIN_RESTRICT out = vectors[v]->denseVector();
+          if (vectors[v]->packedMode()) {
+            outIndex[number[v]] = iRow;
+            out[number[v]++] = value;
+          } else {
+            outIndex[number[v]++] = iRow;
+            out[iRow] = value;
+          }
+        }
+      }
+    }
+    for (int v = 0; v < numberInBlock; v++)
+      vectors[v]->setNumElements(number[v]);
+  }
+}
+// Solves dense part for updateColumns
+void CoinFactorization::updateDenseColumns(bool transpose, int numberVectors,
+  double *block) const
+{
+  int k = numberVectors;
+  int lastSparse = numberRows_ - numberDense_;
+  // copy to be column major after block
+  double *COIN_RESTRICT dense = block + k * numberRowsExtra_;
+  const double *COIN_RESTRICT get = block + lastSparse * k;
+  for (int i = 0; i < numberDense_; i++) {
+    for (int v = 0; v < k; v++)
+      dense[v * numberDense_ + i] = get[i * k + v];
+  }
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+  if (denseCode_ == 2) {
+#if COIN_FACTORIZATION_DENSE_CODE == 1
+    char trans = transpose ? 'T' : 'N';
+    int info;
+    COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberDense_,&k,
+                     denseAreaAddress_,&numberDense_,densePermute_,
+                     dense,&numberDense_,&info,1);
+#elif COIN_FACTORIZATION_DENSE_CODE==2
+    clapack_dgetrs(CblasColMajor,transpose ? CblasTrans : CblasNoTrans,
+                   numberDense_,k,denseAreaAddress_,numberDense_,
+                   densePermute_,dense,numberDense_);
+#elif COIN_FACTORIZATION_DENSE_CODE==3
+    LAPACKE_dgetrs(LAPACK_COL_MAJOR,transpose ? 'T' : 'N',numberDense_,k,
+                   denseAreaAddress_,numberDense_,densePermute_,
+                   dense,numberDense_);
+#endif
+  } else
+#endif
+  {
+    // built in code (factors are same format as LAPACK)
+    for (int v = 0; v < k; v++)
+      CoinDenseLUSolve(transpose, numberDense_, denseAreaAddress_,
+        numberDense_, densePermute_, dense + v * numberDense_);
+  }
+  double *COIN_RESTRICT put = block + lastSparse * k;
+  for (int i = 0; i < numberDense_; i++) {
+    for (int v = 0; v < k; v++)
+      put[i * k + v] = dense[v * numberDense_ + i];
+  }
+}
+/* Solves with float copies of L, R and U.  in is dense by row (FTRAN)
+   or by pivot sequence (BTRAN) and out is dense the other way.  Done by
+   column without tolerances as result is going to be refined. */
+void CoinFactorization::updateColumnFloat(bool transpose, const double *in,
+  double *out, double *work) const
+{
+  const float *COIN_RESTRICT elementLFloat = elementLFloat_.array();
+  const float *COIN_RESTRICT elementUFloat = elementUFloat_.array();
+  const CoinFactorizationDouble *COIN_RESTRICT pivotRegion = pivotRegionArray_;
+  const int *COIN_RESTRICT permute = permuteArray_;
+  const int *COIN_RESTRICT permuteBack = pivotColumnBack();
+  CoinZeroN(work, numberRowsExtra_);
+  CoinZeroN(out, numberRows_);
+  if (!transpose) {
+    for (int i = 0; i < numberRows_; i++) {
+      if (in[i])
+        work[permute[i]] = in[i];
+    }
+    //  ******* L
+    {
+      const int *COIN_RESTRICT startColumn = startColumnLArray_;
+      const int *COIN_RESTRICT indexRow = indexRowLArray_;
+      int last = numberRows_ - numberDense_;
+      for (int i = baseL_; i < last; i++) {
+        CoinFactorizationDouble pivotValue = work[i];
+        if (pivotValue) {
+          for (int j = startColumn[i]; j < startColumn[i + 1]; j++)
+            work[indexRow[j]] -= elementLFloat[j] * pivotValue;
+        }
+      }
+      if (numberDense_)
+        updateDenseColumns(false, 1, work);
+    }
+    //  ******* R
+    {
+      const int *COIN_RESTRICT startColumn = startColumnRArray_ - numberRows_;
+      const int *COIN_RESTRICT indexRow = indexRowR_;
+      const float *COIN_RESTRICT elementR = elementLFloat + lengthL_;
+      for (int i = numberRows_; i < numberRowsExtra_; i++) {
+        //move using permute_ (stored in inverse fashion)
+        int iRow = permute[i];
+        CoinFactorizationDouble pivotValue = work[iRow];
+        work[iRow] = 0.0;
+        for (int j = startColumn[i]; j < startColumn[i + 1]; j++)
+          pivotValue -= elementR[j] * work[indexRow[j]];
+        work[i] = pivotValue;
+      }
+    }
+    //  ******* U
+    {
+      const int *COIN_RESTRICT startColumn = startColumnUArray_;
+      const int *COIN_RESTRICT indexRow = indexRowUArray_;
+      const int *COIN_RESTRICT numberInColumn = numberInColumnArray_;
+      for (int i = numberU_ - 1; i >= numberSlacks_; i--) {
+        CoinFactorizationDouble pivotValue = work[i];
+        if (pivotValue) {
+          int start = startColumn[i];
+          int end = start + numberInColumn[i];
+          for (int j = start; j < end; j++)
+            work[indexRow[j]] -= elementUFloat[j] * pivotValue;
+          work[i] = pivotValue * pivotRegion[i];
+        }
+      }
+      // now do slacks
+#ifndef COIN_FAST_CODE
+      if (slackValue_ == -1.0) {
+#endif
+        for (int i = 0; i < numberSlacks_; i++)
+          work[i] = -work[i];
+#ifndef COIN_FAST_CODE
+      }
+#endif
+    }
+    for (int i = 0; i < numberRowsExtra_; i++) {
+      if (work[i])
+        out[permuteBack[i]] = work[i];
+    }
+  } else {
+    const int *COIN_RESTRICT pivotColumn = pivotColumnArray_;
+    for (int i = 0; i < numberRows_; i++) {
+      if (in[i]) {
+        int iPivot = pivotColumn[i];
+        work[iPivot] = in[i] * pivotRegion[iPivot];
+      }
+    }
+    //  ******* U
+    {
+      const int *COIN_RESTRICT startColumn = startColumnUArray_;
+      const int *COIN_RESTRICT indexRow = indexRowUArray_;
+      const int *COIN_RESTRICT numberInColumn = numberInColumnArray_;
+      for (int i = numberSlacks_; i < numberU_; i++) {
+        CoinFactorizationDouble pivotValue = work[i];
+        int start = startColumn[i];
+        int end = start + numberInColumn[i];
+        for (int j = start; j < end; j++)
+          pivotValue -= elementUFloat[j] * work[indexRow[j]];
+        work[i] = pivotValue;
+      }
+    }
+    //  ******* R
+    {
+      const int *COIN_RESTRICT startColumn = startColumnRArray_ - numberRows_;
+      const int *COIN_RESTRICT indexRow = indexRowR_;
+      const float *COIN_RESTRICT elementR = elementLFloat + lengthL_;
+      for (int i = numberRowsExtra_ - 1; i >= numberRows_; i--) {
+        CoinFactorizationDouble pivotValue = work[i];
+        if (pivotValue) {
+          work[i] = 0.0;
+          for (int j = startColumn[i]; j < startColumn[i + 1]; j++)
+            work[indexRow[j]] -= elementR[j] * pivotValue;
+          work[permute[i]] = pivotValue;
+        }
+      }
+    }
+    //  ******* L
+    {
+      if (numberDense_)
+        updateDenseColumns(true, 1, work);
+      const int *COIN_RESTRICT startColumn = startColumnLArray_;
+      const int *COIN_RESTRICT indexRow = indexRowLArray_;
+      for (int i = baseL_ + numberL_ - 1; i >= baseL_; i--) {
+        CoinFactorizationDouble pivotValue = work[i];
+        for (int j = startColumn[i]; j < startColumn[i + 1]; j++)
+          pivotValue -= elementLFloat[j] * work[indexRow[j]];
+        work[i] = pivotValue;
+      }
+    }
+    for (int i = 0; i < numberRows_; i++)
+      out[permuteBack[i]] = work[i];
+  }
+}
+/* Solves with float copies and then does refinement steps using
+   residual against copy of basis.  regionSparse2 is as for
+   updateColumn or updateColumnTranspose. */
+int CoinFactorization::updateColumnRefined(bool transpose,
+  CoinIndexedVector *regionSparse2) const
+{
+  if (!floatFactorsValid_)
+    makeFloatFactors();
+  int numberRows = numberRows_;
+  double *COIN_RESTRICT rhs = refineRegion_.conditionalNew(4 * numberRows + numberRowsExtra_ + numberDense_);
+  double *COIN_RESTRICT solution = rhs + numberRows;
+  double *COIN_RESTRICT residual = solution + numberRows;
+  double *COIN_RESTRICT correction = residual + numberRows;
+  double *COIN_RESTRICT work = correction + numberRows;
+  int numberNonZero = regionSparse2->getNumElements();
+  int *COIN_RESTRICT index = regionSparse2->getIndices();
+  double *COIN_RESTRICT array = regionSparse2->denseVector();
+  bool packed = regionSparse2->packedMode();
+  CoinZeroN(rhs, numberRows);
+  double largest = 0.0;
+  for (int j = 0; j < numberNonZero; j++) {
+    int iRow = index[j];
+    double value;
+    if (packed) {
+      value = array[j];
+      array[j] = 0.0;
+    } else {
+      value = array[iRow];
+      array[iRow] = 0.0;
+    }
+    rhs[iRow] = value;
+    largest = std::max(largest, fabs(value));
+  }
+  if (!largest) {
+    regionSparse2->setNumElements(0);
+    return 0;
+  }
+  const int *COIN_RESTRICT basisStart = basisStart_.array();
+  const int *COIN_RESTRICT basisLength = basisLength_.array();
+  const int *COIN_RESTRICT basisIndex = basisIndex_.array();
+  const double *COIN_RESTRICT basisElement = basisElement_.array();
+  double residualNorm;
+  for (int iPass = 0;; iPass++) {
+    if (!iPass) {
+      updateColumnFloat(transpose, rhs, solution, work);
+    } else {
+      updateColumnFloat(transpose, residual, correction, work);
+      for (int i = 0; i < numberRows; i++)
+        solution[i] += correction[i];
+    }
+    // residual in double against basis
+    CoinMemcpyN(rhs, numberRows, residual);
+    if (!transpose) {
+      for (int i = 0; i < numberRows; i++) {
+        double value = solution[i];
+        if (value) {
+          for (int j = basisStart[i]; j < basisStart[i] + basisLength[i]; j++)
+            residual[basisIndex[j]] -= basisElement[j] * value;
+        }
+      }
+    } else {
+      for (int i = 0; i < numberRows; i++) {
+        double value = residual[i];
+        for (int j = basisStart[i]; j < basisStart[i] + basisLength[i]; j++)
+          value -= basisElement[j] * solution[basisIndex[j]];
+        residual[i] = value;
+      }
+    }
+    residualNorm = 0.0;
+    for (int i = 0; i < numberRows; i++)
+      residualNorm = std::max(residualNorm, fabs(residual[i]));
+    residualNorm /= largest;
+    if (iPass == floatFactors_ || residualNorm < 1.0e-15)
+      break;
+    numberRefinementSteps_++;
+  }
+  lastResidual_ = residualNorm;
+  largestResidual_ = std::max(largestResidual_, residualNorm);
+  double tolerance = zeroTolerance_;
+  numberNonZero = 0;
+  for (int i = 0; i < numberRows; i++) {
+    double value = solution[i];
+    if (fabs(value) > tolerance) {
+      if (packed) {
+        index[numberNonZero] = i;
+        array[numberNonZero++] = value;
+      } else {
+        index[numberNonZero++] = i;
+        array[i] = value;
+      }
+    }
+  }
+  regionSparse2->setNumElements(numberNonZero);
+  return numberNonZero;
+}
 //  updateColumnL.  Updates part of column (FTRANL)
 void CoinFactorization::updateColumnL(CoinIndexedVector *regionSparse,
   int *COIN_RESTRICT regionIndex) const
 {
+  double startTime = statistics_.startSolve();
   if (numberL_) {
     int number = regionSparse->getNumElements();
     int goSparse;
@@ -258,6 +865,7 @@ void CoinFactorization::updateColumnL(CoinIndexedVector *regionSparse,
     } else {
       goSparse = 0;
     }
+    statistics_.addMethod(0, goSparse);
     switch (goSparse) {
     case 0: // densish
       updateColumnLDensish(regionSparse, regionIndex);
@@ -270,7 +878,6 @@ void CoinFactorization::updateColumnL(CoinIndexedVector *regionSparse,
       break;
     }
   }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   if (numberDense_) {
     //take off list
     int lastSparse = numberRows_ - numberDense_;
@@ -288,22 +895,31 @@ void CoinFactorization::updateColumnL(CoinIndexedVector *regionSparse,
       }
     }
     if (doDense) {
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+      if (denseCode_ == 2) {
 #if COIN_FACTORIZATION_DENSE_CODE == 1
-      char trans = 'N';
-      int ione = 1;
-      int info;
-      COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberDense_,&ione,
-                       denseAreaAddress_,&numberDense_,densePermute_,
-                       region+lastSparse,&numberDense_,&info,1);
+        char trans = 'N';
+        int ione = 1;
+        int info;
+        COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberDense_,&ione,
+                         denseAreaAddress_,&numberDense_,densePermute_,
+                         region+lastSparse,&numberDense_,&info,1);
 #elif COIN_FACTORIZATION_DENSE_CODE==2
-      clapack_dgetrs(CblasColMajor,CblasNoTrans,numberDense_,1,
-                     denseAreaAddress_,numberDense_,densePermute_,
-                     region+lastSparse,numberDense_);
+        clapack_dgetrs(CblasColMajor,CblasNoTrans,numberDense_,1,
+                       denseAreaAddress_,numberDense_,densePermute_,
+                       region+lastSparse,numberDense_);
 #elif COIN_FACTORIZATION_DENSE_CODE==3
-      LAPACKE_dgetrs(LAPACK_COL_MAJOR,'N',numberDense_,1,
-                     denseAreaAddress_,numberDense_,densePermute_,
-                     region+lastSparse,numberDense_);
+        LAPACKE_dgetrs(LAPACK_COL_MAJOR,'N',numberDense_,1,
+                       denseAreaAddress_,numberDense_,densePermute_,
+                       region+lastSparse,numberDense_);
+#endif
+      } else
 #endif
+      {
+        // built in code (factors are same format as LAPACK)
+        CoinDenseLUSolve(false, numberDense_, denseAreaAddress_, numberDense_,
+          densePermute_, region + lastSparse);
+      }
       for (int i = lastSparse; i < numberRows_; i++) {
         double value = region[i];
         if (value) {
@@ -316,7 +932,7 @@ void CoinFactorization::updateColumnL(CoinIndexedVector *regionSparse,
       regionSparse->setNumElements(number);
     }
   }
-#endif
+  statistics_.endSolve(CoinFactorizationStatistics::ftranL, regionSparse->getNumElements(), startTime);
 }
 // Updates part of column (FTRANL) when densish
 void CoinFactorization::updateColumnLDensish(CoinIndexedVector *regionSparse,
@@ -335,10 +951,8 @@ void CoinFactorization::updateColumnLDensish(CoinIndexedVector *regionSparse,
   const CoinFactorizationDouble *COIN_RESTRICT element = elementLArray_;
   int last = numberRows_;
   assert(last == baseL_ + numberL_);
-#if COIN_FACTORIZATION_DENSE_CODE
   //can take out last bit of sparse L as empty
   last -= numberDense_;
-#endif
   int smallestIndex = numberRowsExtra_;
   // do easy ones
   for (int k = 0; k < number; k++) {
@@ -395,10 +1009,8 @@ void CoinFactorization::updateColumnLSparsish(CoinIndexedVector *regionSparse,
   const CoinFactorizationDouble *COIN_RESTRICT element = elementLArray_;
   int last = numberRows_;
   assert(last == baseL_ + numberL_);
-#if COIN_FACTORIZATION_DENSE_CODE
   //can take out last bit of sparse L as empty
   last -= numberDense_;
-#endif
   // mark known to be zero
   int nInBig = sizeof(int) / sizeof(int);
 #if ABOCA_LITE_FACTORIZATION == 0
@@ -560,6 +1172,29 @@ void CoinFactorization::updateColumnLSparse(CoinIndexedVector *regionSparse,
   }
 #endif
   nList = 0;
+  if (reachCaching_) {
+    // appending cached reaches (skipping ones already in) keeps order
+    for (int k = 0; k < number; k++) {
+      int kPivot = regionIndex[k];
+      if (kPivot >= baseL_) {
+        if (!mark[kPivot]) {
+          const int *reach = reachOf(0, kPivot);
+          int nReach = reach[0];
+          for (int i = 1; i <= nReach; i++) {
+            int iPivot = reach[i];
+            if (!mark[iPivot]) {
+              mark[iPivot] = 1;
+              list[nList++] = iPivot;
+            }
+          }
+        }
+      } else {
+        // just put on list
+        regionIndex[numberNonZero++] = kPivot;
+      }
+    }
+    number = 0;
+  }
   for (int k = 0; k < number; k++) {
     int kPivot = regionIndex[k];
     if (kPivot >= baseL_) {
@@ -646,6 +1281,8 @@ int CoinFactorization::updateTwoColumnsFT(CoinIndexedVector *regionSparse1,
   CoinIndexedVector save2(*regionSparse2);
   CoinIndexedVector save3(*regionSparse3);
 #endif
+  if (floatFactors_)
+    saveIncomingColumn(regionSparse2);
   CoinIndexedVector *regionFT;
   CoinIndexedVector *regionUpdate;
   int *COIN_RESTRICT regionIndex;
@@ -1019,6 +1656,7 @@ double sumNumberDensishX = 0.0;
 void CoinFactorization::updateColumnU(CoinIndexedVector *regionSparse,
   int *COIN_RESTRICT indexIn) const
 {
+  double startTime = statistics_.startSolve();
   int numberNonZero = regionSparse->getNumElements();
 
   int goSparse;
@@ -1063,6 +1701,7 @@ void CoinFactorization::updateColumnU(CoinIndexedVector *regionSparse,
       numberSparseX, averageSparse, ftranAverageAfterU_);
   }
 #endif
+  statistics_.addMethod(1, goSparse);
   switch (goSparse) {
   case 0: // densish
   {
@@ -1089,6 +1728,7 @@ void CoinFactorization::updateColumnU(CoinIndexedVector *regionSparse,
     scaledLengthU += lengthU_ * numberNonZero;
 #endif
   }
+  statistics_.endSolve(CoinFactorizationStatistics::ftranU, regionSparse->getNumElements(), startTime);
 }
 #ifdef COIN_DEVELOP
 double ncall_DZ = 0.0;
@@ -1665,6 +2305,7 @@ void CoinFactorization::updateColumnR(CoinIndexedVector *regionSparse) const
 
   if (!numberR_)
     return; //return if nothing to do
+  double startTime = statistics_.startSolve();
   double tolerance = zeroTolerance_;
 
   const int *startColumn = startColumnRArray_ - numberRows_;
@@ -1974,11 +2615,13 @@ void CoinFactorization::updateColumnR(CoinIndexedVector *regionSparse) const
   }
   //set counts
   regionSparse->setNumElements(numberNonZero);
+  statistics_.endSolve(CoinFactorizationStatistics::ftranR, regionSparse->getNumElements(), startTime);
 }
 //  updateColumnR.  Updates part of column (FTRANR)
 void CoinFactorization::updateColumnRFT(CoinIndexedVector *regionSparse,
   int *COIN_RESTRICT regionIndex)
 {
+  double startTime = statistics_.startSolve();
   double *COIN_RESTRICT region = regionSparse->denseVector();
   //int *regionIndex = regionSparse->getIndices (  );
   int *COIN_RESTRICT startColumnU = startColumnUArray_;
@@ -2241,6 +2884,7 @@ void CoinFactorization::updateColumnRFT(CoinIndexedVector *regionSparse,
       putElement[i] = value;
     }
   }
+  statistics_.endSolve(CoinFactorizationStatistics::ftranR, regionSparse->getNumElements(), startTime);
 }
 /* Updates one column (FTRAN) from region2 and permutes.
    region1 starts as zero
@@ -2252,6 +2896,8 @@ int CoinFactorization::updateColumnFT(CoinIndexedVector *regionSparse,
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX = CoinCpuTime();
 #endif
+  if (floatFactors_)
+    saveIncomingColumn(regionSparse2);
   //permute and move indices into index array
   int *COIN_RESTRICT regionIndex = regionSparse->getIndices();
   int numberNonZero = regionSparse2->getNumElements();
@@ -11,11 +11,16 @@
 
 #include <cassert>
 #include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <functional>
 
 #include "CoinFactorization.hpp"
 #include "CoinIndexedVector.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinTime.hpp"
+#include "CoinDenseLU.hpp"
 #include <stdio.h>
 #include <iostream>
 #if COIN_FACTORIZATION_DENSE_CODE == 1
@@ -292,6 +297,7 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX = CoinCpuTime();
 #endif
+  double startTime = statistics_.startSolve();
   assert(numberU_ <= numberRowsExtra_);
   int *COIN_RESTRICT startColumnU = startColumnUArray_;
   int *COIN_RESTRICT startColumn;
@@ -300,11 +306,16 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
 
   //return at once if too many iterations
   if (numberColumnsExtra_ >= maximumColumnsExtra_) {
+    statistics_.endUpdate(5, totalElements_, factorElements_, startTime);
     return 5;
   }
   if (lengthAreaU_ < startColumnU[maximumColumnsExtra_]) {
+    statistics_.endUpdate(3, totalElements_, factorElements_, startTime);
     return 3;
   }
+  // float copies are kept up to date if pivot is taken
+  float *COIN_RESTRICT elementUFloat = floatFactorsValid_ ? elementUFloat_.array() : NULL;
+  floatFactorsValid_ = false;
 
   int *COIN_RESTRICT numberInRow = numberInRowArray_;
   int *COIN_RESTRICT numberInColumn = numberInColumnArray_;
@@ -408,6 +419,7 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
     if (checkBeforeModifying) {
       if (lengthR_ + maximumRowsExtra_ + 1 >= lengthAreaR_) {
         //not enough room
+        statistics_.endUpdate(3, totalElements_, factorElements_, startTime);
         return 3;
       }
       saveWhere = indexRowR_ + lengthR_;
@@ -450,6 +462,7 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
       totalElements_ += number;
       numberInColumn[realPivotRow] = number;
       regionSparse->clear();
+      statistics_.endUpdate(status, totalElements_, factorElements_, startTime);
       return status;
 #if COIN_ONE_ETA_COPY
     } else if (convertRowToColumn) {
@@ -481,6 +494,17 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
   for (int i = startColumnU[realPivotRow]; i < saveEnd; i++) {
     element[i] = 0.0;
   }
+  if (elementUFloat) {
+    if (convertRowToColumn) {
+      for (int i = start; i < end; i++)
+        elementUFloat[convertRowToColumn[i]] = 0.0f;
+      for (int i = startColumnU[realPivotRow]; i < saveEnd; i++)
+        elementUFloat[i] = 0.0f;
+    } else {
+      // row was taken out by replaceColumnU
+      elementUFloat = NULL;
+    }
+  }
   //zero out pivot Row (before or after?)
   //add to R
   startColumn = startColumnRArray_;
@@ -498,6 +522,7 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
   if (lengthR_ >= lengthAreaR_) {
     //not enough room
     regionSparse->clear();
+    statistics_.endUpdate(3, totalElements_, factorElements_, startTime);
     return 3;
   }
 #if COIN_DEBUG > 1
@@ -561,6 +586,7 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
   if (lengthU_ >= lengthAreaU_) {
     //not enough room
     regionSparse->clear();
+    statistics_.endUpdate(3, totalElements_, factorElements_, startTime);
     return 3;
   }
 
@@ -662,6 +688,26 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
     numberColumnsExtra_++;
     numberGoodU_++;
     numberPivots_++;
+    if (elementUFloat) {
+      elementUFloat += startU;
+      for (int i = 0; i < number; i++)
+        elementUFloat[i] = static_cast< float >(elementU[i]);
+      float *COIN_RESTRICT elementRFloat = elementLFloat_.array() + lengthL_;
+      for (int i = lengthR_ - numberNonZero; i < lengthR_; i++)
+        elementRFloat[i] = static_cast< float >(elementR_[i]);
+      floatFactorsValid_ = true;
+    }
+    if (basisValid_) {
+      // incoming column saved by updateColumnFT
+      if (incomingLength_ >= 0) {
+        basisStart_.array()[pivotRow] = basisSize_;
+        basisLength_.array()[pivotRow] = incomingLength_;
+        basisSize_ += incomingLength_;
+        incomingLength_ = -1;
+      } else {
+        basisValid_ = false;
+      }
+    }
   }
   if (numberRowsExtra_ > numberRows_ + 50) {
     int extra = factorElements_ >> 1;
@@ -733,6 +779,7 @@ int CoinFactorization::replaceColumn(CoinIndexedVector *regionSparse,
   currentLengthR = lengthR_;
   currentLengthU = lengthU_;
 #endif
+  statistics_.endUpdate(status, totalElements_, factorElements_, startTime);
   return status;
 }
 #if ABOCA_LITE_FACTORIZATION
@@ -1199,6 +1246,8 @@ int CoinFactorization::updateColumnTranspose(CoinIndexedVector *regionSparse,
 #endif
   //zero region
   regionSparse->clear();
+  if (usingFloatFactors(regionSparse2->getNumElements()))
+    return updateColumnRefined(true, regionSparse2);
   double *COIN_RESTRICT region = regionSparse->denseVector();
   double *COIN_RESTRICT vector = regionSparse2->denseVector();
   int *COIN_RESTRICT index = regionSparse2->getIndices();
@@ -1943,6 +1992,7 @@ void CoinFactorization::updateColumnTransposeU(CoinIndexedVector *regionSparse,
     return;
   }
 #endif
+  double startTime = statistics_.startSolve();
   int number = regionSparse->getNumElements();
   int goSparse;
   // Guess at number at end
@@ -1964,6 +2014,7 @@ void CoinFactorization::updateColumnTransposeU(CoinIndexedVector *regionSparse,
   } else {
     goSparse = 0;
   }
+  statistics_.addMethod(2, goSparse);
   switch (goSparse) {
   case 0: // densish
     updateColumnTransposeUDensish(regionSparse, smallestIndex);
@@ -1975,6 +2026,7 @@ void CoinFactorization::updateColumnTransposeU(CoinIndexedVector *regionSparse,
     updateColumnTransposeUSparse(regionSparse);
     break;
   }
+  statistics_.endSolve(CoinFactorizationStatistics::btranU, regionSparse->getNumElements(), startTime);
 }
 
 /*  updateColumnTransposeLDensish.
@@ -2223,6 +2275,24 @@ void CoinFactorization::updateColumnTransposeLSparse(CoinIndexedVector *regionSp
   }
 #endif
   nList = 0;
+  if (reachCaching_) {
+    // appending cached reaches (skipping ones already in) keeps order
+    for (int k = 0; k < number; k++) {
+      int kPivot = regionIndex[k];
+      if (!mark[kPivot] && region[kPivot]) {
+        const int *reach = reachOf(1, kPivot);
+        int nReach = reach[0];
+        for (int i = 1; i <= nReach; i++) {
+          int iPivot = reach[i];
+          if (!mark[iPivot]) {
+            mark[iPivot] = 1;
+            list[nList++] = iPivot;
+          }
+        }
+      }
+    }
+    number = 0;
+  }
   for (int k = 0; k < number; k++) {
     int kPivot = regionIndex[k];
     if (!mark[kPivot] && region[kPivot]) {
@@ -2284,6 +2354,7 @@ void CoinFactorization::updateColumnTransposeL(CoinIndexedVector *regionSparse)
     if (sparseArray_ || number < numberRows_)
       return;
   }
+  double startTime = statistics_.startSolve();
   int goSparse;
   // Guess at number at end
   // we may need to rethink on dense
@@ -2305,7 +2376,6 @@ void CoinFactorization::updateColumnTransposeL(CoinIndexedVector *regionSparse)
   } else {
     goSparse = -1;
   }
-#ifdef COIN_FACTORIZATION_DENSE_CODE
   if (numberDense_) {
     //take off list
     int lastSparse = numberRows_ - numberDense_;
@@ -2342,22 +2412,31 @@ void CoinFactorization::updateColumnTransposeL(CoinIndexedVector *regionSparse)
     }
     if (doDense) {
       regionSparse->setNumElements(number);
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+      if (denseCode_ == 2) {
 #if COIN_FACTORIZATION_DENSE_CODE == 1
-      char trans = 'T';
-      int ione = 1;
-      int info;
-      COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberDense_,&ione,
-              denseAreaAddress_,&numberDense_,densePermute_,region+lastSparse,
-              &numberDense_,&info,1);
+        char trans = 'T';
+        int ione = 1;
+        int info;
+        COINUTILS_LAPACK_FUNC(dgetrs,DGETRS)(&trans,&numberDense_,&ione,
+                denseAreaAddress_,&numberDense_,densePermute_,region+lastSparse,
+                &numberDense_,&info,1);
 #elif COIN_FACTORIZATION_DENSE_CODE==2
-      clapack_dgetrs(CblasColMajor,CblasTrans,numberDense_,1,
-                     denseAreaAddress_,numberDense_,densePermute_,
-                     region+lastSparse,numberDense_);
+        clapack_dgetrs(CblasColMajor,CblasTrans,numberDense_,1,
+                       denseAreaAddress_,numberDense_,densePermute_,
+                       region+lastSparse,numberDense_);
 #elif COIN_FACTORIZATION_DENSE_CODE==3
-      LAPACKE_dgetrs(LAPACK_COL_MAJOR,'T',numberDense_,1,
-                     denseAreaAddress_,numberDense_,densePermute_,
-                     region+lastSparse,numberDense_);
+        LAPACKE_dgetrs(LAPACK_COL_MAJOR,'T',numberDense_,1,
+                       denseAreaAddress_,numberDense_,densePermute_,
+                       region+lastSparse,numberDense_);
+#endif
+      } else
 #endif
+      {
+        // built in code (factors are same format as LAPACK)
+        CoinDenseLUSolve(true, numberDense_, denseAreaAddress_, numberDense_,
+          densePermute_, region + lastSparse);
+      }
       //and scan again
       if (goSparse > 0 || !numberL_)
         regionSparse->scan(lastSparse, numberRows_, zeroTolerance_);
@@ -2368,12 +2447,13 @@ void CoinFactorization::updateColumnTransposeL(CoinIndexedVector *regionSparse)
         regionSparse->setNumElements(0);
         regionSparse->scan(0, numberRows_, zeroTolerance_);
       }
+      statistics_.endSolve(CoinFactorizationStatistics::btranL, regionSparse->getNumElements(), startTime);
       return;
     }
   }
-#endif
   if (goSparse > 0 && regionSparse->getNumElements() > numberRows_)
     goSparse = 0;
+  statistics_.addMethod(4, std::max(goSparse, 0));
   switch (goSparse) {
   case -1: // No row copy
     updateColumnTransposeLDensish(regionSparse);
@@ -2388,6 +2468,7 @@ void CoinFactorization::updateColumnTransposeL(CoinIndexedVector *regionSparse)
     updateColumnTransposeLSparse(regionSparse);
     break;
   }
+  statistics_.endSolve(CoinFactorizationStatistics::btranL, regionSparse->getNumElements(), startTime);
 }
 #if COIN_ONE_ETA_COPY
 /* Combines BtranU and delete elements
@@ -2565,8 +2646,40 @@ void CoinFactorization::updateColumnTransposeRSparse(CoinIndexedVector *regionSp
   for (int i = 0; i < numberNonZero; i++) {
     spare[regionIndex[i]] = i;
   }
-  // still need to do in correct order (for now)
-  for (int i = last; i >= numberRows_; i--) {
+  // etas to do - all if not caching reaches
+  int *COIN_RESTRICT list = NULL;
+  int nList = last - numberRows_ + 1;
+  char *COIN_RESTRICT mark = NULL;
+  if (reachCaching_) {
+    // spare uses stack area
+    list = spare + maximumRowsExtra_;
+    mark = reinterpret_cast< char * >(list + 2 * maximumRowsExtra_);
+    nList = 0;
+    for (int k = 0; k < numberNonZero; k++) {
+      int kPivot = regionIndex[k];
+      if (kPivot >= numberRows_ && !mark[kPivot] && region[kPivot]) {
+        const int *reach = reachOf(2, kPivot);
+        int nReach = reach[0];
+        for (int i = 1; i <= nReach; i++) {
+          int iPivot = reach[i];
+          if (!mark[iPivot]) {
+            mark[iPivot] = 1;
+            list[nList++] = iPivot;
+          }
+        }
+      }
+    }
+    // still need to do in correct order
+    std::sort(list, list + nList, std::greater< int >());
+  }
+  for (int k = 0; k < nList; k++) {
+    int i;
+    if (list) {
+      i = list[k];
+      mark[i] = 0;
+    } else {
+      i = last - k;
+    }
     int putRow = permute[i];
     assert(putRow <= i);
     CoinFactorizationDouble pivotValue = region[i];
@@ -2604,14 +2717,17 @@ void CoinFactorization::updateColumnTransposeR(CoinIndexedVector *regionSparse)
 {
   if (numberRowsExtra_ == numberRows_)
     return;
+  double startTime = statistics_.startSolve();
   int numberNonZero = regionSparse->getNumElements();
 
   if (numberNonZero) {
     if (numberNonZero < (sparseThreshold_ << 2) || (!numberL_ && sparseArray_)) {
+      statistics_.addMethod(3, 2);
       updateColumnTransposeRSparse(regionSparse);
       if (collectStatistics_)
         btranCountAfterR_ += regionSparse->getNumElements();
     } else {
+      statistics_.addMethod(3, 0);
       updateColumnTransposeRDensish(regionSparse);
       // we have lost indices
       // make sure won't try and go sparse again
@@ -2620,6 +2736,7 @@ void CoinFactorization::updateColumnTransposeR(CoinIndexedVector *regionSparse)
       regionSparse->setNumElements(numberRows_ + 1);
     }
   }
+  statistics_.endSolve(CoinFactorizationStatistics::btranR, std::min(regionSparse->getNumElements(), numberRows_), startTime);
 }
 //  makes a row copy of L
 void CoinFactorization::goSparse()
@@ -2652,6 +2769,7 @@ void CoinFactorization::goSparse()
     }
     sparseThreshold2_ = sparseThreshold_;
   }
+  clearReachCache();
   if (!sparseThreshold_)
     return;
   // allow for stack, list, next and char map of mark
@@ -2740,6 +2858,243 @@ void CoinFactorization::sparseThreshold(int value)
     goSparse();
   }
 }
+// Sets whether sparse solves cache reaches
+void CoinFactorization::setReachCaching(bool yes)
+{
+  reachCaching_ = yes;
+  clearReachCache();
+}
+// Forgets cached reaches
+void CoinFactorization::clearReachCache()
+{
+  reachListSize_ = 0;
+  int *reachStart = reachStart_.array();
+  if (reachStart)
+    CoinFillN(reachStart, reachStart_.getSize(), -1);
+}
+// Sets number of refinement steps for solves with float copies
+void CoinFactorization::setFloatFactors(int numberRefinements)
+{
+  floatFactors_ = std::max(numberRefinements, 0);
+  if (!floatFactors_) {
+    basisValid_ = false;
+    floatFactorsValid_ = false;
+    elementLFloat_.conditionalDelete();
+    elementUFloat_.conditionalDelete();
+    basisIndex_.conditionalDelete();
+    basisElement_.conditionalDelete();
+    refineRegion_.conditionalDelete();
+  }
+}
+// Makes float copies of L, R and U
+void CoinFactorization::makeFloatFactors() const
+{
+  const CoinFactorizationDouble *COIN_RESTRICT elementL = elementLArray_;
+  float *COIN_RESTRICT elementLFloat = elementLFloat_.conditionalNew(lengthAreaL_);
+  for (int i = 0; i < lengthL_; i++)
+    elementLFloat[i] = static_cast< float >(elementL[i]);
+  // R is after L
+  float *COIN_RESTRICT elementRFloat = elementLFloat + lengthL_;
+  for (int i = 0; i < lengthR_; i++)
+    elementRFloat[i] = static_cast< float >(elementR_[i]);
+  const CoinFactorizationDouble *COIN_RESTRICT elementU = elementUArray_;
+  float *COIN_RESTRICT elementUFloat = elementUFloat_.conditionalNew(lengthAreaU_);
+  for (int i = 0; i < maximumU_; i++)
+    elementUFloat[i] = static_cast< float >(elementU[i]);
+  floatFactorsValid_ = true;
+}
+// Copies columns of basis from U before factorizing
+void CoinFactorization::saveBasis()
+{
+  basisValid_ = false;
+  incomingLength_ = -1;
+  basisSize_ = 0;
+  if (numberColumns_ != numberRows_)
+    return;
+  const int *COIN_RESTRICT startColumnU = startColumnUArray_;
+  const int *COIN_RESTRICT numberInColumn = numberInColumnArray_;
+  const int *COIN_RESTRICT indexRowU = indexRowUArray_;
+  const CoinFactorizationDouble *COIN_RESTRICT elementU = elementUArray_;
+  int numberElements = 0;
+  for (int i = 0; i < numberColumns_; i++)
+    numberElements += numberInColumn[i];
+  // room for one update - basisSpace grows it
+  int *COIN_RESTRICT start = basisStart_.conditionalNew(numberRows_);
+  int *COIN_RESTRICT length = basisLength_.conditionalNew(numberRows_);
+  int *COIN_RESTRICT index = basisIndex_.conditionalNew(numberElements + numberRows_);
+  double *COIN_RESTRICT element = basisElement_.conditionalNew(numberElements + numberRows_);
+  for (int i = 0; i < numberColumns_; i++) {
+    int number = numberInColumn[i];
+    const int *COIN_RESTRICT indexColumn = indexRowU + startColumnU[i];
+    const CoinFactorizationDouble *COIN_RESTRICT elementColumn = elementU + startColumnU[i];
+    start[i] = basisSize_;
+    length[i] = number;
+    for (int j = 0; j < number; j++) {
+      index[basisSize_] = indexColumn[j];
+      element[basisSize_++] = elementColumn[j];
+    }
+  }
+}
+// Puts saved basis columns in pivot sequence after factorizing
+void CoinFactorization::sequenceBasis()
+{
+  if (numberColumns_ != numberRows_)
+    return;
+  int *COIN_RESTRICT start = basisStart_.array();
+  int *COIN_RESTRICT length = basisLength_.array();
+  int *COIN_RESTRICT temp = new int[2 * numberRows_];
+  CoinMemcpyN(start, numberRows_, temp);
+  CoinMemcpyN(length, numberRows_, temp + numberRows_);
+  // column i will be solution entry permuteBack[pivotColumnBack[i]]
+  const int *COIN_RESTRICT permuteBack = permuteBackArray_;
+  const int *COIN_RESTRICT back = pivotColumnBack();
+  for (int i = 0; i < numberColumns_; i++) {
+    int iSequence = permuteBack[back[i]];
+    start[iSequence] = temp[i];
+    length[iSequence] = temp[numberRows_ + i];
+  }
+  delete[] temp;
+  basisValid_ = true;
+  makeFloatFactors();
+}
+// Makes sure basis copy has room for another numberRows_ elements
+void CoinFactorization::basisSpace()
+{
+  if (basisSize_ + numberRows_ <= basisIndex_.getSize())
+    return;
+  // compress into new arrays
+  int *COIN_RESTRICT start = basisStart_.array();
+  const int *COIN_RESTRICT length = basisLength_.array();
+  int numberElements = 0;
+  for (int i = 0; i < numberRows_; i++)
+    numberElements += length[i];
+  CoinIntArrayWithLength newIndex;
+  CoinDoubleArrayWithLength newElement;
+  newIndex.switchOn();
+  newElement.switchOn();
+  int *COIN_RESTRICT index = newIndex.conditionalNew(2 * (numberElements + numberRows_));
+  double *COIN_RESTRICT element = newElement.conditionalNew(2 * (numberElements + numberRows_));
+  const int *COIN_RESTRICT oldIndex = basisIndex_.array();
+  const double *COIN_RESTRICT oldElement = basisElement_.array();
+  int put = 0;
+  for (int i = 0; i < numberRows_; i++) {
+    CoinMemcpyN(oldIndex + start[i], length[i], index + put);
+    CoinMemcpyN(oldElement + start[i], length[i], element + put);
+    start[i] = put;
+    put += length[i];
+  }
+  basisIndex_.swap(newIndex);
+  basisElement_.swap(newElement);
+  basisSize_ = put;
+}
+// Keeps incoming column from updateColumnFT for replaceColumn
+void CoinFactorization::saveIncomingColumn(const CoinIndexedVector *column)
+{
+  if (!basisValid_)
+    return;
+  basisSpace();
+  int number = column->getNumElements();
+  const int *COIN_RESTRICT columnIndex = column->getIndices();
+  const double *COIN_RESTRICT columnElement = column->denseVector();
+  int *COIN_RESTRICT index = basisIndex_.array() + basisSize_;
+  double *COIN_RESTRICT element = basisElement_.array() + basisSize_;
+  if (column->packedMode()) {
+    CoinMemcpyN(columnIndex, number, index);
+    CoinMemcpyN(columnElement, number, element);
+  } else {
+    for (int j = 0; j < number; j++) {
+      int iRow = columnIndex[j];
+      index[j] = iRow;
+      element[j] = columnElement[iRow];
+    }
+  }
+  incomingLength_ = number;
+}
+/* Reach of pivot as length then pivots.  Found by depth first search
+   so list is in reverse of order to do.  R etas always point back so
+   caller can just sort.  Cached if room. */
+const int *CoinFactorization::reachOf(int type, int pivot) const
+{
+  if (reachStart_.getSize() < 3 * maximumRowsExtra_) {
+    reachStart_.conditionalNew(3 * maximumRowsExtra_);
+    CoinFillN(reachStart_.array(), reachStart_.getSize(), -1);
+    reachListSize_ = 0;
+    // stack, next, length and list, then char mark
+    int nMark = (maximumRowsExtra_ + CoinSizeofAsInt(int) - 1) / CoinSizeofAsInt(int);
+    reachWork_.conditionalNew(3 * maximumRowsExtra_ + 1 + nMark);
+    memset(reachWork_.array() + 3 * maximumRowsExtra_ + 1, 0,
+      maximumRowsExtra_ * sizeof(char));
+  }
+  int *COIN_RESTRICT reachStart = reachStart_.array() + type * maximumRowsExtra_;
+  if (reachStart[pivot] >= 0) {
+    reachCacheHits_++;
+    return reachList_.array() + reachStart[pivot];
+  }
+  reachCacheMisses_++;
+  const int *start;
+  const int *index;
+  int first = 0;
+  const int *permute = permuteArray_;
+  if (type == 0) {
+    start = startColumnLArray_;
+    index = indexRowLArray_;
+  } else if (type == 1) {
+    start = startRowLArray_;
+    index = indexColumnLArray_;
+  } else {
+    // eta i also moves its value to permute[i]
+    start = startColumnRArray_ - numberRows_;
+    index = indexRowR_;
+    first = numberRows_;
+  }
+  int *COIN_RESTRICT stack = reachWork_.array();
+  int *COIN_RESTRICT next = stack + maximumRowsExtra_;
+  int *COIN_RESTRICT list = next + maximumRowsExtra_;
+  char *COIN_RESTRICT mark = reinterpret_cast< char * >(list + maximumRowsExtra_ + 1);
+  int extra = (type == 2) ? 1 : 0;
+  int nList = 0;
+  int nStack = 0;
+  stack[0] = pivot;
+  next[0] = start[pivot + 1] - 1;
+  mark[pivot] = 1;
+  while (nStack >= 0) {
+    int kPivot = stack[nStack];
+    int j = next[nStack];
+    if (j >= start[kPivot] - extra) {
+      next[nStack] = j - 1;
+      int jPivot = (j >= start[kPivot]) ? index[j] : permute[kPivot];
+      if (jPivot >= first && !mark[jPivot]) {
+        mark[jPivot] = 1;
+        stack[++nStack] = jPivot;
+        next[nStack] = start[jPivot + 1] - 1;
+      }
+    } else {
+      list[++nList] = kPivot;
+      --nStack;
+    }
+  }
+  for (int i = 1; i <= nList; i++)
+    mark[list[i]] = 0;
+  list[0] = nList;
+  // keep if room
+  int maximumSize = 8 * maximumRowsExtra_ + 2 * lengthL_;
+  if (reachListSize_ + nList + 1 <= maximumSize) {
+    if (reachListSize_ + nList + 1 > reachList_.getSize()) {
+      int newSize = std::max(2 * reachList_.getSize(), reachListSize_ + nList + 1);
+      newSize = std::min(newSize, maximumSize);
+      CoinIntArrayWithLength newList;
+      newList.switchOn();
+      newList.conditionalNew(newSize);
+      if (reachListSize_)
+        CoinMemcpyN(reachList_.array(), reachListSize_, newList.array());
+      reachList_.swap(newList);
+    }
+    reachStart[pivot] = reachListSize_;
+    CoinMemcpyN(list, nList + 1, reachList_.array() + reachListSize_);
+    reachListSize_ += nList + 1;
+  }
+  return list;
+}
 void CoinFactorization::maximumPivots(int value)
 {
   if (value > 0) {
@@ -2806,6 +3161,16 @@ void CoinFactorization::resetStatistics()
   btranAverageAfterU_ = 0.0;
   btranAverageAfterR_ = 0.0;
   btranAverageAfterL_ = 0.0;
+
+  /// Methods used and reach cache
+  statistics_.reset();
+  reachCacheHits_ = 0.0;
+  reachCacheMisses_ = 0.0;
+
+  /// Refined solves
+  lastResidual_ = 0.0;
+  largestResidual_ = 0.0;
+  numberRefinementSteps_ = 0.0;
 }
 /*  getColumnSpaceIterate.  Gets space for one extra U element in Column
     may have to do compression  (returns true)
@@ -2982,6 +3347,8 @@ int CoinFactorization::replaceRow(int whichRow, int iNumberInRow,
 {
   if (!iNumberInRow)
     return 0;
+  // basis copy not kept up to date
+  basisValid_ = false;
   int next = nextRowArray_[whichRow];
   int *COIN_RESTRICT numberInRow = numberInRowArray_;
 #ifndef NDEBUG
@@ -3100,6 +3467,8 @@ int CoinFactorization::replaceRow(int whichRow, int iNumberInRow,
 void CoinFactorization::emptyRows(int numberToEmpty, const int which[])
 {
   int i;
+  // basis copy not kept up to date
+  basisValid_ = false;
   int *COIN_RESTRICT delRow = new int[maximumRowsExtra_];
   int *COIN_RESTRICT indexRowU = indexRowUArray_;
 #ifndef NDEBUG
@@ -3453,6 +3822,29 @@ void CoinFactorization::gutsOfCopy(const CoinFactorization &other)
 
   numberDense_ = other.numberDense_;
   denseThreshold_ = other.denseThreshold_;
+  denseCode_ = other.denseCode_;
+  setNumberThreads(other.numberThreads_);
+  reachCaching_ = other.reachCaching_;
+  clearReachCache();
+  floatFactors_ = other.floatFactors_;
+  statistics_.setTimeSolves(other.statistics_.timeSolves());
+  floatFactorsValid_ = false;
+  basisValid_ = other.basisValid_;
+  basisSize_ = other.basisSize_;
+  incomingLength_ = other.incomingLength_;
+  if (basisValid_) {
+    basisStart_ = other.basisStart_;
+    basisLength_ = other.basisLength_;
+    basisIndex_ = other.basisIndex_;
+    basisElement_ = other.basisElement_;
+  }
+  numberHistory_ = other.numberHistory_;
+  historyRows_ = other.historyRows_;
+  historyColumns_ = other.historyColumns_;
+  numberRepeated_ = other.numberRepeated_;
+  if (numberHistory_)
+    CoinMemcpyN(other.pivotHistory_.array(), 2 * numberHistory_,
+      pivotHistory_.conditionalNew(2 * historyRows_));
   if (numberDense_) {
     denseArea_ = new double[numberDense_ * numberDense_];
     denseAreaAddress_ = denseArea_;
@@ -3551,6 +3943,408 @@ void CoinFactorization::gutsOfCopy(const CoinFactorization &other)
     goSparse();
   }
 }
+/* Snapshot layout - header, int scalars, double scalars, directory of
+   sections (offset and length in bytes) and then sections, each
+   starting on an 8 byte boundary.  Checksum covers all after header.
+*/
+#define COIN_SNAPSHOT_VERSION 1
+#define COIN_SNAPSHOT_INTS 38
+#define COIN_SNAPSHOT_DOUBLES 5
+#define COIN_SNAPSHOT_SECTIONS 26
+namespace {
+struct CoinSnapshotHeader {
+  char magic[8];
+  int version;
+  int sizeofDouble;
+  int sizeofInt;
+  int sizeofBigIndex;
+  int endian;
+  int numberInts;
+  int numberDoubles;
+  int numberSections;
+  CoinUInt64 length;
+  CoinUInt64 checksum;
+};
+const char snapshotMagic[8] = { 'C', 'o', 'i', 'n', 'L', 'U', 'F', 'T' };
+inline size_t snapshotRound(size_t bytes)
+{
+  return (bytes + 7) & ~static_cast< size_t >(7);
+}
+// Hash of whole 8 byte words (buffer is aligned and padded)
+CoinUInt64 snapshotChecksum(const char *buffer, size_t length)
+{
+  const CoinUInt64 *words = reinterpret_cast< const CoinUInt64 * >(buffer);
+  size_t n = length >> 3;
+  CoinUInt64 hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < n; i++) {
+    hash ^= words[i];
+    hash *= 1099511628211ULL;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+}
+// Addresses of scalars kept in snapshot
+void CoinFactorization::snapshotScalars(int **intValue,
+  double **doubleValue) const
+{
+  CoinFactorization *self = const_cast< CoinFactorization * >(this);
+  int **put = intValue;
+  *put++ = &self->numberTrials_;
+  *put++ = &self->biggerDimension_;
+  *put++ = &self->numberSlacks_;
+  *put++ = &self->numberU_;
+  *put++ = &self->maximumU_;
+  *put++ = &self->lengthU_;
+  *put++ = &self->lengthAreaU_;
+  *put++ = &self->numberL_;
+  *put++ = &self->baseL_;
+  *put++ = &self->lengthL_;
+  *put++ = &self->lengthAreaL_;
+  *put++ = &self->numberR_;
+  *put++ = &self->lengthR_;
+  *put++ = &self->lengthAreaR_;
+  *put++ = &self->numberRows_;
+  *put++ = &self->numberRowsExtra_;
+  *put++ = &self->maximumRowsExtra_;
+  *put++ = &self->numberColumns_;
+  *put++ = &self->numberColumnsExtra_;
+  *put++ = &self->maximumColumnsExtra_;
+  *put++ = &self->maximumPivots_;
+  *put++ = &self->numberGoodU_;
+  *put++ = &self->numberGoodL_;
+  *put++ = &self->numberPivots_;
+  *put++ = &self->messageLevel_;
+  *put++ = &self->totalElements_;
+  *put++ = &self->factorElements_;
+  *put++ = &self->status_;
+  *put++ = &self->biasLU_;
+  *put++ = &self->sparseThreshold_;
+  *put++ = &self->sparseThreshold2_;
+  *put++ = &self->numberDense_;
+  *put++ = &self->denseThreshold_;
+  *put++ = &self->denseCode_;
+  *put++ = &self->floatFactors_;
+  // threads, flags and extent of row copy of U are done by caller
+  *put++ = NULL;
+  *put++ = NULL;
+  *put++ = NULL;
+  assert(put - intValue == COIN_SNAPSHOT_INTS);
+  double **putDouble = doubleValue;
+  *putDouble++ = &self->pivotTolerance_;
+  *putDouble++ = &self->zeroTolerance_;
+#ifndef COIN_FAST_CODE
+  *putDouble++ = &self->slackValue_;
+#else
+  *putDouble++ = NULL;
+#endif
+  *putDouble++ = &self->areaFactor_;
+  *putDouble++ = &self->relaxCheck_;
+  assert(putDouble - doubleValue == COIN_SNAPSHOT_DOUBLES);
+}
+// Extent of row copy of U
+int CoinFactorization::snapshotRowExtent() const
+{
+  int rowExtent = 0;
+  if (convertRowToColumnU_.array()) {
+    const int *startRowU = startRowU_.array();
+    const int *numberInRow = numberInRow_.array();
+    for (int iRow = 0; iRow < numberRowsExtra_; iRow++)
+      rowExtent = std::max(rowExtent, startRowU[iRow] + numberInRow[iRow]);
+  }
+  return rowExtent;
+}
+/* Addresses and lengths in bytes of arrays kept in snapshot.
+   Only used parts of U, L and R are kept.  Row copy of L is made again
+   by goSparse. */
+void CoinFactorization::snapshotSections(char **address,
+  size_t *length, int rowExtent) const
+{
+  int numberRowsExtra = maximumRowsExtra_ + 1;
+  int numberColumnsExtra = maximumColumnsExtra_ + 1;
+  const size_t sizeDouble = sizeof(CoinFactorizationDouble);
+  const size_t sizeInt = sizeof(int);
+  int n = 0;
+#define COIN_SNAPSHOT_ARRAY(array, number, size)                      \
+  address[n] = reinterpret_cast< char * >(const_cast< CoinFactorization * >(this)->array); \
+  length[n] = address[n] ? static_cast< size_t >(number) * (size) : 0;                   \
+  n++
+  COIN_SNAPSHOT_ARRAY(elementU_.array(), maximumU_, sizeDouble);
+  COIN_SNAPSHOT_ARRAY(indexRowU_.array(), maximumU_, sizeInt);
+  COIN_SNAPSHOT_ARRAY(indexColumnU_.array(), rowExtent, sizeInt);
+  COIN_SNAPSHOT_ARRAY(convertRowToColumnU_.array(), rowExtent, sizeInt);
+  COIN_SNAPSHOT_ARRAY(startRowU_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(numberInRow_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(pivotRegion_.array(), numberRowsExtra, sizeDouble);
+  COIN_SNAPSHOT_ARRAY(permuteBack_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(permute_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(pivotColumnBack_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(firstCount_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(nextRow_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(lastRow_.array(), numberRowsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(startColumnU_.array(), numberColumnsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(numberInColumn_.array(), numberColumnsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(pivotColumn_.array(), numberColumnsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(nextColumn_.array(), numberColumnsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(lastColumn_.array(), numberColumnsExtra, sizeInt);
+  COIN_SNAPSHOT_ARRAY(startColumnR_.array(),
+    std::max(numberRowsExtra_ - numberColumns_ + 1, 0), sizeInt);
+  COIN_SNAPSHOT_ARRAY(startColumnL_.array(), numberRows_ + 1, sizeInt);
+  COIN_SNAPSHOT_ARRAY(elementL_.array(), lengthL_, sizeDouble);
+  COIN_SNAPSHOT_ARRAY(indexRowL_.array(), lengthL_, sizeInt);
+  COIN_SNAPSHOT_ARRAY(elementR_, lengthR_, sizeDouble);
+  COIN_SNAPSHOT_ARRAY(indexRowR_, lengthR_, sizeInt);
+  COIN_SNAPSHOT_ARRAY(denseAreaAddress_, numberDense_ * numberDense_, sizeof(double));
+  COIN_SNAPSHOT_ARRAY(densePermute_, numberDense_, sizeInt);
+#undef COIN_SNAPSHOT_ARRAY
+  assert(n == COIN_SNAPSHOT_SECTIONS);
+}
+// Length in bytes of snapshot
+size_t CoinFactorization::snapshotLength() const
+{
+  char *address[COIN_SNAPSHOT_SECTIONS];
+  size_t length[COIN_SNAPSHOT_SECTIONS];
+  snapshotSections(address, length, snapshotRowExtent());
+  size_t total = snapshotRound(sizeof(CoinSnapshotHeader))
+    + snapshotRound(COIN_SNAPSHOT_INTS * sizeof(int))
+    + snapshotRound(COIN_SNAPSHOT_DOUBLES * sizeof(double))
+    + 2 * COIN_SNAPSHOT_SECTIONS * sizeof(CoinUInt64);
+  for (int i = 0; i < COIN_SNAPSHOT_SECTIONS; i++)
+    total += snapshotRound(length[i]);
+  return total;
+}
+// Writes snapshot to buffer
+void CoinFactorization::writeSnapshot(char *buffer) const
+{
+  size_t total = snapshotLength();
+  // padding is zeroed so checksum is repeatable
+  memset(buffer, 0, total);
+  CoinSnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, snapshotMagic, 8);
+  header.version = COIN_SNAPSHOT_VERSION;
+  header.sizeofDouble = static_cast< int >(sizeof(CoinFactorizationDouble));
+  header.sizeofInt = static_cast< int >(sizeof(int));
+  header.sizeofBigIndex = static_cast< int >(sizeof(CoinBigIndex));
+  header.endian = 0x01020304;
+  header.numberInts = COIN_SNAPSHOT_INTS;
+  header.numberDoubles = COIN_SNAPSHOT_DOUBLES;
+  header.numberSections = COIN_SNAPSHOT_SECTIONS;
+  header.length = total;
+  size_t put = snapshotRound(sizeof(CoinSnapshotHeader));
+  // scalars
+  int *intValue[COIN_SNAPSHOT_INTS];
+  double *doubleValue[COIN_SNAPSHOT_DOUBLES];
+  snapshotScalars(intValue, doubleValue);
+  int *intPut = reinterpret_cast< int * >(buffer + put);
+  int rowExtent = snapshotRowExtent();
+  for (int i = 0; i < COIN_SNAPSHOT_INTS - 3; i++)
+    intPut[i] = *intValue[i];
+  intPut[COIN_SNAPSHOT_INTS - 3] = numberThreads_;
+  intPut[COIN_SNAPSHOT_INTS - 2] = (doForrestTomlin_ ? 1 : 0) + (reachCaching_ ? 2 : 0);
+  intPut[COIN_SNAPSHOT_INTS - 1] = convertRowToColumnU_.array() ? rowExtent : -1;
+  put += snapshotRound(COIN_SNAPSHOT_INTS * sizeof(int));
+  double *doublePut = reinterpret_cast< double * >(buffer + put);
+  for (int i = 0; i < COIN_SNAPSHOT_DOUBLES; i++)
+    doublePut[i] = doubleValue[i] ? *doubleValue[i] : 0.0;
+  put += snapshotRound(COIN_SNAPSHOT_DOUBLES * sizeof(double));
+  // directory and sections
+  char *address[COIN_SNAPSHOT_SECTIONS];
+  size_t length[COIN_SNAPSHOT_SECTIONS];
+  snapshotSections(address, length, rowExtent);
+  CoinUInt64 *directory = reinterpret_cast< CoinUInt64 * >(buffer + put);
+  put += 2 * COIN_SNAPSHOT_SECTIONS * sizeof(CoinUInt64);
+  for (int i = 0; i < COIN_SNAPSHOT_SECTIONS; i++) {
+    directory[2 * i] = put;
+    directory[2 * i + 1] = length[i];
+    if (length[i])
+      memcpy(buffer + put, address[i], length[i]);
+    put += snapshotRound(length[i]);
+  }
+  assert(put == total);
+  size_t start = snapshotRound(sizeof(CoinSnapshotHeader));
+  header.checksum = snapshotChecksum(buffer + start, total - start);
+  memcpy(buffer, &header, sizeof(header));
+}
+// Restores from snapshot in memory
+int CoinFactorization::readSnapshot(const char *buffer, size_t length)
+{
+  CoinSnapshotHeader header;
+  if (length < sizeof(header))
+    return 1;
+  memcpy(&header, buffer, sizeof(header));
+  if (memcmp(header.magic, snapshotMagic, 8) || header.version != COIN_SNAPSHOT_VERSION)
+    return 1;
+  if (header.sizeofDouble != static_cast< int >(sizeof(CoinFactorizationDouble))
+    || header.sizeofInt != static_cast< int >(sizeof(int))
+    || header.sizeofBigIndex != static_cast< int >(sizeof(CoinBigIndex))
+    || header.endian != 0x01020304 || header.numberInts != COIN_SNAPSHOT_INTS
+    || header.numberDoubles != COIN_SNAPSHOT_DOUBLES
+    || header.numberSections != COIN_SNAPSHOT_SECTIONS)
+    return 2;
+  size_t start = snapshotRound(sizeof(CoinSnapshotHeader));
+  // scalars and directory must be there before sections
+  size_t fixed = start + snapshotRound(COIN_SNAPSHOT_INTS * sizeof(int))
+    + snapshotRound(COIN_SNAPSHOT_DOUBLES * sizeof(double))
+    + 2 * COIN_SNAPSHOT_SECTIONS * sizeof(CoinUInt64);
+  if (header.length > length || header.length < fixed || (header.length & 7) != 0
+    || (reinterpret_cast< size_t >(buffer) & 7) != 0)
+    return 3;
+  if (snapshotChecksum(buffer + start, static_cast< size_t >(header.length) - start) != header.checksum)
+    return 3;
+  // Get rid of current (as operator=)
+  gutsOfDestructor(2);
+  gutsOfInitialize(3);
+  size_t get = start;
+  int *intValue[COIN_SNAPSHOT_INTS];
+  double *doubleValue[COIN_SNAPSHOT_DOUBLES];
+  snapshotScalars(intValue, doubleValue);
+  const int *intGet = reinterpret_cast< const int * >(buffer + get);
+  for (int i = 0; i < COIN_SNAPSHOT_INTS - 3; i++)
+    *intValue[i] = intGet[i];
+  // thread count is kept for information - it belongs to this process
+  doForrestTomlin_ = (intGet[COIN_SNAPSHOT_INTS - 2] & 1) != 0;
+  reachCaching_ = (intGet[COIN_SNAPSHOT_INTS - 2] & 2) != 0;
+  int rowExtent = intGet[COIN_SNAPSHOT_INTS - 1];
+  get += snapshotRound(COIN_SNAPSHOT_INTS * sizeof(int));
+  const double *doubleGet = reinterpret_cast< const double * >(buffer + get);
+  for (int i = 0; i < COIN_SNAPSHOT_DOUBLES; i++) {
+    if (doubleValue[i])
+      *doubleValue[i] = doubleGet[i];
+  }
+  get += snapshotRound(COIN_SNAPSHOT_DOUBLES * sizeof(double));
+  // used parts must fit in space about to be allocated
+  if (numberRows_ < 0 || numberColumns_ < 0 || maximumPivots_ < 0
+    || maximumRowsExtra_ < numberRowsExtra_ || numberRowsExtra_ < numberRows_
+    || maximumColumnsExtra_ < numberColumnsExtra_ || numberColumnsExtra_ < numberColumns_
+    || lengthAreaU_ < 0 || lengthAreaU_ > COIN_INT_MAX - EXTRA_U_SPACE
+    || maximumU_ < 0 || maximumU_ > lengthAreaU_ + EXTRA_U_SPACE
+    || rowExtent > lengthAreaU_ + EXTRA_U_SPACE
+    || lengthL_ < 0 || lengthR_ < 0 || lengthAreaL_ < 0
+    || lengthL_ > lengthAreaL_ || lengthR_ > lengthAreaL_ - lengthL_
+    || numberRowsExtra_ - numberColumns_ > maximumPivots_
+    || numberDense_ < 0 || numberDense_ > numberRows_) {
+    gutsOfDestructor(2);
+    gutsOfInitialize(3);
+    return 3;
+  }
+  // get space as gutsOfCopy
+  int lengthU = lengthAreaU_ + EXTRA_U_SPACE;
+  elementU_.conditionalNew(lengthU);
+  indexRowU_.conditionalNew(lengthU);
+  indexColumnU_.conditionalNew(lengthU);
+  elementL_.conditionalNew(lengthAreaL_);
+  indexRowL_.conditionalNew(lengthAreaL_);
+  startColumnL_.conditionalNew(numberRows_ + 1);
+  startColumnR_.conditionalNew(maximumPivots_ + 1);
+  pivotRegion_.conditionalNew(maximumRowsExtra_ + 1);
+  permuteBack_.conditionalNew(maximumRowsExtra_ + 1);
+  permute_.conditionalNew(maximumRowsExtra_ + 1);
+  pivotColumnBack_.conditionalNew(maximumRowsExtra_ + 1);
+  firstCount_.conditionalNew(maximumRowsExtra_ + 1);
+  nextRow_.conditionalNew(maximumRowsExtra_ + 1);
+  lastRow_.conditionalNew(maximumRowsExtra_ + 1);
+  startColumnU_.conditionalNew(maximumColumnsExtra_ + 1);
+  numberInColumn_.conditionalNew(maximumColumnsExtra_ + 1);
+  pivotColumn_.conditionalNew(maximumColumnsExtra_ + 1);
+  nextColumn_.conditionalNew(maximumColumnsExtra_ + 1);
+  lastColumn_.conditionalNew(maximumColumnsExtra_ + 1);
+#if COIN_ONE_ETA_COPY
+  if (rowExtent >= 0) {
+#endif
+    convertRowToColumnU_.conditionalNew(lengthU);
+    startRowU_.conditionalNew(maximumRowsExtra_ + 1);
+    numberInRow_.conditionalNew(maximumRowsExtra_ + 1);
+#if COIN_ONE_ETA_COPY
+  }
+#endif
+  if (numberDense_) {
+    denseArea_ = new double[numberDense_ * numberDense_];
+    denseAreaAddress_ = denseArea_;
+    densePermute_ = new int[numberDense_];
+  }
+  elementR_ = elementL_.array() + lengthL_;
+  indexRowR_ = indexRowL_.array() + lengthL_;
+  lengthAreaR_ = lengthAreaL_ - lengthL_;
+  // sections must be as this build would write them
+  char *address[COIN_SNAPSHOT_SECTIONS];
+  size_t sectionLength[COIN_SNAPSHOT_SECTIONS];
+  snapshotSections(address, sectionLength, std::max(rowExtent, 0));
+  const CoinUInt64 *directory = reinterpret_cast< const CoinUInt64 * >(buffer + get);
+  int returnCode = 0;
+  for (int i = 0; i < COIN_SNAPSHOT_SECTIONS; i++) {
+    size_t offset = static_cast< size_t >(directory[2 * i]);
+    size_t bytes = static_cast< size_t >(directory[2 * i + 1]);
+    if (bytes != sectionLength[i] || offset > header.length
+      || bytes > header.length - offset)
+      returnCode = 3;
+    else if (bytes && !returnCode)
+      memcpy(address[i], buffer + offset, bytes);
+  }
+  setupPointers();
+  if (returnCode) {
+    // leave as if new
+    gutsOfDestructor(2);
+    gutsOfInitialize(3);
+    return returnCode;
+  }
+  clearReachCache();
+  if (sparseThreshold_)
+    goSparse();
+  return 0;
+}
+// Saves snapshot on file
+int CoinFactorization::saveSnapshot(const char *file) const
+{
+  size_t length = snapshotLength();
+  // CoinUInt64 so buffer is aligned
+  std::vector< CoinUInt64 > buffer(length >> 3);
+  writeSnapshot(reinterpret_cast< char * >(&buffer[0]));
+  FILE *fp = fopen(file, "wb");
+  if (!fp)
+    return 1;
+  int returnCode = fwrite(&buffer[0], length, 1, fp) != 1 ? 1 : 0;
+  if (fclose(fp))
+    returnCode = 1;
+  return returnCode;
+}
+// Restores from snapshot on file
+int CoinFactorization::restoreSnapshot(const char *file)
+{
+  FILE *fp = fopen(file, "rb");
+  if (!fp)
+    return 4;
+  CoinSnapshotHeader header;
+  if (fread(&header, sizeof(header), 1, fp) != 1) {
+    fclose(fp);
+    return 1;
+  }
+  if (memcmp(header.magic, snapshotMagic, 8) || header.version != COIN_SNAPSHOT_VERSION
+    || (header.length & 7) != 0 || header.length < sizeof(header)) {
+    fclose(fp);
+    return 1;
+  }
+  // length is not trusted until it is known file has that much
+  long fileSize = -1;
+  if (!fseek(fp, 0, SEEK_END))
+    fileSize = ftell(fp);
+  if (fileSize < 0 || header.length > static_cast< CoinUInt64 >(fileSize)
+    || fseek(fp, sizeof(header), SEEK_SET)) {
+    fclose(fp);
+    return 3;
+  }
+  size_t length = static_cast< size_t >(header.length);
+  std::vector< CoinUInt64 > buffer(length >> 3);
+  memcpy(&buffer[0], &header, sizeof(header));
+  size_t rest = length - sizeof(header);
+  int returnCode = 0;
+  if (rest && fread(reinterpret_cast< char * >(&buffer[0]) + sizeof(header), rest, 1, fp) != 1)
+    returnCode = 3;
+  fclose(fp);
+  if (!returnCode)
+    returnCode = readSnapshot(reinterpret_cast< const char * >(&buffer[0]), length);
+  return returnCode;
+}
 // See if worth going sparse
 void CoinFactorization::checkSparse()
 {
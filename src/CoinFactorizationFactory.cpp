@@ -0,0 +1,325 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+#include "CoinFactorizationFactory.hpp"
+#include "CoinSimpFactorization.hpp"
+#include "CoinOslFactorization.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+
+// Default constructor
+CoinFactorizationFactory::CoinFactorizationFactory()
+  : goDenseThreshold_(50)
+  , goSmallThreshold_(300)
+  , denseDensity_(0.3)
+  , maximumDenseRows_(1000)
+  , calibrate_(false)
+  , calibrationSolves_(50)
+  , lastChoice_(osl)
+  , numberSingletons_(0)
+  , coreRows_(0)
+  , coreDensity_(0.0)
+  , handler_(new CoinMessageHandler())
+  , defaultHandler_(true)
+  , messages_(CoinMessage())
+{
+  for (int i = 0; i < numberBackends; i++)
+    calibrationTime_[i] = -1.0;
+}
+// Copy constructor
+CoinFactorizationFactory::CoinFactorizationFactory(const CoinFactorizationFactory &rhs)
+  : goDenseThreshold_(rhs.goDenseThreshold_)
+  , goSmallThreshold_(rhs.goSmallThreshold_)
+  , denseDensity_(rhs.denseDensity_)
+  , maximumDenseRows_(rhs.maximumDenseRows_)
+  , calibrate_(rhs.calibrate_)
+  , calibrationSolves_(rhs.calibrationSolves_)
+  , lastChoice_(rhs.lastChoice_)
+  , numberSingletons_(rhs.numberSingletons_)
+  , coreRows_(rhs.coreRows_)
+  , coreDensity_(rhs.coreDensity_)
+  , handler_(rhs.defaultHandler_ ? new CoinMessageHandler(*rhs.handler_) : rhs.handler_)
+  , defaultHandler_(rhs.defaultHandler_)
+  , messages_(rhs.messages_)
+{
+  CoinMemcpyN(rhs.calibrationTime_, static_cast< int >(numberBackends),
+    calibrationTime_);
+}
+// Assignment operator
+CoinFactorizationFactory &
+CoinFactorizationFactory::operator=(const CoinFactorizationFactory &rhs)
+{
+  if (this != &rhs) {
+    goDenseThreshold_ = rhs.goDenseThreshold_;
+    goSmallThreshold_ = rhs.goSmallThreshold_;
+    denseDensity_ = rhs.denseDensity_;
+    maximumDenseRows_ = rhs.maximumDenseRows_;
+    calibrate_ = rhs.calibrate_;
+    calibrationSolves_ = rhs.calibrationSolves_;
+    lastChoice_ = rhs.lastChoice_;
+    numberSingletons_ = rhs.numberSingletons_;
+    coreRows_ = rhs.coreRows_;
+    coreDensity_ = rhs.coreDensity_;
+    CoinMemcpyN(rhs.calibrationTime_, static_cast< int >(numberBackends),
+      calibrationTime_);
+    if (defaultHandler_)
+      delete handler_;
+    defaultHandler_ = rhs.defaultHandler_;
+    handler_ = defaultHandler_ ? new CoinMessageHandler(*rhs.handler_) : rhs.handler_;
+    messages_ = rhs.messages_;
+  }
+  return *this;
+}
+// Destructor
+CoinFactorizationFactory::~CoinFactorizationFactory()
+{
+  if (defaultHandler_)
+    delete handler_;
+}
+// Pass in message handler
+void CoinFactorizationFactory::passInMessageHandler(CoinMessageHandler *handler)
+{
+  if (defaultHandler_)
+    delete handler_;
+  defaultHandler_ = false;
+  handler_ = handler;
+}
+// Name of backend
+const char *CoinFactorizationFactory::backendName(int backend)
+{
+  static const char *names[] = { "dense", "simple", "osl" };
+  return (backend >= 0 && backend < numberBackends) ? names[backend] : "unknown";
+}
+// Makes a new (empty) factorization of given backend
+CoinOtherFactorization *CoinFactorizationFactory::newFactorization(int backend)
+{
+  switch (backend) {
+  case dense:
+    return new CoinDenseFactorization();
+  case simple:
+    return new CoinSimpFactorization();
+  default:
+    return new CoinOslFactorization();
+  }
+}
+// Loads basis into factorization and factorizes
+int CoinFactorizationFactory::factorize(CoinOtherFactorization *factorization,
+  const CoinPackedMatrix &basis, int *pivotVariable)
+{
+  if (!basis.isColOrdered()) {
+    CoinPackedMatrix columnCopy;
+    columnCopy.reverseOrderedCopyOf(basis);
+    return factorize(factorization, columnCopy, pivotVariable);
+  }
+  int numberRows = basis.getNumRows();
+  int numberColumns = basis.getNumCols();
+  assert(numberRows == numberColumns);
+  const CoinBigIndex *columnStart = basis.getVectorStarts();
+  const int *columnLength = basis.getVectorLengths();
+  const int *row = basis.getIndices();
+  const double *element = basis.getElements();
+  int numberElements = 0;
+  for (int i = 0; i < numberColumns; i++)
+    numberElements += columnLength[i];
+  int status = -99;
+  // backends increase space themselves after -99
+  for (int tries = 0; status == -99 && tries < 10; tries++) {
+    factorization->setStatus(-99);
+    factorization->getAreas(numberRows, numberColumns, numberElements,
+      2 * numberElements);
+    CoinFactorizationDouble2 *elementU = factorization->elements();
+    int *indexRowU = factorization->indices();
+    int *startColumnU = factorization->starts();
+    int *numberInRow = factorization->numberInRow();
+    int *numberInColumn = factorization->numberInColumn();
+    CoinZeroN(numberInRow, numberRows);
+    CoinZeroN(numberInColumn, numberColumns);
+    int put = 0;
+    for (int i = 0; i < numberColumns; i++) {
+      startColumnU[i] = put;
+      for (CoinBigIndex j = columnStart[i]; j < columnStart[i] + columnLength[i]; j++) {
+        if (element[j]) {
+          int iRow = row[j];
+          indexRowU[put] = iRow;
+          elementU[put++] = element[j];
+          numberInRow[iRow]++;
+        }
+      }
+      numberInColumn[i] = put - startColumnU[i];
+    }
+    startColumnU[numberColumns] = put;
+    factorization->preProcess();
+    factorization->factor();
+    status = factorization->status();
+  }
+  if (!status) {
+    std::vector< int > sequence(numberRows);
+    std::vector< int > pivot(numberRows);
+    for (int i = 0; i < numberRows; i++)
+      sequence[i] = i;
+    if (!pivotVariable)
+      pivotVariable = numberRows ? &pivot[0] : NULL;
+    factorization->postProcess(numberRows ? &sequence[0] : NULL, pivotVariable);
+  }
+  return status;
+}
+// Looks at structure of basis
+void CoinFactorizationFactory::analyze(const CoinPackedMatrix &basis)
+{
+  int numberRows = basis.getNumRows();
+  int numberColumns = basis.getNumCols();
+  const CoinBigIndex *columnStart = basis.getVectorStarts();
+  const int *columnLength = basis.getVectorLengths();
+  const int *row = basis.getIndices();
+  std::vector< int > rowCount(numberRows, 0);
+  // 1 if row taken by singleton column, 2 if row singleton
+  std::vector< char > rowTaken(numberRows, 0);
+  int numberColumnSingletons = 0;
+  for (int i = 0; i < numberColumns; i++) {
+    CoinBigIndex start = columnStart[i];
+    for (CoinBigIndex j = start; j < start + columnLength[i]; j++)
+      rowCount[row[j]]++;
+    if (columnLength[i] == 1 && !rowTaken[row[start]]) {
+      rowTaken[row[start]] = 1;
+      numberColumnSingletons++;
+    }
+  }
+  int numberRowSingletons = 0;
+  for (int i = 0; i < numberRows; i++) {
+    if (rowCount[i] == 1 && !rowTaken[i]) {
+      rowTaken[i] = 2;
+      numberRowSingletons++;
+    }
+  }
+  numberSingletons_ = numberColumnSingletons + numberRowSingletons;
+  coreRows_ = std::max(numberRows - numberSingletons_, 0);
+  double coreElements = 0.0;
+  for (int i = 0; i < numberColumns; i++) {
+    if (columnLength[i] > 1) {
+      CoinBigIndex start = columnStart[i];
+      for (CoinBigIndex j = start; j < start + columnLength[i]; j++) {
+        if (!rowTaken[row[j]])
+          coreElements++;
+      }
+    }
+  }
+  coreDensity_ = coreRows_ ? coreElements / (static_cast< double >(coreRows_) * coreRows_) : 0.0;
+}
+// Chooses by structure
+CoinFactorizationFactory::Backend
+CoinFactorizationFactory::chooseByStructure() const
+{
+  int numberRows = numberSingletons_ + coreRows_;
+  if (numberRows <= goDenseThreshold_)
+    return dense;
+  else if (numberRows <= maximumDenseRows_ && coreDensity_ >= denseDensity_)
+    return dense;
+  else if (numberRows <= goSmallThreshold_ && numberRows <= maximumDenseRows_)
+    return simple;
+  else
+    return osl;
+}
+// Times backends on basis and returns fastest
+CoinFactorizationFactory::Backend
+CoinFactorizationFactory::chooseByTiming(const CoinPackedMatrix &basis)
+{
+  Backend best = chooseByStructure();
+  int numberRows = basis.getNumRows();
+  const CoinBigIndex *columnStart = basis.getVectorStarts();
+  const int *columnLength = basis.getVectorLengths();
+  const int *row = basis.getIndices();
+  const double *element = basis.getElements();
+  CoinIndexedVector region;
+  CoinIndexedVector work;
+  region.reserve(2 * numberRows + 10);
+  work.reserve(2 * numberRows + 10);
+  // time a few solves and scale up
+  int numberSolves = std::max(std::min(calibrationSolves_, 10), 1);
+  for (int backend = 0; backend < numberBackends; backend++) {
+    calibrationTime_[backend] = -1.0;
+    if (backend != osl && numberRows > maximumDenseRows_)
+      continue;
+    CoinOtherFactorization *factorization = newFactorization(backend);
+    double startTime = CoinCpuTime();
+    int status = factorize(factorization, basis, NULL);
+    double factorTime = CoinCpuTime() - startTime;
+    if (!status && numberRows) {
+      startTime = CoinCpuTime();
+      for (int k = 0; k < numberSolves; k++) {
+        int iColumn = (k * 97) % numberRows;
+        region.clear();
+        for (CoinBigIndex j = columnStart[iColumn];
+             j < columnStart[iColumn] + columnLength[iColumn]; j++)
+          region.quickAdd(row[j], element[j]);
+        factorization->updateColumn(&work, &region);
+        region.clear();
+        region.insert((k * 89) % numberRows, 1.0);
+        factorization->updateColumnTranspose(&work, &region);
+      }
+      double solveTime = (CoinCpuTime() - startTime) / numberSolves;
+      calibrationTime_[backend] = factorTime + calibrationSolves_ * solveTime;
+    }
+    delete factorization;
+  }
+  // structural choice wins ties (times may be too small to measure)
+  for (int backend = 0; backend < numberBackends; backend++) {
+    if (calibrationTime_[backend] < 0.0)
+      continue;
+    if (calibrationTime_[best] < 0.0 || calibrationTime_[backend] < calibrationTime_[best])
+      best = static_cast< Backend >(backend);
+  }
+  region.clear();
+  return best;
+}
+// Logs choice
+void CoinFactorizationFactory::logChoice(const CoinPackedMatrix &basis) const
+{
+  char line[200];
+  sprintf(line, "Factorization backend %s chosen for %d rows with %d elements - %d singletons, core of %d rows with density %g",
+    backendName(lastChoice_), basis.getNumRows(),
+    static_cast< int >(basis.getNumElements()), numberSingletons_,
+    coreRows_, coreDensity_);
+  handler_->message(COIN_GENERAL_INFO, messages_) << line << CoinMessageEol;
+  if (calibrate_) {
+    sprintf(line, "Calibration times - dense %g, simple %g, osl %g",
+      calibrationTime_[dense], calibrationTime_[simple], calibrationTime_[osl]);
+    handler_->message(COIN_GENERAL_INFO, messages_) << line << CoinMessageEol;
+  }
+}
+// Chooses backend for basis
+CoinFactorizationFactory::Backend
+CoinFactorizationFactory::choose(const CoinPackedMatrix &basis)
+{
+  if (!basis.isColOrdered()) {
+    CoinPackedMatrix columnCopy;
+    columnCopy.reverseOrderedCopyOf(basis);
+    return choose(columnCopy);
+  }
+  analyze(basis);
+  for (int i = 0; i < numberBackends; i++)
+    calibrationTime_[i] = -1.0;
+  if (calibrate_)
+    lastChoice_ = chooseByTiming(basis);
+  else
+    lastChoice_ = chooseByStructure();
+  logChoice(basis);
+  return lastChoice_;
+}
+// Chooses backend for basis, makes it and factorizes basis
+CoinOtherFactorization *
+CoinFactorizationFactory::factorization(const CoinPackedMatrix &basis,
+  int *pivotVariable)
+{
+  CoinOtherFactorization *model = newFactorization(choose(basis));
+  factorize(model, basis, pivotVariable);
+  return model;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
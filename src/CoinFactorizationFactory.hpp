@@ -0,0 +1,228 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinFactorizationFactory_H
+#define CoinFactorizationFactory_H
+
+#include "CoinUtilsConfig.h"
+#include "CoinMessageHandler.hpp"
+#include "CoinMessage.hpp"
+#include "CoinDenseFactorization.hpp"
+
+class CoinPackedMatrix;
+
+/** Chooses and makes a CoinOtherFactorization for a basis.
+
+    CoinDenseFactorization is fastest for small or dense bases,
+    CoinSimpFactorization for moderate ones and CoinOslFactorization for
+    large sparse ones.  The factory looks at the size of the basis, how
+    many columns and rows are singletons and how dense the rest (the
+    core) is, and picks one - following the thresholds below in the same
+    way as goDenseOrSmall in Clp.  If calibrate is set it instead
+    factorizes the basis with each backend which could be used and times
+    that together with some solves, picking the fastest.
+
+    The choice, and why, is logged through the message handler at log
+    level 1 and is also available afterwards.  CoinFactorization itself
+    is not a CoinOtherFactorization so can not be chosen - for very large
+    bases CoinOslFactorization takes its place.
+*/
+class COINUTILSLIB_EXPORT CoinFactorizationFactory {
+
+public:
+  /// Backends which may be chosen
+  enum Backend {
+    dense = 0,
+    simple,
+    osl,
+    numberBackends
+  };
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinFactorizationFactory();
+  /// Copy constructor
+  CoinFactorizationFactory(const CoinFactorizationFactory &rhs);
+  /// Assignment operator
+  CoinFactorizationFactory &operator=(const CoinFactorizationFactory &rhs);
+  /// Destructor
+  ~CoinFactorizationFactory();
+  //@}
+
+  /**@name Making factorizations */
+  //@{
+  /** Chooses backend for square column ordered basis.
+      Calibrates if calibrate is set (and then basis must be
+      non-singular for a fair comparison). */
+  Backend choose(const CoinPackedMatrix &basis);
+  /** Chooses backend for basis, makes it and factorizes basis.
+      Caller owns the result - status() is that of factorization.
+      If pivotVariable not NULL it is set to the column pivoted on
+      each row (see factorize). */
+  CoinOtherFactorization *factorization(const CoinPackedMatrix &basis,
+    int *pivotVariable = NULL);
+  /// Makes a new (empty) factorization of given backend
+  static CoinOtherFactorization *newFactorization(int backend);
+  /** Loads basis into factorization and factorizes, returning status
+      (0 okay, -1 singular).  If okay pivotVariable (which can be NULL)
+      has the column of basis for each row - so after FTRAN entry i is
+      the value for column pivotVariable[i]. */
+  static int factorize(CoinOtherFactorization *factorization,
+    const CoinPackedMatrix &basis, int *pivotVariable);
+  /// Name of backend
+  static const char *backendName(int backend);
+  //@}
+
+  /**@name Thresholds */
+  //@{
+  /// Dense backend if number of rows no more than this
+  inline int goDenseThreshold() const
+  {
+    return goDenseThreshold_;
+  }
+  /// Set dense threshold
+  inline void setGoDenseThreshold(int value)
+  {
+    goDenseThreshold_ = value;
+  }
+  /// Simple backend if number of rows no more than this
+  inline int goSmallThreshold() const
+  {
+    return goSmallThreshold_;
+  }
+  /// Set small threshold
+  inline void setGoSmallThreshold(int value)
+  {
+    goSmallThreshold_ = value;
+  }
+  /// Dense backend if core at least this dense (and rows no more than maximumDenseRows)
+  inline double denseDensity() const
+  {
+    return denseDensity_;
+  }
+  /// Set dense density
+  inline void setDenseDensity(double value)
+  {
+    denseDensity_ = value;
+  }
+  /// Largest basis for dense or simple backends (they need rows squared space)
+  inline int maximumDenseRows() const
+  {
+    return maximumDenseRows_;
+  }
+  /// Set largest basis for dense or simple backends
+  inline void setMaximumDenseRows(int value)
+  {
+    maximumDenseRows_ = value;
+  }
+  /// Whether to choose by timing backends
+  inline bool calibrate() const
+  {
+    return calibrate_;
+  }
+  /// Set whether to choose by timing backends
+  inline void setCalibrate(bool yes)
+  {
+    calibrate_ = yes;
+  }
+  /** Number of solves (FTRAN and BTRAN) expected per factorization.
+      When calibrating a backend's time is that of factorization plus
+      this many solves. */
+  inline int calibrationSolves() const
+  {
+    return calibrationSolves_;
+  }
+  /// Set number of solves expected per factorization
+  inline void setCalibrationSolves(int value)
+  {
+    calibrationSolves_ = value;
+  }
+  //@}
+
+  /**@name Last choice */
+  //@{
+  /// Backend chosen last time
+  inline Backend lastChoice() const
+  {
+    return lastChoice_;
+  }
+  /// Number of singleton columns (including slacks) and rows in last basis
+  inline int numberSingletons() const
+  {
+    return numberSingletons_;
+  }
+  /// Number of rows left after taking out singletons
+  inline int coreRows() const
+  {
+    return coreRows_;
+  }
+  /// Density of core
+  inline double coreDensity() const
+  {
+    return coreDensity_;
+  }
+  /** Time taken by backend when calibrating (factorization plus
+      calibrationSolves solves) - negative if not tried. */
+  inline double calibrationTime(int backend) const
+  {
+    return calibrationTime_[backend];
+  }
+  //@}
+
+  /**@name Message handling */
+  //@{
+  /** Pass in message handler.
+      It will not be destroyed when the factory is. */
+  void passInMessageHandler(CoinMessageHandler *handler);
+  /// Return the message handler
+  inline CoinMessageHandler *messageHandler() const
+  {
+    return handler_;
+  }
+  //@}
+
+private:
+  /// Looks at structure of basis
+  void analyze(const CoinPackedMatrix &basis);
+  /// Chooses by structure
+  Backend chooseByStructure() const;
+  /// Times backends on basis and returns fastest
+  Backend chooseByTiming(const CoinPackedMatrix &basis);
+  /// Logs choice
+  void logChoice(const CoinPackedMatrix &basis) const;
+
+  /// Dense threshold
+  int goDenseThreshold_;
+  /// Small threshold
+  int goSmallThreshold_;
+  /// Dense density
+  double denseDensity_;
+  /// Largest basis for dense or simple
+  int maximumDenseRows_;
+  /// Whether to calibrate
+  bool calibrate_;
+  /// Solves per factorization when calibrating
+  int calibrationSolves_;
+  /// Last choice
+  Backend lastChoice_;
+  /// Singletons in last basis
+  int numberSingletons_;
+  /// Rows in core of last basis
+  int coreRows_;
+  /// Density of core of last basis
+  double coreDensity_;
+  /// Times when calibrating
+  double calibrationTime_[numberBackends];
+  /// Message handler
+  CoinMessageHandler *handler_;
+  /// Whether handler is ours
+  bool defaultHandler_;
+  /// Messages
+  CoinMessages messages_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,116 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+#include <cstdio>
+#include <algorithm>
+#include "CoinFactorizationStatistics.hpp"
+#include "CoinHelperFunctions.hpp"
+
+// Default constructor
+CoinFactorizationStatistics::CoinFactorizationStatistics()
+  : timeSolves_(false)
+{
+  reset();
+}
+// Sets all counts and times to zero
+void CoinFactorizationStatistics::reset()
+{
+  phase_ = singletons;
+  phaseStart_ = 0.0;
+  CoinZeroN(calls_, static_cast< int >(numberPhases));
+  CoinZeroN(time_, static_cast< int >(numberPhases));
+  CoinZeroN(work_, static_cast< int >(numberPhases));
+  CoinZeroN(&method_[0][0], 15);
+  numberFactorizations_ = 0.0;
+  numberFailedFactorizations_ = 0.0;
+  basisElements_ = 0.0;
+  thisBasisElements_ = 0.0;
+  factorElements_ = 0.0;
+  largestFill_ = 0.0;
+  numberRejectedUpdates_ = 0.0;
+  largestUpdateGrowth_ = 0.0;
+}
+// Name of phase
+const char *CoinFactorizationStatistics::phaseName(int phase)
+{
+  static const char *names[] = { "singletons", "markowitz", "dense",
+    "ftranL", "ftranR", "ftranU", "btranU", "btranR", "btranL", "update" };
+  return (phase >= 0 && phase < numberPhases) ? names[phase] : "unknown";
+}
+// Prints summary and a line for each phase
+void CoinFactorizationStatistics::print() const
+{
+  printf("%g factorizations (%g failed), %g basis elements, %g factor elements, largest fill %g\n",
+    numberFactorizations_, numberFailedFactorizations_, basisElements_,
+    factorElements_, largestFill_);
+  printf("%g updates (%g rejected), largest growth from updates %g\n",
+    calls_[update], numberRejectedUpdates_, largestUpdateGrowth_);
+  printf("%-12s %12s %12s %14s %12s\n", "phase", "calls", "time", "work",
+    "average");
+  for (int i = 0; i < numberPhases; i++) {
+    printf("%-12s %12g %12g %14g %12g\n", phaseName(i), calls_[i], time_[i],
+      work_[i], calls_[i] ? work_[i] / calls_[i] : 0.0);
+  }
+  static const char *which[] = { "ftranL", "ftranU", "btranU", "btranR",
+    "btranL" };
+  printf("%-12s %12s %12s %12s\n", "methods", "densish", "sparsish",
+    "sparse");
+  for (int i = 0; i < 5; i++)
+    printf("%-12s %12g %12g %12g\n", which[i], method_[i][0], method_[i][1],
+      method_[i][2]);
+}
+// Start of factorization of basis with numberElements
+void CoinFactorizationStatistics::startFactorization(int numberElements)
+{
+  numberFactorizations_++;
+  thisBasisElements_ = numberElements;
+  basisElements_ += numberElements;
+  phase_ = singletons;
+  phaseStart_ = CoinCpuTime();
+}
+// Moves to new factorization phase
+void CoinFactorizationStatistics::startPhase(int phase)
+{
+  double now = CoinCpuTime();
+  time_[phase_] += now - phaseStart_;
+  phase_ = phase;
+  phaseStart_ = now;
+}
+// Start of dense factorization of numberDense rows
+void CoinFactorizationStatistics::startDense(int numberDense)
+{
+  startPhase(dense);
+  calls_[dense]++;
+  double n = numberDense;
+  work_[dense] += n * n * n / 3.0;
+}
+// End of factorization with elements in factors
+void CoinFactorizationStatistics::endFactorization(int status,
+  int numberElements)
+{
+  double now = CoinCpuTime();
+  time_[phase_] += now - phaseStart_;
+  phase_ = singletons;
+  if (status) {
+    numberFailedFactorizations_++;
+  } else {
+    factorElements_ += numberElements;
+    if (thisBasisElements_)
+      largestFill_ = std::max(largestFill_, numberElements / thisBasisElements_);
+  }
+}
+// End of update
+void CoinFactorizationStatistics::endUpdate(int status, int numberElements,
+  int factorElements, double startTime)
+{
+  endSolve(update, numberElements, startTime);
+  if (status)
+    numberRejectedUpdates_++;
+  if (factorElements)
+    largestUpdateGrowth_ = std::max(largestUpdateGrowth_,
+      static_cast< double >(numberElements) / factorElements);
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,229 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinFactorizationStatistics_H
+#define CoinFactorizationStatistics_H
+
+#include "CoinUtilsConfig.h"
+#include "CoinTime.hpp"
+
+/** Counts and times for a CoinFactorization.
+
+    Kept by every CoinFactorization (see CoinFactorization::statistics)
+    and so always available.  For each phase of factorization and solve
+    it records the number of calls, the time taken and a measure of work -
+    multiply-adds for the phases of factorization and nonzeros at the end
+    of each part of a solve.  It also counts which method (densish,
+    sparsish or sparse) each part of a solve used, the Forrest-Tomlin
+    updates and how much the basis filled in.
+
+    Factorizations are always timed as that takes a few calls per
+    factorization.  Solves and updates are only timed if setTimeSolves is
+    on, as timing would then cost about as much as a very sparse solve.
+    Everything is reset by reset (or CoinFactorization::resetStatistics)
+    and can be printed by print.
+*/
+class COINUTILSLIB_EXPORT CoinFactorizationStatistics {
+
+public:
+  /// Phases recorded
+  enum Phase {
+    /// Slacks and singletons up to first pivot needing elimination
+    singletons = 0,
+    /// Rest of sparse factorization
+    markowitz,
+    /// Dense tail
+    dense,
+    /// FTRAN on L (including any dense part)
+    ftranL,
+    /// FTRAN on R etas
+    ftranR,
+    /// FTRAN on U
+    ftranU,
+    /// BTRAN on U
+    btranU,
+    /// BTRAN on R etas
+    btranR,
+    /// BTRAN on L (including any dense part)
+    btranL,
+    /// Forrest-Tomlin update (replaceColumn)
+    update,
+    numberPhases
+  };
+
+  /**@name Constructors */
+  //@{
+  /// Default constructor - all zero and solves not timed
+  CoinFactorizationStatistics();
+  //@}
+
+  /**@name Reset and print */
+  //@{
+  /// Sets all counts and times to zero (keeps setTimeSolves)
+  void reset();
+  /// Prints summary and a line for each phase
+  void print() const;
+  /// Name of phase
+  static const char *phaseName(int phase);
+  //@}
+
+  /**@name Settings */
+  //@{
+  /// Whether solves and updates are timed
+  inline bool timeSolves() const
+  {
+    return timeSolves_;
+  }
+  /// Sets whether solves and updates are timed
+  inline void setTimeSolves(bool yes)
+  {
+    timeSolves_ = yes;
+  }
+  //@}
+
+  /**@name Results */
+  //@{
+  /// Number of times phase done
+  inline double calls(int phase) const
+  {
+    return calls_[phase];
+  }
+  /// Seconds spent in phase (solves and updates only if timed)
+  inline double time(int phase) const
+  {
+    return time_[phase];
+  }
+  /// Multiply-adds (factorization) or nonzeros after (solves) in phase
+  inline double work(int phase) const
+  {
+    return work_[phase];
+  }
+  /** Number of times a part of a solve used a method.
+      which - 0 FTRAN L, 1 FTRAN U, 2 BTRAN U, 3 BTRAN R, 4 BTRAN L.
+      method - 0 densish, 1 sparsish, 2 sparse (R has no sparsish).
+  */
+  inline double numberMethod(int which, int method) const
+  {
+    return method_[which][method];
+  }
+  /// Number of factorizations
+  inline double numberFactorizations() const
+  {
+    return numberFactorizations_;
+  }
+  /// Number of factorizations which failed (singular or no memory)
+  inline double numberFailedFactorizations() const
+  {
+    return numberFailedFactorizations_;
+  }
+  /// Elements in bases given to factorizations
+  inline double basisElements() const
+  {
+    return basisElements_;
+  }
+  /// Elements in L, U and dense part after good factorizations
+  inline double factorElements() const
+  {
+    return factorElements_;
+  }
+  /// Largest ratio of factor elements to basis elements
+  inline double largestFill() const
+  {
+    return largestFill_;
+  }
+  /// Number of updates which were rejected (replaceColumn not 0)
+  inline double numberRejectedUpdates() const
+  {
+    return numberRejectedUpdates_;
+  }
+  /// Largest ratio of elements after updates to those after factorization
+  inline double largestUpdateGrowth() const
+  {
+    return largestUpdateGrowth_;
+  }
+  //@}
+
+  /**@name Recording - used by CoinFactorization */
+  //@{
+  /// Start of factorization of basis with numberElements
+  void startFactorization(int numberElements);
+  /// Sparse pivot with numberDoRow other entries in row and numberDoColumn in column
+  inline void pivot(int numberDoRow, int numberDoColumn)
+  {
+    if (numberDoRow && numberDoColumn) {
+      if (phase_ == singletons)
+        startPhase(markowitz);
+      calls_[markowitz]++;
+      work_[markowitz] += static_cast< double >(numberDoRow) * numberDoColumn;
+    } else {
+      calls_[phase_]++;
+      work_[phase_] += numberDoColumn;
+    }
+  }
+  /// Start of dense factorization of numberDense rows
+  void startDense(int numberDense);
+  /// End of factorization with elements in factors
+  void endFactorization(int status, int numberElements);
+  /// Start of solve or update - returns time if timing
+  inline double startSolve() const
+  {
+    return timeSolves_ ? CoinCpuTime() : 0.0;
+  }
+  /// End of part of solve with number nonzero
+  inline void endSolve(int phase, int number, double startTime)
+  {
+    calls_[phase]++;
+    work_[phase] += number;
+    if (timeSolves_)
+      time_[phase] += CoinCpuTime() - startTime;
+  }
+  /// Part of solve used method
+  inline void addMethod(int which, int method)
+  {
+    method_[which][method]++;
+  }
+  /// End of update with status and elements now and after factorization
+  void endUpdate(int status, int numberElements, int factorElements,
+    double startTime);
+  //@}
+
+private:
+  /// Moves to new factorization phase
+  void startPhase(int phase);
+
+  /// Whether solves are timed
+  bool timeSolves_;
+  /// Factorization phase now
+  int phase_;
+  /// Time phase started
+  double phaseStart_;
+  /// Calls by phase
+  double calls_[numberPhases];
+  /// Time by phase
+  double time_[numberPhases];
+  /// Work by phase
+  double work_[numberPhases];
+  /// Methods used by parts of solves
+  double method_[5][3];
+  /// Factorizations
+  double numberFactorizations_;
+  /// Failed factorizations
+  double numberFailedFactorizations_;
+  /// Elements in bases
+  double basisElements_;
+  /// Elements in this basis
+  double thisBasisElements_;
+  /// Elements in factors
+  double factorElements_;
+  /// Largest fill
+  double largestFill_;
+  /// Rejected updates
+  double numberRejectedUpdates_;
+  /// Largest growth by updates
+  double largestUpdateGrowth_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
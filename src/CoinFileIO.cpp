@@ -12,6 +12,7 @@
 #include "CoinError.hpp"
 #include "CoinHelperFunctions.hpp"
 
+#include <atomic>
 #include <vector>
 #include <cstring>
 
@@ -99,6 +100,79 @@ char *CoinPlainFileInput::gets(char *buffer, int size)
 #endif
 }
 
+// ------ Input for plain text using mmap ------
+
+#if defined(__unix__) || defined(__APPLE__)
+#define COIN_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+CoinMappedFileInput::CoinMappedFileInput(const std::string &fileName)
+  : CoinFileInput(fileName)
+  , data_(NULL)
+  , size_(0)
+  , position_(0)
+{
+  readType_ = "plain";
+#ifdef COIN_HAS_MMAP
+  int fd = open(fileName.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd >= 0 && !fstat(fd, &info) && S_ISREG(info.st_mode) && info.st_size > 0) {
+    size_ = static_cast< size_t >(info.st_size);
+    void *address = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED) {
+      data_ = reinterpret_cast< const char * >(address);
+#ifdef MADV_SEQUENTIAL
+      madvise(address, size_, MADV_SEQUENTIAL);
+#endif
+    }
+  }
+  if (fd >= 0)
+    close(fd);
+#endif
+  if (!data_)
+    throw CoinError("Could not map file for reading!",
+      "CoinMappedFileInput",
+      "CoinMappedFileInput");
+}
+
+CoinMappedFileInput::~CoinMappedFileInput()
+{
+#ifdef COIN_HAS_MMAP
+  if (data_)
+    munmap(const_cast< char * >(data_), size_);
+#endif
+}
+
+int CoinMappedFileInput::read(void *buffer, int size)
+{
+  if (size <= 0)
+    return 0;
+  size_t n = CoinMin(static_cast< size_t >(size), size_ - position_);
+  CoinMemcpyN(data_ + position_, n, static_cast< char * >(buffer));
+  position_ += n;
+  return static_cast< int >(n);
+}
+
+char *CoinMappedFileInput::gets(char *buffer, int size)
+{
+  // same as fgets
+  if (size <= 0 || position_ == size_)
+    return 0;
+  const char *start = data_ + position_;
+  size_t n = CoinMin(static_cast< size_t >(size - 1), size_ - position_);
+  const char *newLine = static_cast< const char * >(memchr(start, '\n', n));
+  if (newLine)
+    n = newLine - start + 1;
+  memcpy(buffer, start, n);
+  buffer[n] = '\0';
+  position_ += n;
+  return buffer;
+}
+
 // ------ helper class supporting buffered gets -------
 
 // This is a CoinFileInput class to handle cases, where the gets method
@@ -337,6 +411,24 @@ bool CoinFileInput::haveBzip2Support()
 #endif
 }
 
+// process-wide, read by create (see setMappedInput)
+static std::atomic< bool > mappedInput(true);
+
+/// indicates whether CoinFileInput can memory map plain files
+bool CoinFileInput::haveMmapSupport()
+{
+#ifdef COIN_HAS_MMAP
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CoinFileInput::setMappedInput(bool yesNo)
+{
+  mappedInput = yesNo;
+}
+
 CoinFileInput *CoinFileInput::create(const std::string &fileName)
 {
   // first try to open file, and read first bytes
@@ -380,6 +472,15 @@ CoinFileInput *CoinFileInput::create(const std::string &fileName)
   }
 
   // fallback: probably plain text file
+#ifdef COIN_HAS_MMAP
+  if (mappedInput && fileName != "stdin") {
+    // empty files, pipes etc can not be mapped
+    try {
+      return new CoinMappedFileInput(fileName);
+    } catch (CoinError &) {
+    }
+  }
+#endif
   return new CoinPlainFileInput(fileName);
 }
 
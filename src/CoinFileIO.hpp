@@ -46,11 +46,24 @@ public:
   static bool haveGzipSupport();
   /// indicates whether CoinFileInput supports bzip2'ed files
   static bool haveBzip2Support();
+  /// indicates whether CoinFileInput can memory map plain files
+  static bool haveMmapSupport();
+  /** Whether create should memory map plain files (default true
+      if supported).  Mapping avoids copying through stdio buffers and lets
+      readers look at the whole file in place (see CoinMappedFileInput).
+
+      This is one process-wide switch, not a per-reader option.  Setting it
+      is atomic, but it is only looked at when create opens a file, so a
+      reader already open keeps the input it got.  Threads that need
+      different settings must not share it.
+  */
+  static void setMappedInput(bool yesNo);
 
   /// Factory method, that creates a CoinFileInput (more precisely
   /// a subclass of it) for the file specified. This method reads the
   /// first few bytes of the file and determines if this is a compressed
   /// or a plain file and returns the correct subclass to handle it.
+  /// Plain files are memory mapped if possible (see setMappedInput).
   /// If the file does not exist or uses a compression not compiled in
   /// an exception is thrown.
   /// @param fileName The file that should be read.
@@ -97,6 +110,57 @@ private:
   FILE *f_;
 };
 
+/** This reads plain text files by mapping them into memory.
+
+    read and gets behave exactly as for CoinPlainFileInput but copy
+    straight from the mapped pages.  The whole file is also available as
+    one contiguous read-only block (data(), size()), so a reader can
+    tokenize in place and move the read position itself.  At present only
+    the parallel COLUMNS reader of CoinMpsIO does that; the serial MPS
+    reader and CoinLpIO still take one line at a time through gets (a copy
+    from the mapped pages, without stdio buffering).  Only available
+    where mmap is (see CoinFileInput::haveMmapSupport); otherwise the
+    constructor throws.
+*/
+class COINUTILSLIB_EXPORT CoinMappedFileInput : public CoinFileInput {
+public:
+  CoinMappedFileInput(const std::string &fileName);
+  virtual ~CoinMappedFileInput();
+
+  virtual int read(void *buffer, int size);
+
+  virtual char *gets(char *buffer, int size);
+
+  /// Whole file (not null terminated)
+  inline const char *data() const
+  {
+    return data_;
+  }
+  /// Size of file in bytes
+  inline size_t size() const
+  {
+    return size_;
+  }
+  /// Offset of next character to be read
+  inline size_t position() const
+  {
+    return position_;
+  }
+  /// Set offset of next character to be read
+  inline void setPosition(size_t position)
+  {
+    position_ = position < size_ ? position : size_;
+  }
+
+private:
+  CoinMappedFileInput();
+  CoinMappedFileInput(const CoinMappedFileInput &);
+
+  const char *data_;
+  size_t size_;
+  size_t position_;
+};
+
 /// Abstract base class for file output classes.
 class COINUTILSLIB_EXPORT CoinFileOutput: public CoinFileIOBase
 {
@@ -0,0 +1,611 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+#include "CoinHelperFunctions.hpp"
+
+#include <atomic>
+#include <cmath>
+
+/*
+  Vector versions of dense kernels.  They are compiled with target
+  attributes so the library itself can still be built for (and run on)
+  any x86 processor; which version is used is decided at run time.
+*/
+#if !defined(COIN_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+  && ((defined(__clang__) && __clang_major__ >= 4) \
+    || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 7))
+#define COIN_SIMD_X86
+#include <immintrin.h>
+/*
+  avx512f brings in fma, so multiplies and adds must not be contracted
+  or element by element kernels would not match plain loops.
+*/
+#ifdef __clang__
+#pragma STDC FP_CONTRACT OFF
+#define COIN_TARGET_AVX2 __attribute__((target("avx2")))
+#define COIN_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define COIN_TARGET_AVX2 __attribute__((target("avx2"), optimize("fp-contract=off")))
+#define COIN_TARGET_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+#endif
+#endif
+
+// -1 until first use - kernels may first be called from worker threads
+static std::atomic< int > simdLevel(-1);
+
+int CoinSimdLevelAvailable()
+{
+#ifdef COIN_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return COIN_SIMD_AVX512;
+  else if (__builtin_cpu_supports("avx2"))
+    return COIN_SIMD_AVX2;
+#endif
+  return COIN_SIMD_SCALAR;
+}
+
+int CoinSimdLevel()
+{
+  int level = simdLevel.load(std::memory_order_relaxed);
+  if (level < 0) {
+    // racing threads all find the same answer
+    level = CoinSimdLevelAvailable();
+    simdLevel.store(level, std::memory_order_relaxed);
+  }
+  return level;
+}
+
+int CoinSetSimdLevel(int level)
+{
+  int available = CoinSimdLevelAvailable();
+  if (level < 0 || level > available)
+    level = available;
+  simdLevel.store(level, std::memory_order_relaxed);
+  return level;
+}
+
+#ifdef COIN_SIMD_X86
+//-------------------------------------------------------------------
+// AVX2
+//-------------------------------------------------------------------
+COIN_TARGET_AVX2 static void
+fillAvx2(double *to, CoinBigIndex size, double value)
+{
+  __m256d v = _mm256_set1_pd(value);
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_pd(to + i, v);
+    _mm256_storeu_pd(to + i + 4, v);
+  }
+  for (; i < size; i++)
+    to[i] = value;
+}
+
+COIN_TARGET_AVX2 static double
+dotAvx2(const double *x, const double *y, CoinBigIndex size)
+{
+  __m256d sum0 = _mm256_setzero_pd();
+  __m256d sum1 = _mm256_setzero_pd();
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8) {
+    sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+  }
+  double part[4];
+  _mm256_storeu_pd(part, _mm256_add_pd(sum0, sum1));
+  double value = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; i < size; i++)
+    value += x[i] * y[i];
+  return value;
+}
+
+COIN_TARGET_AVX2 static void
+axpyAvx2(double alpha, const double *x, CoinBigIndex size, double *y)
+{
+  __m256d a = _mm256_set1_pd(alpha);
+  CoinBigIndex i = 0;
+  for (; i + 4 <= size; i += 4) {
+    // multiply and add separately so answers are same as scalar code
+    __m256d product = _mm256_mul_pd(a, _mm256_loadu_pd(x + i));
+    _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), product));
+  }
+  for (; i < size; i++)
+    y[i] += alpha * x[i];
+}
+
+COIN_TARGET_AVX2 static void
+scaledCopyAvx2(const double *from, CoinBigIndex size, double scale, double *to)
+{
+  __m256d s = _mm256_set1_pd(scale);
+  CoinBigIndex i = 0;
+  for (; i + 4 <= size; i += 4)
+    _mm256_storeu_pd(to + i, _mm256_mul_pd(s, _mm256_loadu_pd(from + i)));
+  for (; i < size; i++)
+    to[i] = scale * from[i];
+}
+
+/* dense[which[0..3]].  Masked form with zero source as plain gather
+   leaves source undefined (and so gives warnings). */
+COIN_TARGET_AVX2 static inline __m256d
+gatherAvx2(const double *dense, __m128i which)
+{
+  return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), dense, which,
+    _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+}
+
+COIN_TARGET_AVX2 static double
+gatherDotAvx2(const double *element, const int *index, CoinBigIndex size,
+  const double *dense)
+{
+  __m256d sum0 = _mm256_setzero_pd();
+  __m256d sum1 = _mm256_setzero_pd();
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m128i which0 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i));
+    __m128i which1 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i + 4));
+    sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(_mm256_loadu_pd(element + i), gatherAvx2(dense, which0)));
+    sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(_mm256_loadu_pd(element + i + 4), gatherAvx2(dense, which1)));
+  }
+  double part[4];
+  _mm256_storeu_pd(part, _mm256_add_pd(sum0, sum1));
+  double value = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; i < size; i++)
+    value += element[i] * dense[index[i]];
+  return value;
+}
+
+COIN_TARGET_AVX2 static void
+scatterAxpyAvx2(double alpha, const double *element, const int *index,
+  CoinBigIndex size, double *dense)
+{
+  __m256d a = _mm256_set1_pd(alpha);
+  CoinBigIndex i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m128i which = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i));
+    __m256d product = _mm256_mul_pd(a, _mm256_loadu_pd(element + i));
+    double value[4];
+    _mm256_storeu_pd(value, _mm256_add_pd(gatherAvx2(dense, which), product));
+    // no scatter in AVX2
+    dense[index[i]] = value[0];
+    dense[index[i + 1]] = value[1];
+    dense[index[i + 2]] = value[2];
+    dense[index[i + 3]] = value[3];
+  }
+  for (; i < size; i++)
+    dense[index[i]] += alpha * element[i];
+}
+
+COIN_TARGET_AVX2 static void
+gatherAxpyAvx2(double alpha, const double *dense, const int *index,
+  CoinBigIndex size, double *element)
+{
+  __m256d a = _mm256_set1_pd(alpha);
+  CoinBigIndex i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m128i which = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i));
+    __m256d product = _mm256_mul_pd(a, gatherAvx2(dense, which));
+    _mm256_storeu_pd(element + i, _mm256_add_pd(_mm256_loadu_pd(element + i), product));
+  }
+  for (; i < size; i++)
+    element[i] += alpha * dense[index[i]];
+}
+
+COIN_TARGET_AVX2 static double
+sumAvx2(const double *x, CoinBigIndex size, bool absolute)
+{
+  // clearing sign bit gives absolute value
+  __m256d mask = absolute ? _mm256_set1_pd(-0.0) : _mm256_setzero_pd();
+  __m256d sum0 = _mm256_setzero_pd();
+  __m256d sum1 = _mm256_setzero_pd();
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8) {
+    sum0 = _mm256_add_pd(sum0, _mm256_andnot_pd(mask, _mm256_loadu_pd(x + i)));
+    sum1 = _mm256_add_pd(sum1, _mm256_andnot_pd(mask, _mm256_loadu_pd(x + i + 4)));
+  }
+  double part[4];
+  _mm256_storeu_pd(part, _mm256_add_pd(sum0, sum1));
+  double value = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; i < size; i++)
+    value += absolute ? fabs(x[i]) : x[i];
+  return value;
+}
+
+COIN_TARGET_AVX2 static double
+maxAbsAvx2(const double *x, CoinBigIndex size)
+{
+  __m256d mask = _mm256_set1_pd(-0.0);
+  __m256d max0 = _mm256_setzero_pd();
+  __m256d max1 = _mm256_setzero_pd();
+  CoinBigIndex i = 0;
+  // NaN in first operand gives second so NaNs are ignored as in scalar code
+  for (; i + 8 <= size; i += 8) {
+    max0 = _mm256_max_pd(_mm256_andnot_pd(mask, _mm256_loadu_pd(x + i)), max0);
+    max1 = _mm256_max_pd(_mm256_andnot_pd(mask, _mm256_loadu_pd(x + i + 4)), max1);
+  }
+  double part[4];
+  _mm256_storeu_pd(part, _mm256_max_pd(max0, max1));
+  double value = CoinMax(CoinMax(part[0], part[1]), CoinMax(part[2], part[3]));
+  for (; i < size; i++) {
+    // written so NaN compares false and is ignored
+    double absValue = fabs(x[i]);
+    if (absValue > value)
+      value = absValue;
+  }
+  return value;
+}
+
+//-------------------------------------------------------------------
+// AVX-512
+//-------------------------------------------------------------------
+COIN_TARGET_AVX512 static void
+fillAvx512(double *to, CoinBigIndex size, double value)
+{
+  __m512d v = _mm512_set1_pd(value);
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8)
+    _mm512_storeu_pd(to + i, v);
+  for (; i < size; i++)
+    to[i] = value;
+}
+
+/* Sum of the eight entries.  Done by hand as _mm512_reduce_add_pd
+   works on undefined registers (and so gives warnings). */
+COIN_TARGET_AVX512 static inline double
+reduceAddAvx512(__m512d v)
+{
+  double part[8];
+  _mm512_storeu_pd(part, v);
+  return ((part[0] + part[1]) + (part[2] + part[3]))
+    + ((part[4] + part[5]) + (part[6] + part[7]));
+}
+
+COIN_TARGET_AVX512 static double
+dotAvx512(const double *x, const double *y, CoinBigIndex size)
+{
+  __m512d sum0 = _mm512_setzero_pd();
+  __m512d sum1 = _mm512_setzero_pd();
+  CoinBigIndex i = 0;
+  for (; i + 16 <= size; i += 16) {
+    sum0 = _mm512_add_pd(sum0, _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    sum1 = _mm512_add_pd(sum1, _mm512_mul_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8)));
+  }
+  double value = reduceAddAvx512(_mm512_add_pd(sum0, sum1));
+  for (; i < size; i++)
+    value += x[i] * y[i];
+  return value;
+}
+
+COIN_TARGET_AVX512 static double
+sumAvx512(const double *x, CoinBigIndex size, bool absolute)
+{
+  __m512d sum0 = _mm512_setzero_pd();
+  __m512d sum1 = _mm512_setzero_pd();
+  CoinBigIndex i = 0;
+  if (absolute) {
+    for (; i + 16 <= size; i += 16) {
+      sum0 = _mm512_add_pd(sum0, _mm512_abs_pd(_mm512_loadu_pd(x + i)));
+      sum1 = _mm512_add_pd(sum1, _mm512_abs_pd(_mm512_loadu_pd(x + i + 8)));
+    }
+  } else {
+    for (; i + 16 <= size; i += 16) {
+      sum0 = _mm512_add_pd(sum0, _mm512_loadu_pd(x + i));
+      sum1 = _mm512_add_pd(sum1, _mm512_loadu_pd(x + i + 8));
+    }
+  }
+  double value = reduceAddAvx512(_mm512_add_pd(sum0, sum1));
+  for (; i < size; i++)
+    value += absolute ? fabs(x[i]) : x[i];
+  return value;
+}
+
+COIN_TARGET_AVX512 static double
+maxAbsAvx512(const double *x, CoinBigIndex size)
+{
+  __m512d max0 = _mm512_setzero_pd();
+  __m512d max1 = _mm512_setzero_pd();
+  CoinBigIndex i = 0;
+  /* NaN in first operand gives second so NaNs are ignored as in scalar code.
+     Zero masked forms as plain ones pass undefined registers. */
+  for (; i + 16 <= size; i += 16) {
+    max0 = _mm512_maskz_max_pd(0xff, _mm512_abs_pd(_mm512_loadu_pd(x + i)), max0);
+    max1 = _mm512_maskz_max_pd(0xff, _mm512_abs_pd(_mm512_loadu_pd(x + i + 8)), max1);
+  }
+  double part[8];
+  _mm512_storeu_pd(part, _mm512_maskz_max_pd(0xff, max0, max1));
+  double value = CoinMax(CoinMax(CoinMax(part[0], part[1]), CoinMax(part[2], part[3])),
+    CoinMax(CoinMax(part[4], part[5]), CoinMax(part[6], part[7])));
+  for (; i < size; i++) {
+    // written so NaN compares false and is ignored
+    double absValue = fabs(x[i]);
+    if (absValue > value)
+      value = absValue;
+  }
+  return value;
+}
+
+COIN_TARGET_AVX512 static void
+axpyAvx512(double alpha, const double *x, CoinBigIndex size, double *y)
+{
+  __m512d a = _mm512_set1_pd(alpha);
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m512d product = _mm512_mul_pd(a, _mm512_loadu_pd(x + i));
+    _mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), product));
+  }
+  for (; i < size; i++)
+    y[i] += alpha * x[i];
+}
+
+COIN_TARGET_AVX512 static void
+scaledCopyAvx512(const double *from, CoinBigIndex size, double scale, double *to)
+{
+  __m512d s = _mm512_set1_pd(scale);
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8)
+    _mm512_storeu_pd(to + i, _mm512_mul_pd(s, _mm512_loadu_pd(from + i)));
+  for (; i < size; i++)
+    to[i] = scale * from[i];
+}
+
+// dense[which[0..7]] - see gatherAvx2
+COIN_TARGET_AVX512 static inline __m512d
+gatherAvx512(const double *dense, __m256i which)
+{
+  return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, which, dense, 8);
+}
+
+COIN_TARGET_AVX512 static double
+gatherDotAvx512(const double *element, const int *index, CoinBigIndex size,
+  const double *dense)
+{
+  __m512d sum0 = _mm512_setzero_pd();
+  __m512d sum1 = _mm512_setzero_pd();
+  CoinBigIndex i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m256i which0 = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(index + i));
+    __m256i which1 = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(index + i + 8));
+    sum0 = _mm512_add_pd(sum0, _mm512_mul_pd(_mm512_loadu_pd(element + i), gatherAvx512(dense, which0)));
+    sum1 = _mm512_add_pd(sum1, _mm512_mul_pd(_mm512_loadu_pd(element + i + 8), gatherAvx512(dense, which1)));
+  }
+  double value = reduceAddAvx512(_mm512_add_pd(sum0, sum1));
+  for (; i < size; i++)
+    value += element[i] * dense[index[i]];
+  return value;
+}
+
+COIN_TARGET_AVX512 static void
+scatterAxpyAvx512(double alpha, const double *element, const int *index,
+  CoinBigIndex size, double *dense)
+{
+  __m512d a = _mm512_set1_pd(alpha);
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i which = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(index + i));
+    __m512d product = _mm512_mul_pd(a, _mm512_loadu_pd(element + i));
+    _mm512_i32scatter_pd(dense, which,
+      _mm512_add_pd(gatherAvx512(dense, which), product), 8);
+  }
+  for (; i < size; i++)
+    dense[index[i]] += alpha * element[i];
+}
+
+COIN_TARGET_AVX512 static void
+gatherAxpyAvx512(double alpha, const double *dense, const int *index,
+  CoinBigIndex size, double *element)
+{
+  __m512d a = _mm512_set1_pd(alpha);
+  CoinBigIndex i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i which = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(index + i));
+    __m512d product = _mm512_mul_pd(a, gatherAvx512(dense, which));
+    _mm512_storeu_pd(element + i, _mm512_add_pd(_mm512_loadu_pd(element + i), product));
+  }
+  for (; i < size; i++)
+    element[i] += alpha * dense[index[i]];
+}
+#endif
+
+//-------------------------------------------------------------------
+// Entry points
+//-------------------------------------------------------------------
+// Short vectors are not worth the call overhead of vector code
+#define COIN_SIMD_MINIMUM 8
+
+void CoinFillN(double *to, const CoinBigIndex size, const double value)
+{
+#ifndef NDEBUG
+  if (size < 0)
+    throw CoinError("trying to fill negative number of entries",
+      "CoinFillN", "");
+#endif
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512) {
+      fillAvx512(to, size, value);
+      return;
+    } else if (level == COIN_SIMD_AVX2) {
+      fillAvx2(to, size, value);
+      return;
+    }
+  }
+#endif
+  for (CoinBigIndex i = 0; i < size; i++)
+    to[i] = value;
+}
+
+double CoinDotProductN(const double *x, const double *y, const CoinBigIndex size)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return dotAvx512(x, y, size);
+    else if (level == COIN_SIMD_AVX2)
+      return dotAvx2(x, y, size);
+  }
+#endif
+  double value = 0.0;
+  for (CoinBigIndex i = 0; i < size; i++)
+    value += x[i] * y[i];
+  return value;
+}
+
+double CoinSumOfSquaresN(const double *x, const CoinBigIndex size)
+{
+  return CoinDotProductN(x, x, size);
+}
+
+double CoinSumN(const double *x, const CoinBigIndex size)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return sumAvx512(x, size, false);
+    else if (level == COIN_SIMD_AVX2)
+      return sumAvx2(x, size, false);
+  }
+#endif
+  double value = 0.0;
+  for (CoinBigIndex i = 0; i < size; i++)
+    value += x[i];
+  return value;
+}
+
+double CoinAbsSumN(const double *x, const CoinBigIndex size)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return sumAvx512(x, size, true);
+    else if (level == COIN_SIMD_AVX2)
+      return sumAvx2(x, size, true);
+  }
+#endif
+  double value = 0.0;
+  for (CoinBigIndex i = 0; i < size; i++)
+    value += fabs(x[i]);
+  return value;
+}
+
+double CoinMaxAbsN(const double *x, const CoinBigIndex size)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return maxAbsAvx512(x, size);
+    else if (level == COIN_SIMD_AVX2)
+      return maxAbsAvx2(x, size);
+  }
+#endif
+  double value = 0.0;
+  for (CoinBigIndex i = 0; i < size; i++) {
+    // NaN compares false so is ignored as in vector versions
+    double absValue = fabs(x[i]);
+    if (absValue > value)
+      value = absValue;
+  }
+  return value;
+}
+
+void CoinAxpyN(const double alpha, const double *x, const CoinBigIndex size,
+  double *y)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512) {
+      axpyAvx512(alpha, x, size, y);
+      return;
+    } else if (level == COIN_SIMD_AVX2) {
+      axpyAvx2(alpha, x, size, y);
+      return;
+    }
+  }
+#endif
+  for (CoinBigIndex i = 0; i < size; i++)
+    y[i] += alpha * x[i];
+}
+
+void CoinScaledCopyN(const double *from, const CoinBigIndex size,
+  const double scale, double *to)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512) {
+      scaledCopyAvx512(from, size, scale, to);
+      return;
+    } else if (level == COIN_SIMD_AVX2) {
+      scaledCopyAvx2(from, size, scale, to);
+      return;
+    }
+  }
+#endif
+  for (CoinBigIndex i = 0; i < size; i++)
+    to[i] = scale * from[i];
+}
+
+double CoinGatherDotN(const double *element, const int *index,
+  const CoinBigIndex size, const double *dense)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return gatherDotAvx512(element, index, size, dense);
+    else if (level == COIN_SIMD_AVX2)
+      return gatherDotAvx2(element, index, size, dense);
+  }
+#endif
+  double value = 0.0;
+  for (CoinBigIndex i = 0; i < size; i++)
+    value += element[i] * dense[index[i]];
+  return value;
+}
+
+void CoinScatterAxpyN(const double alpha, const double *element,
+  const int *index, const CoinBigIndex size, double *dense)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512) {
+      scatterAxpyAvx512(alpha, element, index, size, dense);
+      return;
+    } else if (level == COIN_SIMD_AVX2) {
+      scatterAxpyAvx2(alpha, element, index, size, dense);
+      return;
+    }
+  }
+#endif
+  for (CoinBigIndex i = 0; i < size; i++)
+    dense[index[i]] += alpha * element[i];
+}
+
+void CoinGatherAxpyN(const double alpha, const double *dense,
+  const int *index, const CoinBigIndex size, double *element)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512) {
+      gatherAxpyAvx512(alpha, dense, index, size, element);
+      return;
+    } else if (level == COIN_SIMD_AVX2) {
+      gatherAxpyAvx2(alpha, dense, index, size, element);
+      return;
+    }
+  }
+#endif
+  for (CoinBigIndex i = 0; i < size; i++)
+    element[i] += alpha * dense[index[i]];
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
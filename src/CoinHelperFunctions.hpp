@@ -19,6 +19,7 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <algorithm>
 #include "CoinTypes.h"
 #include "CoinError.hpp"
@@ -376,6 +377,23 @@ CoinMemcpyN(const T *COIN_RESTRICT from, CoinByteArray size, T *COIN_RESTRICT to
 }
 #endif
 
+/** Version of CoinMemcpyN for doubles.  This goes straight to memcpy which
+    the C library already implements with the widest instructions the
+    processor has. */
+inline void
+CoinMemcpyN(const double *from, const CoinByteArray size, double *to)
+{
+  if (size == 0 || from == to)
+    return;
+#ifndef NDEBUG
+  if (size < 0)
+    throw CoinError("trying to copy negative number of entries",
+      "CoinMemcpyN", "");
+#endif
+  if (size > 0)
+    std::memcpy(to, from, size * sizeof(double));
+}
+
 //-----------------------------------------------------------------------------
 
 /** This helper function copies an array to another location. The two arrays
@@ -473,6 +491,11 @@ CoinFillN(T *to, const CoinBigIndex size, const T value)
 #endif
 }
 
+/** Version of CoinFillN for doubles using vector instructions chosen at
+    run time (see CoinSimdLevel). */
+COINUTILSLIB_EXPORT void
+CoinFillN(double *to, const CoinBigIndex size, const double value);
+
 //-----------------------------------------------------------------------------
 
 /** This helper function fills an array with a given value. For speed 8
@@ -571,6 +594,20 @@ CoinZeroN(T *to, const CoinBigIndex size)
 #endif
 #endif
 }
+/** Version of CoinZeroN for doubles.  This goes straight to memset which
+    the C library already implements with the widest instructions the
+    processor has. */
+inline void
+CoinZeroN(double *to, const CoinBigIndex size)
+{
+#ifndef NDEBUG
+  if (size < 0)
+    throw CoinError("trying to fill negative number of entries",
+      "CoinZeroN", "");
+#endif
+  if (size > 0)
+    memset(to, 0, size * sizeof(double));
+}
 /// This Debug helper function checks an array is all zero
 inline void
 CoinCheckDoubleZero(double *to, const CoinBigIndex size)
@@ -615,6 +652,75 @@ CoinZero(T *first, T *last)
 
 //#############################################################################
 
+/**@name Dense double kernels
+
+   These use AVX2 or AVX-512 when the processor (and compiler) support them
+   and plain loops otherwise.  The choice is made on first use and may be
+   lowered with CoinSetSimdLevel.  Element by element kernels (CoinFillN,
+   CoinAxpyN, CoinScaledCopyN, CoinScatterAxpyN, CoinGatherAxpyN) give
+   exactly the same answers at every level; the reductions add in a
+   different order so may differ in the last bits from a plain loop (but
+   are repeatable for a given level).
+*/
+//@{
+/// No vector instructions
+#define COIN_SIMD_SCALAR 0
+/// AVX2 (4 doubles at a time)
+#define COIN_SIMD_AVX2 1
+/// AVX-512 (8 doubles at a time)
+#define COIN_SIMD_AVX512 2
+/// Level used by kernels
+COINUTILSLIB_EXPORT int CoinSimdLevel();
+/// Best level this processor and build support
+COINUTILSLIB_EXPORT int CoinSimdLevelAvailable();
+/** Set level used by kernels - negative means best available and values
+    above CoinSimdLevelAvailable() are reduced to it.  Returns level set.
+    Not to be called while another thread is using the kernels. */
+COINUTILSLIB_EXPORT int CoinSetSimdLevel(int level);
+/// Returns sum of x[i]*y[i]
+COINUTILSLIB_EXPORT double
+CoinDotProductN(const double *x, const double *y, const CoinBigIndex size);
+/// Returns sum of x[i]*x[i] (square of two norm)
+COINUTILSLIB_EXPORT double
+CoinSumOfSquaresN(const double *x, const CoinBigIndex size);
+/// Returns sum of x[i]
+COINUTILSLIB_EXPORT double
+CoinSumN(const double *x, const CoinBigIndex size);
+/// Returns sum of fabs(x[i]) (one norm)
+COINUTILSLIB_EXPORT double
+CoinAbsSumN(const double *x, const CoinBigIndex size);
+/** Returns largest fabs(x[i]) (infinity norm) - 0.0 if size is 0.
+    NaNs are ignored (so all NaN gives 0.0).  Exactly same at every
+    level. */
+COINUTILSLIB_EXPORT double
+CoinMaxAbsN(const double *x, const CoinBigIndex size);
+/// y[i] += alpha*x[i]
+COINUTILSLIB_EXPORT void
+CoinAxpyN(const double alpha, const double *x, const CoinBigIndex size,
+  double *y);
+/// to[i] = scale*from[i] - arrays must not overlap unless equal
+COINUTILSLIB_EXPORT void
+CoinScaledCopyN(const double *from, const CoinBigIndex size,
+  const double scale, double *to);
+/** Returns sum of element[i]*dense[index[i]] - as in a packed
+    vector times a full vector. */
+COINUTILSLIB_EXPORT double
+CoinGatherDotN(const double *element, const int *index,
+  const CoinBigIndex size, const double *dense);
+/** dense[index[i]] += alpha*element[i] - as in adding a multiple of a
+    packed vector to a full vector.  Entries of index must be different. */
+COINUTILSLIB_EXPORT void
+CoinScatterAxpyN(const double alpha, const double *element,
+  const int *index, const CoinBigIndex size, double *dense);
+/** element[i] += alpha*dense[index[i]] - as in adding a multiple of a
+    full vector to a packed vector. */
+COINUTILSLIB_EXPORT void
+CoinGatherAxpyN(const double alpha, const double *dense, const int *index,
+  const CoinBigIndex size, double *element);
+//@}
+
+//#############################################################################
+
 /** Returns strdup or NULL if original NULL */
 inline char *CoinStrdup(const char *name)
 {
@@ -7,6 +7,7 @@
 #pragma warning(disable : 4786)
 #endif
 
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 
@@ -14,6 +15,486 @@
 #include "CoinFloatEqual.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinIndexedVector.hpp"
+#include "CoinThreadPool.hpp"
+
+// Same conditions as vector kernels in CoinHelperFunctions.cpp
+#if !defined(COIN_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+  && ((defined(__clang__) && __clang_major__ >= 4) \
+    || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 7))
+#define COIN_SIMD_X86
+#include <immintrin.h>
+#define COIN_TARGET_AVX2 __attribute__((target("avx2")))
+#define COIN_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+// Shorter scans are not worth the call overhead of vector code
+#define COIN_INDEXED_SIMD_MINIMUM 32
+
+/*
+  Scans and cleans.  Vector versions test a block of entries at once with
+  the same comparisons as the plain loops (so NaN and -0.0 are treated
+  alike) and write indices and values in the same order, so results are
+  identical at every level (see CoinSimdLevel).
+*/
+#ifdef COIN_SIMD_X86
+//-------------------------------------------------------------------
+// AVX2 - no compress store so set bits of mask are walked
+//-------------------------------------------------------------------
+// Bits for nonzeros of four doubles
+COIN_TARGET_AVX2 static inline int
+nonZeroBitsAvx2(__m256d value)
+{
+  return _mm256_movemask_pd(_mm256_cmp_pd(value, _mm256_setzero_pd(), _CMP_NEQ_UQ));
+}
+// Bits for four doubles with absolute value >= tolerance
+COIN_TARGET_AVX2 static inline int
+bigBitsAvx2(__m256d value, __m256d tolerance)
+{
+  __m256d absValue = _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+  return _mm256_movemask_pd(_mm256_cmp_pd(absValue, tolerance, _CMP_GE_OQ));
+}
+
+COIN_TARGET_AVX2 static int
+scanAvx2(double *elements, int start, int end, double tolerance,
+  bool useTolerance, int *index)
+{
+  __m256d tol = _mm256_set1_pd(tolerance);
+  int number = 0;
+  int i = start;
+  for (; i + 8 <= end; i += 8) {
+    __m256d value0 = _mm256_loadu_pd(elements + i);
+    __m256d value1 = _mm256_loadu_pd(elements + i + 4);
+    int nonZero = nonZeroBitsAvx2(value0) | (nonZeroBitsAvx2(value1) << 4);
+    if (nonZero) {
+      int keep = nonZero;
+      if (useTolerance) {
+        keep &= bigBitsAvx2(value0, tol) | (bigBitsAvx2(value1, tol) << 4);
+        int small = nonZero & ~keep;
+        for (; small; small &= small - 1)
+          elements[i + __builtin_ctz(small)] = 0.0;
+      }
+      for (; keep; keep &= keep - 1)
+        index[number++] = i + __builtin_ctz(keep);
+    }
+  }
+  for (; i < end; i++) {
+    double value = elements[i];
+    if (value) {
+      if (!useTolerance || fabs(value) >= tolerance)
+        index[number++] = i;
+      else
+        elements[i] = 0.0;
+    }
+  }
+  return number;
+}
+
+COIN_TARGET_AVX2 static int
+scanAndPackAvx2(double *elements, int start, int end, double tolerance,
+  bool useTolerance, int *index)
+{
+  __m256d tol = _mm256_set1_pd(tolerance);
+  __m256d zero = _mm256_setzero_pd();
+  int number = 0;
+  int i = start;
+  for (; i + 8 <= end; i += 8) {
+    double value[8];
+    __m256d value0 = _mm256_loadu_pd(elements + i);
+    __m256d value1 = _mm256_loadu_pd(elements + i + 4);
+    int keep;
+    if (useTolerance)
+      keep = bigBitsAvx2(value0, tol) | (bigBitsAvx2(value1, tol) << 4);
+    else
+      keep = nonZeroBitsAvx2(value0) | (nonZeroBitsAvx2(value1) << 4);
+    if (keep) {
+      _mm256_storeu_pd(value, value0);
+      _mm256_storeu_pd(value + 4, value1);
+    }
+    // packed values are never beyond this block
+    _mm256_storeu_pd(elements + i, zero);
+    _mm256_storeu_pd(elements + i + 4, zero);
+    for (; keep; keep &= keep - 1) {
+      int k = __builtin_ctz(keep);
+      elements[number] = value[k];
+      index[number++] = i + k;
+    }
+  }
+  for (; i < end; i++) {
+    double value = elements[i];
+    elements[i] = 0.0;
+    if (useTolerance ? fabs(value) >= tolerance : value != 0.0) {
+      elements[number] = value;
+      index[number++] = i;
+    }
+  }
+  return number;
+}
+
+/* elements[which[0..3]].  Masked form with zero source as plain gather
+   leaves source undefined (and so gives warnings). */
+COIN_TARGET_AVX2 static inline __m256d
+gatherAvx2(const double *elements, __m128i which)
+{
+  return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), elements, which,
+    _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+}
+
+COIN_TARGET_AVX2 static int
+cleanAvx2(double *elements, int *index, int size, double tolerance)
+{
+  __m256d tol = _mm256_set1_pd(tolerance);
+  int number = 0;
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m128i which0 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i));
+    __m128i which1 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i + 4));
+    __m256d value0 = gatherAvx2(elements, which0);
+    __m256d value1 = gatherAvx2(elements, which1);
+    int keep = bigBitsAvx2(value0, tol) | (bigBitsAvx2(value1, tol) << 4);
+    int which[8];
+    _mm_storeu_si128(reinterpret_cast< __m128i * >(which), which0);
+    _mm_storeu_si128(reinterpret_cast< __m128i * >(which + 4), which1);
+    for (int k = 0; k < 8; k++) {
+      if ((keep & (1 << k)) != 0)
+        index[number++] = which[k];
+      else
+        elements[which[k]] = 0.0;
+    }
+  }
+  for (; i < size; i++) {
+    int indexValue = index[i];
+    if (fabs(elements[indexValue]) >= tolerance)
+      index[number++] = indexValue;
+    else
+      elements[indexValue] = 0.0;
+  }
+  return number;
+}
+
+/* Blocks where an index could be overwritten by a packed value before
+   being read are done one at a time as in plain loop. */
+COIN_TARGET_AVX2 static int
+cleanAndPackAvx2(double *elements, int *index, int size, double tolerance)
+{
+  __m256d tol = _mm256_set1_pd(tolerance);
+  int number = 0;
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m128i which0 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i));
+    __m128i which1 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(index + i + 4));
+    __m128i last = _mm_set1_epi32(number + 7);
+    if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi32(which0, last),
+          _mm_cmpgt_epi32(which1, last)))
+      == 0xffff) {
+      __m256d value0 = gatherAvx2(elements, which0);
+      __m256d value1 = gatherAvx2(elements, which1);
+      int keep = bigBitsAvx2(value0, tol) | (bigBitsAvx2(value1, tol) << 4);
+      double value[8];
+      int which[8];
+      _mm256_storeu_pd(value, value0);
+      _mm256_storeu_pd(value + 4, value1);
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(which), which0);
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(which + 4), which1);
+      for (int k = 0; k < 8; k++)
+        elements[which[k]] = 0.0;
+      for (; keep; keep &= keep - 1) {
+        int k = __builtin_ctz(keep);
+        elements[number] = value[k];
+        index[number++] = which[k];
+      }
+    } else {
+      for (int k = i; k < i + 8; k++) {
+        int indexValue = index[k];
+        double value = elements[indexValue];
+        elements[indexValue] = 0.0;
+        if (fabs(value) >= tolerance) {
+          elements[number] = value;
+          index[number++] = indexValue;
+        }
+      }
+    }
+  }
+  for (; i < size; i++) {
+    int indexValue = index[i];
+    double value = elements[indexValue];
+    elements[indexValue] = 0.0;
+    if (fabs(value) >= tolerance) {
+      elements[number] = value;
+      index[number++] = indexValue;
+    }
+  }
+  return number;
+}
+
+//-------------------------------------------------------------------
+// AVX-512 - masks and compress store
+//-------------------------------------------------------------------
+// Mask for nonzeros of eight doubles
+COIN_TARGET_AVX512 static inline __mmask8
+nonZeroMaskAvx512(__m512d value)
+{
+  return _mm512_cmp_pd_mask(value, _mm512_setzero_pd(), _CMP_NEQ_UQ);
+}
+// Mask for eight doubles with absolute value >= tolerance
+COIN_TARGET_AVX512 static inline __mmask8
+bigMaskAvx512(__m512d value, __m512d tolerance)
+{
+  return _mm512_cmp_pd_mask(_mm512_abs_pd(value), tolerance, _CMP_GE_OQ);
+}
+
+COIN_TARGET_AVX512 static int
+scanAvx512(double *elements, int start, int end, double tolerance,
+  bool useTolerance, int *index)
+{
+  __m512d tol = _mm512_set1_pd(tolerance);
+  __m512i sequence = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+    8, 9, 10, 11, 12, 13, 14, 15);
+  int number = 0;
+  int i = start;
+  for (; i + 16 <= end; i += 16) {
+    __m512d value0 = _mm512_loadu_pd(elements + i);
+    __m512d value1 = _mm512_loadu_pd(elements + i + 8);
+    __mmask8 nonZero0 = nonZeroMaskAvx512(value0);
+    __mmask8 nonZero1 = nonZeroMaskAvx512(value1);
+    if (nonZero0 | nonZero1) {
+      __mmask8 keep0 = nonZero0;
+      __mmask8 keep1 = nonZero1;
+      if (useTolerance) {
+        keep0 &= bigMaskAvx512(value0, tol);
+        keep1 &= bigMaskAvx512(value1, tol);
+        _mm512_mask_storeu_pd(elements + i, nonZero0 & ~keep0, _mm512_setzero_pd());
+        _mm512_mask_storeu_pd(elements + i + 8, nonZero1 & ~keep1, _mm512_setzero_pd());
+      }
+      __mmask16 keep = static_cast< __mmask16 >(keep0 | (keep1 << 8));
+      _mm512_mask_compressstoreu_epi32(index + number, keep,
+        _mm512_add_epi32(sequence, _mm512_set1_epi32(i)));
+      number += __builtin_popcount(keep);
+    }
+  }
+  for (; i < end; i++) {
+    double value = elements[i];
+    if (value) {
+      if (!useTolerance || fabs(value) >= tolerance)
+        index[number++] = i;
+      else
+        elements[i] = 0.0;
+    }
+  }
+  return number;
+}
+
+COIN_TARGET_AVX512 static int
+scanAndPackAvx512(double *elements, int start, int end, double tolerance,
+  bool useTolerance, int *index)
+{
+  __m512d tol = _mm512_set1_pd(tolerance);
+  __m512d zero = _mm512_setzero_pd();
+  __m512i sequence = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+    8, 9, 10, 11, 12, 13, 14, 15);
+  int number = 0;
+  int i = start;
+  for (; i + 8 <= end; i += 8) {
+    __m512d value = _mm512_loadu_pd(elements + i);
+    __mmask8 keep = useTolerance ? bigMaskAvx512(value, tol) : nonZeroMaskAvx512(value);
+    // packed values are never beyond this block
+    _mm512_storeu_pd(elements + i, zero);
+    if (keep) {
+      _mm512_mask_compressstoreu_pd(elements + number, keep, value);
+      _mm512_mask_compressstoreu_epi32(index + number, keep,
+        _mm512_add_epi32(sequence, _mm512_set1_epi32(i)));
+      number += __builtin_popcount(keep);
+    }
+  }
+  for (; i < end; i++) {
+    double value = elements[i];
+    elements[i] = 0.0;
+    if (useTolerance ? fabs(value) >= tolerance : value != 0.0) {
+      elements[number] = value;
+      index[number++] = i;
+    }
+  }
+  return number;
+}
+
+// elements[which[0..7]] - see gatherAvx2
+COIN_TARGET_AVX512 static inline __m512d
+gatherAvx512(const double *elements, __m256i which)
+{
+  return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, which, elements, 8);
+}
+
+COIN_TARGET_AVX512 static int
+cleanAvx512(double *elements, int *index, int size, double tolerance)
+{
+  __m512d tol = _mm512_set1_pd(tolerance);
+  __m512d zero = _mm512_setzero_pd();
+  int number = 0;
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i which = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(index + i));
+    __m512d value = gatherAvx512(elements, which);
+    __mmask8 keep = bigMaskAvx512(value, tol);
+    _mm512_mask_i32scatter_pd(elements, static_cast< __mmask8 >(~keep), which, zero, 8);
+    _mm512_mask_compressstoreu_epi32(index + number, keep,
+      _mm512_castsi256_si512(which));
+    number += __builtin_popcount(keep);
+  }
+  for (; i < size; i++) {
+    int indexValue = index[i];
+    if (fabs(elements[indexValue]) >= tolerance)
+      index[number++] = indexValue;
+    else
+      elements[indexValue] = 0.0;
+  }
+  return number;
+}
+
+/* Blocks where an index could be overwritten by a packed value before
+   being read are done one at a time as in plain loop. */
+COIN_TARGET_AVX512 static int
+cleanAndPackAvx512(double *elements, int *index, int size, double tolerance)
+{
+  __m512d tol = _mm512_set1_pd(tolerance);
+  __m512d zero = _mm512_setzero_pd();
+  int number = 0;
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i which = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(index + i));
+    __m256i last = _mm256_set1_epi32(number + 7);
+    if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(which, last)) == -1) {
+      __m512d value = gatherAvx512(elements, which);
+      __mmask8 keep = bigMaskAvx512(value, tol);
+      _mm512_i32scatter_pd(elements, which, zero, 8);
+      _mm512_mask_compressstoreu_pd(elements + number, keep, value);
+      _mm512_mask_compressstoreu_epi32(index + number, keep,
+        _mm512_castsi256_si512(which));
+      number += __builtin_popcount(keep);
+    } else {
+      for (int k = i; k < i + 8; k++) {
+        int indexValue = index[k];
+        double value = elements[indexValue];
+        elements[indexValue] = 0.0;
+        if (fabs(value) >= tolerance) {
+          elements[number] = value;
+          index[number++] = indexValue;
+        }
+      }
+    }
+  }
+  for (; i < size; i++) {
+    int indexValue = index[i];
+    double value = elements[indexValue];
+    elements[indexValue] = 0.0;
+    if (fabs(value) >= tolerance) {
+      elements[number] = value;
+      index[number++] = indexValue;
+    }
+  }
+  return number;
+}
+#endif
+
+// Indices of nonzeros (>= tolerance if useTolerance) in start to < end
+static int scanElements(double *elements, int start, int end, double tolerance,
+  bool useTolerance, int *index)
+{
+#ifdef COIN_SIMD_X86
+  if (end - start >= COIN_INDEXED_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return scanAvx512(elements, start, end, tolerance, useTolerance, index);
+    else if (level == COIN_SIMD_AVX2)
+      return scanAvx2(elements, start, end, tolerance, useTolerance, index);
+  }
+#endif
+  int number = 0;
+  if (!useTolerance) {
+    for (int i = start; i < end; i++)
+      if (elements[i])
+        index[number++] = i;
+  } else {
+    for (int i = start; i < end; i++) {
+      double value = elements[i];
+      if (value) {
+        if (fabs(value) >= tolerance)
+          index[number++] = i;
+        else
+          elements[i] = 0.0;
+      }
+    }
+  }
+  return number;
+}
+// As scanElements but values packed to start of elements and rest zeroed
+static int scanAndPackElements(double *elements, int start, int end,
+  double tolerance, bool useTolerance, int *index)
+{
+#ifdef COIN_SIMD_X86
+  if (end - start >= COIN_INDEXED_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return scanAndPackAvx512(elements, start, end, tolerance, useTolerance, index);
+    else if (level == COIN_SIMD_AVX2)
+      return scanAndPackAvx2(elements, start, end, tolerance, useTolerance, index);
+  }
+#endif
+  int number = 0;
+  for (int i = start; i < end; i++) {
+    double value = elements[i];
+    elements[i] = 0.0;
+    if (useTolerance ? fabs(value) >= tolerance : value != 0.0) {
+      elements[number] = value;
+      index[number++] = i;
+    }
+  }
+  return number;
+}
+// Drops entries of index list below tolerance
+static int cleanElements(double *elements, int *index, int size, double tolerance)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_INDEXED_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return cleanAvx512(elements, index, size, tolerance);
+    else if (level == COIN_SIMD_AVX2)
+      return cleanAvx2(elements, index, size, tolerance);
+  }
+#endif
+  int number = 0;
+  for (int i = 0; i < size; i++) {
+    int indexValue = index[i];
+    if (fabs(elements[indexValue]) >= tolerance)
+      index[number++] = indexValue;
+    else
+      elements[indexValue] = 0.0;
+  }
+  return number;
+}
+// As cleanElements but values packed to start of elements
+static int cleanAndPackElements(double *elements, int *index, int size,
+  double tolerance)
+{
+#ifdef COIN_SIMD_X86
+  if (size >= COIN_INDEXED_SIMD_MINIMUM) {
+    int level = CoinSimdLevel();
+    if (level == COIN_SIMD_AVX512)
+      return cleanAndPackAvx512(elements, index, size, tolerance);
+    else if (level == COIN_SIMD_AVX2)
+      return cleanAndPackAvx2(elements, index, size, tolerance);
+  }
+#endif
+  int number = 0;
+  for (int i = 0; i < size; i++) {
+    int indexValue = index[i];
+    double value = elements[indexValue];
+    elements[indexValue] = 0.0;
+    if (fabs(value) >= tolerance) {
+      elements[number] = value;
+      index[number++] = indexValue;
+    }
+  }
+  return number;
+}
 
 //#############################################################################
 #define WARN_USELESS 0
@@ -36,7 +517,18 @@ void CoinIndexedVector::clear()
       nElements_);
 #endif
   assert(nElements_ <= capacity_);
-  if (!packedMode_) {
+  if (bitmapMode_) {
+    // zero blocks of 32 which have nonzeros
+    int numberWords = (capacity_ + 31) >> 5;
+    for (int iWord = 0; iWord < numberWords; iWord++) {
+      if (nonzeroBits_[iWord]) {
+        nonzeroBits_[iWord] = 0;
+        int first = iWord << 5;
+        CoinZeroN(elements_ + first, std::min(32, capacity_ - first));
+      }
+    }
+    bitmapMode_ = false;
+  } else if (!packedMode_) {
 #ifndef NDEBUG
     for (int i = 0; i < nElements_; i++)
       assert(indices_[i] >= 0 && indices_[i] < capacity_);
@@ -65,6 +557,8 @@ void CoinIndexedVector::clear()
 }
 void CoinIndexedVector::reallyClear()
 {
+  if (bitmapMode_)
+    dropBitmap();
   CoinZeroN(elements_, capacity_);
   nElements_ = 0;
   packedMode_ = false;
@@ -75,6 +569,9 @@ void CoinIndexedVector::empty()
 {
   delete[] indices_;
   indices_ = NULL;
+  delete[] nonzeroBits_;
+  nonzeroBits_ = NULL;
+  bitmapMode_ = false;
   if (elements_)
     delete[](elements_ - offset_);
   elements_ = NULL;
@@ -90,6 +587,8 @@ CoinIndexedVector::operator=(const CoinIndexedVector &rhs)
 {
   if (this != &rhs) {
     clear();
+    if (rhs.bitmapMode_)
+      rhs.rebuildIndices();
     packedMode_ = rhs.packedMode_;
     if (!packedMode_)
       gutsOfSetVector(rhs.capacity_, rhs.nElements_,
@@ -105,6 +604,8 @@ CoinIndexedVector::operator=(const CoinIndexedVector &rhs)
    not re-allocate memory just clears and copies */
 void CoinIndexedVector::copy(const CoinIndexedVector &rhs, double multiplier)
 {
+  if (rhs.bitmapMode_)
+    rhs.rebuildIndices();
   if (capacity_ == rhs.capacity_) {
     // can do fast
     clear();
@@ -165,6 +666,8 @@ void CoinIndexedVector::borrowVector(int size, int numberIndices, int *inds, dou
 
 void CoinIndexedVector::returnVector()
 {
+  if (bitmapMode_)
+    dropBitmap();
   indices_ = NULL;
   elements_ = NULL;
   nElements_ = 0;
@@ -243,6 +746,8 @@ void CoinIndexedVector::setElement(int index, double element)
   if (index < 0)
     throw CoinError("index < 0", "setElement", "CoinIndexedVector");
 #endif
+  if (bitmapMode_)
+    rebuildIndices();
   elements_[indices_[index]] = element;
 }
 
@@ -260,7 +765,13 @@ void CoinIndexedVector::insert(int index, double element)
   if (elements_[index])
     throw CoinError("Index already exists", "insert", "CoinIndexedVector");
 #endif
-  indices_[nElements_++] = index;
+  if (!bitmapMode_) {
+    indices_[nElements_++] = index;
+    if (nElements_ >= denseLimit())
+      startBitmap();
+  } else {
+    markNonzero(index);
+  }
   elements_[index] = element;
 }
 
@@ -282,7 +793,13 @@ void CoinIndexedVector::add(int index, double element)
       elements_[index] = COIN_INDEXED_REALLY_TINY_ELEMENT;
     }
   } else if (fabs(element) >= COIN_INDEXED_TINY_ELEMENT) {
-    indices_[nElements_++] = index;
+    if (!bitmapMode_) {
+      indices_[nElements_++] = index;
+      if (nElements_ >= denseLimit())
+        startBitmap();
+    } else {
+      markNonzero(index);
+    }
     assert(nElements_ <= capacity_);
     elements_[index] = element;
   }
@@ -292,18 +809,10 @@ void CoinIndexedVector::add(int index, double element)
 
 int CoinIndexedVector::clean(double tolerance)
 {
-  int number = nElements_;
-  int i;
-  nElements_ = 0;
+  if (bitmapMode_)
+    rebuildIndices();
   assert(!packedMode_);
-  for (i = 0; i < number; i++) {
-    int indexValue = indices_[i];
-    if (fabs(elements_[indexValue]) >= tolerance) {
-      indices_[nElements_++] = indexValue;
-    } else {
-      elements_[indexValue] = 0.0;
-    }
-  }
+  nElements_ = cleanElements(elements_, indices_, nElements_, tolerance);
   return nElements_;
 }
 #ifndef NDEBUG
@@ -314,6 +823,7 @@ void CoinIndexedVector::checkClear()
 #ifndef NDEBUG
   //printf("checkClear %p\n",this);
   assert(!nElements_);
+  assert(!bitmapMode_);
   //assert(!packedMode_);
   int i;
   for (i = 0; i < capacity_; i++) {
@@ -353,6 +863,8 @@ void CoinIndexedVector::checkClear()
 void CoinIndexedVector::checkClean()
 {
   //printf("checkClean %p\n",this);
+  if (bitmapMode_)
+    rebuildIndices();
   int i;
   if (packedMode_) {
     for (i = 0; i < nElements_; i++)
@@ -397,6 +909,8 @@ void CoinIndexedVector::append(const CoinPackedVectorBase &caboose)
     if (maxIndex < indexValue)
       maxIndex = indexValue;
   }
+  if (bitmapMode_)
+    rebuildIndices();
   reserve(maxIndex + 1);
   bool needClean = false;
   int numberDuplicates = 0;
@@ -447,6 +961,8 @@ void CoinIndexedVector::swap(int i, int j)
 
   // Swap positions i and j of the
   // indices array
+  if (bitmapMode_)
+    rebuildIndices();
 
   int isave = indices_[i];
   indices_[i] = indices_[j];
@@ -465,6 +981,8 @@ void CoinIndexedVector::truncate(int n)
 void CoinIndexedVector::operator+=(double value)
 {
   assert(!packedMode_);
+  if (bitmapMode_)
+    rebuildIndices();
   int i, indexValue;
   for (i = 0; i < nElements_; i++) {
     indexValue = indices_[i];
@@ -481,6 +999,8 @@ void CoinIndexedVector::operator+=(double value)
 void CoinIndexedVector::operator-=(double value)
 {
   assert(!packedMode_);
+  if (bitmapMode_)
+    rebuildIndices();
   int i, indexValue;
   for (i = 0; i < nElements_; i++) {
     indexValue = indices_[i];
@@ -497,6 +1017,8 @@ void CoinIndexedVector::operator-=(double value)
 void CoinIndexedVector::operator*=(double value)
 {
   assert(!packedMode_);
+  if (bitmapMode_)
+    rebuildIndices();
   int i, indexValue;
   for (i = 0; i < nElements_; i++) {
     indexValue = indices_[i];
@@ -513,6 +1035,8 @@ void CoinIndexedVector::operator*=(double value)
 void CoinIndexedVector::operator/=(double value)
 {
   assert(!packedMode_);
+  if (bitmapMode_)
+    rebuildIndices();
   int i, indexValue;
   for (i = 0; i < nElements_; i++) {
     indexValue = indices_[i];
@@ -528,6 +1052,13 @@ void CoinIndexedVector::operator/=(double value)
 void CoinIndexedVector::reserve(int n)
 {
   assert (!packedMode_||!nElements_);
+  if (bitmapMode_)
+    rebuildIndices();
+  if (nonzeroBits_ && n > capacity_) {
+    // bitmap too small - get again when needed
+    delete[] nonzeroBits_;
+    nonzeroBits_ = NULL;
+  }
 #if OLD_COININDEXED_RESERVE_CODE
   /* Code was modified in 2017 to fix a bug
      I can not see justification for the changes then, so going back 
@@ -670,6 +1201,9 @@ CoinIndexedVector::CoinIndexedVector()
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
 }
 
@@ -680,6 +1214,9 @@ CoinIndexedVector::CoinIndexedVector(int size)
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
   // Get space
   reserve(size);
@@ -695,6 +1232,9 @@ CoinIndexedVector::CoinIndexedVector(int size,
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
   gutsOfSetVector(size, inds, elems);
 }
@@ -709,6 +1249,9 @@ CoinIndexedVector::CoinIndexedVector(int size,
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
   gutsOfSetConstant(size, inds, value);
 }
@@ -722,6 +1265,9 @@ CoinIndexedVector::CoinIndexedVector(int size, const double *element)
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
   setFull(size, element);
 }
@@ -735,6 +1281,9 @@ CoinIndexedVector::CoinIndexedVector(const CoinPackedVectorBase &rhs)
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
   gutsOfSetVector(rhs.getNumElements(),
     rhs.getIndices(), rhs.getElements());
@@ -749,7 +1298,13 @@ CoinIndexedVector::CoinIndexedVector(const CoinIndexedVector &rhs)
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
+  if (rhs.bitmapMode_)
+    rhs.rebuildIndices();
+  densityThreshold_ = rhs.densityThreshold_;
   if (!rhs.packedMode_)
     gutsOfSetVector(rhs.capacity_, rhs.nElements_, rhs.indices_, rhs.elements_);
   else
@@ -765,7 +1320,13 @@ CoinIndexedVector::CoinIndexedVector(const CoinIndexedVector *rhs)
   , capacity_(0)
   , offset_(0)
   , packedMode_(false)
+  , bitmapMode_(false)
+  , densityThreshold_(0.0)
+  , nonzeroBits_(NULL)
 {
+  if (rhs->bitmapMode_)
+    rhs->rebuildIndices();
+  densityThreshold_ = rhs->densityThreshold_;
   if (!rhs->packedMode_)
     gutsOfSetVector(rhs->capacity_, rhs->nElements_, rhs->indices_, rhs->elements_);
   else
@@ -777,6 +1338,7 @@ CoinIndexedVector::CoinIndexedVector(const CoinIndexedVector *rhs)
 CoinIndexedVector::~CoinIndexedVector()
 {
   delete[] indices_;
+  delete[] nonzeroBits_;
   if (elements_)
     delete[](elements_ - offset_);
 }
@@ -789,6 +1351,8 @@ CoinIndexedVector::operator+(
   const CoinIndexedVector &op2)
 {
   assert(!packedMode_);
+  if (op2.bitmapMode_)
+    op2.rebuildIndices();
   int i;
   int nElements = nElements_;
   int capacity = std::max(capacity_, op2.capacity_);
@@ -836,6 +1400,8 @@ CoinIndexedVector::operator-(
   const CoinIndexedVector &op2)
 {
   assert(!packedMode_);
+  if (op2.bitmapMode_)
+    op2.rebuildIndices();
   int i;
   int nElements = nElements_;
   int capacity = std::max(capacity_, op2.capacity_);
@@ -883,6 +1449,8 @@ CoinIndexedVector
     const CoinIndexedVector &op2)
 {
   assert(!packedMode_);
+  if (op2.bitmapMode_)
+    op2.rebuildIndices();
   int i;
   int nElements = nElements_;
   int capacity = std::max(capacity_, op2.capacity_);
@@ -927,6 +1495,8 @@ CoinIndexedVector::operator/(const CoinIndexedVector &op2)
 {
   assert(!packedMode_);
   // I am treating 0.0/0.0 as 0.0
+  if (op2.bitmapMode_)
+    op2.rebuildIndices();
   int i;
   int nElements = nElements_;
   int capacity = std::max(capacity_, op2.capacity_);
@@ -996,6 +1566,8 @@ void CoinIndexedVector::operator/=(const CoinIndexedVector &op2)
 //#############################################################################
 void CoinIndexedVector::sortDecrIndex()
 {
+  if (bitmapMode_)
+    rebuildIndices();
   // Should replace with std sort
   double *elements = new double[nElements_];
   CoinZeroN(elements, nElements_);
@@ -1012,6 +1584,8 @@ void CoinIndexedVector::sortPacked()
 
 void CoinIndexedVector::sortIncrElement()
 {
+  if (bitmapMode_)
+    rebuildIndices();
   double *elements = new double[nElements_];
   int i;
   for (i = 0; i < nElements_; i++)
@@ -1023,6 +1597,8 @@ void CoinIndexedVector::sortIncrElement()
 
 void CoinIndexedVector::sortDecrElement()
 {
+  if (bitmapMode_)
+    rebuildIndices();
   double *elements = new double[nElements_];
   int i;
   for (i = 0; i < nElements_; i++)
@@ -1260,6 +1836,8 @@ void CoinIndexedVector::append(const CoinIndexedVector &caboose)
     if (maxIndex < indexValue)
       maxIndex = indexValue;
   }
+  if (bitmapMode_)
+    rebuildIndices();
   reserve(maxIndex + 1);
   bool needClean = false;
   int numberDuplicates = 0;
@@ -1297,6 +1875,10 @@ void CoinIndexedVector::append(const CoinIndexedVector &caboose)
 // Append a CoinIndexedVector to the end and modify indices
 void CoinIndexedVector::append(CoinIndexedVector &other, int adjustIndex, bool zapElements /*,double multiplier*/)
 {
+  if (bitmapMode_)
+    rebuildIndices();
+  if (other.bitmapMode_)
+    other.rebuildIndices();
   const int cs = other.nElements_;
   const int *cind = other.indices_;
   double *celem = other.elements_;
@@ -1502,6 +2084,8 @@ int CoinIndexedVector::isApproximatelyEqual(const CoinIndexedVector &rhs, double
    element of each vector is equal. */
 bool CoinIndexedVector::operator==(const CoinIndexedVector &rhs) const
 {
+  if (rhs.bitmapMode_)
+    rhs.rebuildIndices();
   const int cs = rhs.nElements_;
 
   const int *cind = rhs.indices_;
@@ -1552,6 +2136,8 @@ bool CoinIndexedVector::operator==(const CoinIndexedVector &rhs) const
 /// Not equal
 bool CoinIndexedVector::operator!=(const CoinIndexedVector &rhs) const
 {
+  if (rhs.bitmapMode_)
+    rhs.rebuildIndices();
   const int cs = rhs.nElements_;
 
   const int *cind = rhs.indices_;
@@ -1572,6 +2158,8 @@ bool CoinIndexedVector::operator!=(const CoinIndexedVector &rhs) const
 // Get value of maximum index
 int CoinIndexedVector::getMaxIndex() const
 {
+  if (bitmapMode_)
+    rebuildIndices();
   int maxIndex = -COIN_INT_MAX;
   int i;
   for (i = 0; i < nElements_; i++)
@@ -1581,6 +2169,8 @@ int CoinIndexedVector::getMaxIndex() const
 // Get value of minimum index
 int CoinIndexedVector::getMinIndex() const
 {
+  if (bitmapMode_)
+    rebuildIndices();
   int minIndex = COIN_INT_MAX;
   int i;
   for (i = 0; i < nElements_; i++)
@@ -1590,6 +2180,8 @@ int CoinIndexedVector::getMinIndex() const
 // Scan dense region and set up indices
 int CoinIndexedVector::scan()
 {
+  if (bitmapMode_)
+    dropBitmap();
   nElements_ = 0;
   return scan(0, capacity_);
 }
@@ -1599,18 +2191,18 @@ int CoinIndexedVector::scan(int start, int end)
   assert(!packedMode_);
   end = std::min(end, capacity_);
   start = std::max(start, 0);
-  int i;
-  int number = 0;
-  int *indices = indices_ + nElements_;
-  for (i = start; i < end; i++)
-    if (elements_[i])
-      indices[number++] = i;
+  if (densityThreshold_ > 0.0)
+    return scanTracking(start, end, 0.0);
+  int number = scanElements(elements_, start, end, 0.0, false,
+    indices_ + nElements_);
   nElements_ += number;
   return number;
 }
 // Scan dense region and set up indices with tolerance
 int CoinIndexedVector::scan(double tolerance)
 {
+  if (bitmapMode_)
+    dropBitmap();
   nElements_ = 0;
 #if ABOCA_LITE_FACTORIZATION == 0
   return scan(0, capacity_, tolerance);
@@ -1628,37 +2220,21 @@ int CoinIndexedVector::scan(int start, int end, double tolerance)
   end = std::min(end, capacity_ & 0x7fffffff);
 #endif
   start = std::max(start, 0);
-  int i;
-  int number = 0;
-  int *indices = indices_ + nElements_;
-  for (i = start; i < end; i++) {
-    double value = elements_[i];
-    if (value) {
-      if (fabs(value) >= tolerance)
-        indices[number++] = i;
-      else
-        elements_[i] = 0.0;
-    }
-  }
+  if (densityThreshold_ > 0.0)
+    return scanTracking(start, end, tolerance);
+  int number = scanElements(elements_, start, end, tolerance, true,
+    indices_ + nElements_);
   nElements_ += number;
   return number;
 }
 // These pack down
 int CoinIndexedVector::cleanAndPack(double tolerance)
 {
+  if (bitmapMode_)
+    rebuildIndices();
   if (!packedMode_) {
-    int number = nElements_;
-    int i;
-    nElements_ = 0;
-    for (i = 0; i < number; i++) {
-      int indexValue = indices_[i];
-      double value = elements_[indexValue];
-      elements_[indexValue] = 0.0;
-      if (fabs(value) >= tolerance) {
-        elements_[nElements_] = value;
-        indices_[nElements_++] = indexValue;
-      }
-    }
+    nElements_ = cleanAndPackElements(elements_, indices_, nElements_,
+      tolerance);
     packedMode_ = true;
   }
   return nElements_;
@@ -1666,6 +2242,8 @@ int CoinIndexedVector::cleanAndPack(double tolerance)
 // These pack down
 int CoinIndexedVector::cleanAndPackSafe(double tolerance)
 {
+  if (bitmapMode_)
+    rebuildIndices();
   int number = nElements_;
   if (number) {
     int i;
@@ -1710,6 +2288,8 @@ int CoinIndexedVector::cleanAndPackSafe(double tolerance)
 // Scan dense region and set up indices
 int CoinIndexedVector::scanAndPack()
 {
+  if (bitmapMode_)
+    dropBitmap();
   nElements_ = 0;
   return scanAndPack(0, capacity_);
 }
@@ -1717,19 +2297,12 @@ int CoinIndexedVector::scanAndPack()
 int CoinIndexedVector::scanAndPack(int start, int end)
 {
   assert(!packedMode_);
+  if (bitmapMode_)
+    rebuildIndices();
   end = std::min(end, capacity_);
   start = std::max(start, 0);
-  int i;
-  int number = 0;
-  int *indices = indices_ + nElements_;
-  for (i = start; i < end; i++) {
-    double value = elements_[i];
-    elements_[i] = 0.0;
-    if (value) {
-      elements_[number] = value;
-      indices[number++] = i;
-    }
-  }
+  int number = scanAndPackElements(elements_, start, end, 0.0, false,
+    indices_ + nElements_);
   nElements_ += number;
   packedMode_ = true;
   return number;
@@ -1737,6 +2310,8 @@ int CoinIndexedVector::scanAndPack(int start, int end)
 // Scan dense region and set up indices with tolerance
 int CoinIndexedVector::scanAndPack(double tolerance)
 {
+  if (bitmapMode_)
+    dropBitmap();
   nElements_ = 0;
   return scanAndPack(0, capacity_, tolerance);
 }
@@ -1744,23 +2319,110 @@ int CoinIndexedVector::scanAndPack(double tolerance)
 int CoinIndexedVector::scanAndPack(int start, int end, double tolerance)
 {
   assert(!packedMode_);
+  if (bitmapMode_)
+    rebuildIndices();
   end = std::min(end, capacity_);
   start = std::max(start, 0);
-  int i;
-  int number = 0;
-  int *indices = indices_ + nElements_;
-  for (i = start; i < end; i++) {
-    double value = elements_[i];
-    elements_[i] = 0.0;
-    if (fabs(value) >= tolerance) {
-      elements_[number] = value;
-      indices[number++] = i;
-    }
-  }
+  int number = scanAndPackElements(elements_, start, end, tolerance, true,
+    indices_ + nElements_);
   nElements_ += number;
   packedMode_ = true;
   return number;
 }
+// Sets density at which list of indices is dropped
+void CoinIndexedVector::setDensityThreshold(double fraction)
+{
+  if (bitmapMode_ && fraction <= 0.0)
+    rebuildIndices();
+  densityThreshold_ = CoinMax(fraction, 0.0);
+}
+// Drops list of indices if dense enough
+bool CoinIndexedVector::checkDensity()
+{
+  if (!bitmapMode_ && !packedMode_ && nElements_ && nElements_ >= denseLimit())
+    startBitmap();
+  return bitmapMode_;
+}
+// Rebuilds list of indices (in increasing order) from bitmap
+void CoinIndexedVector::rebuildIndices() const
+{
+  assert(bitmapMode_);
+  int number = 0;
+  int numberWords = (capacity_ + 31) >> 5;
+  for (int iWord = 0; iWord < numberWords; iWord++) {
+    unsigned int bits = nonzeroBits_[iWord];
+    if (bits) {
+      nonzeroBits_[iWord] = 0;
+      int iRow = iWord << 5;
+      for (; bits; bits = bits >> 1, iRow++) {
+        if ((bits & 1) != 0)
+          indices_[number++] = iRow;
+      }
+    }
+  }
+  assert(number == nElements_);
+  bitmapMode_ = false;
+}
+// Drops list of indices and flags nonzeros in bitmap
+void CoinIndexedVector::startBitmap()
+{
+  assert(!bitmapMode_ && !packedMode_);
+  if (!nonzeroBits_) {
+    int numberWords = (capacity_ + 31) >> 5;
+    nonzeroBits_ = new unsigned int[numberWords];
+    CoinZeroN(nonzeroBits_, numberWords);
+  }
+  for (int i = 0; i < nElements_; i++) {
+    int iRow = indices_[i];
+    nonzeroBits_[iRow >> 5] |= 1u << (iRow & 31);
+  }
+  bitmapMode_ = true;
+}
+// Zeroes bitmap and forgets list of indices
+void CoinIndexedVector::dropBitmap()
+{
+  CoinZeroN(nonzeroBits_, (capacity_ + 31) >> 5);
+  bitmapMode_ = false;
+}
+/* Scan from start to < end appending when tracking density.
+   Indices are listed until dense enough and then flagged in bitmap. */
+int CoinIndexedVector::scanTracking(int start, int end, double tolerance)
+{
+  int numberBefore = nElements_;
+  int number = nElements_;
+  int i = start;
+  if (!bitmapMode_) {
+    int limit = denseLimit();
+    for (; i < end && number < limit; i++) {
+      double value = elements_[i];
+      if (value) {
+        if (fabs(value) >= tolerance)
+          indices_[number++] = i;
+        else
+          elements_[i] = 0.0;
+      }
+    }
+    nElements_ = number;
+    if (number >= limit && number)
+      startBitmap();
+  }
+  if (bitmapMode_) {
+    unsigned int *COIN_RESTRICT bits = nonzeroBits_;
+    for (; i < end; i++) {
+      double value = elements_[i];
+      if (value) {
+        if (fabs(value) >= tolerance) {
+          bits[i >> 5] |= 1u << (i & 31);
+          number++;
+        } else {
+          elements_[i] = 0.0;
+        }
+      }
+    }
+    nElements_ = number;
+  }
+  return number - numberBefore;
+}
 // This is mainly for testing - goes from packed to indexed
 void CoinIndexedVector::expand()
 {
@@ -1782,6 +2444,8 @@ void CoinIndexedVector::expand()
 void CoinIndexedVector::createPacked(int number, const int *indices,
   const double *elements)
 {
+  if (bitmapMode_)
+    dropBitmap();
   nElements_ = number;
   packedMode_ = true;
   CoinMemcpyN(indices, number, indices_);
@@ -1791,6 +2455,8 @@ void CoinIndexedVector::createPacked(int number, const int *indices,
 void CoinIndexedVector::createUnpacked(int number, const int *indices,
   const double *elements)
 {
+  if (bitmapMode_)
+    dropBitmap();
   nElements_ = number;
   packedMode_ = false;
   for (int i = 0; i < nElements_; i++) {
@@ -1802,6 +2468,8 @@ void CoinIndexedVector::createUnpacked(int number, const int *indices,
 // Create unpacked singleton
 void CoinIndexedVector::createOneUnpackedElement(int index, double element)
 {
+  if (bitmapMode_)
+    dropBitmap();
   nElements_ = 1;
   packedMode_ = false;
   indices_[0] = index;
@@ -1810,6 +2478,8 @@ void CoinIndexedVector::createOneUnpackedElement(int index, double element)
 //  Print out
 void CoinIndexedVector::print() const
 {
+  if (bitmapMode_)
+    rebuildIndices();
   printf("Vector has %d elements (%spacked mode)\n", nElements_, packedMode_ ? "" : "un");
   for (int i = 0; i < nElements_; i++) {
     if (i && (i % 5 == 0))
@@ -1827,28 +2497,192 @@ void CoinArrayWithLength::clear()
   assert((size_ > 0 && array_) || !array_);
   memset(array_, 0, size_);
 }
+//#############################################################################
+// Allocation of CoinArrayWithLength memory
+//#############################################################################
+
+static CoinArrayAllocationPolicy arrayPolicy = { 6, 0, 0, NULL, NULL };
+// Statistics - updated by any thread
+typedef struct {
+  std::atomic< CoinInt64 > numberAllocations;
+  std::atomic< CoinInt64 > numberHugePages;
+  std::atomic< CoinInt64 > currentBytes;
+  std::atomic< CoinInt64 > peakBytes;
+  std::atomic< CoinInt64 > totalBytes;
+} CoinArrayCounters;
+static CoinArrayCounters arrayCounters[COIN_ARRAY_TYPES];
+
+// How memory of an array was got
+#define COIN_ARRAY_NEW 0
+#define COIN_ARRAY_USER 1
+#define COIN_ARRAY_MAPPED 2
+/* Kept just before every array so it can be freed whatever the policy
+   is by then */
+typedef struct {
+  /// Start of memory
+  char *memory;
+  /// Bytes of memory (mapped) or in array (for statistics)
+  CoinByteArray numberBytes;
+  /// Bytes in array
+  CoinByteArray arrayBytes;
+  /// Used if COIN_ARRAY_USER
+  void (*release)(void *memory);
+  /// COIN_ARRAY_NEW etc
+  int source;
+  /// CoinArrayType
+  int type;
+} CoinArrayHeader;
+
+#if defined(__unix__) || defined(__APPLE__)
+#define COIN_HAS_MMAP
+#include <sys/mman.h>
+#endif
+// Size of huge page which transparent huge pages want alignment on
+#define COIN_HUGE_PAGE (2 * 1024 * 1024)
+
+/* Gets memory on huge pages (NULL if can not).
+   Sets number of bytes mapped. */
+static char *hugePageMemory(CoinByteArray size, CoinByteArray &numberBytes)
+{
+#ifdef COIN_HAS_MMAP
+  size_t length = static_cast< size_t >(size);
+  length = ((length + COIN_HUGE_PAGE - 1) / COIN_HUGE_PAGE) * COIN_HUGE_PAGE;
+  void *address = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (arrayPolicy.hugePageMode == 1)
+    address = mmap(NULL, length, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+  if (address == MAP_FAILED) {
+    // transparent - map extra so start can be on a huge page
+    size_t extra = length + COIN_HUGE_PAGE;
+    address = mmap(NULL, extra, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED)
+      return NULL;
+    char *start = reinterpret_cast< char * >(address);
+    CoinInt64 xx = reinterpret_cast< CoinInt64 >(start);
+    size_t front = static_cast< size_t >((COIN_HUGE_PAGE - (xx & (COIN_HUGE_PAGE - 1))) & (COIN_HUGE_PAGE - 1));
+    if (front)
+      munmap(start, front);
+    if (extra - front > length)
+      munmap(start + front + length, extra - front - length);
+    address = start + front;
+#ifdef MADV_HUGEPAGE
+    madvise(address, length, MADV_HUGEPAGE);
+#endif
+  }
+  numberBytes = static_cast< CoinByteArray >(length);
+  return reinterpret_cast< char * >(address);
+#else
+  return NULL;
+#endif
+}
+
+/* Returns array of size bytes aligned on at least 2**alignment
+   bytes and sets offset from start of memory */
+static char *allocateArray(CoinByteArray size, int alignment, int type,
+  int &offset)
+{
+  int align = 1 << CoinMax(CoinMax(alignment, arrayPolicy.alignment), 3);
+  CoinByteArray extra = align + static_cast< CoinByteArray >(sizeof(CoinArrayHeader));
+  CoinByteArray numberBytes = size + extra;
+  int source = COIN_ARRAY_NEW;
+  char *memory = NULL;
+  if (arrayPolicy.hugePageBytes > 0 && size >= arrayPolicy.hugePageBytes) {
+    memory = hugePageMemory(numberBytes, numberBytes);
+    if (memory)
+      source = COIN_ARRAY_MAPPED;
+  }
+  if (!memory) {
+    if (arrayPolicy.allocate) {
+      memory = reinterpret_cast< char * >(arrayPolicy.allocate(numberBytes));
+      source = COIN_ARRAY_USER;
+    } else {
+      memory = new char[numberBytes];
+    }
+  }
+  CoinInt64 xx = reinterpret_cast< CoinInt64 >(memory + sizeof(CoinArrayHeader));
+  int iBottom = static_cast< int >(xx & (align - 1));
+  offset = static_cast< int >(sizeof(CoinArrayHeader)) + (iBottom ? align - iBottom : 0);
+  char *array = memory + offset;
+  CoinArrayHeader *header = reinterpret_cast< CoinArrayHeader * >(array) - 1;
+  header->memory = memory;
+  header->numberBytes = numberBytes;
+  header->arrayBytes = size;
+  header->release = arrayPolicy.release;
+  header->source = source;
+  header->type = type;
+  CoinArrayCounters &counters = arrayCounters[type];
+  counters.numberAllocations++;
+  if (source == COIN_ARRAY_MAPPED)
+    counters.numberHugePages++;
+  counters.totalBytes += size;
+  CoinInt64 current = (counters.currentBytes += size);
+  CoinInt64 peak = counters.peakBytes;
+  while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current)) {
+  }
+  return array;
+}
+
+// Frees array from allocateArray
+static void freeArray(char *array)
+{
+  if (array) {
+    CoinArrayHeader *header = reinterpret_cast< CoinArrayHeader * >(array) - 1;
+    arrayCounters[header->type].currentBytes -= header->arrayBytes;
+    if (header->source == COIN_ARRAY_NEW) {
+      delete[] header->memory;
+    } else if (header->source == COIN_ARRAY_USER) {
+      header->release(header->memory);
+    } else {
+#ifdef COIN_HAS_MMAP
+      munmap(header->memory, static_cast< size_t >(header->numberBytes));
+#endif
+    }
+  }
+}
+
+// Set allocation policy
+void CoinArrayWithLength::setAllocationPolicy(const CoinArrayAllocationPolicy &policy)
+{
+  assert(!policy.allocate == !policy.release);
+  arrayPolicy = policy;
+}
+// Get allocation policy
+CoinArrayAllocationPolicy CoinArrayWithLength::allocationPolicy()
+{
+  return arrayPolicy;
+}
+// Statistics for one CoinArrayType
+CoinArrayStatistics CoinArrayWithLength::statistics(int type)
+{
+  assert(type >= 0 && type < COIN_ARRAY_TYPES);
+  const CoinArrayCounters &counters = arrayCounters[type];
+  CoinArrayStatistics statistics;
+  statistics.numberAllocations = counters.numberAllocations;
+  statistics.numberHugePages = counters.numberHugePages;
+  statistics.currentBytes = counters.currentBytes;
+  statistics.peakBytes = counters.peakBytes;
+  statistics.totalBytes = counters.totalBytes;
+  return statistics;
+}
+// Zero statistics (current bytes are kept)
+void CoinArrayWithLength::resetStatistics()
+{
+  for (int i = 0; i < COIN_ARRAY_TYPES; i++) {
+    CoinArrayCounters &counters = arrayCounters[i];
+    counters.numberAllocations = 0;
+    counters.numberHugePages = 0;
+    counters.peakBytes = static_cast< CoinInt64 >(counters.currentBytes);
+    counters.totalBytes = 0;
+  }
+}
 // Get array with alignment
 void CoinArrayWithLength::getArray(CoinByteArray size)
 {
   if (size > 0) {
-    if (alignment_ > 2) {
-      offset_ = 1 << alignment_;
-    } else {
-      offset_ = 0;
-    }
-    char *array = new char[size + offset_];
-    if (offset_) {
-      // need offset
-      CoinInt64 xx = reinterpret_cast< CoinInt64 >(array);
-      int iBottom = static_cast< int >(xx & ((offset_ - 1)));
-      if (iBottom)
-        offset_ = offset_ - iBottom;
-      else
-        offset_ = 0;
-      array_ = array + offset_;
-    } else {
-      array_ = array;
-    }
+    array_ = allocateArray(size, alignment_, type_, offset_);
     if (size_ != -1)
       size_ = size;
   } else {
@@ -1859,9 +2693,7 @@ void CoinArrayWithLength::getArray(CoinByteArray size)
 void CoinArrayWithLength::conditionalDelete()
 {
   if (size_ == -1) {
-    char *charArray = reinterpret_cast< char * >(array_);
-    if (charArray)
-      delete[](charArray - offset_);
+    freeArray(array_);
     array_ = NULL;
   } else if (size_ >= 0) {
     size_ = -size_ - 2;
@@ -1870,9 +2702,7 @@ void CoinArrayWithLength::conditionalDelete()
 // Really get rid of array with alignment
 void CoinArrayWithLength::reallyFreeArray()
 {
-  char *charArray = reinterpret_cast< char * >(array_);
-  if (charArray)
-    delete[](charArray - offset_);
+  freeArray(array_);
   array_ = NULL;
   size_ = -1;
 }
@@ -1900,9 +2730,10 @@ void CoinArrayWithLength::getCapacity(CoinByteArray numberBytes, CoinByteArray n
    if size<=0 just does alignment
    If abs(mode) >2 then align on that as power of 2
 */
-CoinArrayWithLength::CoinArrayWithLength(CoinByteArray size, int mode)
+CoinArrayWithLength::CoinArrayWithLength(CoinByteArray size, int mode, int type)
 {
   alignment_ = abs(mode);
+  type_ = type;
   size_ = size;
   getArray(size);
   if (mode > 0 && array_)
@@ -1910,8 +2741,7 @@ CoinArrayWithLength::CoinArrayWithLength(CoinByteArray size, int mode)
 }
 CoinArrayWithLength::~CoinArrayWithLength()
 {
-  if (array_)
-    delete[](array_ - offset_);
+  freeArray(array_);
 }
 // Conditionally gets new array
 char *
@@ -1929,8 +2759,11 @@ CoinArrayWithLength::conditionalNew(CoinByteArray sizeWanted)
 }
 /* Copy constructor. */
 CoinArrayWithLength::CoinArrayWithLength(const CoinArrayWithLength &rhs)
+  : size_(rhs.size_)
+  , offset_(0)
+  , alignment_(rhs.alignment_)
+  , type_(rhs.type_)
 {
-  assert(capacity() >= 0);
   getArray(rhs.capacity());
   if (size_ > 0)
     CoinMemcpyN(rhs.array_, size_, array_);
@@ -1938,6 +2771,9 @@ CoinArrayWithLength::CoinArrayWithLength(const CoinArrayWithLength &rhs)
 
 /* Copy constructor.2 */
 CoinArrayWithLength::CoinArrayWithLength(const CoinArrayWithLength *rhs)
+  : offset_(0)
+  , alignment_(rhs->alignment_)
+  , type_(rhs->type_)
 {
   assert(rhs->capacity() >= 0);
   size_ = rhs->size_;
@@ -1986,7 +2822,7 @@ void CoinArrayWithLength::allocate(const CoinArrayWithLength &rhs, CoinByteArray
   } else {
     assert(numberBytes >= 0);
     if (size_ == -1) {
-      delete[] array_;
+      freeArray(array_);
       array_ = NULL;
     } else {
       size_ = -1;
@@ -1996,7 +2832,7 @@ void CoinArrayWithLength::allocate(const CoinArrayWithLength &rhs, CoinByteArray
     assert(numberBytes >= 0);
     assert(!array_);
     if (numberBytes)
-      array_ = new char[numberBytes];
+      array_ = allocateArray(numberBytes, alignment_, type_, offset_);
   }
 }
 // Does what is needed to set persistence
@@ -2006,7 +2842,7 @@ void CoinArrayWithLength::setPersistence(int flag, CoinByteArray currentLength)
     if (size_ == -1) {
       if (currentLength && array_) {
 	if (flag==3) {
-	  delete[](array_ - offset_);
+	  freeArray(array_);
 	  getArray(size_);
 	}
         size_ = currentLength;
@@ -2047,8 +2883,8 @@ void CoinArrayWithLength::extend(CoinByteArray newSize)
     char *temp = array_;
     getArray(newSize);
     if (temp) {
-      CoinMemcpyN(array_, size_, temp);
-      delete[](temp - offset_);
+      CoinMemcpyN(temp, size_, array_);
+      freeArray(temp);
     }
     size_ = newSize;
   }
@@ -2057,18 +2893,24 @@ void CoinArrayWithLength::extend(CoinByteArray newSize)
 /* Default constructor */
 CoinPartitionedVector::CoinPartitionedVector()
   : CoinIndexedVector()
+  , numberThreads_(1)
+  , threadPool_(NULL)
 {
   memset(startPartition_, 0, ((&numberPartitions_ - startPartition_) + 1) * sizeof(int));
 }
 /* Copy constructor. */
 CoinPartitionedVector::CoinPartitionedVector(const CoinPartitionedVector &rhs)
   : CoinIndexedVector(rhs)
+  , numberThreads_(rhs.numberThreads_)
+  , threadPool_(NULL)
 {
   memcpy(startPartition_, rhs.startPartition_, ((&numberPartitions_ - startPartition_) + 1) * sizeof(int));
 }
 /* Copy constructor.2 */
 CoinPartitionedVector::CoinPartitionedVector(const CoinPartitionedVector *rhs)
   : CoinIndexedVector(rhs)
+  , numberThreads_(rhs->numberThreads_)
+  , threadPool_(NULL)
 {
   memcpy(startPartition_, rhs->startPartition_, ((&numberPartitions_ - startPartition_) + 1) * sizeof(int));
 }
@@ -2078,12 +2920,14 @@ CoinPartitionedVector &CoinPartitionedVector::operator=(const CoinPartitionedVec
   if (this != &rhs) {
     CoinIndexedVector::operator=(rhs);
     memcpy(startPartition_, rhs.startPartition_, ((&numberPartitions_ - startPartition_) + 1) * sizeof(int));
+    setNumberThreads(rhs.numberThreads_);
   }
   return *this;
 }
 /* Destructor */
 CoinPartitionedVector::~CoinPartitionedVector()
 {
+  delete threadPool_;
 }
 // Add up number of elements in partitions
 void CoinPartitionedVector::computeNumberElements()
@@ -2100,29 +2944,25 @@ void CoinPartitionedVector::computeNumberElements()
 void CoinPartitionedVector::compact()
 {
   if (numberPartitions_) {
-    int n = numberElementsPartition_[0];
-    numberElementsPartition_[0] = 0;
-    for (int i = 1; i < numberPartitions_; i++) {
-      int nThis = numberElementsPartition_[i];
-      int start = startPartition_[i];
-      memmove(indices_ + n, indices_ + start, nThis * sizeof(int));
-      memmove(elements_ + n, elements_ + start, nThis * sizeof(double));
-      n += nThis;
+    int offset[COIN_PARTITIONS];
+    int n = 0;
+    for (int i = 0; i < numberPartitions_; i++) {
+      offset[i] = n;
+      n += numberElementsPartition_[i];
     }
     nElements_ = n;
-    // clean up
-    for (int i = 1; i < numberPartitions_; i++) {
-      int nThis = numberElementsPartition_[i];
-      int start = startPartition_[i];
-      numberElementsPartition_[i] = 0;
-      int end = nThis + start;
-      if (nElements_ < end) {
-        int offset = std::max(nElements_ - start, 0);
-        start += offset;
-        nThis -= offset;
-        memset(elements_ + start, 0, nThis * sizeof(double));
+    /* Partitions can be moved at same time unless one lands on
+       elements of an earlier partition which have not been moved yet */
+    bool overlap = false;
+    for (int i = 2; i < numberPartitions_; i++) {
+      int endThis = offset[i] + numberElementsPartition_[i];
+      for (int j = 1; j < i; j++) {
+        if (endThis > startPartition_[j]
+          && offset[i] < startPartition_[j] + numberElementsPartition_[j])
+          overlap = true;
       }
     }
+    doPartitions(compactTask, offset, overlap ? 0 : nElements_);
     packedMode_ = true;
     numberPartitions_ = 0;
   }
@@ -2162,11 +3002,10 @@ void CoinPartitionedVector::clearAndReset()
 {
   if (numberPartitions_) {
     assert(packedMode_ || !nElements_);
-    for (int i = 0; i < numberPartitions_; i++) {
-      int n = numberElementsPartition_[i];
-      memset(elements_ + startPartition_[i], 0, n * sizeof(double));
-      numberElementsPartition_[i] = 0;
-    }
+    int n = 0;
+    for (int i = 0; i < numberPartitions_; i++)
+      n += numberElementsPartition_[i];
+    doPartitions(clearTask, NULL, n);
   } else {
     memset(elements_, 0, nElements_ * sizeof(double));
   }
@@ -2179,11 +3018,10 @@ void CoinPartitionedVector::clearAndReset()
 void CoinPartitionedVector::clearAndKeep()
 {
   assert(packedMode_);
-  for (int i = 0; i < numberPartitions_; i++) {
-    int n = numberElementsPartition_[i];
-    memset(elements_ + startPartition_[i], 0, n * sizeof(double));
-    numberElementsPartition_[i] = 0;
-  }
+  int n = 0;
+  for (int i = 0; i < numberPartitions_; i++)
+    n += numberElementsPartition_[i];
+  doPartitions(clearTask, NULL, n);
   nElements_ = 0;
 }
 // Clear a partition.
@@ -2297,6 +3135,27 @@ int CoinPartitionedVector::scan(int partition, double tolerance)
   numberElementsPartition_[partition] = n;
   return n;
 }
+// Drop elements of a partition with absolute value less than tolerance
+int CoinPartitionedVector::cleanPartition(int partition, double tolerance)
+{
+  assert(packedMode_);
+  assert(partition < COIN_PARTITIONS);
+  int n = 0;
+  int start = startPartition_[partition];
+  double *COIN_RESTRICT elements = elements_ + start;
+  int *COIN_RESTRICT indices = indices_ + start;
+  int number = numberElementsPartition_[partition];
+  for (int i = 0; i < number; i++) {
+    double value = elements[i];
+    elements[i] = 0.0;
+    if (fabs(value) >= tolerance) {
+      elements[n] = value;
+      indices[n++] = indices[i];
+    }
+  }
+  numberElementsPartition_[partition] = n;
+  return n;
+}
 //  Print out
 void CoinPartitionedVector::print() const
 {
@@ -2337,5 +3196,148 @@ void CoinPartitionedVector::sort()
   }
 }
 
+// Partitioned vectors with less work than this are done serially
+#define COIN_PARTITION_PARALLEL_SIZE 10000
+
+void CoinPartitionedVector::setNumberThreads(int numberThreads)
+{
+  if (numberThreads < 1)
+    numberThreads = CoinThreadPool::numberProcessors();
+  numberThreads_ = numberThreads;
+  if (threadPool_ && threadPool_->numberThreads() != numberThreads_) {
+    delete threadPool_;
+    threadPool_ = NULL;
+  }
+}
+
+// Passed to CoinThreadPool::run by doPartitions
+typedef struct {
+  CoinPartitionedVector *vector;
+  CoinPartitionFunction function;
+  void *info;
+} CoinPartitionTaskInfo;
+
+static void partitionTask(void *info, int which)
+{
+  CoinPartitionTaskInfo *task = reinterpret_cast< CoinPartitionTaskInfo * >(info);
+  task->function(task->vector, which, task->info);
+}
+
+// Run function on all partitions - threaded if worth it for work
+void CoinPartitionedVector::doPartitions(CoinPartitionFunction function,
+  void *info, int work)
+{
+  if (numberThreads_ > 1 && numberPartitions_ > 1
+    && work >= COIN_PARTITION_PARALLEL_SIZE
+    && CoinThreadPool::threadsAvailable()) {
+    if (!threadPool_)
+      threadPool_ = new CoinThreadPool(numberThreads_);
+    CoinPartitionTaskInfo task;
+    task.vector = this;
+    task.function = function;
+    task.info = info;
+    threadPool_->run(numberPartitions_, partitionTask, &task);
+  } else {
+    for (int i = 0; i < numberPartitions_; i++)
+      function(this, i, info);
+  }
+}
+
+void CoinPartitionedVector::scanTask(CoinPartitionedVector *vector,
+  int partition, void *info)
+{
+  vector->scan(partition, *reinterpret_cast< double * >(info));
+}
+
+void CoinPartitionedVector::cleanTask(CoinPartitionedVector *vector,
+  int partition, void *info)
+{
+  vector->cleanPartition(partition, *reinterpret_cast< double * >(info));
+}
+
+void CoinPartitionedVector::clearTask(CoinPartitionedVector *vector,
+  int partition, void *)
+{
+  int n = vector->numberElementsPartition_[partition];
+  memset(vector->elements_ + vector->startPartition_[partition], 0, n * sizeof(double));
+  vector->numberElementsPartition_[partition] = 0;
+}
+
+// Moves partition down to offset and zeroes rest (nElements_ already set)
+void CoinPartitionedVector::compactTask(CoinPartitionedVector *vector,
+  int partition, void *info)
+{
+  int nThis = vector->numberElementsPartition_[partition];
+  vector->numberElementsPartition_[partition] = 0;
+  if (!partition)
+    return;
+  int n = reinterpret_cast< int * >(info)[partition];
+  int start = vector->startPartition_[partition];
+  int *indices = vector->indices_;
+  double *elements = vector->elements_;
+  memmove(indices + n, indices + start, nThis * sizeof(int));
+  memmove(elements + n, elements + start, nThis * sizeof(double));
+  // clean up
+  int nElements = vector->nElements_;
+  int end = nThis + start;
+  if (nElements < end) {
+    int offset = std::max(nElements - start, 0);
+    memset(elements + start + offset, 0, (nThis - offset) * sizeof(double));
+  }
+}
+
+// Scan dense region of every partition (returns total number found)
+int CoinPartitionedVector::scanPartitions(double tolerance)
+{
+  doPartitions(scanTask, &tolerance, startPartition_[numberPartitions_]);
+  computeNumberElements();
+  return nElements_;
+}
+
+// Drop small elements of every partition (returns total number left)
+int CoinPartitionedVector::cleanPartitions(double tolerance)
+{
+  int n = 0;
+  for (int i = 0; i < numberPartitions_; i++)
+    n += numberElementsPartition_[i];
+  doPartitions(cleanTask, &tolerance, n);
+  computeNumberElements();
+  return nElements_;
+}
+
+// Run function for every partition
+void CoinPartitionedVector::runPartitions(CoinPartitionFunction function,
+  void *info)
+{
+  doPartitions(function, info, COIN_INT_MAX);
+}
+
+// Passed to runPartitions by reducePartitions
+typedef struct {
+  CoinPartitionReduceFunction function;
+  void *info;
+  double result[COIN_PARTITIONS];
+} CoinPartitionReduceInfo;
+
+static void reduceTask(CoinPartitionedVector *vector, int partition, void *info)
+{
+  CoinPartitionReduceInfo *reduce = reinterpret_cast< CoinPartitionReduceInfo * >(info);
+  reduce->result[partition] = reduce->function(vector, partition, reduce->info);
+}
+
+// Add up values from function for every partition
+double CoinPartitionedVector::reducePartitions(CoinPartitionReduceFunction function,
+  void *info)
+{
+  CoinPartitionReduceInfo reduce;
+  reduce.function = function;
+  reduce.info = info;
+  runPartitions(reduceTask, &reduce);
+  double sum = 0.0;
+  for (int i = 0; i < numberPartitions_; i++)
+    sum += reduce.result[i];
+  return sum;
+}
+
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
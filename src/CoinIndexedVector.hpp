@@ -30,6 +30,12 @@ It is designed to be lightweight in normal use.
 
 It now has a "packed" mode when it is even more like CoinPackedVector
 
+It can also track density (see setDensityThreshold).  Once dense enough
+the list of indices is dropped and nonzeros are flagged in a bitmap until
+a user asks for the indices (getIndices) when the list is rebuilt in
+increasing order.  This saves keeping up a list which would never be
+used when results are dense.
+
 Indices array has capacity_ extra chars which are zeroed and can
 be used for any purpose - but must be re-zeroed
 
@@ -104,12 +110,22 @@ public:
   //@{
   /// Get the size
   inline int getNumElements() const { return nElements_; }
-  /// Get indices of elements
-  inline const int *getIndices() const { return indices_; }
+  /// Get indices of elements (rebuilt if dropped - see bitmapMode)
+  inline const int *getIndices() const
+  {
+    if (bitmapMode_)
+      rebuildIndices();
+    return indices_;
+  }
   /// Get element values
   // ** No longer supported virtual const double * getElements() const ;
-  /// Get indices of elements
-  inline int *getIndices() { return indices_; }
+  /// Get indices of elements (rebuilt if dropped - see bitmapMode)
+  inline int *getIndices()
+  {
+    if (bitmapMode_)
+      rebuildIndices();
+    return indices_;
+  }
   /** Get the vector as a dense vector. This is normal storage method.
        The user should not not delete [] this.
    */
@@ -138,6 +154,8 @@ public:
   /// Set the size
   inline void setNumElements(int value)
   {
+    if (bitmapMode_)
+      rebuildIndices();
     nElements_ = value;
     if (!nElements_)
       packedMode_ = false;
@@ -198,7 +216,10 @@ public:
   inline void quickInsert(int index, double element)
   {
     assert(!elements_[index]);
-    indices_[nElements_++] = index;
+    if (!bitmapMode_)
+      indices_[nElements_++] = index;
+    else
+      markNonzero(index);
     assert(nElements_ <= capacity_);
     elements_[index] = element;
   }
@@ -218,7 +239,10 @@ public:
         elements_[index] = 1.0e-100;
       }
     } else if ((element > 0 ? element : -element) >= COIN_INDEXED_TINY_ELEMENT) {
-      indices_[nElements_++] = index;
+      if (!bitmapMode_)
+        indices_[nElements_++] = index;
+      else
+        markNonzero(index);
       assert(nElements_ <= capacity_);
       elements_[index] = element;
     }
@@ -238,7 +262,10 @@ public:
         elements_[index] = COIN_DBL_MIN;
       }
     } else {
-      indices_[nElements_++] = index;
+      if (!bitmapMode_)
+        indices_[nElements_++] = index;
+      else
+        markNonzero(index);
       assert(nElements_ <= capacity_);
       elements_[index] = element;
     }
@@ -271,6 +298,27 @@ public:
   inline void checkClear() {};
   inline void checkClean() {};
 #endif
+  /** Density tracking.  If fraction is positive then once more than that
+      fraction of capacity is nonzero (found by scan, insert or add or
+      checkDensity) the list of indices is dropped and nonzeros are
+      flagged in a bitmap.  The list is rebuilt (in increasing order) when
+      next needed e.g. by getIndices.  Not for packed mode or
+      CoinPartitionedVector.  Default 0.0 - always keep list.
+  */
+  void setDensityThreshold(double fraction);
+  /// Density at which list of indices is dropped (0.0 never)
+  inline double densityThreshold() const
+  {
+    return densityThreshold_;
+  }
+  /// True if list of indices dropped (nonzeros flagged in bitmap)
+  inline bool bitmapMode() const
+  {
+    return bitmapMode_;
+  }
+  /** Drops list of indices if dense enough (see setDensityThreshold).
+      For use after filling by quickInsert etc.  Returns bitmapMode() */
+  bool checkDensity();
   /// Scan dense region and set up indices (returns number found)
   int scan();
   /** Scan dense region from start to < end and set up indices
@@ -359,11 +407,15 @@ public:
   /** Sort the indexed storage vector (increasing indices). */
   void sort()
   {
+    if (bitmapMode_)
+      rebuildIndices();
     std::sort(indices_, indices_ + nElements_);
   }
 
   void sortIncrIndex()
   {
+    if (bitmapMode_)
+      rebuildIndices();
     std::sort(indices_, indices_ + nElements_);
   }
 
@@ -435,6 +487,8 @@ public:
   /// Sets packed mode
   inline void setPackedMode(bool yesNo)
   {
+    if (bitmapMode_)
+      rebuildIndices();
     packedMode_ = yesNo;
   }
   /// Gets packed mode
@@ -482,6 +536,25 @@ private:
   ///
   void gutsOfSetConstant(int size,
     const int *inds, double value);
+  /// Rebuilds list of indices from bitmap
+  void rebuildIndices() const;
+  /// Drops list of indices and flags nonzeros in bitmap
+  void startBitmap();
+  /// Zeroes bitmap and forgets list of indices (when about to rescan)
+  void dropBitmap();
+  /// Scan (appending) when tracking density
+  int scanTracking(int start, int end, double tolerance);
+  /// Flags a new nonzero when list of indices dropped
+  inline void markNonzero(int index)
+  {
+    nonzeroBits_[index >> 5] |= 1u << (index & 31);
+    nElements_++;
+  }
+  /// Number of nonzeros at which list of indices is dropped
+  inline int denseLimit() const
+  {
+    return densityThreshold_ > 0.0 ? CoinMax(static_cast< int >(densityThreshold_ * capacity_), 1) : COIN_INT_MAX;
+  }
   //@}
 
 protected:
@@ -499,6 +572,12 @@ protected:
   int offset_;
   /// If true then is operating in packed mode
   bool packedMode_;
+  /// If true list of indices dropped and nonzeros flagged in nonzeroBits_
+  mutable bool bitmapMode_;
+  /// Fraction of capacity nonzero at which list of indices dropped
+  double densityThreshold_;
+  /// One bit per entry (all zero unless bitmapMode_)
+  unsigned int *nonzeroBits_;
   //@}
 };
 
@@ -509,6 +588,58 @@ protected:
     library should be compiled with optimization on, but this method should be
     compiled with debugging. */
 void CoinIndexedVectorUnitTest();
+
+/// Kinds of CoinArrayWithLength (for allocation statistics)
+enum CoinArrayType {
+  COIN_ARRAY_CHAR = 0,
+  COIN_ARRAY_DOUBLE,
+  COIN_ARRAY_FLOAT,
+  COIN_ARRAY_FACTORIZATION_DOUBLE,
+  COIN_ARRAY_FACTORIZATION_LONG_DOUBLE,
+  COIN_ARRAY_INT,
+  COIN_ARRAY_BIG_INDEX,
+  COIN_ARRAY_UNSIGNED_INT,
+  COIN_ARRAY_VOID_STAR,
+  COIN_ARRAY_ARBITRARY,
+  COIN_ARRAY_TYPES
+};
+
+/** How CoinArrayWithLength and its subclasses get memory.
+
+    Default is every array aligned on 64 bytes (as wanted by vector code)
+    from new[], with no huge pages.  Large arrays can be put on huge pages
+    to cut TLB misses - either transparent huge pages (advice only, so
+    always works) or explicit ones (MAP_HUGETLB) which need pages reserved
+    by the system and fall back to transparent ones if none are free.
+    Huge pages are only available on systems with mmap.
+*/
+typedef struct {
+  /// Arrays are aligned on at least 2**alignment bytes (default 6)
+  int alignment;
+  /// Arrays of at least this many bytes go on huge pages (0 never)
+  CoinByteArray hugePageBytes;
+  /// 0 transparent huge pages, 1 explicit huge pages
+  int hugePageMode;
+  /// If not NULL used instead of new[] for other arrays
+  void *(*allocate)(size_t numberBytes);
+  /// Frees memory got from allocate
+  void (*release)(void *memory);
+} CoinArrayAllocationPolicy;
+
+/// Allocation statistics for one CoinArrayType
+typedef struct {
+  /// Number of arrays allocated
+  CoinInt64 numberAllocations;
+  /// Number of those on huge pages
+  CoinInt64 numberHugePages;
+  /// Bytes in arrays now allocated
+  CoinInt64 currentBytes;
+  /// Largest value of currentBytes
+  CoinInt64 peakBytes;
+  /// Bytes in all arrays allocated
+  CoinInt64 totalBytes;
+} CoinArrayStatistics;
+
 /** Pointer with length in bytes
     
     This has a pointer to an array and the number of bytes in array.
@@ -607,6 +738,7 @@ public:
     , size_(-1)
     , offset_(0)
     , alignment_(0)
+    , type_(COIN_ARRAY_CHAR)
   {
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
@@ -614,16 +746,18 @@ public:
     : size_(-1)
     , offset_(0)
     , alignment_(0)
+    , type_(COIN_ARRAY_CHAR)
   {
-    array_ = new char[size];
+    getArray(size);
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       mode>0 size_ set to size and zeroed
       if size<=0 just does alignment
       If abs(mode) >2 then align on that as power of 2
+      type is CoinArrayType for statistics
   */
-  CoinArrayWithLength(CoinByteArray size, int mode);
+  CoinArrayWithLength(CoinByteArray size, int mode, int type = COIN_ARRAY_CHAR);
   /** Copy constructor. */
   CoinArrayWithLength(const CoinArrayWithLength &rhs);
   /** Copy constructor.2 */
@@ -644,6 +778,28 @@ public:
   void getCapacity(CoinByteArray numberBytes, CoinByteArray numberIfNeeded = -1);
   //@}
 
+  /**@name Allocation policy and statistics
+
+     The policy is shared by all arrays.  It should be set before arrays
+     are created and not while other threads are allocating; arrays keep
+     the way they were allocated so may be freed under any policy.
+  */
+  //@{
+  /// Set allocation policy
+  static void setAllocationPolicy(const CoinArrayAllocationPolicy &policy);
+  /// Get allocation policy
+  static CoinArrayAllocationPolicy allocationPolicy();
+  /// Statistics for one CoinArrayType
+  static CoinArrayStatistics statistics(int type);
+  /// Zero statistics (current bytes are kept)
+  static void resetStatistics();
+  /// Kind of array (CoinArrayType)
+  inline int arrayType() const
+  {
+    return type_;
+  }
+  //@}
+
 protected:
   /**@name Private member data */
   //@{
@@ -655,6 +811,8 @@ protected:
   int offset_;
   /// Alignment wanted (power of 2)
   int alignment_;
+  /// Kind of array (CoinArrayType)
+  int type_;
   //@}
 };
 /// double * version
@@ -701,19 +859,20 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_DOUBLE;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinDoubleArrayWithLength(CoinByteArray size)
   {
-    array_ = new char[size * CoinSizeofAsInt(double)];
-    size_ = -1;
+    type_ = COIN_ARRAY_DOUBLE;
+    getArray(size * CoinSizeofAsInt(double));
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
   */
   inline CoinDoubleArrayWithLength(CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * CoinSizeofAsInt(double), mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(double), mode, COIN_ARRAY_DOUBLE)
   {
   }
   /** Copy constructor. */
@@ -734,6 +893,84 @@ public:
   }
   //@}
 };
+/// float * version
+
+class COINUTILSLIB_EXPORT CoinFloatArrayWithLength : public CoinArrayWithLength {
+
+public:
+  /**@name Get methods. */
+  //@{
+  /// Get the size
+  inline CoinBigIndex getSize() const
+  {
+    return static_cast<CoinBigIndex>(size_ / CoinSizeofAsInt(float));
+  }
+  /// Get Array
+  inline float *array() const
+  {
+    return reinterpret_cast< float * >((size_ > -2) ? array_ : NULL);
+  }
+  //@}
+
+  /**@name Set methods */
+  //@{
+  /// Set the size
+  inline void setSize(CoinByteArray value)
+  {
+    size_ = value * CoinSizeofAsInt(float);
+  }
+  //@}
+
+  /**@name Condition methods */
+  //@{
+  /// Conditionally gets new array
+  inline float *conditionalNew(CoinByteArray  sizeWanted)
+  {
+    return reinterpret_cast< float * >(CoinArrayWithLength::conditionalNew(sizeWanted >= 0 ? sizeWanted*CoinSizeofAsInt(float) : -1));
+  }
+  //@}
+
+  /**@name Constructors and destructors */
+  //@{
+  /** Default constructor - NULL*/
+  inline CoinFloatArrayWithLength()
+  {
+    array_ = NULL;
+    size_ = -1;
+    type_ = COIN_ARRAY_FLOAT;
+  }
+  /** Alternate Constructor - length in bytes - size_ -1 */
+  inline CoinFloatArrayWithLength(CoinByteArray size)
+  {
+    type_ = COIN_ARRAY_FLOAT;
+    getArray(size * CoinSizeofAsInt(float));
+  }
+  /** Alternate Constructor - length in bytes 
+      mode -  0 size_ set to size
+      1 size_ set to size and zeroed
+  */
+  inline CoinFloatArrayWithLength(CoinByteArray size, int mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(float), mode, COIN_ARRAY_FLOAT)
+  {
+  }
+  /** Copy constructor. */
+  inline CoinFloatArrayWithLength(const CoinFloatArrayWithLength &rhs)
+    : CoinArrayWithLength(rhs)
+  {
+  }
+  /** Copy constructor.2 */
+  inline CoinFloatArrayWithLength(const CoinFloatArrayWithLength *rhs)
+    : CoinArrayWithLength(rhs)
+  {
+  }
+  /** Assignment operator. */
+  inline CoinFloatArrayWithLength &operator=(const CoinFloatArrayWithLength &rhs)
+  {
+    CoinArrayWithLength::operator=(rhs);
+    return *this;
+  }
+  //@}
+};
 /// CoinFactorizationDouble * version
 
 class COINUTILSLIB_EXPORT CoinFactorizationDoubleArrayWithLength : public CoinArrayWithLength {
@@ -778,19 +1015,20 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_FACTORIZATION_DOUBLE;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinFactorizationDoubleArrayWithLength(CoinByteArray size)
   {
-    array_ = new char[size * CoinSizeofAsInt(CoinFactorizationDouble)];
-    size_ = -1;
+    type_ = COIN_ARRAY_FACTORIZATION_DOUBLE;
+    getArray(size * CoinSizeofAsInt(CoinFactorizationDouble));
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
   */
   inline CoinFactorizationDoubleArrayWithLength(CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * CoinSizeofAsInt(CoinFactorizationDouble), mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(CoinFactorizationDouble), mode, COIN_ARRAY_FACTORIZATION_DOUBLE)
   {
   }
   /** Copy constructor. */
@@ -855,19 +1093,20 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_FACTORIZATION_LONG_DOUBLE;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinFactorizationLongDoubleArrayWithLength(CoinByteArray size)
   {
-    array_ = new char[size * CoinSizeofAsInt(long double)];
-    size_ = -1;
+    type_ = COIN_ARRAY_FACTORIZATION_LONG_DOUBLE;
+    getArray(size * CoinSizeofAsInt(long double));
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
   */
   inline CoinFactorizationLongDoubleArrayWithLength(CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * CoinSizeofAsInt(long double), mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(long double), mode, COIN_ARRAY_FACTORIZATION_LONG_DOUBLE)
   {
   }
   /** Copy constructor. */
@@ -932,19 +1171,20 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_INT;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinIntArrayWithLength(CoinByteArray size)
   {
-    array_ = new char[size * CoinSizeofAsInt(int)];
-    size_ = -1;
+    type_ = COIN_ARRAY_INT;
+    getArray(size * CoinSizeofAsInt(int));
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
   */
   inline CoinIntArrayWithLength(CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * CoinSizeofAsInt(int), mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(int), mode, COIN_ARRAY_INT)
   {
   }
   /** Copy constructor. */
@@ -1009,19 +1249,20 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_BIG_INDEX;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinBigIndexArrayWithLength(CoinByteArray size)
   {
-    array_ = new char[size * CoinSizeofAsInt(CoinBigIndex)];
-    size_ = -1;
+    type_ = COIN_ARRAY_BIG_INDEX;
+    getArray(size * CoinSizeofAsInt(CoinBigIndex));
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
   */
   inline CoinBigIndexArrayWithLength(CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * CoinSizeofAsInt(CoinBigIndex), mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(CoinBigIndex), mode, COIN_ARRAY_BIG_INDEX)
   {
   }
   /** Copy constructor. */
@@ -1086,19 +1327,20 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_UNSIGNED_INT;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinUnsignedIntArrayWithLength(CoinByteArray size)
   {
-    array_ = new char[size * CoinSizeofAsInt(unsigned int)];
-    size_ = -1;
+    type_ = COIN_ARRAY_UNSIGNED_INT;
+    getArray(size * CoinSizeofAsInt(unsigned int));
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
   */
   inline CoinUnsignedIntArrayWithLength(CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * CoinSizeofAsInt(unsigned int), mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(unsigned int), mode, COIN_ARRAY_UNSIGNED_INT)
   {
   }
   /** Copy constructor. */
@@ -1163,19 +1405,20 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_VOID_STAR;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinVoidStarArrayWithLength(CoinByteArray size)
   {
-    array_ = new char[size * CoinSizeofAsInt(void *)];
-    size_ = -1;
+    type_ = COIN_ARRAY_VOID_STAR;
+    getArray(size * CoinSizeofAsInt(void *));
   }
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
   */
   inline CoinVoidStarArrayWithLength(CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * CoinSizeofAsInt(void *), mode)
+    : CoinArrayWithLength(size * CoinSizeofAsInt(void *), mode, COIN_ARRAY_VOID_STAR)
   {
   }
   /** Copy constructor. */
@@ -1241,13 +1484,14 @@ public:
   {
     array_ = NULL;
     size_ = -1;
+    type_ = COIN_ARRAY_ARBITRARY;
     lengthInBytes_ = length;
   }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinArbitraryArrayWithLength(int length, CoinByteArray size)
   {
-    array_ = new char[size * length];
-    size_ = -1;
+    type_ = COIN_ARRAY_ARBITRARY;
+    getArray(size * length);
     lengthInBytes_ = length;
   }
   /** Alternate Constructor - length in bytes 
@@ -1255,7 +1499,7 @@ public:
       1 size_ set to size and zeroed
   */
   inline CoinArbitraryArrayWithLength(int length, CoinByteArray size, int mode)
-    : CoinArrayWithLength(size * length, mode)
+    : CoinArrayWithLength(size * length, mode, COIN_ARRAY_ARBITRARY)
   {
     lengthInBytes_ = length;
   }
@@ -1284,6 +1528,18 @@ protected:
   CoinBigIndex lengthInBytes_;
   //@}
 };
+class CoinPartitionedVector;
+class CoinThreadPool;
+/** Signature of work done on one partition of a CoinPartitionedVector
+    (see CoinPartitionedVector::runPartitions).  \p info is the pointer
+    given to runPartitions.
+*/
+typedef void (*CoinPartitionFunction)(CoinPartitionedVector *vector,
+  int partition, void *info);
+/// Signature of work on one partition giving a value to be added up
+typedef double (*CoinPartitionReduceFunction)(const CoinPartitionedVector *vector,
+  int partition, void *info);
+
 class COINUTILSLIB_EXPORT CoinPartitionedVector : public CoinIndexedVector {
 
 public:
@@ -1362,6 +1618,9 @@ public:
 #endif
   /// Scan dense region and set up indices (returns number found)
   int scan(int partition, double tolerance = 0.0);
+  /** Drop elements of a partition with absolute value less than tolerance
+      (returns number left) */
+  int cleanPartition(int partition, double tolerance);
   /** Scan dense region from start to < end and set up indices
        returns number found
    */
@@ -1375,6 +1634,49 @@ public:
   void sort();
   //@}
 
+  /**@name Parallel partition operations
+
+     Each partition is a separate task on a CoinThreadPool, so results are
+     exactly those of doing partitions one after another.  compact,
+     clearAndReset and clearAndKeep also use the threads.  Small vectors
+     are always done serially.
+  */
+  //@{
+  /** Set number of threads used on partitions (values less than one mean
+      number of processors).  Default is 1 i.e. serial.
+  */
+  void setNumberThreads(int numberThreads);
+  /// Number of threads used on partitions
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /// Scan dense region of every partition (returns total number found)
+  int scanPartitions(double tolerance = 0.0);
+  /** Drop elements of every partition with absolute value less than
+      tolerance (returns total number left) */
+  int cleanPartitions(double tolerance);
+  /** Run function(this, partition, info) for every partition.  A call
+      must only change its own partition.  Threads are used whenever there
+      is more than one thread and partition.
+  */
+  void runPartitions(CoinPartitionFunction function, void *info);
+  /** As runPartitions but adds up values returned.  Values are added in
+      partition order so the sum does not depend on the number of threads.
+  */
+  double reducePartitions(CoinPartitionReduceFunction function, void *info);
+  /** Call function(vector, partition) for every partition as
+      runPartitions.  \p function is a function object (or lambda) taking
+      (CoinPartitionedVector &, int).
+  */
+  template < class Function >
+  void forEachPartition(const Function &function)
+  {
+    runPartitions(callPartition< Function >,
+      const_cast< void * >(static_cast< const void * >(&function)));
+  }
+  //@}
+
   /**@name Constructors and destructors (not all wriiten) */
   //@{
   /** Default constructor */
@@ -1406,7 +1708,27 @@ protected:
   int numberElementsPartition_[COIN_PARTITIONS];
   /// Number of partitions (0 means off)
   int numberPartitions_;
+  /// Number of threads used on partitions
+  int numberThreads_;
+  /// Threads for partitions (created when first needed)
+  CoinThreadPool *threadPool_;
   //@}
+
+private:
+  /// Run function on all partitions - threaded if worth it for work
+  void doPartitions(CoinPartitionFunction function, void *info, int work);
+  /// Tasks for parallel operations
+  static void scanTask(CoinPartitionedVector *vector, int partition, void *info);
+  static void cleanTask(CoinPartitionedVector *vector, int partition, void *info);
+  static void clearTask(CoinPartitionedVector *vector, int partition, void *info);
+  static void compactTask(CoinPartitionedVector *vector, int partition, void *info);
+  /// Calls function object for forEachPartition
+  template < class Function >
+  static void callPartition(CoinPartitionedVector *vector, int partition,
+    void *info)
+  {
+    (*static_cast< const Function * >(info))(*vector, partition);
+  }
 };
 inline double *roundUpDouble(double *address)
 {
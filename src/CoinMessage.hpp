@@ -67,6 +67,7 @@ enum COIN_Message {
   COIN_CGRAPH_FIX_VAR,
   COIN_CGRAPH_FIX_VAR_DIFFER_MIPSTART,
   COIN_CGRAPH_INFEASIBLE_IMPLICATION,
+  COIN_MPS_BADBINARY,
   COIN_DUMMY_END
 };
 
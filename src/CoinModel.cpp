@@ -2069,6 +2069,58 @@ int CoinModel::createArrays(double *&rowLower, double *&rowUpper,
  */
 int CoinModel::writeMps(const char *filename, int compression,
   int formatType, int numberAcross, bool keepStrings)
+{
+  CoinMpsIO writer;
+  loadWriter(writer, keepStrings);
+  return writer.writeMps(filename, compression, formatType, numberAcross);
+}
+/* Write the problem in binary format to a file with the given filename.
+ */
+int CoinModel::writeBinary(const char *filename, int compression)
+{
+  CoinMpsIO writer;
+  loadWriter(writer, false);
+  return writer.writeBinary(filename, compression);
+}
+/* Replace model by one read from a file written by writeBinary.
+ */
+int CoinModel::readBinary(const char *fileName)
+{
+  CoinMpsIO m;
+  m.setInfinity(COIN_DBL_MAX);
+  int status = m.readBinary(fileName, "");
+  if (status)
+    return status;
+  CoinModel model;
+  model.setLogLevel(logLevel_);
+  model.problemName_ = m.getProblemName();
+  model.objectiveOffset_ = m.objectiveOffset();
+  int numberRows = m.getNumRows();
+  int numberColumns = m.getNumCols();
+  const double *rowLower = m.getRowLower();
+  const double *rowUpper = m.getRowUpper();
+  for (int i = 0; i < numberRows; i++) {
+    model.setRowBounds(i, rowLower[i], rowUpper[i]);
+    model.setRowName(i, m.rowName(i));
+  }
+  const CoinPackedMatrix *matrix = m.getMatrixByCol();
+  const double *element = matrix->getElements();
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  const double *columnLower = m.getColLower();
+  const double *columnUpper = m.getColUpper();
+  const double *objective = m.getObjCoefficients();
+  for (int i = 0; i < numberColumns; i++) {
+    model.addColumn(columnLength[i], row + columnStart[i],
+      element + columnStart[i], columnLower[i], columnUpper[i],
+      objective[i], m.columnName(i), m.isInteger(i));
+  }
+  *this = model;
+  return 0;
+}
+// Loads writer for writeMps and writeBinary
+int CoinModel::loadWriter(CoinMpsIO &writer, bool keepStrings)
 {
   int numberErrors = 0;
   // Set arrays for normal use
@@ -2101,7 +2153,6 @@ int CoinModel::writeMps(const char *filename, int compression,
     }
   }
 
-  CoinMpsIO writer;
   writer.setInfinity(COIN_DBL_MAX);
   const char *const *rowNames = NULL;
   if (rowName_.numberItems())
@@ -2132,7 +2183,7 @@ int CoinModel::writeMps(const char *filename, int compression,
     // load up strings - sorted by column and row
     writer.copyStringElements(this);
   }
-  return writer.writeMps(filename, compression, formatType, numberAcross);
+  return numberErrors;
 }
 /* Check two models against each other.  Return nonzero if different.
    Ignore names if that set.
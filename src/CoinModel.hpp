@@ -9,6 +9,7 @@
 #include "CoinMessageHandler.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
+class CoinMpsIO;
 class COINUTILSLIB_EXPORT CoinBaseModel {
 
 public:
@@ -475,6 +476,15 @@ public:
   int writeMps(const char *filename, int compression = 0,
     int formatType = 0, int numberAcross = 2, bool keepStrings = false);
 
+  /** Write the problem in binary format (see CoinMpsIO::writeBinary).
+      String elements are evaluated as for writeMps.
+  */
+  int writeBinary(const char *filename, int compression = 0);
+  /** Replace model by one read from a file written by writeBinary.
+      Return codes as CoinMpsIO::readBinary.
+  */
+  int readBinary(const char *fileName);
+
   /** Check two models against each other.  Return nonzero if different.
       Ignore names if that set.
       May modify both models by cleaning up
@@ -1018,6 +1028,8 @@ public:
   void validateLinks() const;
   //@}
 private:
+  /// Loads writer for writeMps and writeBinary - returns number of errors
+  int loadWriter(CoinMpsIO &writer, bool keepStrings);
   /// Resize
   void resize(int maximumRows, int maximumColumns, CoinBigIndex maximumElements);
   /// Fill in default row information
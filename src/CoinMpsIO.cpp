@@ -22,6 +22,7 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinModel.hpp"
 #include "CoinSort.hpp"
+#include "CoinThreadPool.hpp"
 //#############################################################################
 // type - 0 normal, 1 INTEL IEEE, 2 other IEEE
 
@@ -481,6 +482,189 @@ void CoinMpsCardReader::strcpyAndCompress(char *to, const char *from)
   to[nto] = '\0';
 }
 
+// Sets section from section card
+COINSectionType
+CoinMpsCardReader::sectionFromCard()
+{
+  int i;
+
+  handler_->message(COIN_MPS_LINE, messages_) << cardNumber_
+                                              << card_ << CoinMessageEol;
+  for (i = COIN_ROW_SECTION; i < COIN_UNKNOWN_SECTION; i++) {
+    if (!strncmp(card_, section[i], strlen(section[i]))) {
+      break;
+    }
+  }
+  position_ = card_;
+  eol_ = card_;
+  section_ = static_cast< COINSectionType >(i);
+  return section_;
+}
+
+int CoinMpsCardReader::formatFlags() const
+{
+  return (freeFormat_ ? 1 : 0) | (eightChar_ ? 2 : 0)
+    | (stringsAllowed_ ? 4 : 0) | (ieeeFormat_ << 3);
+}
+
+void CoinMpsCardReader::setFormatFlags(int flags)
+{
+  freeFormat_ = (flags & 1) != 0;
+  eightChar_ = (flags & 2) != 0;
+  stringsAllowed_ = (flags & 4) != 0;
+  ieeeFormat_ = flags >> 3;
+}
+
+// Reads rest of section as raw cards - same tests as nextField
+CoinBigIndex
+CoinMpsCardReader::readSectionCards(std::vector< char > &cards,
+  const char *&start, const char *&end)
+{
+  CoinMappedFileInput *mapped = dynamic_cast< CoinMappedFileInput * >(input_);
+  if (mapped) {
+    // Find cards in place - give up if anything is not simple
+    const char *data = mapped->data();
+    const char *endData = data + mapped->size();
+    const char *line = data + mapped->position();
+    CoinBigIndex numberCards = 0;
+    start = line;
+    while (line != endData) {
+      const char *endLine = static_cast< const char * >(memchr(line, '\n', endData - line));
+      endLine = endLine ? endLine + 1 : endData;
+      if (endLine - line >= MAX_CARD_LENGTH - 1)
+        break; // gets would split card
+      // first character of card after cleanCard
+      unsigned char first = *line;
+      if (first == '\t') {
+        // tab followed by nothing but blanks is an empty card
+        const char *look = line;
+        while (look != endLine && (*look == '\t' || *look == ' '))
+          look++;
+        if (look == endLine || static_cast< unsigned char >(*look) < ' ')
+          first = '\0';
+      }
+      if (first == ' ' || first == '*' || (first < ' ' && first != '\t')) {
+        // data, blank or comment
+        numberCards++;
+        line = endLine;
+      } else {
+        end = line;
+        mapped->setPosition(line - data);
+        cardNumber_ += numberCards;
+        cleanCard();
+        return numberCards;
+      }
+    }
+    // long card or no section card - copy instead
+  }
+  CoinBigIndex numberCards = 0;
+  while (true) {
+    if (cleanCard())
+      numberCards = -1;
+    else if (card_[0] == ' ' || card_[0] == '\0' || card_[0] == '*') {
+      // data, blank or comment
+      cards.insert(cards.end(), card_, card_ + strlen(card_));
+      cards.push_back('\n');
+      numberCards++;
+      continue;
+    }
+    start = cards.size() ? &cards[0] : NULL;
+    end = start + cards.size();
+    return numberCards;
+  }
+}
+
+namespace {
+/* Input from memory - used for chunks of a section read in parallel
+   and for putting cards back in front of a file.
+   Unlike fgets a newline just after a full buffer is swallowed, so
+   cards stored by readSectionCards come back exactly as they were read.
+*/
+class CoinMpsMemoryInput : public CoinFileInput {
+public:
+  // Takes cards (leaving vector empty) and then reads from next
+  CoinMpsMemoryInput(std::vector< char > &cards, CoinFileInput *next)
+    : CoinFileInput(next->getFileName())
+    , position_(NULL)
+    , end_(NULL)
+    , next_(next)
+  {
+    readType_ = next->getReadType();
+    data_.swap(cards);
+    if (data_.size()) {
+      position_ = &data_[0];
+      end_ = position_ + data_.size();
+    }
+  }
+  // Reads from memory owned by someone else
+  CoinMpsMemoryInput(const char *start, const char *end)
+    : CoinFileInput("")
+    , position_(start)
+    , end_(end)
+    , next_(NULL)
+  {
+    readType_ = "memory";
+  }
+  virtual ~CoinMpsMemoryInput()
+  {
+    delete next_;
+  }
+  virtual int read(void *buffer, int size)
+  {
+    int n = static_cast< int >(CoinMin(static_cast< CoinBigIndex >(size),
+      static_cast< CoinBigIndex >(end_ - position_)));
+    memcpy(buffer, position_, n);
+    position_ += n;
+    if (n < size && next_)
+      n += next_->read(reinterpret_cast< char * >(buffer) + n, size - n);
+    return n;
+  }
+  virtual char *gets(char *buffer, int size)
+  {
+    if (position_ == end_)
+      return next_ ? next_->gets(buffer, size) : NULL;
+    int n = 0;
+    while (position_ != end_ && n < size - 1) {
+      char thisChar = *position_++;
+      buffer[n++] = thisChar;
+      if (thisChar == '\n')
+        break;
+    }
+    if (position_ != end_ && *position_ == '\n' && buffer[n - 1] != '\n')
+      position_++;
+    buffer[n] = '\0';
+    return buffer;
+  }
+
+private:
+  std::vector< char > data_;
+  const char *position_;
+  const char *end_;
+  CoinFileInput *next_;
+};
+} // end file-local namespace
+
+void CoinMpsCardReader::unreadCards(std::vector< char > &cards,
+  const char *start, CoinBigIndex cardNumber, COINSectionType section,
+  bool withCard)
+{
+  CoinMappedFileInput *mapped = dynamic_cast< CoinMappedFileInput * >(input_);
+  if (mapped && start >= mapped->data() && start <= mapped->data() + mapped->size()) {
+    // cards were never copied
+    mapped->setPosition(start - mapped->data());
+  } else {
+    if (withCard) {
+      cards.insert(cards.end(), card_, card_ + strlen(card_));
+      cards.push_back('\n');
+    }
+    input_ = new CoinMpsMemoryInput(cards, input_);
+  }
+  cardNumber_ = cardNumber;
+  section_ = section;
+  position_ = card_;
+  eol_ = card_;
+}
+
 //  nextField
 COINSectionType
 CoinMpsCardReader::nextField()
@@ -836,19 +1020,7 @@ CoinMpsCardReader::nextField()
       return section_;
     } else if (card_[0] != '*') {
       // not a comment
-      int i;
-
-      handler_->message(COIN_MPS_LINE, messages_) << cardNumber_
-                                                  << card_ << CoinMessageEol;
-      for (i = COIN_ROW_SECTION; i < COIN_UNKNOWN_SECTION; i++) {
-        if (!strncmp(card_, section[i], strlen(section[i]))) {
-          break;
-        }
-      }
-      position_ = card_;
-      eol_ = card_;
-      section_ = static_cast< COINSectionType >(i);
-      return section_;
+      return sectionFromCard();
     } else {
       // comment
     }
@@ -1582,6 +1754,326 @@ int CoinMpsIO::readMps()
   delete[] sets;
   return returnCode;
 }
+void CoinMpsIO::setNumberThreads(int value)
+{
+  numberThreads_ = value > 0 ? value : CoinThreadPool::numberProcessors();
+}
+
+namespace {
+// One chunk of COLUMNS section read in parallel
+typedef struct {
+  // Input
+  const char *startCards;
+  const char *endCards;
+  // Format at start of chunk
+  int format;
+  CoinMpsCardReader *reader;
+  const CoinMpsIO *model;
+  int numberRows;
+  double smallElement;
+  // Output - false if serial reader must be used
+  bool ok;
+  // Per column (integer 2 means as at end of previous chunk)
+  std::vector< char * > name;
+  std::vector< char > integer;
+  std::vector< double > objective;
+  std::vector< char > objectiveUsed;
+  std::vector< CoinBigIndex > start;
+  // Elements
+  std::vector< COINRowIndex > row;
+  std::vector< double > element;
+  // Last marker (-1 none, 0 INTEND, 1 INTORG)
+  int integerAtEnd;
+} CoinMpsColumnChunk;
+
+/* Reads a chunk of the COLUMNS section as readMps would.
+   Anything which would give a message stops the chunk so the
+   section can be read again serially. */
+void readColumnChunk(void *info, int which)
+{
+  CoinMpsColumnChunk *chunk = reinterpret_cast< CoinMpsColumnChunk * >(info) + which;
+  CoinMpsCardReader *reader = chunk->reader;
+  const CoinMpsIO *model = chunk->model;
+  int numberRows = chunk->numberRows;
+  double smallElement = chunk->smallElement;
+  // for duplicates
+  CoinBigIndex *rowUsed = new CoinBigIndex[numberRows];
+  for (int i = 0; i < numberRows; i++)
+    rowUsed[i] = -1;
+  char lastColumn[200];
+  lastColumn[0] = '\0';
+  char inIntegerSet = 2;
+  for (size_t i = 0; i < chunk->name.size(); i++)
+    free(chunk->name[i]);
+  chunk->name.clear();
+  chunk->integer.clear();
+  chunk->objective.clear();
+  chunk->objectiveUsed.clear();
+  chunk->start.clear();
+  chunk->row.clear();
+  chunk->element.clear();
+  chunk->integerAtEnd = -1;
+  chunk->ok = true;
+  while (chunk->ok && reader->nextField() == COIN_COLUMN_SECTION) {
+    switch (reader->mpsType()) {
+    case COIN_BLANK_COLUMN:
+      if (strcmp(lastColumn, reader->columnName())) {
+        // new column - reset old one
+        if (chunk->start.size()) {
+          CoinBigIndex numberElements = static_cast< CoinBigIndex >(chunk->row.size());
+          for (CoinBigIndex i = chunk->start.back(); i < numberElements; i++)
+            rowUsed[chunk->row[i]] = -1;
+        }
+        strcpy(lastColumn, reader->columnName());
+        chunk->name.push_back(CoinStrdup(lastColumn));
+        chunk->integer.push_back(inIntegerSet);
+        chunk->objective.push_back(0.0);
+        chunk->objectiveUsed.push_back(0);
+        chunk->start.push_back(static_cast< CoinBigIndex >(chunk->row.size()));
+      }
+      if (fabs(reader->value()) > smallElement) {
+        COINRowIndex irow = model->rowIndex(reader->rowName());
+        double value = reader->value();
+        if (irow < 0) {
+          chunk->ok = false;
+        } else if (irow == numberRows) {
+          // objective
+          if (chunk->objectiveUsed.back()) {
+            chunk->ok = false;
+          } else {
+            chunk->objectiveUsed.back() = 1;
+            if (fabs(value) <= smallElement)
+              value = 0.0;
+            chunk->objective.back() = value;
+          }
+        } else if (irow < numberRows) {
+          if (rowUsed[irow] >= 0) {
+            chunk->ok = false;
+          } else {
+            rowUsed[irow] = static_cast< CoinBigIndex >(chunk->row.size());
+            chunk->row.push_back(irow);
+            chunk->element.push_back(value);
+          }
+        }
+      } else if (reader->value() == STRING_VALUE) {
+        chunk->ok = false;
+      }
+      break;
+    case COIN_INTORG:
+      inIntegerSet = 1;
+      chunk->integerAtEnd = 1;
+      break;
+    case COIN_INTEND:
+      inIntegerSet = 0;
+      chunk->integerAtEnd = 0;
+      break;
+    default:
+      chunk->ok = false;
+    }
+  }
+  delete[] rowUsed;
+}
+} // end file-local namespace
+
+bool CoinMpsIO::readColumnsParallel(COINMpsType *&columnType, char **&columnName,
+  CoinBigIndex *&start, COINRowIndex *&row, double *&element,
+  COINColumnIndex &numberIntegers)
+{
+  CoinBigIndex firstCard = cardReader_->cardNumber();
+  std::vector< char > cards;
+  const char *startCards;
+  const char *endCards;
+  CoinBigIndex numberCards = cardReader_->readSectionCards(cards, startCards, endCards);
+  if (numberCards <= 0) {
+    // end of file or empty - let serial code deal with it
+    cardReader_->unreadCards(cards, startCards, firstCard, COIN_COLUMN_SECTION,
+      numberCards == 0);
+    return false;
+  }
+  // Split at card boundaries
+  int numberChunks = numberThreads_;
+  std::vector< CoinMpsColumnChunk > chunks(numberChunks);
+  const char *startChunk = startCards;
+  size_t sizeCards = endCards - startCards;
+  for (int iChunk = 0; iChunk < numberChunks; iChunk++) {
+    const char *endChunk = startCards + (sizeCards * (iChunk + 1)) / numberChunks;
+    if (endChunk < startChunk)
+      endChunk = startChunk;
+    while (endChunk != endCards && endChunk[-1] != '\n')
+      endChunk++;
+    CoinMpsColumnChunk &chunk = chunks[iChunk];
+    chunk.startCards = startChunk;
+    chunk.endCards = endChunk;
+    chunk.format = cardReader_->formatFlags();
+    chunk.reader = NULL;
+    chunk.model = this;
+    chunk.numberRows = numberRows_;
+    chunk.smallElement = smallElement_;
+    startChunk = endChunk;
+  }
+  /*
+    A card may change format (typically first non fixed format card
+    switches to free format).  Chunks after that were read with wrong
+    format so are read again with correct one.  As format changes are
+    rare and one way, this is normally at most one extra pass.
+  */
+  CoinThreadPool pool(numberThreads_);
+  int firstChunk = 0;
+  bool ok = true;
+  while (firstChunk < numberChunks && ok) {
+    for (int iChunk = firstChunk; iChunk < numberChunks; iChunk++) {
+      CoinMpsColumnChunk &chunk = chunks[iChunk];
+      delete chunk.reader;
+      chunk.reader = new CoinMpsCardReader(new CoinMpsMemoryInput(chunk.startCards, chunk.endCards), this);
+      chunk.reader->setFormatFlags(chunk.format);
+      chunk.reader->setWhichSection(COIN_COLUMN_SECTION);
+    }
+    pool.run(numberChunks - firstChunk, readColumnChunk, &chunks[firstChunk]);
+    int nextChunk = numberChunks;
+    for (int iChunk = firstChunk; iChunk < numberChunks; iChunk++) {
+      CoinMpsColumnChunk &chunk = chunks[iChunk];
+      if (!chunk.ok) {
+        ok = false;
+        break;
+      }
+      int format = chunk.reader->formatFlags();
+      if (iChunk < numberChunks - 1 && format != chunks[iChunk + 1].format) {
+        for (int jChunk = iChunk + 1; jChunk < numberChunks; jChunk++)
+          chunks[jChunk].format = format;
+        nextChunk = iChunk + 1;
+        break;
+      }
+    }
+    firstChunk = nextChunk;
+  }
+  int endFormat = chunks[numberChunks - 1].reader->formatFlags();
+  COINColumnIndex numberColumns = 0;
+  CoinBigIndex numberElements = 0;
+  for (int iChunk = 0; iChunk < numberChunks; iChunk++) {
+    CoinMpsColumnChunk &chunk = chunks[iChunk];
+    numberColumns += static_cast< COINColumnIndex >(chunk.name.size());
+    numberElements += static_cast< CoinBigIndex >(chunk.row.size());
+    delete chunk.reader;
+  }
+  // Merge - a column may be continued in next chunk
+  COINMpsType *newType = NULL;
+  char **newName = NULL;
+  double *newObjective = NULL;
+  CoinBigIndex *newStart = NULL;
+  COINRowIndex *newRow = NULL;
+  double *newElement = NULL;
+  COINColumnIndex numberNew = 0;
+  CoinBigIndex numberNewElements = 0;
+  int numberNewIntegers = 0;
+  if (ok) {
+    newType = reinterpret_cast< COINMpsType * >(malloc((numberColumns + 1) * sizeof(COINMpsType)));
+    newName = reinterpret_cast< char ** >(malloc((numberColumns + 1) * sizeof(char *)));
+    newObjective = reinterpret_cast< double * >(malloc((numberColumns + 1) * sizeof(double)));
+    newStart = reinterpret_cast< CoinBigIndex * >(malloc((numberColumns + 1) * sizeof(CoinBigIndex)));
+    newRow = reinterpret_cast< COINRowIndex * >(malloc((numberElements + 1) * sizeof(COINRowIndex)));
+    newElement = reinterpret_cast< double * >(malloc((numberElements + 1) * sizeof(double)));
+    // marks rows of last column of a chunk (for duplicates across chunks)
+    CoinBigIndex *rowUsed = new CoinBigIndex[numberRows_];
+    for (int i = 0; i < numberRows_; i++)
+      rowUsed[i] = -1;
+    bool lastMarked = false;
+    bool lastObjectiveUsed = false;
+    char inIntegerSet = 0;
+    for (int iChunk = 0; iChunk < numberChunks && ok; iChunk++) {
+      CoinMpsColumnChunk &chunk = chunks[iChunk];
+      int numberInChunk = static_cast< int >(chunk.name.size());
+      CoinBigIndex endChunk = static_cast< CoinBigIndex >(chunk.row.size());
+      for (int j = 0; j < numberInChunk && ok; j++) {
+        CoinBigIndex startColumn = chunk.start[j];
+        CoinBigIndex endColumn = (j < numberInChunk - 1) ? chunk.start[j + 1] : endChunk;
+        bool continued = (!j && numberNew && !strcmp(chunk.name[0], newName[numberNew - 1]));
+        if (continued) {
+          free(chunk.name[0]);
+          chunk.name[0] = NULL;
+          if (chunk.objectiveUsed[0]) {
+            if (lastObjectiveUsed)
+              ok = false;
+            newObjective[numberNew - 1] = chunk.objective[0];
+            lastObjectiveUsed = true;
+          }
+        } else {
+          if (lastMarked) {
+            for (CoinBigIndex i = newStart[numberNew - 1]; i < numberNewElements; i++)
+              rowUsed[newRow[i]] = -1;
+            lastMarked = false;
+          }
+          char integer = chunk.integer[j] == 2 ? inIntegerSet : chunk.integer[j];
+          if (integer) {
+            newType[numberNew] = COIN_INTORG;
+            numberNewIntegers++;
+          } else {
+            newType[numberNew] = COIN_UNSET_BOUND;
+          }
+          newName[numberNew] = chunk.name[j];
+          chunk.name[j] = NULL;
+          newObjective[numberNew] = chunk.objective[j];
+          lastObjectiveUsed = chunk.objectiveUsed[j] != 0;
+          newStart[numberNew] = numberNewElements;
+          numberNew++;
+        }
+        bool mark = continued || j == numberInChunk - 1;
+        for (CoinBigIndex i = startColumn; i < endColumn; i++) {
+          COINRowIndex irow = chunk.row[i];
+          if (mark) {
+            if (rowUsed[irow] >= 0)
+              ok = false;
+            rowUsed[irow] = numberNewElements;
+          }
+          newRow[numberNewElements] = irow;
+          newElement[numberNewElements++] = chunk.element[i];
+        }
+        if (mark)
+          lastMarked = true;
+      }
+      if (chunk.integerAtEnd >= 0)
+        inIntegerSet = static_cast< char >(chunk.integerAtEnd);
+    }
+    delete[] rowUsed;
+  }
+  for (int iChunk = 0; iChunk < numberChunks; iChunk++) {
+    CoinMpsColumnChunk &chunk = chunks[iChunk];
+    for (size_t j = 0; j < chunk.name.size(); j++)
+      free(chunk.name[j]);
+  }
+  if (!ok) {
+    for (COINColumnIndex i = 0; i < numberNew; i++)
+      free(newName[i]);
+    free(newType);
+    free(newName);
+    free(newObjective);
+    free(newStart);
+    free(newRow);
+    free(newElement);
+    // put cards back (including section card just read)
+    cardReader_->unreadCards(cards, startCards, firstCard, COIN_COLUMN_SECTION, true);
+    return false;
+  }
+  newStart[numberNew] = numberNewElements;
+  cardReader_->setFormatFlags(endFormat);
+  cardReader_->sectionFromCard();
+  free(columnType);
+  free(columnName);
+  free(objective_);
+  free(start);
+  free(row);
+  free(element);
+  columnType = newType;
+  columnName = newName;
+  objective_ = newObjective;
+  start = newStart;
+  row = newRow;
+  element = newElement;
+  numberColumns_ = numberNew;
+  numberElements_ = numberNewElements;
+  numberIntegers = numberNewIntegers;
+  return true;
+}
+
 int CoinMpsIO::readMps(int &numberSets, CoinSet **&sets)
 {
   bool ifmps;
@@ -1827,7 +2319,14 @@ int CoinMpsIO::readMps(int &numberSets, CoinSet **&sets)
     bool inIntegerSet = false;
     COINColumnIndex numberIntegers = 0;
 
-    while (cardReader_->nextField() == COIN_COLUMN_SECTION) {
+    if (numberThreads_ > 1 && !allowStringElements_
+      && readColumnsParallel(columnType, columnName, start, row, element,
+           numberIntegers)) {
+      // already got COLUMNS section and next section card
+      column = numberColumns_ - 1;
+    }
+    while (cardReader_->whichSection() == COIN_COLUMN_SECTION
+      && cardReader_->nextField() == COIN_COLUMN_SECTION) {
       switch (cardReader_->mpsType()) {
       case COIN_BLANK_COLUMN:
         if (strcmp(lastColumn, cardReader_->columnName())) {
@@ -4224,16 +4723,11 @@ strcpyeq(char *output, const char *input)
   strcpy(output + 1, input);
 }
 
-int CoinMpsIO::writeMps(const char *filename, int compression,
-  int formatType, int numberAcross,
-  CoinPackedMatrix *quadratic,
-  int numberSOS, const CoinSet *setInfo) const
+/* Creates output for writeMps and writeBinary - compression as writeMps,
+   falling back to other compression or plain file if not available */
+static CoinFileOutput *
+createOutput(const char *filename, int compression)
 {
-  // Clean up format and numberacross
-  numberAcross = std::max(1, numberAcross);
-  numberAcross = std::min(2, numberAcross);
-  formatType = std::max(0, formatType);
-  formatType = std::min(2, formatType);
   int possibleCompression = 0;
 #ifdef COINUTILS_HAS_ZLIB
   possibleCompression = 1;
@@ -4270,6 +4764,21 @@ int CoinMpsIO::writeMps(const char *filename, int compression,
     output = CoinFileOutput::create(line, CoinFileOutput::COMPRESS_NONE);
     break;
   }
+  return output;
+}
+
+int CoinMpsIO::writeMps(const char *filename, int compression,
+  int formatType, int numberAcross,
+  CoinPackedMatrix *quadratic,
+  int numberSOS, const CoinSet *setInfo) const
+{
+  // Clean up format and numberacross
+  numberAcross = std::max(1, numberAcross);
+  numberAcross = std::min(2, numberAcross);
+  formatType = std::max(0, formatType);
+  formatType = std::min(2, formatType);
+  CoinFileOutput *output = createOutput(filename, compression);
+  std::string line;
 
   // Set locale so won't get , instead of .
   char *saveLocale = strdup(setlocale(LC_ALL, NULL));
@@ -4873,6 +5382,456 @@ int CoinMpsIO::writeMps(const char *filename, int compression,
   return 0;
 }
 
+/*
+  Binary model files.  Everything is in native byte order and every block
+  starts on an eight byte boundary so the file can be used in place once
+  mapped into memory:
+
+    header (CoinBinaryModelHeader)
+    problem, objective, rhs, range and bound names (null terminated)
+    row lower, row upper (numberRows doubles each)
+    column lower, column upper, objective (numberColumns doubles each)
+    column starts (numberColumns+1 64 bit integers)
+    elements (numberElements doubles)
+    row indices (numberElements ints)
+    integer flags (numberColumns chars) if COIN_BINARY_INTEGER
+    row names then column names (null terminated) if COIN_BINARY_NAMES
+    end marker (same as magic)
+*/
+#define COIN_BINARY_VERSION 1
+#define COIN_BINARY_ENDIAN 0x01020304
+#define COIN_BINARY_INTEGER 1
+#define COIN_BINARY_NAMES 2
+static const char binaryMagic[8] = { 'C', 'o', 'i', 'n', 'B', 'i', 'n', '\0' };
+typedef struct {
+  char magic[8];
+  int version;
+  int endian;
+  int numberRows;
+  int numberColumns;
+  CoinInt64 numberElements;
+  int flags;
+  int isMaximization;
+  double objectiveOffset;
+  double infinity;
+  // sizes of name blocks (without padding)
+  CoinInt64 stringLength;
+  CoinInt64 rowNameLength;
+  CoinInt64 columnNameLength;
+} CoinBinaryModelHeader;
+
+// Writes block followed by padding to multiple of 8 bytes
+static bool
+writeBinaryBlock(CoinFileOutput *output, const void *data, size_t size)
+{
+  const char *put = reinterpret_cast< const char * >(data);
+  size_t left = size;
+  while (left) {
+    int n = static_cast< int >(CoinMin(left, static_cast< size_t >(1 << 30)));
+    if (output->write(put, n) != n)
+      return false;
+    put += n;
+    left -= n;
+  }
+  int pad = static_cast< int >((8 - (size & 7)) & 7);
+  const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  return !pad || output->write(zeros, pad) == pad;
+}
+
+// Reads block written by writeBinaryBlock
+static bool
+readBinaryBlock(CoinFileInput *input, void *data, size_t size)
+{
+  char *get = reinterpret_cast< char * >(data);
+  size_t left = size;
+  while (left) {
+    int n = static_cast< int >(CoinMin(left, static_cast< size_t >(1 << 30)));
+    if (input->read(get, n) != n)
+      return false;
+    get += n;
+    left -= n;
+  }
+  int pad = static_cast< int >((8 - (size & 7)) & 7);
+  char padding[8];
+  return !pad || input->read(padding, pad) == pad;
+}
+
+// Bytes taken by block written by writeBinaryBlock
+static inline CoinInt64
+binaryBlockLength(CoinInt64 size)
+{
+  return (size + 7) & ~static_cast< CoinInt64 >(7);
+}
+
+// Length of file described by header (-1 if sizes are silly)
+static CoinInt64
+binaryFileLength(const CoinBinaryModelHeader &header)
+{
+  // keeps sums below would-overflow
+  const CoinInt64 huge = static_cast< CoinInt64 >(1) << 56;
+  if (header.numberRows < 0 || header.numberColumns < 0
+    || header.numberElements < 0 || header.numberElements > huge
+    || header.stringLength < 0 || header.stringLength > huge
+    || header.rowNameLength < 0 || header.rowNameLength > huge
+    || header.columnNameLength < 0 || header.columnNameLength > huge)
+    return -1;
+  CoinInt64 numberRows = header.numberRows;
+  CoinInt64 numberColumns = header.numberColumns;
+  CoinInt64 length = binaryBlockLength(sizeof(header))
+    + binaryBlockLength(header.stringLength)
+    + 2 * numberRows * sizeof(double)
+    + 3 * numberColumns * sizeof(double)
+    + (numberColumns + 1) * sizeof(CoinInt64)
+    + header.numberElements * sizeof(double)
+    + binaryBlockLength(header.numberElements * sizeof(int));
+  if ((header.flags & COIN_BINARY_INTEGER) != 0)
+    length += binaryBlockLength(numberColumns);
+  if ((header.flags & COIN_BINARY_NAMES) != 0)
+    length += binaryBlockLength(header.rowNameLength)
+      + binaryBlockLength(header.columnNameLength);
+  // end marker
+  return length + 8;
+}
+
+namespace {
+/* Input from memory - used for rest of compressed binary model so its
+   length can be checked before anything is allocated from header */
+class CoinBinaryMemoryInput : public CoinFileInput {
+public:
+  CoinBinaryMemoryInput(const std::string &fileName, std::vector< char > &data)
+    : CoinFileInput(fileName)
+    , position_(0)
+  {
+    data_.swap(data);
+  }
+  virtual int read(void *buffer, int size)
+  {
+    int n = static_cast< int >(CoinMin(static_cast< size_t >(size),
+      data_.size() - position_));
+    if (n > 0)
+      memcpy(buffer, &data_[position_], n);
+    position_ += n;
+    return n;
+  }
+  virtual char *gets(char *, int)
+  {
+    return NULL;
+  }
+
+private:
+  std::vector< char > data_;
+  size_t position_;
+};
+}
+
+// Names laid end to end
+static std::vector< char >
+packNames(char **names, int number)
+{
+  std::vector< char > block;
+  for (int i = 0; i < number; i++) {
+    const char *name = names[i] ? names[i] : "";
+    block.insert(block.end(), name, name + strlen(name) + 1);
+  }
+  return block;
+}
+
+// Splits names laid end to end into malloc'ed strings - false if damaged
+static bool
+unpackNames(const std::vector< char > &block, char **names, int number)
+{
+  const char *name = block.size() ? &block[0] : NULL;
+  const char *end = name + block.size();
+  int i;
+  for (i = 0; i < number && name < end; i++) {
+    const char *endName = reinterpret_cast< const char * >(memchr(name, '\0', end - name));
+    if (!endName)
+      break;
+    names[i] = CoinStrdup(name);
+    name = endName + 1;
+  }
+  if (i < number || name != end) {
+    for (int j = 0; j < i; j++)
+      free(names[j]);
+    return false;
+  }
+  return true;
+}
+
+int CoinMpsIO::writeBinary(const char *filename, int compression) const
+{
+  const CoinPackedMatrix *matrix = matrixByColumn_;
+  CoinPackedMatrix copy;
+  if (matrix && matrix->hasGaps()) {
+    copy = *matrix;
+    copy.removeGaps();
+    matrix = &copy;
+  }
+  CoinBinaryModelHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, binaryMagic, 8);
+  header.version = COIN_BINARY_VERSION;
+  header.endian = COIN_BINARY_ENDIAN;
+  header.numberRows = numberRows_;
+  header.numberColumns = numberColumns_;
+  header.numberElements = matrix ? matrix->getNumElements() : 0;
+  header.flags = (integerType_ ? COIN_BINARY_INTEGER : 0)
+    | ((names_[0] && names_[1]) ? COIN_BINARY_NAMES : 0);
+  header.isMaximization = isMaximization_;
+  header.objectiveOffset = objectiveOffset_;
+  header.infinity = infinity_;
+  std::vector< char > strings;
+  const char *stringName[5] = { problemName_, objectiveName_, rhsName_,
+    rangeName_, boundName_ };
+  for (int i = 0; i < 5; i++) {
+    const char *name = stringName[i] ? stringName[i] : "";
+    strings.insert(strings.end(), name, name + strlen(name) + 1);
+  }
+  std::vector< char > rowNames;
+  std::vector< char > columnNames;
+  if ((header.flags & COIN_BINARY_NAMES) != 0) {
+    rowNames = packNames(names_[0], numberRows_);
+    columnNames = packNames(names_[1], numberColumns_);
+  }
+  header.stringLength = strings.size();
+  header.rowNameLength = rowNames.size();
+  header.columnNameLength = columnNames.size();
+  std::vector< CoinInt64 > starts(numberColumns_ + 1, 0);
+  if (matrix) {
+    const CoinBigIndex *columnStart = matrix->getVectorStarts();
+    for (int i = 0; i <= numberColumns_; i++)
+      starts[i] = columnStart[i];
+  }
+  CoinFileOutput *output = createOutput(filename, compression);
+  CoinBigIndex numberElements = static_cast< CoinBigIndex >(header.numberElements);
+  bool ok = writeBinaryBlock(output, &header, sizeof(header))
+    && writeBinaryBlock(output, &strings[0], strings.size())
+    && writeBinaryBlock(output, rowlower_, numberRows_ * sizeof(double))
+    && writeBinaryBlock(output, rowupper_, numberRows_ * sizeof(double))
+    && writeBinaryBlock(output, collower_, numberColumns_ * sizeof(double))
+    && writeBinaryBlock(output, colupper_, numberColumns_ * sizeof(double))
+    && writeBinaryBlock(output, objective_, numberColumns_ * sizeof(double))
+    && writeBinaryBlock(output, &starts[0], starts.size() * sizeof(CoinInt64))
+    && writeBinaryBlock(output, matrix ? matrix->getElements() : NULL,
+      numberElements * sizeof(double))
+    && writeBinaryBlock(output, matrix ? matrix->getIndices() : NULL,
+      numberElements * sizeof(int));
+  if (ok && integerType_)
+    ok = writeBinaryBlock(output, integerType_, numberColumns_);
+  if (ok && (header.flags & COIN_BINARY_NAMES) != 0)
+    ok = writeBinaryBlock(output, rowNames.size() ? &rowNames[0] : NULL, rowNames.size())
+      && writeBinaryBlock(output, columnNames.size() ? &columnNames[0] : NULL, columnNames.size());
+  if (ok)
+    ok = writeBinaryBlock(output, binaryMagic, 8);
+  delete output;
+  return ok ? 0 : -1;
+}
+
+int CoinMpsIO::readBinary(const char *filename, const char *extension)
+{
+  CoinFileInput *input = 0;
+  int returnCode = dealWithFileName(filename, extension, input);
+  if (returnCode < 0)
+    return -1;
+  if (!input) {
+    // same name as last file - open again
+    try {
+      input = CoinFileInput::create(fileName_);
+    } catch (CoinError &) {
+      handler_->message(COIN_MPS_FILE, messages_) << fileName_
+                                                  << CoinMessageEol;
+      return -1;
+    }
+  }
+  // names are only of use to readMps
+  free(fileName_);
+  fileName_ = NULL;
+  std::string name = input->getFileName();
+  CoinBinaryModelHeader header;
+  const char *problem = NULL;
+  if (!readBinaryBlock(input, &header, sizeof(header))
+    || memcmp(header.magic, binaryMagic, 8))
+    problem = "not a binary model";
+  else if (header.version != COIN_BINARY_VERSION)
+    problem = "unknown version";
+  else if (header.endian != COIN_BINARY_ENDIAN)
+    problem = "wrong byte order";
+  else if (binaryFileLength(header) < 0
+    || (header.numberElements > COIN_INT_MAX
+      && sizeof(CoinBigIndex) == sizeof(int)))
+    problem = "bad dimensions";
+  if (problem) {
+    delete input;
+    handler_->message(COIN_MPS_BADBINARY, messages_) << name << problem
+                                                     << CoinMessageEol;
+    return -2;
+  }
+  /* Header counts are only trusted if file is as long as they say, so a
+     damaged file can not ask for huge arrays.  Length of plain files is
+     known, compressed ones are uncompressed into memory (which only grows
+     as data arrives). */
+  CoinInt64 fileLength = binaryFileLength(header);
+  CoinInt64 available = -1;
+  if (CoinMappedFileInput *mapped = dynamic_cast< CoinMappedFileInput * >(input)) {
+    available = mapped->size();
+  } else if (input->getReadType() == "plain") {
+    FILE *fp = fopen(name.c_str(), "rb");
+    if (fp) {
+      if (!fseek(fp, 0, SEEK_END))
+        available = ftell(fp);
+      fclose(fp);
+    }
+  }
+  if (available < 0) {
+    CoinInt64 wanted = fileLength - binaryBlockLength(sizeof(header));
+    std::vector< char > data;
+    const int chunk = 1 << 20;
+    while (static_cast< CoinInt64 >(data.size()) <= wanted) {
+      size_t put = data.size();
+      data.resize(put + chunk);
+      int n = input->read(&data[put], chunk);
+      data.resize(put + CoinMax(n, 0));
+      if (n < chunk)
+        break;
+    }
+    available = binaryBlockLength(sizeof(header)) + data.size();
+    delete input;
+    input = new CoinBinaryMemoryInput(name, data);
+  }
+  bool ok = available == fileLength;
+  freeAll();
+  stringElements_ = NULL;
+  numberStringElements_ = 0;
+  maximumStringElements_ = 0;
+  // if damaged nothing is read and object is left empty
+  numberRows_ = ok ? header.numberRows : 0;
+  numberColumns_ = ok ? header.numberColumns : 0;
+  CoinBigIndex numberElements = ok ? static_cast< CoinBigIndex >(header.numberElements) : 0;
+  isMaximization_ = header.isMaximization;
+  objectiveOffset_ = header.objectiveOffset;
+  rowlower_ = reinterpret_cast< double * >(malloc(numberRows_ * sizeof(double)));
+  rowupper_ = reinterpret_cast< double * >(malloc(numberRows_ * sizeof(double)));
+  collower_ = reinterpret_cast< double * >(malloc(numberColumns_ * sizeof(double)));
+  colupper_ = reinterpret_cast< double * >(malloc(numberColumns_ * sizeof(double)));
+  objective_ = reinterpret_cast< double * >(malloc(numberColumns_ * sizeof(double)));
+  std::vector< char > strings(ok ? static_cast< size_t >(header.stringLength) : 0);
+  std::vector< CoinInt64 > starts(numberColumns_ + 1);
+  double *element = new double[numberElements];
+  int *row = new int[numberElements];
+  ok = ok && readBinaryBlock(input, strings.size() ? &strings[0] : NULL, strings.size())
+    && readBinaryBlock(input, rowlower_, numberRows_ * sizeof(double))
+    && readBinaryBlock(input, rowupper_, numberRows_ * sizeof(double))
+    && readBinaryBlock(input, collower_, numberColumns_ * sizeof(double))
+    && readBinaryBlock(input, colupper_, numberColumns_ * sizeof(double))
+    && readBinaryBlock(input, objective_, numberColumns_ * sizeof(double))
+    && readBinaryBlock(input, &starts[0], starts.size() * sizeof(CoinInt64))
+    && readBinaryBlock(input, element, numberElements * sizeof(double))
+    && readBinaryBlock(input, row, numberElements * sizeof(int));
+  if (ok && (header.flags & COIN_BINARY_INTEGER) != 0) {
+    integerType_ = reinterpret_cast< char * >(malloc(numberColumns_ * sizeof(char)));
+    ok = readBinaryBlock(input, integerType_, numberColumns_);
+  }
+  std::vector< char > rowNames;
+  std::vector< char > columnNames;
+  if (ok && (header.flags & COIN_BINARY_NAMES) != 0) {
+    rowNames.resize(static_cast< size_t >(header.rowNameLength));
+    columnNames.resize(static_cast< size_t >(header.columnNameLength));
+    ok = readBinaryBlock(input, rowNames.size() ? &rowNames[0] : NULL, rowNames.size())
+      && readBinaryBlock(input, columnNames.size() ? &columnNames[0] : NULL, columnNames.size());
+  }
+  char endMarker[8];
+  ok = ok && readBinaryBlock(input, endMarker, 8) && !memcmp(endMarker, binaryMagic, 8);
+  delete input;
+  // check matrix
+  CoinBigIndex *start = new CoinBigIndex[numberColumns_ + 1];
+  int *length = new int[numberColumns_];
+  ok = ok && !starts[0] && starts[numberColumns_] == numberElements;
+  for (int i = 0; ok && i < numberColumns_; i++) {
+    start[i] = static_cast< CoinBigIndex >(starts[i]);
+    length[i] = static_cast< int >(starts[i + 1] - starts[i]);
+    ok = starts[i + 1] >= starts[i];
+  }
+  start[numberColumns_] = numberElements;
+  for (CoinBigIndex j = 0; ok && j < numberElements; j++)
+    ok = row[j] >= 0 && row[j] < numberRows_;
+  // five names
+  const char *stringName[5] = { "", "", "", "", "" };
+  const char *endStrings = strings.size() ? &strings[0] + strings.size() : NULL;
+  const char *nextString = strings.size() ? &strings[0] : NULL;
+  for (int i = 0; ok && i < 5; i++) {
+    const char *endName = NULL;
+    if (nextString < endStrings)
+      endName = reinterpret_cast< const char * >(memchr(nextString, '\0', endStrings - nextString));
+    if (endName) {
+      stringName[i] = nextString;
+      nextString = endName + 1;
+    } else {
+      ok = false;
+    }
+  }
+  problemName_ = CoinStrdup(stringName[0]);
+  objectiveName_ = CoinStrdup(stringName[1]);
+  rhsName_ = CoinStrdup(stringName[2]);
+  rangeName_ = CoinStrdup(stringName[3]);
+  boundName_ = CoinStrdup(stringName[4]);
+  if (ok && (header.flags & COIN_BINARY_NAMES) != 0) {
+    names_[0] = reinterpret_cast< char ** >(malloc(numberRows_ * sizeof(char *)));
+    names_[1] = reinterpret_cast< char ** >(malloc(numberColumns_ * sizeof(char *)));
+    if (unpackNames(rowNames, names_[0], numberRows_))
+      numberHash_[0] = numberRows_;
+    else
+      ok = false;
+    if (ok && unpackNames(columnNames, names_[1], numberColumns_))
+      numberHash_[1] = numberColumns_;
+    else
+      ok = false;
+  }
+  if (!ok) {
+    delete[] element;
+    delete[] row;
+    delete[] start;
+    delete[] length;
+    freeAll();
+    problemName_ = CoinStrdup("");
+    objectiveName_ = CoinStrdup("");
+    rhsName_ = CoinStrdup("");
+    rangeName_ = CoinStrdup("");
+    boundName_ = CoinStrdup("");
+    numberRows_ = 0;
+    numberColumns_ = 0;
+    numberElements_ = 0;
+    handler_->message(COIN_MPS_BADBINARY, messages_) << name << "damaged"
+                                                     << CoinMessageEol;
+    return -3;
+  }
+  if ((header.flags & COIN_BINARY_NAMES) == 0)
+    setMpsDataColAndRowNames(static_cast< char const *const * >(NULL),
+      static_cast< char const *const * >(NULL));
+  numberElements_ = numberElements;
+  matrixByColumn_ = new CoinPackedMatrix();
+  matrixByColumn_->assignMatrix(true, numberRows_, numberColumns_,
+    numberElements, element, row, start, length);
+  if (header.infinity != infinity_) {
+    // use our infinity
+    double *array[4] = { rowlower_, rowupper_, collower_, colupper_ };
+    int number[4] = { numberRows_, numberRows_, numberColumns_, numberColumns_ };
+    for (int k = 0; k < 4; k++) {
+      for (int i = 0; i < number[k]; i++) {
+        if (array[k][i] >= header.infinity)
+          array[k][i] = infinity_;
+        else if (array[k][i] <= -header.infinity)
+          array[k][i] = -infinity_;
+      }
+    }
+  }
+  handler_->message(COIN_MPS_STATS, messages_) << problemName_
+                                               << numberRows_
+                                               << numberColumns_
+                                               << numberElements_
+                                               << CoinMessageEol;
+  return 0;
+}
+
 //------------------------------------------------------------------
 // Problem name
 const char *CoinMpsIO::getProblemName() const
@@ -5530,6 +6489,7 @@ CoinMpsIO::CoinMpsIO()
   , numberStringElements_(0)
   , stringElements_(NULL)
   , isMaximization_(0)
+  , numberThreads_(1)
 {
   numberHash_[0] = 0;
   hash_[0] = NULL;
@@ -5576,6 +6536,7 @@ CoinMpsIO::CoinMpsIO(const CoinMpsIO &rhs)
   , numberStringElements_(rhs.numberStringElements_)
   , stringElements_(NULL)
   , isMaximization_(0)
+  , numberThreads_(rhs.numberThreads_)
 {
   numberHash_[0] = 0;
   hash_[0] = NULL;
@@ -5692,6 +6653,7 @@ CoinMpsIO::operator=(const CoinMpsIO &rhs)
     else
       handler_ = rhs.handler_;
     messages_ = CoinMessage();
+    numberThreads_ = rhs.numberThreads_;
   }
   return *this;
 }
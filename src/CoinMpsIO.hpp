@@ -209,6 +209,32 @@ public:
   {
     stringsAllowed_ = true;
   }
+  /** Format (free, IEEE, eight character names, strings) packed in an int.
+      Reading may change it (e.g. to free format) as cards are seen */
+  int formatFlags() const;
+  /// Sets format as returned by formatFlags
+  void setFormatFlags(int flags);
+  /** Finds rest of current section as raw cards.
+
+      If the input is a memory mapped file the cards are left where they
+      are, otherwise each card is cleaned and stored in cards followed by
+      a newline.  Either way start and end delimit the cards.
+      Stops at next section card, which is left in card() but not yet
+      processed (see sectionFromCard).  Returns number of cards or
+      -1 if end of file was reached.
+  */
+  CoinBigIndex readSectionCards(std::vector< char > &cards,
+    const char *&start, const char *&end);
+  /** Puts cards found by readSectionCards back in front of input so they
+      will be read again (with section card if withCard true).
+
+      Card number and section are reset to given values (i.e. as they
+      were before readSectionCards).
+  */
+  void unreadCards(std::vector< char > &cards, const char *start,
+    CoinBigIndex cardNumber, COINSectionType section, bool withCard);
+  /// Sets section from section card in card() (as nextField would)
+  COINSectionType sectionFromCard();
   //@}
 
   ////////////////// data //////////////////
@@ -662,6 +688,22 @@ public:
   {
     smallElement_ = value;
   }
+  /** Number of threads used by readMps (default 1).
+
+      With more than one thread the COLUMNS section is read into memory,
+      split into chunks and each chunk is parsed on its own thread.  The
+      result is identical to reading serially; if anything in the section
+      needs a message (duplicates, unknown rows, strings, ...) or changes
+      the card format, the section is simply read again serially.
+      Threads are only used if CoinUtils was configured with
+      --enable-coinutils-threads.
+  */
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /// Set number of threads used by readMps (0 means one per processor)
+  void setNumberThreads(int value);
   /// Return true if maximization problem reformulated as minimization
   inline bool wasMaximization() const
   {
@@ -802,6 +844,30 @@ public:
     CoinPackedMatrix *quadratic = NULL,
     int numberSOS = 0, const CoinSet *setInfo = NULL) const;
 
+  /** Write the problem in binary format to a file with the given filename.
+
+	The binary format holds the column ordered matrix, bounds,
+	objective, integrality and names (but not quadratic data, sets or
+	string elements) as raw arrays in native byte order, so readBinary
+	needs no parsing and no name hashing.  Each array starts on an
+	eight byte boundary so a plain file can also be used in place after
+	mapping it into memory.  compression is as for writeMps.
+	Returns 0 on success, -1 on a write error.
+    */
+  int writeBinary(const char *filename, int compression = 0) const;
+
+  /** Read a problem written by writeBinary.
+
+	Compressed files are read as for readMps; plain files are memory
+	mapped (see CoinFileInput) so arrays are copied straight from the
+	file.  Returns 0 on success, -1 if the file can not be opened, -2 if
+	it is not a binary model of this version and byte order and -3 if
+	it is damaged (the object is then empty).  Nothing is allocated from
+	the counts in the header unless the file has exactly the length they
+	imply, so a truncated file gives -3 rather than a huge allocation.
+    */
+  int readBinary(const char *filename, const char *extension = "cbm");
+
   /// Return card reader object so can see what last card was e.g. QUADOBJ
   inline const CoinMpsCardReader *reader() const
   {
@@ -1001,6 +1067,16 @@ protected:
   void addString(int iRow, int iColumn, const char *value);
   /// Decode string
   void decodeString(int iString, int &iRow, int &iColumn, const char *&value) const;
+  /** Reads COLUMNS section using numberThreads_ threads.
+
+      On success the arrays are replaced (malloc'ed as in readMps) and
+      numberColumns_, numberElements_ and objective_ are set.  Returns
+      false if serial reading must be used - cards are then put back and
+      nothing has been changed.
+  */
+  bool readColumnsParallel(COINMpsType *&columnType, char **&columnName,
+    CoinBigIndex *&start, COINRowIndex *&row, double *&element,
+    COINColumnIndex &numberIntegers);
   //@}
 
   // for hashing
@@ -1142,6 +1218,8 @@ protected:
       -1 - maximization but currently treated as minimization
    */
   int isMaximization_;
+  /// Number of threads for reading
+  int numberThreads_;
 
   //@}
 };
@@ -0,0 +1,145 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+/*
+  Converts MPS files to the binary format of CoinMpsIO::writeBinary so
+  later runs can use CoinMpsIO::readBinary or CoinModel::readBinary.
+
+  CoinMpsToBinary [-threads n] [-gz|-bz2] [-check] input.mps[.gz] [output]
+
+  If output is not given it is input with .mps (and any compression
+  suffix) replaced by .cbm.  -check reads the binary file back and
+  compares it with the MPS file.
+*/
+
+#include "CoinUtilsConfig.h"
+#include "CoinMpsIO.hpp"
+#include "CoinTime.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void usage()
+{
+  fprintf(stderr, "usage: CoinMpsToBinary [-threads n] [-gz|-bz2] [-check] input.mps [output]\n");
+}
+
+// Returns true if the two problems are the same
+static bool sameModel(const CoinMpsIO &a, const CoinMpsIO &b)
+{
+  int numberRows = a.getNumRows();
+  int numberColumns = a.getNumCols();
+  if (numberRows != b.getNumRows() || numberColumns != b.getNumCols()
+    || a.getNumElements() != b.getNumElements())
+    return false;
+  for (int i = 0; i < numberRows; i++) {
+    if (a.getRowLower()[i] != b.getRowLower()[i]
+      || a.getRowUpper()[i] != b.getRowUpper()[i]
+      || strcmp(a.rowName(i), b.rowName(i)))
+      return false;
+  }
+  for (int i = 0; i < numberColumns; i++) {
+    if (a.getColLower()[i] != b.getColLower()[i]
+      || a.getColUpper()[i] != b.getColUpper()[i]
+      || a.getObjCoefficients()[i] != b.getObjCoefficients()[i]
+      || a.isInteger(i) != b.isInteger(i)
+      || strcmp(a.columnName(i), b.columnName(i)))
+      return false;
+  }
+  return a.getMatrixByCol()->isEquivalent2(*b.getMatrixByCol());
+}
+
+int main(int argc, const char *argv[])
+{
+  int numberThreads = 1;
+  int compression = 0;
+  bool check = false;
+  const char *inputName = NULL;
+  const char *outputName = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-threads") && i + 1 < argc) {
+      numberThreads = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-gz")) {
+      compression = 1;
+    } else if (!strcmp(argv[i], "-bz2")) {
+      compression = 2;
+    } else if (!strcmp(argv[i], "-check")) {
+      check = true;
+    } else if (argv[i][0] == '-' && argv[i][1]) {
+      usage();
+      return 1;
+    } else if (!inputName) {
+      inputName = argv[i];
+    } else if (!outputName) {
+      outputName = argv[i];
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (!inputName) {
+    usage();
+    return 1;
+  }
+  if (compression == 1 && !CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_GZIP)) {
+    fprintf(stderr, "gzip not available - writing plain file\n");
+    compression = 0;
+  } else if (compression == 2 && !CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_BZIP2)) {
+    fprintf(stderr, "bzip2 not available - writing plain file\n");
+    compression = 0;
+  }
+  std::string output;
+  if (outputName) {
+    output = outputName;
+  } else {
+    output = inputName;
+    const char *suffix[] = { ".gz", ".bz2", ".mps", ".MPS" };
+    for (int i = 0; i < 4; i++) {
+      size_t length = strlen(suffix[i]);
+      if (output.size() > length
+        && !output.compare(output.size() - length, length, suffix[i]))
+        output.erase(output.size() - length);
+    }
+    output += ".cbm";
+  }
+
+  CoinMpsIO model;
+  model.setNumberThreads(numberThreads);
+  double time1 = CoinGetTimeOfDay();
+  int numberErrors = model.readMps(inputName, "");
+  double time2 = CoinGetTimeOfDay();
+  if (numberErrors) {
+    fprintf(stderr, "%d errors reading %s\n", numberErrors, inputName);
+    return 1;
+  }
+  if (model.writeBinary(output.c_str(), compression)) {
+    fprintf(stderr, "Unable to write %s\n", output.c_str());
+    return 1;
+  }
+  double time3 = CoinGetTimeOfDay();
+  printf("%s read in %.2f seconds, %s written in %.2f seconds\n",
+    inputName, time2 - time1, output.c_str(), time3 - time2);
+  if (check) {
+    CoinMpsIO binary;
+    // writeBinary adds suffix if missing
+    const char *suffix = compression == 1 ? ".gz" : ".bz2";
+    size_t length = strlen(suffix);
+    if (compression && (output.size() <= length
+        || output.compare(output.size() - length, length, suffix)))
+      output += suffix;
+    int returnCode = binary.readBinary(output.c_str(), "");
+    double time4 = CoinGetTimeOfDay();
+    if (returnCode || !sameModel(model, binary)) {
+      fprintf(stderr, "%s does not match %s\n", output.c_str(), inputName);
+      return 1;
+    }
+    printf("%s read back in %.2f seconds and matches\n", output.c_str(),
+      time4 - time3);
+  }
+  return 0;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -56,6 +56,8 @@ void c_ekkftrn2(EKKfactinfo *fact, double *dwork1,
   double *dwork1_ft, int *mpt_ft, int *nincolp_ft);
 
 int c_ekklfct(EKKfactinfo *fact);
+int c_ekkbtju_levels(EKKfactinfo *fact, int *space);
+void c_ekkbtju_levels_move(EKKfactinfo *fact, int *space, int kpivrw);
 int c_ekkslcf(const EKKfactinfo *fact);
 inline void c_ekkscpy(int n, const int *marr1, int *marr2)
 {
@@ -12,6 +12,7 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
+#include "CoinThreadPool.hpp"
 #include <stdio.h>
 static void c_ekksmem(EKKfactinfo *fact, int numberRows, int maximumPivots);
 static void c_ekksmem_copy(EKKfactinfo *fact, const EKKfactinfo *rhsFact);
@@ -20,6 +21,9 @@ static void c_ekksmem_delete(EKKfactinfo *fact);
 //  CoinOslFactorization.  Constructor
 CoinOslFactorization::CoinOslFactorization()
   : CoinOtherFactorization()
+  , numberThreads_(1)
+  , threadPool_(NULL)
+  , levelSchedule_(NULL)
 {
   gutsOfInitialize();
 }
@@ -27,6 +31,9 @@ CoinOslFactorization::CoinOslFactorization()
 /// Copy constructor
 CoinOslFactorization::CoinOslFactorization(const CoinOslFactorization &other)
   : CoinOtherFactorization(other)
+  , numberThreads_(1)
+  , threadPool_(NULL)
+  , levelSchedule_(NULL)
 {
   gutsOfInitialize();
   gutsOfCopy(other);
@@ -43,9 +50,12 @@ void CoinOslFactorization::gutsOfDestructor(bool clearFact)
   delete[] elements_;
   delete[] pivotRow_;
   delete[] workArea_;
+  delete[] levelSchedule_;
   elements_ = NULL;
   pivotRow_ = NULL;
   workArea_ = NULL;
+  levelSchedule_ = NULL;
+  factInfo_.numberLevels = 0;
   numberRows_ = 0;
   numberColumns_ = 0;
   numberGoodU_ = 0;
@@ -90,6 +100,20 @@ void CoinOslFactorization::gutsOfInitialize(bool zapFact)
 CoinOslFactorization::~CoinOslFactorization()
 {
   gutsOfDestructor();
+  delete threadPool_;
+}
+// Sets number of threads
+void CoinOslFactorization::setNumberThreads(int value)
+{
+  if (value < 1)
+    value = CoinThreadPool::numberProcessors();
+  if (value != numberThreads_) {
+    numberThreads_ = value;
+    delete threadPool_;
+    threadPool_ = NULL;
+    // schedule (if any) points to old pool
+    factInfo_.numberLevels = 0;
+  }
 }
 //  =
 CoinOslFactorization &CoinOslFactorization::operator=(const CoinOslFactorization &other)
@@ -125,6 +149,24 @@ void CoinOslFactorization::gutsOfCopy(const CoinOslFactorization &other)
   pivotRow_ = NULL;
   workArea_ = NULL;
   c_ekksmem_copy(&factInfo_, &other.factInfo_);
+  setNumberThreads(other.numberThreads_);
+  factInfo_.numberLevels = 0;
+  if (other.factInfo_.numberLevels)
+    buildLevels();
+}
+// Finds level schedule for threaded U transpose solve
+void CoinOslFactorization::buildLevels()
+{
+  factInfo_.numberLevels = 0;
+  if (numberThreads_ > 1 && numberRows_) {
+    delete[] levelSchedule_;
+    levelSchedule_ = new int[4 * numberRows_ + 3];
+    if (c_ekkbtju_levels(&factInfo_, levelSchedule_)) {
+      if (!threadPool_)
+        threadPool_ = new CoinThreadPool(numberThreads_);
+      factInfo_.threadPool = threadPool_;
+    }
+  }
 }
 
 //  getAreas.  Gets space for a factorization
@@ -234,6 +276,7 @@ void CoinOslFactorization::preProcess()
 //Does factorization
 int CoinOslFactorization::factor()
 {
+  factInfo_.numberLevels = 0;
   /*     Uwe's factorization (sort of) */
   int irtcod = c_ekklfct(&factInfo_);
 
@@ -328,6 +371,7 @@ void CoinOslFactorization::postProcess(const int *sequence, int *pivotVariable)
   factInfo_.iterin = factInfo_.iterno;
   factInfo_.npivots = 0;
   numberPivots_ = 0;
+  buildLevels();
   const int *permute3 = factInfo_.mpermu + 1;
   assert(permute3 == reinterpret_cast< const int * >(factInfo_.kadrpm + numberRows_ + 1));
   // this is ridiculous - must be better way
@@ -380,6 +424,8 @@ int CoinOslFactorization::replaceColumn(CoinIndexedVector *regionSparse,
 {
   if (numberPivots_ + 1 == maximumPivots_)
     return 3;
+  // pivot whose column of U is replaced
+  int kpivrw = factInfo_.mpermu[pivotRow + 1];
   int *regionIndex = regionSparse->getIndices();
   double *region = regionSparse->denseVector();
   int orig_nincol = 0;
@@ -392,6 +438,12 @@ int CoinOslFactorization::replaceColumn(CoinIndexedVector *regionSparse,
     pivotRow + 1,
     reinterpret_cast< int * >(factInfo_.kw1adr));
   factInfo_.drtpiv = saveTolerance;
+  if (factInfo_.numberLevels) {
+    if (!returnCode)
+      c_ekkbtju_levels_move(&factInfo_, levelSchedule_, kpivrw);
+    else
+      factInfo_.numberLevels = 0; // not sure how far U got
+  }
   if (returnCode != 2)
     numberPivots_++;
 #ifndef NDEBUG
@@ -17,6 +17,7 @@
 #include "CoinIndexedVector.hpp"
 #include "CoinDenseFactorization.hpp"
 class CoinPackedMatrix;
+class CoinThreadPool;
 /** This deals with Factorization and Updates
     This is ripped off from OSL!!!!!!!!!
 
@@ -102,6 +103,14 @@ typedef struct _EKKfactinfo {
   int eta_size;
   int last_eta_size;
   int maxNNetas;
+  /* level schedule for threaded U transpose solve - not copied with
+     the scalars above, see c_ekkbtju_levels */
+  CoinThreadPool *threadPool;
+  const int *levelStart;
+  const int *levelPivot;
+  const int *levelPosition;
+  int numberLevels; /* 0 if no valid schedule */
+  int levelMoved; /* pivots moved by updates since schedule found */
 } EKKfactinfo;
 
 class COINUTILSLIB_EXPORT CoinOslFactorization : public CoinOtherFactorization {
@@ -188,6 +197,22 @@ public:
   /// Set maximum pivots
   virtual void maximumPivots(int value);
 
+  /// Number of threads used in U transpose solve
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /** Sets number of threads (including caller) used in solves.
+      Values less than one mean number of processors.  Default is 1.
+      With more than one thread each factorization without a dense part
+      also finds which rows of U can be solved at the same time and
+      updateColumnTranspose uses that.  Columns brought in by
+      replaceColumn are solved serially after the rest, so the gain
+      shrinks as updates build up.  FTRAN (updateColumn and
+      updateColumnFT) is always serial.
+      Answers are identical to those found with one thread.
+  */
+  void setNumberThreads(int value);
   /// Returns maximum absolute value in factorization
   double maximumCoefficient() const;
   /// Condition number - product of pivots after factorization
@@ -272,12 +297,20 @@ protected:
   /** Returns accuracy status of replaceColumn
       returns 0=OK, 1=Probably OK, 2=singular */
   int checkPivot(double saveFromU, double oldPivot) const;
+  /// Finds level schedule for threaded U transpose solve (if wanted)
+  void buildLevels();
   ////////////////// data //////////////////
 protected:
   /**@name data */
   //@{
   /// Osl factorization data
   EKKfactinfo factInfo_;
+  /// Number of threads
+  int numberThreads_;
+  /// Threads for solves (created when needed)
+  CoinThreadPool *threadPool_;
+  /// Space for level schedule (see setNumberThreads)
+  int *levelSchedule_;
   //@}
 };
 #endif
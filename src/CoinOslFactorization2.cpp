@@ -14,6 +14,7 @@
 #include "CoinOslFactorization.hpp"
 #include "CoinOslC.h"
 #include "CoinFinite.hpp"
+#include "CoinThreadPool.hpp"
 
 #ifndef NDEBUG
 extern int ets_count;
@@ -878,7 +879,7 @@ static void c_ekkbtju_dense(const int nrow,
   int *COIN_RESTRICT hpivco,
   double *COIN_RESTRICT dwork1,
   int *COIN_RESTRICT start, int last, int offset,
-  double *COIN_RESTRICT densew)
+  double *COIN_RESTRICT densew, int simd)
 {
   /* Local variables */
   int ipiv1, ipiv2;
@@ -907,15 +908,22 @@ static void c_ekkbtju_dense(const int nrow,
     double dv1 = dwork1[ipiv1];
     double dv2 = dwork1[ipiv2];
 
-    for (iel = kx1; iel < k1; ++iel) {
-      dv1 -= SHIFT_REF(dwork1, hrowi[iel]) * dluval[iel];
-    }
-    for (iel = kx2; iel < k2; ++iel) {
-      dv2 -= SHIFT_REF(dwork1, hrowi[iel]) * dluval[iel];
-    }
-    for (k = 0; k < n1; k++) {
-      dv1 -= dlu1[k] * densew[k];
-      dv2 -= dlu2[k] * densew[k];
+    if (simd) {
+      dv1 -= CoinGatherDotN(dluval + kx1, hrowi + kx1, k1 - kx1, dwork1);
+      dv2 -= CoinGatherDotN(dluval + kx2, hrowi + kx2, k2 - kx2, dwork1);
+      dv1 -= CoinDotProductN(dlu1, densew, n1);
+      dv2 -= CoinDotProductN(dlu2, densew, n1);
+    } else {
+      for (iel = kx1; iel < k1; ++iel) {
+        dv1 -= SHIFT_REF(dwork1, hrowi[iel]) * dluval[iel];
+      }
+      for (iel = kx2; iel < k2; ++iel) {
+        dv2 -= SHIFT_REF(dwork1, hrowi[iel]) * dluval[iel];
+      }
+      for (k = 0; k < n1; k++) {
+        dv1 -= dlu1[k] * densew[k];
+        dv2 -= dlu2[k] * densew[k];
+      }
     }
     dv1 *= dpiv1;
     dv2 -= dlu2[n1] * dv1;
@@ -929,58 +937,42 @@ static void c_ekkbtju_dense(const int nrow,
   *start = ipiv1;
   return;
 }
-/* about 8-10% of execution time is spent in this routine */
-static int c_ekkbtju_aux(const double *COIN_RESTRICT dluval,
+/* columns shorter than this are done by plain loops even when
+   vector instructions are wanted (see CoinSimdLevel) */
+#define C_EKK_SIMD_MINIMUM 8
+/*
+ * Solves for one unknown of U transpose.  This is the body of the loop
+ * in c_ekkbtju_aux and is also used by c_ekkbtju_level, so a threaded
+ * solve gives exactly the same answers as a serial one.
+ */
+static inline void c_ekkbtju_pivot(const double *COIN_RESTRICT dluval,
   const int *COIN_RESTRICT hrowi,
   const int *COIN_RESTRICT mcstrt,
-  const int *COIN_RESTRICT hpivco,
   double *COIN_RESTRICT dwork1,
-  int ipiv, int loop_end)
+  int ipiv, int simd)
 {
-#define UNROLL2 2
-#ifndef UNROLL2
-#if CLP_OSL == 2 || CLP_OSL == 3
-#define UNROLL2 2
-#else
-#define UNROLL2 1
-#endif
-#endif
-  while (ipiv <= loop_end) {
-    int kx = mcstrt[ipiv];
-    const int nel = hrowi[kx - 1];
-#if UNROLL2 < 2
-    const int kxe = kx + nel;
-#endif
-
-    double dv = dwork1[ipiv]; /* rhs */
-#if UNROLL2 > 1
-    const int *hrowi2 = hrowi + kx;
-    const int *hrowi2end = hrowi2 + nel;
-    const double *dluval2 = dluval + kx;
-#else
-    int iel;
-#endif
-    const double dpiv = dluval[kx - 1]; /* inverse of pivot */
-
-    /* subtract terms whose unknowns have been solved for */
-
-    /* a significant proportion of these loops may not modify dv at all.
-     * However, it seems to be just as expensive to check if the loop
-     * would modify dv as it is to just do it.
-     * The only difference would be that dluval wouldn't be referenced
-     * for those loops, would might save some cache paging,
-     * but unfortunately the code generated to search for zeros (on AIX)
-     * is *worse* than code that just multiplies by dval.
-     */
-#if UNROLL2 < 2
-    for (iel = kx; iel < kxe; ++iel) {
-      const int irow = hrowi[iel];
-      const double dval = dluval[iel];
-      dv -= SHIFT_REF(dwork1, irow) * dval;
-    }
-
-    dwork1[ipiv] = dv * dpiv; /* divide by the pivot */
-#else
+  int kx = mcstrt[ipiv];
+  const int nel = hrowi[kx - 1];
+
+  double dv = dwork1[ipiv]; /* rhs */
+  const int *hrowi2 = hrowi + kx;
+  const int *hrowi2end = hrowi2 + nel;
+  const double *dluval2 = dluval + kx;
+  const double dpiv = dluval[kx - 1]; /* inverse of pivot */
+
+  /* subtract terms whose unknowns have been solved for */
+
+  /* a significant proportion of these loops may not modify dv at all.
+   * However, it seems to be just as expensive to check if the loop
+   * would modify dv as it is to just do it.
+   * The only difference would be that dluval wouldn't be referenced
+   * for those loops, would might save some cache paging,
+   * but unfortunately the code generated to search for zeros (on AIX)
+   * is *worse* than code that just multiplies by dval.
+   */
+  if (simd && nel >= C_EKK_SIMD_MINIMUM) {
+    dv -= CoinGatherDotN(dluval2, hrowi2, nel, dwork1);
+  } else {
     if ((nel & 1) != 0) {
       int irow = *hrowi2;
       double dval = *dluval2;
@@ -998,9 +990,19 @@ static int c_ekkbtju_aux(const double *COIN_RESTRICT dluval,
       dv -= d0 * dval0;
       dv -= d1 * dval1;
     }
-    dwork1[ipiv] = dv * dpiv; /* divide by the pivot */
-#endif
-
+  }
+  dwork1[ipiv] = dv * dpiv; /* divide by the pivot */
+}
+/* about 8-10% of execution time is spent in this routine */
+static int c_ekkbtju_aux(const double *COIN_RESTRICT dluval,
+  const int *COIN_RESTRICT hrowi,
+  const int *COIN_RESTRICT mcstrt,
+  const int *COIN_RESTRICT hpivco,
+  double *COIN_RESTRICT dwork1,
+  int ipiv, int loop_end, int simd)
+{
+  while (ipiv <= loop_end) {
+    c_ekkbtju_pivot(dluval, hrowi, mcstrt, dwork1, ipiv, simd);
     ipiv = hpivco[ipiv];
   }
 
@@ -1043,6 +1045,7 @@ static void c_ekkbtju(COIN_REGISTER2 const EKKfactinfo *COIN_RESTRICT2 fact,
   int ndenuc = fact->ndenuc;
   int first_dense = fact->first_dense;
   int last_dense = fact->last_dense;
+  const int simd = CoinSimdLevel() != COIN_SIMD_SCALAR;
 
   const int has_dense = (first_dense < last_dense && mcstrt[ipiv] <= mcstrt[last_dense]);
 
@@ -1058,7 +1061,7 @@ static void c_ekkbtju(COIN_REGISTER2 const EKKfactinfo *COIN_RESTRICT2 fact,
 
   if (has_dense)
     ipiv = c_ekkbtju_aux(dluval, hrowi, mcstrt, hpivco_new, dwork1, ipiv,
-      first_dense - 1);
+      first_dense - 1, simd);
 
   if (has_dense) {
     int n = 0;
@@ -1086,12 +1089,187 @@ static void c_ekkbtju(COIN_REGISTER2 const EKKfactinfo *COIN_RESTRICT2 fact,
       }
     }
     c_ekkbtju_dense(nrow, dluval, hrowi, mcstrt, const_cast< int * >(hpivco_new),
-      dwork1, &ipiv, last_dense, n - first_dense, densew);
+      dwork1, &ipiv, last_dense, n - first_dense, densew, simd);
   }
 
-  (void)c_ekkbtju_aux(dluval, hrowi, mcstrt, hpivco_new, dwork1, ipiv, nrow);
+  (void)c_ekkbtju_aux(dluval, hrowi, mcstrt, hpivco_new, dwork1, ipiv, nrow,
+    simd);
 } /* c_ekkbtju */
 
+/* levels narrower than this are solved by the calling thread */
+#define C_EKK_LEVEL_WIDTH 256
+typedef struct {
+  const double *dluval;
+  const int *hrowi;
+  const int *mcstrt;
+  const int *levelPivot;
+  const int *levelPosition;
+  double *dwork1;
+  int first;
+  int last;
+  int numberBlocks;
+  int startPosition;
+  int endPosition;
+  int simd;
+} EKKlevelInfo;
+/* solves one block of the pivots of a level */
+static void c_ekkbtju_block(void *info, int which)
+{
+  const EKKlevelInfo *level = reinterpret_cast< const EKKlevelInfo * >(info);
+  const int number = level->last - level->first;
+  const int first = level->first + (number * which) / level->numberBlocks;
+  const int last = level->first + (number * (which + 1)) / level->numberBlocks;
+  for (int k = first; k < last; k++) {
+    int ipiv = level->levelPivot[k];
+    int position = level->levelPosition[ipiv];
+    if (position >= level->startPosition && position < level->endPosition)
+      c_ekkbtju_pivot(level->dluval, level->hrowi, level->mcstrt,
+        level->dwork1, ipiv, level->simd);
+  }
+}
+/*
+ * Same as c_ekkbtju but using the level schedule from c_ekkbtju_levels.
+ * All unknowns in a level only depend on those in earlier levels so
+ * wide levels are split between threads.  Each unknown is found by
+ * exactly the same code as in c_ekkbtju so answers are identical.
+ * Unknowns before ipiv in the pivot order are left alone, as there.
+ * Pivots moved by updates since the schedule was found (see
+ * c_ekkbtju_levels_move) are at the end of the pivot order and are
+ * done serially after the levels.
+ */
+static void c_ekkbtju_level(COIN_REGISTER2 const EKKfactinfo *COIN_RESTRICT2 fact,
+  double *COIN_RESTRICT dwork1,
+  int ipiv)
+{
+  EKKlevelInfo info;
+  const int nrow = fact->nrow;
+  const int *levelStart = fact->levelStart;
+  info.startPosition = fact->levelPosition[ipiv];
+  info.endPosition = nrow;
+  /* nothing to do in levels if ipiv itself has been moved */
+  const int numberLevels = info.startPosition < nrow ? fact->numberLevels : 0;
+  CoinThreadPool *threadPool = fact->threadPool;
+  const int numberThreads = threadPool->numberThreads();
+  info.dluval = fact->xeeadr + 1;
+  info.hrowi = fact->xeradr + 1;
+  info.mcstrt = fact->xcsadr;
+  info.levelPivot = fact->levelPivot;
+  info.levelPosition = fact->levelPosition;
+  info.dwork1 = dwork1;
+  info.simd = CoinSimdLevel() != COIN_SIMD_SCALAR;
+  for (int iLevel = 0; iLevel < numberLevels; iLevel++) {
+    info.first = levelStart[iLevel];
+    info.last = levelStart[iLevel + 1];
+    int width = info.last - info.first;
+    if (width >= C_EKK_LEVEL_WIDTH) {
+      info.numberBlocks = std::min(numberThreads, width / (C_EKK_LEVEL_WIDTH / 2));
+      threadPool->run(info.numberBlocks, c_ekkbtju_block, &info);
+    } else {
+      info.numberBlocks = 1;
+      c_ekkbtju_block(&info, 0);
+    }
+  }
+  if (fact->levelMoved) {
+    const int *COIN_RESTRICT hpivco_new = fact->kcpadr + 1;
+    int jpiv = ipiv;
+    if (info.startPosition < nrow) {
+      /* first moved pivot */
+      jpiv = nrow + 1;
+      for (int i = 0; i < fact->levelMoved; i++)
+        jpiv = fact->back[jpiv];
+    }
+    while (jpiv <= nrow) {
+      c_ekkbtju_pivot(info.dluval, info.hrowi, info.mcstrt, dwork1, jpiv,
+        info.simd);
+      jpiv = hpivco_new[jpiv];
+    }
+  }
+} /* c_ekkbtju_level */
+
+/*
+ * Finds the level schedule used by c_ekkbtju_level.  The level of
+ * an unknown of U transpose is one more than the largest level of the
+ * unknowns it depends on.  space must have room for 4*nrow+3 ints.
+ * Returns number of levels or 0 if there is a dense part or most
+ * unknowns are in levels too narrow to be worth handing to threads
+ * (then c_ekkbtju is used).
+ */
+int c_ekkbtju_levels(EKKfactinfo *fact, int *space)
+{
+  const int nrow = fact->nrow;
+  const int *COIN_RESTRICT hrowi = fact->xeradr + 1;
+  const int *COIN_RESTRICT mcstrt = fact->xcsadr;
+  const int *COIN_RESTRICT hpivco_new = fact->kcpadr + 1;
+  int *COIN_RESTRICT levelStart = space;
+  int *COIN_RESTRICT levelPivot = levelStart + nrow + 1;
+  int *COIN_RESTRICT levelPosition = levelPivot + nrow;
+  int *COIN_RESTRICT level = levelPosition + nrow + 1;
+  int numberLevels = 0;
+  fact->numberLevels = 0;
+  fact->levelMoved = 0;
+  if (fact->first_dense < fact->last_dense || nrow < C_EKK_LEVEL_WIDTH)
+    return 0;
+  /* levels in pivot order */
+  CoinFillN(level + 1, nrow, -1);
+  int ipiv = hpivco_new[0];
+  for (int i = 0; i < nrow; i++) {
+    const int kx = mcstrt[ipiv];
+    const int nel = hrowi[kx - 1];
+    int iLevel = 0;
+    for (int iel = kx; iel < kx + nel; iel++) {
+      assert(level[hrowi[iel]] >= 0); /* solved earlier */
+      iLevel = std::max(iLevel, level[hrowi[iel]] + 1);
+    }
+    level[ipiv] = iLevel;
+    levelPosition[ipiv] = i;
+    numberLevels = std::max(numberLevels, iLevel + 1);
+    ipiv = hpivco_new[ipiv];
+  }
+  /* sort by level keeping pivot order within a level */
+  CoinZeroN(levelStart, numberLevels + 1);
+  for (int i = 1; i <= nrow; i++)
+    levelStart[level[i] + 1]++;
+  int numberWide = 0;
+  for (int iLevel = 0; iLevel < numberLevels; iLevel++) {
+    if (levelStart[iLevel + 1] >= C_EKK_LEVEL_WIDTH)
+      numberWide += levelStart[iLevel + 1];
+    levelStart[iLevel + 1] += levelStart[iLevel];
+  }
+  if (2 * numberWide < nrow)
+    return 0; /* mostly narrow levels */
+  ipiv = hpivco_new[0];
+  for (int i = 0; i < nrow; i++) {
+    levelPivot[levelStart[level[ipiv]]++] = ipiv;
+    ipiv = hpivco_new[ipiv];
+  }
+  for (int iLevel = numberLevels; iLevel > 0; iLevel--)
+    levelStart[iLevel] = levelStart[iLevel - 1];
+  levelStart[0] = 0;
+  fact->levelStart = levelStart;
+  fact->levelPivot = levelPivot;
+  fact->levelPosition = levelPosition;
+  fact->numberLevels = numberLevels;
+  return numberLevels;
+} /* c_ekkbtju_levels */
+
+/*
+ * Keeps the level schedule after an update which replaced the column of
+ * pivot kpivrw.  The update takes row kpivrw out of all other columns
+ * of U and moves kpivrw to the end of the pivot order, so the levels
+ * still hold for pivots which have not been moved.  A moved pivot is
+ * given a position after all of those, in the order of updates, and is
+ * then done serially by c_ekkbtju_level.  space is as passed to
+ * c_ekkbtju_levels.
+ */
+void c_ekkbtju_levels_move(EKKfactinfo *fact, int *space, int kpivrw)
+{
+  const int nrow = fact->nrow;
+  int *COIN_RESTRICT levelPosition = space + 2 * nrow + 1;
+  if (levelPosition[kpivrw] < nrow)
+    fact->levelMoved++;
+  levelPosition[kpivrw] = nrow + fact->npivots;
+} /* c_ekkbtju_levels_move */
+
 /*
  * mpt / *nincolp contain the indices of nonzeros in dwork1.
  * nonzero contains the same information as a byte-mask.
@@ -1275,8 +1453,11 @@ int c_ekkbtrn(COIN_REGISTER3 const EKKfactinfo *COIN_RESTRICT2 fact,
      * ipiv tends to be >nrow for the second */
 
     /*       DO U */
-    c_ekkbtju(fact, dpermu,
-      ipiv);
+    if (fact->numberLevels)
+      c_ekkbtju_level(fact, dpermu, ipiv);
+    else
+      c_ekkbtju(fact, dpermu,
+        ipiv);
   }
 
   /*       DO ROW ETAS IN L */
@@ -3093,25 +3274,30 @@ c_ekkftjup_scan_aux(COIN_REGISTER2 const EKKfactinfo *COIN_RESTRICT2 fact,
         SHIFT_REF(dwork1, irow1) = d1;
       } /* end loop */
 #else
-      if ((nel & 1) != 0) {
-        int irow = *hrowi2;
-        double dval = *dluval2;
-        SHIFT_REF(dwork1, irow) -= dv * dval;
-        hrowi2++;
-        dluval2++;
-      }
-      for (; hrowi2 < hrowi2end; hrowi2 += 2, dluval2 += 2) {
-        int irow0 = hrowi2[0];
-        int irow1 = hrowi2[1];
-        double dval0 = dluval2[0];
-        double dval1 = dluval2[1];
-        double d0 = SHIFT_REF(dwork1, irow0);
-        double d1 = SHIFT_REF(dwork1, irow1);
-
-        d0 -= dv * dval0;
-        d1 -= dv * dval1;
-        SHIFT_REF(dwork1, irow0) = d0;
-        SHIFT_REF(dwork1, irow1) = d1;
+      if (nel >= C_EKK_SIMD_MINIMUM) {
+        /* same answers as loop below */
+        CoinScatterAxpyN(-dv, dluval2, hrowi2, nel, dwork1);
+      } else {
+        if ((nel & 1) != 0) {
+          int irow = *hrowi2;
+          double dval = *dluval2;
+          SHIFT_REF(dwork1, irow) -= dv * dval;
+          hrowi2++;
+          dluval2++;
+        }
+        for (; hrowi2 < hrowi2end; hrowi2 += 2, dluval2 += 2) {
+          int irow0 = hrowi2[0];
+          int irow1 = hrowi2[1];
+          double dval0 = dluval2[0];
+          double dval1 = dluval2[1];
+          double d0 = SHIFT_REF(dwork1, irow0);
+          double d1 = SHIFT_REF(dwork1, irow1);
+
+          d0 -= dv * dval0;
+          d1 -= dv * dval1;
+          SHIFT_REF(dwork1, irow0) = d0;
+          SHIFT_REF(dwork1, irow1) = d1;
+        }
       }
 #endif
       /* put this down here so that dv is less likely to cause a stall */
@@ -3228,6 +3414,12 @@ static void c_ekkftju_dense(const double *dluval,
             densew[k] -= dv1 * dlu1[k] + dv2 * dlu2[k];
             k--;
           }
+          if (k >= C_EKK_SIMD_MINIMUM) {
+            /* same answers as loop below */
+            CoinAxpyN(-dv1, dlu1, k + 1, densew);
+            CoinAxpyN(-dv2, dlu2, k + 1, densew);
+            k = -1;
+          }
           for (; k >= 0; k -= 2) {
             double da, db;
             da = densew[k];
@@ -3249,7 +3441,10 @@ static void c_ekkftju_dense(const double *dluval,
 	   * }
 	   */
           iel = kx2 + nsparse2 - 1;
-          if ((nsparse2 & 1) != 0) {
+          if (nsparse2 >= C_EKK_SIMD_MINIMUM) {
+            CoinScatterAxpyN(-dv2, dluval + kx2, hrowi + kx2, nsparse2, dwork1);
+            iel = kx2 - 1;
+          } else if ((nsparse2 & 1) != 0) {
             int irow0 = hrowi[iel];
             double dval = dluval[iel];
             SHIFT_REF(dwork1, irow0) -= dv2 * dval;
@@ -3277,11 +3472,9 @@ static void c_ekkftju_dense(const double *dluval,
           ipiv2 = ipiv;
           if (ipiv < last) {
             k--;
-            for (; k >= 0; k--) {
-              double dval;
-              dval = dv1 * dlu1[k];
-              densew[k] = densew[k] - dval;
-            }
+            if (k >= 0)
+              CoinAxpyN(-dv1, dlu1, k + 1, densew);
+            k = -1;
           }
         }
       }
@@ -3294,7 +3487,10 @@ static void c_ekkftju_dense(const double *dluval,
        * }
        */
       iel = kx1 + nsparse1 - 1;
-      if ((nsparse1 & 1) != 0) {
+      if (nsparse1 >= C_EKK_SIMD_MINIMUM) {
+        CoinScatterAxpyN(-dv1, dluval + kx1, hrowi + kx1, nsparse1, dwork1);
+        iel = kx1 - 1;
+      } else if ((nsparse1 & 1) != 0) {
         int irow0 = hrowi[iel];
         double dval = dluval[iel];
         SHIFT_REF(dwork1, irow0) -= dv1 * dval;
@@ -3516,25 +3712,30 @@ c_ekkftjup_scan_aux_pack(COIN_REGISTER2 const EKKfactinfo *COIN_RESTRICT2 fact,
         SHIFT_REF(dwork1, irow1) = d1;
       } /* end loop */
 #else
-      if ((nel & 1) != 0) {
-        int irow = *hrowi2;
-        double dval = *dluval2;
-        SHIFT_REF(dwork1, irow) -= dv * dval;
-        hrowi2++;
-        dluval2++;
-      }
-      for (; hrowi2 < hrowi2end; hrowi2 += 2, dluval2 += 2) {
-        int irow0 = hrowi2[0];
-        int irow1 = hrowi2[1];
-        double dval0 = dluval2[0];
-        double dval1 = dluval2[1];
-        double d0 = SHIFT_REF(dwork1, irow0);
-        double d1 = SHIFT_REF(dwork1, irow1);
-
-        d0 -= dv * dval0;
-        d1 -= dv * dval1;
-        SHIFT_REF(dwork1, irow0) = d0;
-        SHIFT_REF(dwork1, irow1) = d1;
+      if (nel >= C_EKK_SIMD_MINIMUM) {
+        /* same answers as loop below */
+        CoinScatterAxpyN(-dv, dluval2, hrowi2, nel, dwork1);
+      } else {
+        if ((nel & 1) != 0) {
+          int irow = *hrowi2;
+          double dval = *dluval2;
+          SHIFT_REF(dwork1, irow) -= dv * dval;
+          hrowi2++;
+          dluval2++;
+        }
+        for (; hrowi2 < hrowi2end; hrowi2 += 2, dluval2 += 2) {
+          int irow0 = hrowi2[0];
+          int irow1 = hrowi2[1];
+          double dval0 = dluval2[0];
+          double dval1 = dluval2[1];
+          double d0 = SHIFT_REF(dwork1, irow0);
+          double d1 = SHIFT_REF(dwork1, irow1);
+
+          d0 -= dv * dval0;
+          d1 -= dv * dval1;
+          SHIFT_REF(dwork1, irow0) = d0;
+          SHIFT_REF(dwork1, irow1) = d1;
+        }
       }
 #endif
       /* put this down here so that dv is less likely to cause a stall */
@@ -19,6 +19,7 @@
 #endif
 #include "CoinFloatEqual.hpp"
 #include "CoinPackedMatrix.hpp"
+#include "CoinThreadPool.hpp"
 
 #if !defined(COINUTILS_CHECKLEVEL)
 #define COINUTILS_CHECKLEVEL 0
@@ -1047,6 +1048,7 @@ CoinPackedMatrix::operator=(const CoinPackedMatrix &rhs)
     gutsOfDestructor();
     extraGap_ = rhs.extraGap_;
     extraMajor_ = rhs.extraMajor_;
+    setNumberThreads(rhs.numberThreads_);
     gutsOfOpEqual(rhs.colOrdered_,
       rhs.minorDim_, rhs.majorDim_, rhs.size_,
       rhs.element_, rhs.index_, rhs.start_, rhs.length_);
@@ -1063,6 +1065,8 @@ void CoinPackedMatrix::reverseOrdering()
   m.extraMajor_ = extraGap_;
   m.reverseOrderedCopyOf(*this);
   swap(m);
+  // threads stay with this matrix
+  swapThreads(m);
 }
 
 //-----------------------------------------------------------------------------
@@ -1088,6 +1092,17 @@ void CoinPackedMatrix::swap(CoinPackedMatrix &m)
   std::swap(size_, m.size_);
   std::swap(maxMajorDim_, m.maxMajorDim_);
   std::swap(maxSize_, m.maxSize_);
+  swapThreads(m);
+}
+
+//-----------------------------------------------------------------------------
+
+void CoinPackedMatrix::swapThreads(CoinPackedMatrix &m)
+{
+  std::swap(numberThreads_, m.numberThreads_);
+  std::swap(threadPool_, m.threadPool_);
+  std::swap(threadWork_, m.threadWork_);
+  std::swap(threadWorkSize_, m.threadWorkSize_);
 }
 
 //#############################################################################
@@ -1761,8 +1776,161 @@ void CoinPackedMatrix::deleteMinorVectors(const int numDel,
 //#############################################################################
 //#############################################################################
 
+/*
+  Parallel matrix times vector.  Major vectors are split into one block per
+  thread with about the same number of elements.
+*/
+namespace {
+typedef struct {
+  const double *element;
+  const int *index;
+  const CoinBigIndex *start;
+  const int *length;
+  const double *x;
+  double *y;
+  // accumulation vectors for threads after first (timesMajor)
+  double *work;
+  int minorDim;
+  int majorDim;
+  int numberBlocks;
+  // first major vector of each block (numberBlocks+1)
+  const int *firstMajor;
+} CoinTimesInfo;
+
+// y[i] = x . vector i for one block
+void timesMinorBlock(void *info, int which)
+{
+  const CoinTimesInfo *data = reinterpret_cast< const CoinTimesInfo * >(info);
+  const double *element = data->element;
+  const int *index = data->index;
+  const double *x = data->x;
+  double *y = data->y;
+  for (int i = data->firstMajor[which + 1] - 1; i >= data->firstMajor[which]; --i) {
+    double y_i = 0;
+    const CoinBigIndex last = data->start[i] + data->length[i];
+    for (CoinBigIndex j = data->start[i]; j < last; ++j)
+      y_i += x[index[j]] * element[j];
+    y[i] = y_i;
+  }
+}
+
+// Scatters x[i] * vector i into accumulation vector of block
+void timesMajorBlock(void *info, int which)
+{
+  const CoinTimesInfo *data = reinterpret_cast< const CoinTimesInfo * >(info);
+  const double *element = data->element;
+  const int *index = data->index;
+  const double *x = data->x;
+  double *y = which ? data->work + static_cast< CoinBigIndex >(which - 1) * data->minorDim : data->y;
+  memset(y, 0, data->minorDim * sizeof(double));
+  for (int i = data->firstMajor[which + 1] - 1; i >= data->firstMajor[which]; --i) {
+    const double x_i = x[i];
+    if (x_i != 0.0) {
+      const CoinBigIndex last = data->start[i] + data->length[i];
+      for (CoinBigIndex j = data->start[i]; j < last; ++j)
+        y[index[j]] += x_i * element[j];
+    }
+  }
+}
+
+// Adds accumulation vectors into y for one slice of minor dimension
+void timesMajorSum(void *info, int which)
+{
+  const CoinTimesInfo *data = reinterpret_cast< const CoinTimesInfo * >(info);
+  int numberBlocks = data->numberBlocks;
+  int first = static_cast< int >((static_cast< CoinBigIndex >(data->minorDim) * which) / numberBlocks);
+  int last = static_cast< int >((static_cast< CoinBigIndex >(data->minorDim) * (which + 1)) / numberBlocks);
+  double *y = data->y;
+  for (int iBlock = 1; iBlock < numberBlocks; iBlock++) {
+    const double *work = data->work + static_cast< CoinBigIndex >(iBlock - 1) * data->minorDim;
+    for (int i = first; i < last; i++)
+      y[i] += work[i];
+  }
+}
+} // end file-local namespace
+
+// Smallest number of elements worth using threads for
+#define COIN_TIMES_PARALLEL_SIZE 20000
+
+void CoinPackedMatrix::setNumberThreads(int numberThreads)
+{
+  if (numberThreads < 1)
+    numberThreads = CoinThreadPool::numberProcessors();
+  numberThreads_ = numberThreads;
+  if (threadPool_ && threadPool_->numberThreads() != numberThreads_) {
+    delete threadPool_;
+    threadPool_ = NULL;
+  }
+}
+
+/* Does timesMajor (if scatter true) or timesMinor using threads.
+   Returns false if not worth it */
+bool CoinPackedMatrix::timesParallel(const double *x, double *y,
+  bool scatter) const
+{
+  if (numberThreads_ <= 1 || size_ < COIN_TIMES_PARALLEL_SIZE
+    || !CoinThreadPool::threadsAvailable())
+    return false;
+  int numberBlocks = static_cast< int >(CoinMin(static_cast< CoinBigIndex >(numberThreads_),
+    size_ / (COIN_TIMES_PARALLEL_SIZE / 4)));
+  if (scatter) {
+    // clearing and adding accumulation vectors must not cost more than products
+    while (numberBlocks > 1 && static_cast< double >(minorDim_) * numberBlocks > 0.5 * size_)
+      numberBlocks--;
+  }
+  if (numberBlocks <= 1)
+    return false;
+  // another thread is using threads of this matrix - do serially
+  if (threadsInUse_.exchange(true, std::memory_order_acquire))
+    return false;
+  if (!threadPool_)
+    threadPool_ = new CoinThreadPool(numberThreads_);
+  // split so each block has about the same number of elements
+  int *firstMajor = new int[numberBlocks + 1];
+  firstMajor[0] = 0;
+  int iMajor = 0;
+  CoinBigIndex numberSoFar = 0;
+  for (int iBlock = 1; iBlock < numberBlocks; iBlock++) {
+    CoinBigIndex wanted = (size_ * iBlock) / numberBlocks;
+    while (iMajor < majorDim_ && numberSoFar < wanted)
+      numberSoFar += length_[iMajor++];
+    firstMajor[iBlock] = iMajor;
+  }
+  firstMajor[numberBlocks] = majorDim_;
+  CoinTimesInfo info;
+  info.element = element_;
+  info.index = index_;
+  info.start = start_;
+  info.length = length_;
+  info.x = x;
+  info.y = y;
+  info.work = NULL;
+  info.minorDim = minorDim_;
+  info.majorDim = majorDim_;
+  info.numberBlocks = numberBlocks;
+  info.firstMajor = firstMajor;
+  if (!scatter) {
+    threadPool_->run(numberBlocks, timesMinorBlock, &info);
+  } else {
+    CoinBigIndex sizeWork = static_cast< CoinBigIndex >(numberBlocks - 1) * minorDim_;
+    if (sizeWork > threadWorkSize_) {
+      delete[] threadWork_;
+      threadWork_ = new double[sizeWork];
+      threadWorkSize_ = sizeWork;
+    }
+    info.work = threadWork_;
+    threadPool_->run(numberBlocks, timesMajorBlock, &info);
+    threadPool_->run(numberBlocks, timesMajorSum, &info);
+  }
+  threadsInUse_.store(false, std::memory_order_release);
+  delete[] firstMajor;
+  return true;
+}
+
 void CoinPackedMatrix::timesMajor(const double *x, double *y) const
 {
+  if (timesParallel(x, y, true))
+    return;
   memset(y, 0, minorDim_ * sizeof(double));
   for (int i = majorDim_ - 1; i >= 0; --i) {
     const double x_i = x[i];
@@ -1794,6 +1962,8 @@ void CoinPackedMatrix::timesMajor(const CoinPackedVectorBase &x, double *y) cons
 
 void CoinPackedMatrix::timesMinor(const double *x, double *y) const
 {
+  if (timesParallel(x, y, false))
+    return;
   memset(y, 0, majorDim_ * sizeof(double));
   for (int i = majorDim_ - 1; i >= 0; --i) {
     double y_i = 0;
@@ -1833,6 +2003,11 @@ CoinPackedMatrix::CoinPackedMatrix()
   , size_(0)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(1)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   start_ = new CoinBigIndex[1];
   start_[0] = 0;
@@ -1854,6 +2029,11 @@ CoinPackedMatrix::CoinPackedMatrix(const bool colordered,
   , size_(0)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(1)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   start_ = new CoinBigIndex[1];
   start_[0] = 0;
@@ -1880,6 +2060,11 @@ CoinPackedMatrix::CoinPackedMatrix(const bool colordered,
   , size_(0)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(1)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   gutsOfOpEqual(colordered, minor, major, numels, elem, ind, start, len);
 }
@@ -1903,6 +2088,11 @@ CoinPackedMatrix::CoinPackedMatrix(const bool colordered,
   , size_(0)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(1)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   gutsOfOpEqual(colordered, minor, major, numels, elem, ind, start, len);
 }
@@ -1961,6 +2151,11 @@ CoinPackedMatrix::CoinPackedMatrix(
   , size_(0)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(1)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   CoinAbsFltEq eq;
   int *colIndices = new int[numberElements];
@@ -2125,6 +2320,11 @@ CoinPackedMatrix::CoinPackedMatrix(const CoinPackedMatrix &rhs)
   , size_(0)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(rhs.numberThreads_)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   bool hasGaps = rhs.size_ < rhs.start_[rhs.majorDim_];
   if (!hasGaps && !rhs.extraMajor_) {
@@ -2160,6 +2360,11 @@ CoinPackedMatrix::CoinPackedMatrix(const CoinPackedMatrix &rhs,
   , size_(rhs.size_)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(rhs.numberThreads_)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   if (!reverseOrdering) {
     if (extraForMajor >= 0) {
@@ -2309,6 +2514,11 @@ CoinPackedMatrix::CoinPackedMatrix(const CoinPackedMatrix &rhs,
   , size_(0)
   , maxMajorDim_(0)
   , maxSize_(0)
+  , numberThreads_(rhs.numberThreads_)
+  , threadPool_(NULL)
+  , threadWork_(NULL)
+  , threadWorkSize_(0)
+  , threadsInUse_(false)
 {
   if (numberRows <= 0 || numberColumns <= 0) {
     start_ = new CoinBigIndex[1];
@@ -2508,6 +2718,8 @@ CoinPackedMatrix::CoinPackedMatrix(const CoinPackedMatrix &rhs,
 CoinPackedMatrix::~CoinPackedMatrix()
 {
   gutsOfDestructor();
+  delete threadPool_;
+  delete[] threadWork_;
 }
 
 //#############################################################################
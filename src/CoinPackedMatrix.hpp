@@ -5,6 +5,8 @@
 #ifndef CoinPackedMatrix_H
 #define CoinPackedMatrix_H
 
+#include <atomic>
+
 #include "CoinError.hpp"
 #include "CoinTypes.h"
 #ifndef CLP_NO_VECTOR
@@ -13,6 +15,7 @@
 #else
 class COINUTILSLIB_EXPORT CoinRelFltEq;
 #endif
+class CoinThreadPool;
 
 /** Sparse Matrix Base Class
 
@@ -478,6 +481,33 @@ public:
 #endif
   //@}
 
+  /**@name Threads for matrix times vector methods */
+  //@{
+  /** Set number of threads used by times, transposeTimes, timesMajor and
+      timesMinor when x is dense (values less than one mean number of
+      processors).  Default is 1 i.e. serial.
+
+      Products over major vectors (transposeTimes of a column ordered
+      matrix) just split the vectors between threads so results are
+      exactly as serial.  Products which scatter into y (times of a column
+      ordered matrix) accumulate into one vector per thread and add them
+      at the end, so results may differ from serial in the last bits but
+      are the same every time for a given number of threads.  Small
+      matrices are always done serially.
+
+      The const products stay safe to call from several threads at once
+      on one matrix; while one call is using the threads (and their work
+      space) any other call is done serially.  Do not change the number
+      of threads while another thread is multiplying.
+  */
+  void setNumberThreads(int numberThreads);
+  /// Number of threads used by matrix times vector methods
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  //@}
+
   //---------------------------------------------------------------------------
   /**@name Helper functions used internally, but maybe useful externally.
 
@@ -892,6 +922,11 @@ protected:
     const double *element, int numberOther = -1);
 
 private:
+  /** timesMajor (if scatter true) or timesMinor using threads.
+      Returns false (doing nothing) if not worth it. */
+  bool timesParallel(const double *x, double *y, bool scatter) const;
+  /// Swaps number of threads, thread pool and work space with m
+  void swapThreads(CoinPackedMatrix &m);
   inline CoinBigIndex getLastStart() const
   {
     return majorDim_ == 0 ? 0 : start_[majorDim_];
@@ -936,6 +971,16 @@ protected:
   int maxMajorDim_;
   /// max space allocated for entries
   CoinBigIndex maxSize_;
+  /// Number of threads for matrix times vector
+  int numberThreads_;
+  /// Threads for matrix times vector (created when first needed)
+  mutable CoinThreadPool *threadPool_;
+  /// Accumulation space for threads in timesMajor
+  mutable double *threadWork_;
+  /// Size of threadWork_
+  mutable CoinBigIndex threadWorkSize_;
+  /// True while a product is using threadPool_ and threadWork_
+  mutable std::atomic< bool > threadsInUse_;
   //@}
 };
 
@@ -48,6 +48,18 @@ CoinPackedVector::operator=(const CoinPackedVectorBase &rhs)
   return *this;
 }
 
+//#############################################################################
+
+CoinPackedVector &
+CoinPackedVector::operator=(CoinPackedVector &&rhs) noexcept
+{
+  if (this != &rhs) {
+    freeStorage();
+    gutsOfMove(rhs);
+  }
+  return *this;
+}
+
 //#############################################################################
 #if 0
 void
@@ -75,24 +87,18 @@ void CoinPackedVector::assignVector(int size, int *&inds, double *&elems,
   bool testForDuplicateIndex)
 {
   clear();
-  // Allocate storage
+  // Copy into own storage so indices and elements stay in one block
   if (size != 0) {
-    //reserve(size); //This is a BUG!!!
+    reserve(size);
     nElements_ = size;
-    if (indices_ != NULL)
-      delete[] indices_;
-    indices_ = inds;
-    inds = NULL;
-    if (elements_ != NULL)
-      delete[] elements_;
-    elements_ = elems;
-    elems = NULL;
-    if (origIndices_ != NULL)
-      delete[] origIndices_;
-    origIndices_ = new int[size];
+    CoinDisjointCopyN(inds, size, indices_);
+    CoinDisjointCopyN(elems, size, elements_);
     CoinIotaN(origIndices_, size, 0);
-    capacity_ = size;
   }
+  delete[] inds;
+  inds = NULL;
+  delete[] elems;
+  elems = NULL;
   if (testForDuplicateIndex) {
     try {
       CoinPackedVectorBase::setTestForDuplicateIndex(testForDuplicateIndex);
@@ -318,15 +324,25 @@ void CoinPackedVector::reserve(int n)
     return;
   capacity_ = n;
 
+  if (n <= COIN_PACKED_VECTOR_SMALL) {
+    // fits inside object - any existing data is already there
+    elements_ = smallElements_;
+    indices_ = smallIndices_;
+    origIndices_ = smallOrigIndices_;
+    return;
+  }
+
   // save pointers to existing data
   int *tempIndices = indices_;
   int *tempOrigIndices = origIndices_;
   double *tempElements = elements_;
+  bool wasSmall = isSmall();
 
-  // allocate new space
-  indices_ = new int[capacity_];
-  origIndices_ = new int[capacity_];
-  elements_ = new double[capacity_];
+  // allocate new space - elements then indices then original indices
+  // (two ints take the room of one double)
+  elements_ = new double[2 * capacity_];
+  indices_ = reinterpret_cast< int * >(elements_ + capacity_);
+  origIndices_ = indices_ + capacity_;
 
   // copy data to new space
   if (nElements_ > 0) {
@@ -336,9 +352,8 @@ void CoinPackedVector::reserve(int n)
   }
 
   // free old data
-  delete[] tempElements;
-  delete[] tempOrigIndices;
-  delete[] tempIndices;
+  if (!wasSmall)
+    delete[] tempElements;
 }
 
 //#############################################################################
@@ -394,17 +409,24 @@ CoinPackedVector::CoinPackedVector(int capacity, int size,
   int *&inds, double *&elems,
   bool /*testForDuplicateIndex*/)
   : CoinPackedVectorBase()
-  , indices_(inds)
-  , elements_(elems)
-  , nElements_(size)
+  , indices_(NULL)
+  , elements_(NULL)
+  , nElements_(0)
   , origIndices_(NULL)
-  , capacity_(capacity)
+  , capacity_(0)
 {
   assert(size <= capacity);
+  reserve(capacity);
+  if (size != 0) {
+    nElements_ = size;
+    CoinDisjointCopyN(inds, size, indices_);
+    CoinDisjointCopyN(elems, size, elements_);
+    CoinIotaN(origIndices_, size, 0);
+  }
+  delete[] inds;
   inds = NULL;
+  delete[] elems;
   elems = NULL;
-  origIndices_ = new int[capacity_];
-  CoinIotaN(origIndices_, size, 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -451,11 +473,22 @@ CoinPackedVector::CoinPackedVector(const CoinPackedVector &rhs)
 
 //-----------------------------------------------------------------------------
 
+CoinPackedVector::CoinPackedVector(CoinPackedVector &&rhs) noexcept
+  : CoinPackedVectorBase()
+  , indices_(NULL)
+  , elements_(NULL)
+  , nElements_(0)
+  , origIndices_(NULL)
+  , capacity_(0)
+{
+  gutsOfMove(rhs);
+}
+
+//-----------------------------------------------------------------------------
+
 CoinPackedVector::~CoinPackedVector()
 {
-  delete[] indices_;
-  delete[] origIndices_;
-  delete[] elements_;
+  freeStorage();
 }
 
 //#############################################################################
@@ -504,6 +537,47 @@ void CoinPackedVector::gutsOfSetConstant(int size,
   }
 }
 
+//-----------------------------------------------------------------------------
+
+void CoinPackedVector::gutsOfMove(CoinPackedVector &rhs)
+{
+  assert(!elements_);
+  nElements_ = rhs.nElements_;
+  capacity_ = rhs.capacity_;
+  if (rhs.isSmall()) {
+    // inline storage can not be handed over
+    elements_ = smallElements_;
+    indices_ = smallIndices_;
+    origIndices_ = smallOrigIndices_;
+    CoinMemcpyN(rhs.elements_, nElements_, elements_);
+    CoinMemcpyN(rhs.indices_, nElements_, indices_);
+    CoinMemcpyN(rhs.origIndices_, nElements_, origIndices_);
+  } else {
+    elements_ = rhs.elements_;
+    indices_ = rhs.indices_;
+    origIndices_ = rhs.origIndices_;
+  }
+  rhs.elements_ = NULL;
+  rhs.indices_ = NULL;
+  rhs.origIndices_ = NULL;
+  rhs.nElements_ = 0;
+  rhs.capacity_ = 0;
+  moveBase(rhs);
+}
+
+//-----------------------------------------------------------------------------
+
+void CoinPackedVector::freeStorage()
+{
+  if (!isSmall())
+    delete[] elements_;
+  elements_ = NULL;
+  indices_ = NULL;
+  origIndices_ = NULL;
+  nElements_ = 0;
+  capacity_ = 0;
+}
+
 //#############################################################################
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
@@ -22,11 +22,23 @@
 #else
 #define COIN_DEFAULT_VALUE_FOR_DUPLICATE false
 #endif
+/** Number of entries a CoinPackedVector can hold without going to the heap.
+    Shorter vectors (most cuts, for instance) keep indices and elements
+    inside the object. */
+#ifndef COIN_PACKED_VECTOR_SMALL
+#define COIN_PACKED_VECTOR_SMALL 16
+#endif
 /** Sparse Vector
 
 Stores vector of indices and associated element values.
 Supports sorting of vector while maintaining the original indices.
 
+Indices, original positions and elements share one allocation.  A vector
+whose capacity is at most COIN_PACKED_VECTOR_SMALL uses storage inside the
+object instead, so creating, copying and returning short vectors does not
+touch the heap.  Vectors can be moved, which hands over the storage (or
+copies the few inline entries).
+
 Here is a sample usage:
 @verbatim
     const int ne = 4;
@@ -164,11 +176,16 @@ public:
        <code>testForDuplicateIndex</code> setting, and affter copying the data
        it acts accordingly. */
   CoinPackedVector &operator=(const CoinPackedVectorBase &rhs);
+  /** Move assignment operator.  Takes over the storage of rhs, which is
+       left empty.  Unlike copy assignment the
+       <code>testForDuplicateIndex</code> setting of rhs is taken over too. */
+  CoinPackedVector &operator=(CoinPackedVector &&rhs) noexcept;
 
   /** Assign the ownership of the arguments to this vector.
        Size is the length of both the indices and elements vectors.
        The indices and elements vectors are copied into this class instance's
-       member data. The last argument indicates whether this vector will have
+       member data and then deleted; \p inds and \p elems will be NULL on
+       return. The last argument indicates whether this vector will have
        to be tested for duplicate indices.
    */
   void assignVector(int size, int *&inds, double *&elems,
@@ -297,6 +314,7 @@ public:
   /** \brief Alternate Constructors - set elements to vector of doubles
 
      This constructor takes ownership of the vectors passed as parameters.
+     They are copied into the storage of the vector and deleted;
      \p inds and \p elems will be NULL on return.
    */
   CoinPackedVector(int capacity, int size, int *&inds, double *&elems,
@@ -310,6 +328,9 @@ public:
     bool testForDuplicateIndex = COIN_DEFAULT_VALUE_FOR_DUPLICATE);
   /** Copy constructor. */
   CoinPackedVector(const CoinPackedVector &);
+  /** Move constructor.  Takes over the storage of rhs, which is left
+       empty. */
+  CoinPackedVector(CoinPackedVector &&rhs) noexcept;
   /** Copy constructor <em>from a PackedVectorBase</em>. */
   CoinPackedVector(const CoinPackedVectorBase &rhs);
   /** Destructor */
@@ -329,6 +350,15 @@ private:
     const int *inds, double value,
     bool testForDuplicateIndex,
     const char *method);
+  /// Take over storage of rhs (own storage must be free)
+  void gutsOfMove(CoinPackedVector &rhs);
+  /// Free storage - vector is left empty with no capacity
+  void freeStorage();
+  /// True if using storage inside object
+  inline bool isSmall() const
+  {
+    return elements_ == smallElements_;
+  }
   //@}
 
 private:
@@ -344,6 +374,12 @@ private:
   int *origIndices_;
   /// Amount of memory allocated for indices_, origIndices_, and elements_.
   int capacity_;
+  /// Elements while capacity_ <= COIN_PACKED_VECTOR_SMALL
+  double smallElements_[COIN_PACKED_VECTOR_SMALL];
+  /// Indices while capacity_ <= COIN_PACKED_VECTOR_SMALL
+  int smallIndices_[COIN_PACKED_VECTOR_SMALL];
+  /// Original indices while capacity_ <= COIN_PACKED_VECTOR_SMALL
+  int smallOrigIndices_[COIN_PACKED_VECTOR_SMALL];
   //@}
 };
 
@@ -309,6 +309,20 @@ void CoinPackedVectorBase::clearBase() const
   testedDuplicateIndex_ = false;
 }
 
+//-----------------------------------------------------------------------------
+
+void CoinPackedVectorBase::moveBase(CoinPackedVectorBase &rhs)
+{
+  clearIndexSet();
+  maxIndex_ = rhs.maxIndex_;
+  minIndex_ = rhs.minIndex_;
+  indexSetPtr_ = rhs.indexSetPtr_;
+  testForDuplicateIndex_ = rhs.testForDuplicateIndex_;
+  testedDuplicateIndex_ = rhs.testedDuplicateIndex_;
+  rhs.indexSetPtr_ = NULL;
+  rhs.clearBase();
+}
+
 //#############################################################################
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
@@ -240,6 +240,9 @@ protected:
   /// Delete the indexSet
   void clearIndexSet() const;
   void clearBase() const;
+  /** Take over index set, bounds and duplicate test settings of rhs.
+      rhs is left as if cleared. */
+  void moveBase(CoinPackedVectorBase &rhs);
   void copyMaxMinIndex(const CoinPackedVectorBase &x) const
   {
     maxIndex_ = x.maxIndex_;
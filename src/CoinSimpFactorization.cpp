@@ -12,8 +12,6 @@
 #include "CoinFinite.hpp"
 #include <stdio.h>
 
-#define ARRAY 0
-
 FactorPointers::FactorPointers(int numRows, int numColumns,
   int *UrowLengths_,
   int *UcolLengths_)
@@ -1484,11 +1482,13 @@ void CoinSimpFactorization::updateCurrentRow(const int pivotRow,
   double *denseRow = denseVector_;
   const int rowBeg = UrowStarts_[row];
   int rowEnd = rowBeg + UrowLengths_[row];
-  // treat old nonzeros
+  // treat old nonzeros - denseRow is zero except in pivot row so can
+  // update whole row in one pass
+  CoinGatherAxpyN(-multiplier, denseRow, UrowInd_ + rowBeg, rowEnd - rowBeg,
+    Urows_ + rowBeg);
   for (int i = rowBeg; i < rowEnd; ++i) {
     const int column = UrowInd_[i];
     if (colLabels[column]) {
-      Urows_[i] -= multiplier * denseRow[column];
       const double absNewCoeff = fabs(Urows_[i]);
       colLabels[column] = 0;
       --newNonZeros;
@@ -2036,8 +2036,8 @@ void CoinSimpFactorization::allocateSomeArrays()
 void CoinSimpFactorization::Lxeqb(double *b) const
 {
   double *rhs = b;
-  int k, colBeg, *ind, *indEnd;
-  double xk, *Lcol;
+  int k, colBeg;
+  double xk;
   // now solve
   for (int j = firstNumberSlacks_; j < numberRows_; ++j) {
     k = rowOfU_[j];
@@ -2045,13 +2045,8 @@ void CoinSimpFactorization::Lxeqb(double *b) const
     if (xk != 0.0) {
       //if ( fabs(xk)>zeroTolerance_ ) {
       colBeg = LcolStarts_[k];
-      ind = LcolInd_ + colBeg;
-      indEnd = ind + LcolLengths_[k];
-      Lcol = Lcolumns_ + colBeg;
-      for (; ind != indEnd; ++ind) {
-        rhs[*ind] -= (*Lcol) * xk;
-        ++Lcol;
-      }
+      CoinScatterAxpyN(-xk, Lcolumns_ + colBeg, LcolInd_ + colBeg,
+        LcolLengths_[k], rhs);
     }
   }
 }
@@ -2060,72 +2055,30 @@ void CoinSimpFactorization::Lxeqb2(double *b1, double *b2) const
 {
   double *rhs1 = b1;
   double *rhs2 = b2;
-  double x1, x2, *Lcol;
-  int k, colBeg, *ind, *indEnd, j;
+  double x1, x2;
+  int k, colBeg, j;
   // now solve
   for (j = firstNumberSlacks_; j < numberRows_; ++j) {
     k = rowOfU_[j];
     x1 = rhs1[k];
     x2 = rhs2[k];
-    if (x1 == 0.0) {
-      if (x2 == 0.0) {
-      } else {
-        colBeg = LcolStarts_[k];
-        ind = LcolInd_ + colBeg;
-        indEnd = ind + LcolLengths_[k];
-        Lcol = Lcolumns_ + colBeg;
-        for (; ind != indEnd; ++ind) {
-#if 0
-		    rhs2[ *ind ]-= (*Lcol) * x2;
-#else
-          double value = rhs2[*ind];
-          rhs2[*ind] = value - (*Lcol) * x2;
-#endif
-          ++Lcol;
-        }
-      }
-    } else {
-      if (x2 == 0.0) {
-        colBeg = LcolStarts_[k];
-        ind = LcolInd_ + colBeg;
-        indEnd = ind + LcolLengths_[k];
-        Lcol = Lcolumns_ + colBeg;
-        for (; ind != indEnd; ++ind) {
-#if 0
-		    rhs1[ *ind ]-= (*Lcol) * x1;
-#else
-          double value = rhs1[*ind];
-          rhs1[*ind] = value - (*Lcol) * x1;
-#endif
-          ++Lcol;
-        }
-      } else {
-        colBeg = LcolStarts_[k];
-        ind = LcolInd_ + colBeg;
-        indEnd = ind + LcolLengths_[k];
-        Lcol = Lcolumns_ + colBeg;
-        for (; ind != indEnd; ++ind) {
-#if 0
-		    rhs1[ *ind ]-= (*Lcol) * x1;
-		    rhs2[ *ind ]-= (*Lcol) * x2;
-#else
-          double value1 = rhs1[*ind];
-          rhs1[*ind] = value1 - (*Lcol) * x1;
-          double value2 = rhs2[*ind];
-          rhs2[*ind] = value2 - (*Lcol) * x2;
-#endif
-          ++Lcol;
-        }
-      }
-    }
+    if (x1 == 0.0 && x2 == 0.0)
+      continue;
+    colBeg = LcolStarts_[k];
+    if (x1 != 0.0)
+      CoinScatterAxpyN(-x1, Lcolumns_ + colBeg, LcolInd_ + colBeg,
+        LcolLengths_[k], rhs1);
+    if (x2 != 0.0)
+      CoinScatterAxpyN(-x2, Lcolumns_ + colBeg, LcolInd_ + colBeg,
+        LcolLengths_[k], rhs2);
   }
 }
 
 void CoinSimpFactorization::Uxeqb(double *b, double *sol) const
 {
   double *rhs = b;
-  int row, column, colBeg, *ind, *indEnd, k;
-  double x, *uCol;
+  int row, column, colBeg, k;
+  double x;
   // now solve
   for (k = numberRows_ - 1; k >= numberSlacks_; --k) {
     row = secRowOfU_[k];
@@ -2135,18 +2088,8 @@ void CoinSimpFactorization::Uxeqb(double *b, double *sol) const
       //if ( fabs(x) > zeroTolerance_ ) {
       x *= invOfPivots_[row];
       colBeg = UcolStarts_[column];
-      ind = UcolInd_ + colBeg;
-      indEnd = ind + UcolLengths_[column];
-      uCol = Ucolumns_ + colBeg;
-      for (; ind != indEnd; ++ind) {
-#if 0 
-		rhs[ *ind ]-= (*uCol) * x;
-#else
-        double value = rhs[*ind];
-        rhs[*ind] = value - (*uCol) * x;
-#endif
-        ++uCol;
-      }
+      CoinScatterAxpyN(-x, Ucolumns_ + colBeg, UcolInd_ + colBeg,
+        UcolLengths_[column], rhs);
       sol[column] = x;
     } else
       sol[column] = 0.0;
@@ -2162,77 +2105,27 @@ void CoinSimpFactorization::Uxeqb2(double *b1, double *sol1, double *b2, double
 {
   double *rhs1 = b1;
   double *rhs2 = b2;
-  int row, column, colBeg, *ind, *indEnd;
-  double x1, x2, *uCol;
+  int row, column, colBeg;
+  double x1, x2;
   // now solve
   for (int k = numberRows_ - 1; k >= numberSlacks_; --k) {
     row = secRowOfU_[k];
     x1 = rhs1[row];
     x2 = rhs2[row];
     column = colOfU_[k];
-    if (x1 == 0.0) {
-      if (x2 == 0.0) {
-        sol1[column] = 0.0;
-        sol2[column] = 0.0;
-      } else {
-        x2 *= invOfPivots_[row];
-        colBeg = UcolStarts_[column];
-        ind = UcolInd_ + colBeg;
-        indEnd = ind + UcolLengths_[column];
-        uCol = Ucolumns_ + colBeg;
-        for (; ind != indEnd; ++ind) {
-#if 0
-		    rhs2[ *ind ]-= (*uCol) * x2;
-#else
-          double value = rhs2[*ind];
-          rhs2[*ind] = value - (*uCol) * x2;
-#endif
-          ++uCol;
-        }
-        sol1[column] = 0.0;
-        sol2[column] = x2;
-      }
-    } else {
-      if (x2 == 0.0) {
-        x1 *= invOfPivots_[row];
-        colBeg = UcolStarts_[column];
-        ind = UcolInd_ + colBeg;
-        indEnd = ind + UcolLengths_[column];
-        uCol = Ucolumns_ + colBeg;
-        for (; ind != indEnd; ++ind) {
-#if 0
-		    rhs1[ *ind ]-= (*uCol) * x1;
-#else
-          double value = rhs1[*ind];
-          rhs1[*ind] = value - (*uCol) * x1;
-#endif
-          ++uCol;
-        }
-        sol1[column] = x1;
-        sol2[column] = 0.0;
-      } else {
-        x1 *= invOfPivots_[row];
-        x2 *= invOfPivots_[row];
-        colBeg = UcolStarts_[column];
-        ind = UcolInd_ + colBeg;
-        indEnd = ind + UcolLengths_[column];
-        uCol = Ucolumns_ + colBeg;
-        for (; ind != indEnd; ++ind) {
-#if 0
-		    rhs1[ *ind ]-= (*uCol) * x1;
-		    rhs2[ *ind ]-= (*uCol) * x2;
-#else
-          double value1 = rhs1[*ind];
-          rhs1[*ind] = value1 - (*uCol) * x1;
-          double value2 = rhs2[*ind];
-          rhs2[*ind] = value2 - (*uCol) * x2;
-#endif
-          ++uCol;
-        }
-        sol1[column] = x1;
-        sol2[column] = x2;
-      }
+    colBeg = UcolStarts_[column];
+    if (x1 != 0.0) {
+      x1 *= invOfPivots_[row];
+      CoinScatterAxpyN(-x1, Ucolumns_ + colBeg, UcolInd_ + colBeg,
+        UcolLengths_[column], rhs1);
+    }
+    if (x2 != 0.0) {
+      x2 *= invOfPivots_[row];
+      CoinScatterAxpyN(-x2, Ucolumns_ + colBeg, UcolInd_ + colBeg,
+        UcolLengths_[column], rhs2);
     }
+    sol1[column] = x1;
+    sol2[column] = x2;
   }
   for (int k = numberSlacks_ - 1; k >= 0; --k) {
     row = secRowOfU_[k];
@@ -2245,9 +2138,8 @@ void CoinSimpFactorization::Uxeqb2(double *b1, double *sol1, double *b2, double
 void CoinSimpFactorization::xLeqb(double *b) const
 {
   double *rhs = b;
-  int k, *ind, *indEnd, j;
+  int k, j;
   int colBeg;
-  double x, *Lcol;
   // find last nonzero
   int last;
   for (last = numberColumns_ - 1; last >= 0; --last) {
@@ -2258,16 +2150,9 @@ void CoinSimpFactorization::xLeqb(double *b) const
   if (last >= 0) {
     for (j = last; j >= firstNumberSlacks_; --j) {
       k = rowOfU_[j];
-      x = rhs[k];
       colBeg = LcolStarts_[k];
-      ind = LcolInd_ + colBeg;
-      indEnd = ind + LcolLengths_[k];
-      Lcol = Lcolumns_ + colBeg;
-      for (; ind != indEnd; ++ind) {
-        x -= (*Lcol) * rhs[*ind];
-        ++Lcol;
-      }
-      rhs[k] = x;
+      rhs[k] -= CoinGatherDotN(Lcolumns_ + colBeg, LcolInd_ + colBeg,
+        LcolLengths_[k], rhs);
     }
   } // if ( last >= 0 ){
 }
@@ -2275,12 +2160,11 @@ void CoinSimpFactorization::xLeqb(double *b) const
 void CoinSimpFactorization::xUeqb(double *b, double *sol) const
 {
   double *rhs = b;
-  int row, col, *ind, *indEnd, k;
+  int row, col, k;
   double xr;
   // now solve
 #if 1
   int rowBeg;
-  double *uRow;
   for (k = 0; k < numberSlacks_; ++k) {
     row = secRowOfU_[k];
     col = colOfU_[k];
@@ -2289,13 +2173,8 @@ void CoinSimpFactorization::xUeqb(double *b, double *sol) const
       //if ( fabs(xr)> zeroTolerance_ ) {
       xr = -xr;
       rowBeg = UrowStarts_[row];
-      ind = UrowInd_ + rowBeg;
-      indEnd = ind + UrowLengths_[row];
-      uRow = Urows_ + rowBeg;
-      for (; ind != indEnd; ++ind) {
-        rhs[*ind] -= (*uRow) * xr;
-        ++uRow;
-      }
+      CoinScatterAxpyN(-xr, Urows_ + rowBeg, UrowInd_ + rowBeg,
+        UrowLengths_[row], rhs);
       sol[row] = xr;
     } else
       sol[row] = 0.0;
@@ -2308,13 +2187,8 @@ void CoinSimpFactorization::xUeqb(double *b, double *sol) const
       //if ( fabs(xr)> zeroTolerance_ ) {
       xr *= invOfPivots_[row];
       rowBeg = UrowStarts_[row];
-      ind = UrowInd_ + rowBeg;
-      indEnd = ind + UrowLengths_[row];
-      uRow = Urows_ + rowBeg;
-      for (; ind != indEnd; ++ind) {
-        rhs[*ind] -= (*uRow) * xr;
-        ++uRow;
-      }
+      CoinScatterAxpyN(-xr, Urows_ + rowBeg, UrowInd_ + rowBeg,
+        UrowLengths_[row], rhs);
       sol[row] = xr;
     } else
       sol[row] = 0.0;
@@ -2330,7 +2204,8 @@ void CoinSimpFactorization::xUeqb(double *b, double *sol) const
     col = colOfU_[k];
     xr = rhs[col];
     int colBeg = UcolStarts_[col];
-    ind = UcolInd_ + colBeg;
+    int *ind = UcolInd_ + colBeg;
+    int *indEnd;
     indEnd = ind + UcolLengths_[col];
     double *uCol = Ucolumns_ + colBeg;
     for (; ind != indEnd; ++ind, ++uCol) {
@@ -2454,20 +2329,8 @@ int CoinSimpFactorization::LUupdate(int newBasicCol)
     const double multiplier = denseVector_[column] * invOfPivots_[row];
     denseVector_[column] = 0.0;
     const int rowBeg = UrowStarts_[row];
-    const int rowEnd = rowBeg + UrowLengths_[row];
-#if ARRAY
-    for (int j = rowBeg; j < rowEnd; ++j) {
-      denseVector_[UrowInd_[j]] -= multiplier * Urows_[j];
-    }
-#else
-    int *ind = UrowInd_ + rowBeg;
-    int *indEnd = UrowInd_ + rowEnd;
-    double *uRow = Urows_ + rowBeg;
-    for (; ind != indEnd; ++ind) {
-      denseVector_[*ind] -= multiplier * (*uRow);
-      ++uRow;
-    }
-#endif
+    CoinScatterAxpyN(-multiplier, Urows_ + rowBeg, UrowInd_ + rowBeg,
+      UrowLengths_[row], denseVector_);
     // store multiplier
     Eta_[EtaSize_] = multiplier;
     EtaInd_[EtaSize_++] = row;
@@ -2564,21 +2427,13 @@ void CoinSimpFactorization::copyRowPermutations()
 void CoinSimpFactorization::Hxeqb(double *b) const
 {
   double *rhs = b;
-  int row, rowBeg, *ind, *indEnd;
-  double xr, *eta;
+  int row, rowBeg;
   // now solve
   for (int k = 0; k <= lastEtaRow_; ++k) {
     row = EtaPosition_[k];
     rowBeg = EtaStarts_[k];
-    xr = 0.0;
-    ind = EtaInd_ + rowBeg;
-    indEnd = ind + EtaLengths_[k];
-    eta = Eta_ + rowBeg;
-    for (; ind != indEnd; ++ind) {
-      xr += rhs[*ind] * (*eta);
-      ++eta;
-    }
-    rhs[row] -= xr;
+    rhs[row] -= CoinGatherDotN(Eta_ + rowBeg, EtaInd_ + rowBeg,
+      EtaLengths_[k], rhs);
   }
 }
 
@@ -2586,32 +2441,23 @@ void CoinSimpFactorization::Hxeqb2(double *b1, double *b2) const
 {
   double *rhs1 = b1;
   double *rhs2 = b2;
-  int row, rowBeg, *ind, *indEnd;
-  double x1, x2, *eta;
+  int row, rowBeg;
   // now solve
   for (int k = 0; k <= lastEtaRow_; ++k) {
     row = EtaPosition_[k];
     rowBeg = EtaStarts_[k];
-    x1 = 0.0;
-    x2 = 0.0;
-    ind = EtaInd_ + rowBeg;
-    indEnd = ind + EtaLengths_[k];
-    eta = Eta_ + rowBeg;
-    for (; ind != indEnd; ++ind) {
-      x1 += rhs1[*ind] * (*eta);
-      x2 += rhs2[*ind] * (*eta);
-      ++eta;
-    }
-    rhs1[row] -= x1;
-    rhs2[row] -= x2;
+    rhs1[row] -= CoinGatherDotN(Eta_ + rowBeg, EtaInd_ + rowBeg,
+      EtaLengths_[k], rhs1);
+    rhs2[row] -= CoinGatherDotN(Eta_ + rowBeg, EtaInd_ + rowBeg,
+      EtaLengths_[k], rhs2);
   }
 }
 
 void CoinSimpFactorization::xHeqb(double *b) const
 {
   double *rhs = b;
-  int row, rowBeg, *ind, *indEnd;
-  double xr, *eta;
+  int row, rowBeg;
+  double xr;
   // now solve
   for (int k = lastEtaRow_; k >= 0; --k) {
     row = EtaPosition_[k];
@@ -2620,13 +2466,8 @@ void CoinSimpFactorization::xHeqb(double *b) const
       continue;
     //if ( fabs(xr) <= zeroTolerance_ ) continue;
     rowBeg = EtaStarts_[k];
-    ind = EtaInd_ + rowBeg;
-    indEnd = ind + EtaLengths_[k];
-    eta = Eta_ + rowBeg;
-    for (; ind != indEnd; ++ind) {
-      rhs[*ind] -= xr * (*eta);
-      ++eta;
-    }
+    CoinScatterAxpyN(-xr, Eta_ + rowBeg, EtaInd_ + rowBeg, EtaLengths_[k],
+      rhs);
   }
 }
 
@@ -0,0 +1,199 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+#include "CoinThreadPool.hpp"
+
+#include <cassert>
+#include <vector>
+
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#ifdef COINUTILS_PTHREADS
+// Shared state of pool - all fields protected by mutex
+class CoinThreadPoolData {
+public:
+  pthread_mutex_t mutex;
+  /// Signalled when new work (or stop) is posted
+  pthread_cond_t startWork;
+  /// Signalled when last task of a run finishes
+  pthread_cond_t workDone;
+  std::vector< pthread_t > threads;
+  /// Incremented for each run
+  int generation;
+  bool stop;
+  bool busy;
+  CoinThreadFunction function;
+  void *info;
+  int numberTasks;
+  int nextTask;
+  int tasksLeft;
+};
+
+// Take tasks until none left - mutex must be held on entry and is held on exit
+static void doTasks(CoinThreadPoolData *data)
+{
+  while (data->nextTask < data->numberTasks) {
+    int which = data->nextTask++;
+    CoinThreadFunction function = data->function;
+    void *info = data->info;
+    pthread_mutex_unlock(&data->mutex);
+    function(info, which);
+    pthread_mutex_lock(&data->mutex);
+    data->tasksLeft--;
+    if (!data->tasksLeft)
+      pthread_cond_signal(&data->workDone);
+  }
+}
+
+extern "C" {
+static void *coinThreadPoolWorker(void *arg)
+{
+  CoinThreadPoolData *data = reinterpret_cast< CoinThreadPoolData * >(arg);
+  pthread_mutex_lock(&data->mutex);
+  int seen = data->generation;
+  while (true) {
+    while (!data->stop && data->generation == seen)
+      pthread_cond_wait(&data->startWork, &data->mutex);
+    if (data->stop)
+      break;
+    seen = data->generation;
+    doTasks(data);
+  }
+  pthread_mutex_unlock(&data->mutex);
+  return NULL;
+}
+}
+#else
+class CoinThreadPoolData {
+};
+#endif
+
+CoinThreadPool::CoinThreadPool(int numberThreads)
+  : numberThreads_(1)
+  , data_(NULL)
+{
+  setNumberThreads(numberThreads);
+}
+
+CoinThreadPool::~CoinThreadPool()
+{
+  stopThreads();
+}
+
+bool CoinThreadPool::threadsAvailable()
+{
+#ifdef COINUTILS_PTHREADS
+  return true;
+#else
+  return false;
+#endif
+}
+
+int CoinThreadPool::numberProcessors()
+{
+#if defined(_SC_NPROCESSORS_ONLN)
+  long number = sysconf(_SC_NPROCESSORS_ONLN);
+  return number > 0 ? static_cast< int >(number) : 1;
+#else
+  return 1;
+#endif
+}
+
+void CoinThreadPool::setNumberThreads(int numberThreads)
+{
+  if (numberThreads < 1)
+    numberThreads = numberProcessors();
+  if (numberThreads == numberThreads_ && (data_ || numberThreads == 1))
+    return;
+  stopThreads();
+  numberThreads_ = numberThreads;
+  startThreads();
+}
+
+void CoinThreadPool::startThreads()
+{
+#ifdef COINUTILS_PTHREADS
+  assert(!data_);
+  if (numberThreads_ <= 1)
+    return;
+  data_ = new CoinThreadPoolData();
+  pthread_mutex_init(&data_->mutex, NULL);
+  pthread_cond_init(&data_->startWork, NULL);
+  pthread_cond_init(&data_->workDone, NULL);
+  data_->generation = 0;
+  data_->stop = false;
+  data_->busy = false;
+  data_->function = NULL;
+  data_->info = NULL;
+  data_->numberTasks = 0;
+  data_->nextTask = 0;
+  data_->tasksLeft = 0;
+  for (int i = 1; i < numberThreads_; i++) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, coinThreadPoolWorker, data_))
+      break;
+    data_->threads.push_back(thread);
+  }
+  if (data_->threads.empty()) {
+    // could not get any threads - run serially
+    stopThreads();
+    numberThreads_ = 1;
+  }
+#endif
+}
+
+void CoinThreadPool::stopThreads()
+{
+#ifdef COINUTILS_PTHREADS
+  if (!data_)
+    return;
+  pthread_mutex_lock(&data_->mutex);
+  data_->stop = true;
+  pthread_cond_broadcast(&data_->startWork);
+  pthread_mutex_unlock(&data_->mutex);
+  for (size_t i = 0; i < data_->threads.size(); i++)
+    pthread_join(data_->threads[i], NULL);
+  pthread_cond_destroy(&data_->workDone);
+  pthread_cond_destroy(&data_->startWork);
+  pthread_mutex_destroy(&data_->mutex);
+  delete data_;
+#endif
+  data_ = NULL;
+}
+
+void CoinThreadPool::run(int numberTasks, CoinThreadFunction function, void *info)
+{
+#ifdef COINUTILS_PTHREADS
+  if (data_ && numberTasks > 1) {
+    pthread_mutex_lock(&data_->mutex);
+    if (!data_->busy) {
+      data_->busy = true;
+      data_->function = function;
+      data_->info = info;
+      data_->numberTasks = numberTasks;
+      data_->nextTask = 0;
+      data_->tasksLeft = numberTasks;
+      data_->generation++;
+      pthread_cond_broadcast(&data_->startWork);
+      doTasks(data_);
+      while (data_->tasksLeft)
+        pthread_cond_wait(&data_->workDone, &data_->mutex);
+      data_->busy = false;
+      pthread_mutex_unlock(&data_->mutex);
+      return;
+    }
+    pthread_mutex_unlock(&data_->mutex);
+  }
+#endif
+  for (int i = 0; i < numberTasks; i++)
+    function(info, i);
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
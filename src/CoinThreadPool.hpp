@@ -0,0 +1,87 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinThreadPool_H
+#define CoinThreadPool_H
+
+#include "CoinUtilsConfig.h"
+
+/** Signature of work handed to a CoinThreadPool.
+
+    \p info is the pointer given to CoinThreadPool::run and \p which is the
+    number of the task (0 to numberTasks-1).  A task must not write to data
+    that another task of the same run reads or writes.
+*/
+typedef void (*CoinThreadFunction)(void *info, int which);
+
+class CoinThreadPoolData;
+
+/** Very simple pool of worker threads.
+
+    The pool keeps numberThreads-1 workers asleep between calls to run; the
+    calling thread always does its share of the tasks.  If CoinUtils was
+    not configured with --enable-coinutils-threads (or the pool has one
+    thread) run simply executes the tasks in order on the calling thread,
+    so code using the pool never needs its own serial fallback.
+
+    run is not re-entrant: a task that calls run on the pool it is running
+    on (or a second thread using a busy pool) gets serial execution rather
+    than a deadlock.
+*/
+class COINUTILSLIB_EXPORT CoinThreadPool {
+
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /// Constructor - numberThreads includes the calling thread
+  CoinThreadPool(int numberThreads = 1);
+  /// Destructor - stops workers
+  ~CoinThreadPool();
+  //@}
+
+  /**@name Thread count */
+  //@{
+  /// Number of threads (including caller) used by run
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  /** Set number of threads (including caller).
+
+      Values less than one mean numberProcessors().  Workers are restarted
+      so this should not be called from inside a task.
+  */
+  void setNumberThreads(int numberThreads);
+  /// True if CoinUtils was built thread-aware
+  static bool threadsAvailable();
+  /// Number of processors online (1 if unknown)
+  static int numberProcessors();
+  //@}
+
+  /**@name Work */
+  //@{
+  /** Run function(info, i) for i = 0, ..., numberTasks-1 and wait for
+      all of them to finish.  Tasks are handed out in increasing order.
+  */
+  void run(int numberTasks, CoinThreadFunction function, void *info);
+  //@}
+
+private:
+  /// Illegal
+  CoinThreadPool(const CoinThreadPool &);
+  CoinThreadPool &operator=(const CoinThreadPool &);
+  /// Start workers for numberThreads_
+  void startThreads();
+  /// Stop and join workers
+  void stopThreads();
+
+  /// Number of threads including caller
+  int numberThreads_;
+  /// Threading data (NULL if serial)
+  CoinThreadPoolData *data_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
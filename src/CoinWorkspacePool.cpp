@@ -0,0 +1,99 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+#include "CoinWorkspacePool.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+CoinWorkspacePool::CoinWorkspacePool(int capacity)
+  : capacity_(std::max(capacity, 0))
+{
+}
+
+CoinWorkspacePool::~CoinWorkspacePool()
+{
+  for (size_t i = 0; i < vectors_.size(); i++)
+    delete vectors_[i];
+  for (size_t i = 0; i < arrays_.size(); i++)
+    delete arrays_[i];
+}
+
+void CoinWorkspacePool::setCapacity(int capacity)
+{
+  capacity_ = std::max(capacity, 0);
+}
+
+// Get a clear vector
+CoinIndexedVector *CoinWorkspacePool::getVector(int capacity)
+{
+  capacity = std::max(capacity, capacity_);
+  CoinIndexedVector *vector;
+  if (!freeVectors_.empty()) {
+    vector = freeVectors_.back();
+    freeVectors_.pop_back();
+  } else {
+    vector = new CoinIndexedVector();
+    vectors_.push_back(vector);
+  }
+  if (vector->capacity() < capacity)
+    vector->reserve(capacity);
+  return vector;
+}
+
+// Give back vector - it is cleared
+void CoinWorkspacePool::returnVector(CoinIndexedVector *vector)
+{
+  assert(std::find(vectors_.begin(), vectors_.end(), vector) != vectors_.end());
+  assert(std::find(freeVectors_.begin(), freeVectors_.end(), vector) == freeVectors_.end());
+  vector->clear();
+  vector->setPackedMode(false);
+  freeVectors_.push_back(vector);
+}
+
+// Get an array with room for at least numberBytes
+CoinArrayWithLength *CoinWorkspacePool::getArray(CoinByteArray numberBytes)
+{
+  // smallest which is big enough - otherwise enlarge biggest
+  int best = -1;
+  int biggest = -1;
+  for (int i = 0; i < static_cast< int >(freeArrays_.size()); i++) {
+    CoinByteArray size = freeArrays_[i]->capacity();
+    if (size >= numberBytes && (best < 0 || size < freeArrays_[best]->capacity()))
+      best = i;
+    if (biggest < 0 || size > freeArrays_[biggest]->capacity())
+      biggest = i;
+  }
+  if (best < 0)
+    best = biggest;
+  CoinArrayWithLength *array;
+  if (best >= 0) {
+    array = freeArrays_[best];
+    freeArrays_[best] = freeArrays_.back();
+    freeArrays_.pop_back();
+    array->conditionalNew(numberBytes);
+  } else {
+    array = new CoinArrayWithLength(numberBytes, 0);
+    arrays_.push_back(array);
+  }
+  return array;
+}
+
+// Give back array
+void CoinWorkspacePool::returnArray(CoinArrayWithLength *array)
+{
+  assert(std::find(arrays_.begin(), arrays_.end(), array) != arrays_.end());
+  assert(std::find(freeArrays_.begin(), freeArrays_.end(), array) == freeArrays_.end());
+  freeArrays_.push_back(array);
+}
+
+// Pool belonging to calling thread
+CoinWorkspacePool &CoinWorkspacePool::threadInstance()
+{
+  static thread_local CoinWorkspacePool pool;
+  return pool;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,167 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinWorkspacePool_H
+#define CoinWorkspacePool_H
+
+#include <vector>
+
+#include "CoinUtilsConfig.h"
+#include "CoinIndexedVector.hpp"
+
+/** Pool of work vectors and arrays.
+
+    Solver code often wants a clear CoinIndexedVector (or a scratch
+    CoinArrayWithLength) sized to the number of rows for just a few
+    operations.  A pool keeps such objects so they are allocated (and have
+    their pages touched) once rather than on every use.
+
+    Vectors are handed out clear and with at least capacity() entries.
+    When they come back they are cleared, which costs work proportional
+    to their number of elements (see CoinIndexedVector::clear), not to
+    their capacity.  Arrays are just scratch space and are not cleared.
+
+    A pool is not thread safe.  threadInstance() gives each thread a pool
+    of its own, so parallel callers never share one.  Vectors and arrays
+    still out when a pool is destroyed are deleted with it.
+*/
+class COINUTILSLIB_EXPORT CoinWorkspacePool {
+
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /// Constructor - vectors will have capacity at least capacity
+  CoinWorkspacePool(int capacity = 0);
+  /// Destructor - deletes all vectors and arrays
+  ~CoinWorkspacePool();
+  //@}
+
+  /**@name Size */
+  //@{
+  /// Smallest capacity of vectors handed out
+  inline int capacity() const
+  {
+    return capacity_;
+  }
+  /** Set smallest capacity of vectors handed out.
+      Vectors in the pool are enlarged when next handed out. */
+  void setCapacity(int capacity);
+  //@}
+
+  /**@name Vectors */
+  //@{
+  /** Get a clear vector with capacity at least max(capacity,capacity()).
+      Must be given back with returnVector. */
+  CoinIndexedVector *getVector(int capacity = -1);
+  /// Give back vector from getVector - it is cleared
+  void returnVector(CoinIndexedVector *vector);
+  //@}
+
+  /**@name Arrays */
+  //@{
+  /** Get an array with room for at least numberBytes (contents
+      undefined).  Must be given back with returnArray. */
+  CoinArrayWithLength *getArray(CoinByteArray numberBytes);
+  /// Give back array from getArray
+  void returnArray(CoinArrayWithLength *array);
+  //@}
+
+  /**@name Statistics */
+  //@{
+  /// Number of vectors created
+  inline int numberVectors() const
+  {
+    return static_cast< int >(vectors_.size());
+  }
+  /// Number of vectors handed out and not yet given back
+  inline int numberVectorsInUse() const
+  {
+    return static_cast< int >(vectors_.size() - freeVectors_.size());
+  }
+  /// Number of arrays created
+  inline int numberArrays() const
+  {
+    return static_cast< int >(arrays_.size());
+  }
+  /// Number of arrays handed out and not yet given back
+  inline int numberArraysInUse() const
+  {
+    return static_cast< int >(arrays_.size() - freeArrays_.size());
+  }
+  //@}
+
+  /**@name Per thread pools */
+  //@{
+  /** Pool belonging to calling thread (created on first use and deleted
+      when the thread finishes) */
+  static CoinWorkspacePool &threadInstance();
+  //@}
+
+private:
+  /// Illegal
+  CoinWorkspacePool(const CoinWorkspacePool &);
+  CoinWorkspacePool &operator=(const CoinWorkspacePool &);
+
+  /// Smallest capacity of vectors handed out
+  int capacity_;
+  /// All vectors
+  std::vector< CoinIndexedVector * > vectors_;
+  /// Vectors available
+  std::vector< CoinIndexedVector * > freeVectors_;
+  /// All arrays
+  std::vector< CoinArrayWithLength * > arrays_;
+  /// Arrays available
+  std::vector< CoinArrayWithLength * > freeArrays_;
+};
+
+/** Vector from a CoinWorkspacePool for the life of this object.
+
+    \code
+    CoinWorkspaceVector work;   // from pool of this thread
+    work->quickAdd(iRow, value);
+    \endcode
+*/
+class COINUTILSLIB_EXPORT CoinWorkspaceVector {
+
+public:
+  /// Gets vector from pool
+  explicit CoinWorkspaceVector(CoinWorkspacePool &pool = CoinWorkspacePool::threadInstance(),
+    int capacity = -1)
+    : pool_(pool)
+    , vector_(pool.getVector(capacity))
+  {
+  }
+  /// Gives vector back
+  ~CoinWorkspaceVector()
+  {
+    pool_.returnVector(vector_);
+  }
+  /// The vector
+  inline CoinIndexedVector *vector() const
+  {
+    return vector_;
+  }
+  inline CoinIndexedVector *operator->() const
+  {
+    return vector_;
+  }
+  inline CoinIndexedVector &operator*() const
+  {
+    return *vector_;
+  }
+
+private:
+  /// Illegal
+  CoinWorkspaceVector(const CoinWorkspaceVector &);
+  CoinWorkspaceVector &operator=(const CoinWorkspaceVector &);
+
+  /// Pool vector came from
+  CoinWorkspacePool &pool_;
+  /// Vector
+  CoinIndexedVector *vector_;
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -12,6 +12,7 @@
 #endif
 
 #include <cassert>
+#include <cmath>
 
 #include "CoinDenseVector.hpp"
 #include "CoinFloatEqual.hpp"
@@ -80,6 +81,49 @@ CoinDenseVectorUnitTest(T dummy)
     if (div.sum() != 4.0) 
       std::cout << "With float div.sum() may not equal 4.0 exactly "<<std::endl;
 
+    // Compound expressions are evaluated in one pass
+    CoinDenseVector<T> fused = (r + r1) * r2 - r / 2 + 1;
+    for (int i = 0; i < ne; i++)
+      assert( fused[i] == (el[i] + el[i]) * el[i] - el[i] / 2 + 1 );
+    fused = 2 * fused - fused;
+    assert( fused[3] == (50 + 50) * 50 - 25 + 1 );
+    fused -= r * r;
+    fused += r;
+    assert( fused[2] == 3 - 1.0f/2 - 1 + 1 );
+    CoinDenseVector<T> ratio = 100 / r;
+    assert( ratio[0] == 10 && ratio[1] == 2.5 );
+
+    // Reductions on longer vectors at every vector level
+    {
+      const int n = 1001;
+      CoinDenseVector<T> big(n);
+      double sum = 0.0;
+      double oneNorm = 0.0;
+      double twoNorm = 0.0;
+      for (int i = 0; i < n; i++) {
+        T value = static_cast<T>((i % 7 == 3) ? -0.25 * i : 0.5 * (i % 11));
+        big[i] = value;
+        sum += value;
+        oneNorm += fabs(value);
+        twoNorm += value * value;
+      }
+      big[n - 1] = -2000;
+      sum += -2000 - 0.5 * ((n - 1) % 11);
+      oneNorm += 2000 - 0.5 * ((n - 1) % 11);
+      twoNorm += 2000.0 * 2000.0 - 0.25 * ((n - 1) % 11) * ((n - 1) % 11);
+      for (int level = COIN_SIMD_SCALAR; level <= CoinSimdLevelAvailable(); level++) {
+        CoinSetSimdLevel(level);
+        assert( big.infNorm() == 2000 );
+        assert( fabs(big.sum() - sum) < 1.0e-4 * oneNorm );
+        assert( fabs(big.oneNorm() - oneNorm) < 1.0e-4 * oneNorm );
+        assert( eq(big.twoNorm(), sqrt(twoNorm)) );
+      }
+      CoinSetSimdLevel(-1);
+      CoinDenseVector<T> scaled(big);
+      scaled.scale(2);
+      assert( scaled[n - 1] == -4000 && scaled.infNorm() == 4000 );
+    }
+
 }
 
 template void CoinDenseVectorUnitTest<float>(float);
@@ -0,0 +1,1134 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "CoinFactorization.hpp"
+#include "CoinFactorizationFactory.hpp"
+#include "CoinDenseFactorization.hpp"
+#include "CoinOslFactorization.hpp"
+#include "CoinDenseLU.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinThreadPool.hpp"
+#include "CoinPackedMatrix.hpp"
+
+/*
+  Square matrix with enough entries that factorization fills in and
+  goes dense.  Diagonal is large so any pivot order is stable.
+*/
+static CoinPackedMatrix denseTestMatrix(int n, int perColumn)
+{
+  std::vector< CoinBigIndex > start(1, 0);
+  std::vector< int > row;
+  std::vector< double > element;
+  unsigned int seed = 12345;
+  for (int iColumn = 0; iColumn < n; iColumn++) {
+    row.push_back(iColumn);
+    element.push_back(perColumn + 1.0 + (iColumn % 5));
+    for (int j = 0; j < perColumn; j++) {
+      seed = seed * 1103515245 + 12345;
+      int iRow = static_cast< int >((seed >> 8) % n);
+      bool found = false;
+      for (size_t k = start.back(); k < row.size(); k++)
+        found = found || row[k] == iRow;
+      if (!found) {
+        row.push_back(iRow);
+        element.push_back(((seed >> 4) % 200) * 0.01 - 1.0);
+      }
+    }
+    start.push_back(static_cast< CoinBigIndex >(row.size()));
+  }
+  std::vector< int > length(n);
+  for (int i = 0; i < n; i++)
+    length[i] = static_cast< int >(start[i + 1] - start[i]);
+  return CoinPackedMatrix(true, n, n, start[n], &element[0], &row[0],
+    &start[0], &length[0]);
+}
+
+/*
+  Factorizes all columns and solves B x = b and y B = c.  Answers are
+  returned by basic column so different pivot orders can be compared.
+  Returns largest residual.
+*/
+static double factorizeAndSolve(const CoinPackedMatrix &matrix,
+  int denseThreshold, int denseCode, int numberThreads,
+  std::vector< double > &x, std::vector< double > &y)
+{
+  int n = matrix.getNumCols();
+  CoinFactorization factorization;
+  factorization.setDenseThreshold(denseThreshold);
+  factorization.setDenseCode(denseCode);
+  factorization.setNumberThreads(numberThreads);
+  assert(factorization.numberThreads() == numberThreads);
+  std::vector< int > rowIsBasic(n, -1);
+  std::vector< int > columnIsBasic(n, 1);
+  // -99 means more room needed
+  double areaFactor = 0.0;
+  int status;
+  while ((status = factorization.factorize(matrix, &rowIsBasic[0],
+            &columnIsBasic[0], areaFactor))
+    == -99)
+    areaFactor = areaFactor ? 2.0 * areaFactor : 2.0;
+  assert(!status);
+  // factorization copies keep setting
+  CoinFactorization copy(factorization);
+  assert(copy.numberThreads() == numberThreads);
+  assert(copy.denseCode() == factorization.denseCode());
+  CoinIndexedVector work;
+  work.reserve(n);
+  CoinIndexedVector region;
+  region.reserve(n);
+  // B x = b with b = 1,2,...
+  for (int i = 0; i < n; i++)
+    region.insert(i, 1.0 + i);
+  factorization.updateColumn(&work, &region);
+  x.assign(n, 0.0);
+  for (int j = 0; j < n; j++)
+    x[j] = region.denseVector()[columnIsBasic[j]];
+  region.clear();
+  std::vector< double > product(n, 0.0);
+  matrix.times(&x[0], &product[0]);
+  double largest = 0.0;
+  for (int i = 0; i < n; i++)
+    largest = CoinMax(largest, fabs(product[i] - (1.0 + i)));
+  // y B = c with c_j = j % 3 - 1
+  for (int j = 0; j < n; j++) {
+    if (j % 3 != 1)
+      region.insert(columnIsBasic[j], (j % 3) - 1.0);
+  }
+  factorization.updateColumnTranspose(&work, &region);
+  y.assign(region.denseVector(), region.denseVector() + n);
+  region.clear();
+  matrix.transposeTimes(&y[0], &product[0]);
+  for (int j = 0; j < n; j++)
+    largest = CoinMax(largest, fabs(product[j] - ((j % 3) - 1.0)));
+  return largest;
+}
+
+// Checks built in dense LU against products with original matrix
+static void denseLUTest()
+{
+  // not a multiple of panel or kernel sizes
+  const int n = 150;
+  double *original = new double[n * n];
+  double *a = new double[n * n];
+  double *b = new double[n];
+  double *x = new double[n];
+  int *pivot = new int[n];
+  unsigned int seed = 54321;
+  for (int i = 0; i < n * n; i++) {
+    seed = seed * 1103515245 + 12345;
+    original[i] = ((seed >> 8) % 2001) * 0.001 - 1.0;
+  }
+  CoinThreadPool threads(3);
+  int available = CoinSimdLevelAvailable();
+  for (int level = COIN_SIMD_SCALAR; level <= available; level++) {
+    CoinSetSimdLevel(level);
+    for (int pass = 0; pass < 2; pass++) {
+      CoinMemcpyN(original, n * n, a);
+      int info = CoinDenseLUFactor(n, a, n, pivot, pass ? &threads : NULL);
+      assert(!info);
+      for (int transpose = 0; transpose < 2; transpose++) {
+        for (int i = 0; i < n; i++)
+          x[i] = b[i] = (i % 7) - 2.5;
+        CoinDenseLUSolve(transpose != 0, n, a, n, pivot, x);
+        double largest = 0.0;
+        for (int i = 0; i < n; i++) {
+          double value = 0.0;
+          for (int j = 0; j < n; j++)
+            value += (transpose ? original[i * n + j] : original[j * n + i]) * x[j];
+          largest = CoinMax(largest, fabs(value - b[i]));
+        }
+        assert(largest < 1.0e-9);
+      }
+    }
+  }
+  CoinSetSimdLevel(-1);
+  // singular - zero column
+  CoinMemcpyN(original, n * n, a);
+  CoinZeroN(a + 100 * n, n);
+  assert(CoinDenseLUFactor(n, a, n, pivot) == 101);
+  delete[] original;
+  delete[] a;
+  delete[] b;
+  delete[] x;
+  delete[] pivot;
+}
+
+/*
+  Very sparse solves with and without caching of reaches must agree,
+  before and after some column replacements (which add R etas).
+*/
+static void reachCacheTest()
+{
+  const int n = 1000;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 2);
+  CoinFactorization factorization[2];
+  std::vector< int > rowIsBasic(n, -1);
+  std::vector< int > columnIsBasic(n, 1);
+  for (int i = 0; i < 2; i++) {
+    double areaFactor = 0.0;
+    int status;
+    columnIsBasic.assign(n, 1);
+    while ((status = factorization[i].factorize(matrix, &rowIsBasic[0],
+              &columnIsBasic[0], areaFactor))
+      == -99)
+      areaFactor = areaFactor ? 2.0 * areaFactor : 2.0;
+    assert(!status);
+    // row copy of L and sparse thresholds
+    factorization[i].goSparse();
+    assert(factorization[i].sparseThreshold() > 0);
+  }
+  factorization[1].setReachCaching(true);
+  assert(factorization[1].reachCaching());
+  assert(!factorization[0].reachCaching());
+  // updates need room for extra pivots
+  CoinIndexedVector work;
+  work.reserve(2 * n);
+  CoinIndexedVector region[2];
+  region[0].reserve(2 * n);
+  region[1].reserve(2 * n);
+  for (int pass = 0; pass < 2; pass++) {
+    // each unit vector twice so second time is in cache
+    for (int k = 0; k < 100; k++) {
+      int iRow = (k * 37) % 50 + 10 * pass;
+      for (int transpose = 0; transpose < 2; transpose++) {
+        for (int i = 0; i < 2; i++) {
+          region[i].insert(iRow, 1.0);
+          if (transpose)
+            factorization[i].updateColumnTranspose(&work, &region[i]);
+          else
+            factorization[i].updateColumn(&work, &region[i]);
+        }
+        const double *x0 = region[0].denseVector();
+        const double *x1 = region[1].denseVector();
+        for (int j = 0; j < n; j++)
+          assert(fabs(x1[j] - x0[j]) < 1.0e-12 * (1.0 + fabs(x0[j])));
+        region[0].clear();
+        region[1].clear();
+      }
+    }
+    if (!pass) {
+      // replace some columns by others
+      for (int k = 0; k < 10; k++) {
+        int iColumn = (k * 97) % n;
+        CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+        int length = matrix.getVectorLengths()[iColumn];
+        const int *row = matrix.getIndices() + start;
+        const double *element = matrix.getElements() + start;
+        int pivotRow = -1;
+        for (int i = 0; i < 2; i++) {
+          for (int j = 0; j < length; j++)
+            region[i].insert(row[j], element[j] * (1.0 + 0.1 * k));
+          factorization[i].updateColumnFT(&work, &region[i]);
+          const double *x = region[i].denseVector();
+          if (pivotRow < 0) {
+            // biggest
+            double largest = 0.0;
+            for (int j = 0; j < n; j++) {
+              if (fabs(x[j]) > largest) {
+                largest = fabs(x[j]);
+                pivotRow = j;
+              }
+            }
+          }
+          assert(!factorization[i].replaceColumn(&work, pivotRow, x[pivotRow]));
+          region[i].clear();
+        }
+      }
+    }
+  }
+  assert(factorization[1].reachCacheHits() > 0.0);
+  assert(factorization[1].reachCacheMisses() > 0.0);
+  assert(!factorization[0].reachCacheHits());
+  // sparse L and R paths taken both ways
+  assert(factorization[1].numberSolveMethod(0, 2) > 0.0);
+  assert(factorization[1].numberSolveMethod(3, 2) > 0.0);
+  assert(factorization[1].numberSolveMethod(4, 2) > 0.0);
+  CoinFactorization copy(factorization[1]);
+  assert(copy.reachCaching());
+  factorization[1].resetStatistics();
+  assert(!factorization[1].reachCacheHits());
+  assert(!factorization[1].numberSolveMethod(0, 2));
+}
+
+/*
+  Checks updateColumns and updateColumnsTranspose against one at a
+  time solves with a mixture of packed and unpacked vectors.
+*/
+static void checkMultipleSolves(const CoinFactorization &factorization, int n)
+{
+  // not a multiple of block size
+  const int numberVectors = 11;
+  CoinIndexedVector work;
+  work.reserve(2 * n);
+  std::vector< CoinIndexedVector > vectors(numberVectors);
+  std::vector< CoinIndexedVector > singles(numberVectors);
+  CoinIndexedVector *pointers[numberVectors];
+  for (int transpose = 0; transpose < 2; transpose++) {
+    for (int v = 0; v < numberVectors; v++) {
+      CoinIndexedVector &vector = vectors[v];
+      vector.clear();
+      vector.reserve(2 * n);
+      vector.setPackedMode((v & 3) == 3);
+      int number = std::min(5 + 20 * v, n);
+      if (vector.packedMode()) {
+        for (int j = 0; j < number; j++) {
+          vector.getIndices()[j] = (v * 7 + j * 13) % n;
+          vector.denseVector()[j] = 1.0 + 0.01 * j;
+        }
+        vector.setNumElements(number);
+      } else {
+        for (int j = 0; j < number; j++)
+          vector.insert((v * 7 + j * 13) % n, 1.0 + 0.01 * j);
+      }
+      singles[v] = vector;
+      if (transpose)
+        factorization.updateColumnTranspose(&work, &singles[v]);
+      else
+        factorization.updateColumn(&work, &singles[v]);
+      pointers[v] = &vector;
+    }
+    if (transpose)
+      factorization.updateColumnsTranspose(&work, numberVectors, pointers);
+    else
+      factorization.updateColumns(&work, numberVectors, pointers);
+    for (int v = 0; v < numberVectors; v++) {
+      std::vector< double > x0(n, 0.0), x1(n, 0.0);
+      for (int pass = 0; pass < 2; pass++) {
+        const CoinIndexedVector &vector = pass ? vectors[v] : singles[v];
+        std::vector< double > &x = pass ? x1 : x0;
+        assert(vector.packedMode() == ((v & 3) == 3));
+        for (int j = 0; j < vector.getNumElements(); j++) {
+          int iRow = vector.getIndices()[j];
+          x[iRow] = vector.packedMode() ? vector.denseVector()[j] : vector.denseVector()[iRow];
+        }
+      }
+      for (int i = 0; i < n; i++)
+        assert(fabs(x1[i] - x0[i]) < 1.0e-10 * (1.0 + fabs(x0[i])));
+    }
+  }
+}
+
+// Several right hand sides at once with and without updates
+static void multipleSolveTest()
+{
+  const int n = 400;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 40);
+  for (int denseCode = 0; denseCode < 3; denseCode++) {
+    CoinFactorization factorization;
+    factorization.setDenseThreshold(8);
+    factorization.setDenseCode(denseCode);
+    std::vector< int > rowIsBasic(n, -1);
+    std::vector< int > columnIsBasic(n, 1);
+    double areaFactor = 0.0;
+    int status;
+    while ((status = factorization.factorize(matrix, &rowIsBasic[0],
+              &columnIsBasic[0], areaFactor))
+      == -99)
+      areaFactor = areaFactor ? 2.0 * areaFactor : 2.0;
+    assert(!status);
+    checkMultipleSolves(factorization, n);
+    // replace some columns so R is used
+    CoinIndexedVector work;
+    work.reserve(2 * n);
+    CoinIndexedVector column;
+    column.reserve(2 * n);
+    for (int k = 0; k < 10; k++) {
+      int iColumn = (k * 97) % n;
+      CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+      for (int j = 0; j < matrix.getVectorLengths()[iColumn]; j++)
+        column.insert(matrix.getIndices()[start + j],
+          matrix.getElements()[start + j] * (1.0 + 0.1 * k));
+      factorization.updateColumnFT(&work, &column);
+      const double *x = column.denseVector();
+      int pivotRow = 0;
+      for (int j = 1; j < n; j++) {
+        if (fabs(x[j]) > fabs(x[pivotRow]))
+          pivotRow = j;
+      }
+      assert(!factorization.replaceColumn(&work, pivotRow, x[pivotRow]));
+      column.clear();
+    }
+    checkMultipleSolves(factorization, n);
+    // sparse - done one at a time
+    factorization.goSparse();
+    checkMultipleSolves(factorization, n);
+  }
+}
+
+/*
+  Solves using float copies and refinement must agree with ordinary
+  solves, before and after column replacements, with and without a
+  dense part.
+*/
+static void floatFactorsTest()
+{
+  const int n = 400;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 40);
+  for (int denseThreshold = 0; denseThreshold < 16; denseThreshold += 8) {
+    CoinFactorization factorization[2];
+    factorization[1].setFloatFactors(2);
+    assert(factorization[1].floatFactors() == 2);
+    std::vector< int > rowIsBasic(n, -1);
+    std::vector< int > columnIsBasic(n, 1);
+    for (int i = 0; i < 2; i++) {
+      factorization[i].setDenseThreshold(denseThreshold);
+      double areaFactor = 0.0;
+      int status;
+      columnIsBasic.assign(n, 1);
+      while ((status = factorization[i].factorize(matrix, &rowIsBasic[0],
+                &columnIsBasic[0], areaFactor))
+        == -99)
+        areaFactor = areaFactor ? 2.0 * areaFactor : 2.0;
+      assert(!status);
+    }
+    CoinIndexedVector work;
+    work.reserve(2 * n);
+    CoinIndexedVector region[2];
+    for (int pass = 0; pass < 2; pass++) {
+      for (int k = 0; k < 8; k++) {
+        for (int transpose = 0; transpose < 2; transpose++) {
+          for (int i = 0; i < 2; i++) {
+            region[i].clear();
+            region[i].reserve(2 * n);
+            region[i].setPackedMode(k == 3);
+            if (k == 3) {
+              for (int j = 0; j < 20; j++) {
+                region[i].getIndices()[j] = (j * 19) % n;
+                region[i].denseVector()[j] = 1.0 - 0.1 * j;
+              }
+              region[i].setNumElements(20);
+            } else {
+              for (int j = 0; j < 1 + 30 * k; j++)
+                region[i].insert((k + j * 13) % n, 1.0 + 0.01 * j);
+            }
+            if (transpose)
+              factorization[i].updateColumnTranspose(&work, &region[i]);
+            else
+              factorization[i].updateColumn(&work, &region[i]);
+          }
+          assert(factorization[1].lastResidual() < 1.0e-13);
+          std::vector< double > x0(n, 0.0), x1(n, 0.0);
+          for (int i = 0; i < 2; i++) {
+            std::vector< double > &x = i ? x1 : x0;
+            const CoinIndexedVector &vector = region[i];
+            assert(vector.packedMode() == (k == 3));
+            for (int j = 0; j < vector.getNumElements(); j++) {
+              int iRow = vector.getIndices()[j];
+              x[iRow] = vector.packedMode() ? vector.denseVector()[j] : vector.denseVector()[iRow];
+            }
+          }
+          for (int j = 0; j < n; j++)
+            assert(fabs(x1[j] - x0[j]) < 1.0e-10 * (1.0 + fabs(x0[j])));
+        }
+      }
+      if (!pass) {
+        // replace some columns so basis copy and R are updated
+        for (int k = 0; k < 10; k++) {
+          int iColumn = (k * 97) % n;
+          CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+          int length = matrix.getVectorLengths()[iColumn];
+          int pivotRow = -1;
+          for (int i = 0; i < 2; i++) {
+            region[i].clear();
+            region[i].setPackedMode(false);
+            for (int j = 0; j < length; j++)
+              region[i].insert(matrix.getIndices()[start + j],
+                matrix.getElements()[start + j] * (1.0 + 0.1 * k));
+            factorization[i].updateColumnFT(&work, &region[i]);
+            const double *x = region[i].denseVector();
+            if (pivotRow < 0) {
+              pivotRow = 0;
+              for (int j = 1; j < n; j++) {
+                if (fabs(x[j]) > fabs(x[pivotRow]))
+                  pivotRow = j;
+              }
+            }
+            assert(!factorization[i].replaceColumn(&work, pivotRow, x[pivotRow]));
+          }
+        }
+      }
+    }
+    // refinement was needed and worked
+    assert(factorization[1].numberRefinementSteps() > 0.0);
+    assert(factorization[1].largestResidual() < 1.0e-13);
+    assert(!factorization[0].numberRefinementSteps());
+    CoinFactorization copy(factorization[1]);
+    assert(copy.floatFactors() == 2);
+    region[0].clear();
+    region[0].setPackedMode(false);
+    region[0].insert(5, 1.0);
+    copy.updateColumn(&work, &region[0]);
+    assert(copy.lastResidual() < 1.0e-13);
+    // sparse right hand sides stay in double, dense ones use float
+    double numberSteps = copy.numberRefinementSteps();
+    if (copy.sparseThreshold() > 1) {
+      region[0].clear();
+      region[0].insert(7, 1.0);
+      copy.updateColumnTranspose(&work, &region[0]);
+      assert(copy.numberRefinementSteps() == numberSteps);
+    }
+    region[0].clear();
+    for (int j = 0; j < n; j++)
+      region[0].insert(j, 1.0 + 0.01 * j);
+    copy.updateColumnTranspose(&work, &region[0]);
+    assert(copy.numberRefinementSteps() > numberSteps);
+    factorization[1].resetStatistics();
+    assert(!factorization[1].largestResidual());
+    assert(!factorization[1].numberRefinementSteps());
+    factorization[1].setFloatFactors(0);
+    assert(!factorization[1].floatFactors());
+  }
+}
+
+static void statisticsTest()
+{
+  const int n = 400;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 40);
+  for (int denseThreshold = 0; denseThreshold < 16; denseThreshold += 8) {
+    CoinFactorization factorization;
+    CoinFactorizationStatistics &statistics = factorization.statistics();
+    assert(!statistics.timeSolves());
+    statistics.setTimeSolves(true);
+    factorization.setDenseThreshold(denseThreshold);
+    std::vector< int > rowIsBasic(n, -1);
+    std::vector< int > columnIsBasic(n, 1);
+    double areaFactor = 0.0;
+    int status;
+    while ((status = factorization.factorize(matrix, &rowIsBasic[0],
+              &columnIsBasic[0], areaFactor))
+      == -99) {
+      areaFactor = areaFactor ? 2.0 * areaFactor : 2.0;
+      columnIsBasic.assign(n, 1);
+    }
+    assert(!status);
+    int numberFactorizations = static_cast< int >(statistics.numberFactorizations());
+    assert(numberFactorizations >= 1);
+    assert(statistics.numberFailedFactorizations() == numberFactorizations - 1);
+    assert(statistics.basisElements() >= numberFactorizations * matrix.getNumElements());
+    assert(statistics.factorElements() >= matrix.getNumElements());
+    assert(statistics.largestFill() >= 1.0);
+    assert(statistics.calls(CoinFactorizationStatistics::markowitz) > 0.0);
+    assert(statistics.work(CoinFactorizationStatistics::markowitz) > 0.0);
+    if (denseThreshold) {
+      assert(statistics.calls(CoinFactorizationStatistics::dense) == numberFactorizations);
+      assert(statistics.work(CoinFactorizationStatistics::dense) > 0.0);
+    } else {
+      assert(!statistics.calls(CoinFactorizationStatistics::dense));
+    }
+    assert(statistics.time(CoinFactorizationStatistics::markowitz) >= 0.0);
+    CoinIndexedVector work;
+    work.reserve(2 * n);
+    CoinIndexedVector region;
+    region.reserve(2 * n);
+    region.insert(3, 1.0);
+    factorization.updateColumn(&work, &region);
+    assert(statistics.calls(CoinFactorizationStatistics::ftranL) == 1.0);
+    assert(statistics.calls(CoinFactorizationStatistics::ftranU) == 1.0);
+    assert(statistics.work(CoinFactorizationStatistics::ftranU) == region.getNumElements());
+    assert(!statistics.calls(CoinFactorizationStatistics::ftranR));
+    region.clear();
+    region.insert(7, 1.0);
+    factorization.updateColumnTranspose(&work, &region);
+    assert(statistics.calls(CoinFactorizationStatistics::btranU) == 1.0);
+    assert(statistics.calls(CoinFactorizationStatistics::btranL) == 1.0);
+    assert(statistics.work(CoinFactorizationStatistics::btranL) == region.getNumElements());
+    // updates add R etas
+    for (int k = 0; k < 5; k++) {
+      int iColumn = (k * 89) % n;
+      CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+      int length = matrix.getVectorLengths()[iColumn];
+      region.clear();
+      for (int j = 0; j < length; j++)
+        region.insert(matrix.getIndices()[start + j],
+          matrix.getElements()[start + j] * (1.0 + 0.1 * k));
+      factorization.updateColumnFT(&work, &region);
+      const double *x = region.denseVector();
+      int pivotRow = 0;
+      for (int j = 1; j < n; j++) {
+        if (fabs(x[j]) > fabs(x[pivotRow]))
+          pivotRow = j;
+      }
+      assert(!factorization.replaceColumn(&work, pivotRow, x[pivotRow]));
+    }
+    assert(statistics.calls(CoinFactorizationStatistics::update) == 5.0);
+    assert(!statistics.numberRejectedUpdates());
+    assert(statistics.largestUpdateGrowth() > 1.0);
+    assert(statistics.calls(CoinFactorizationStatistics::ftranR) >= 4.0);
+    region.clear();
+    region.insert(11, 1.0);
+    factorization.updateColumnTranspose(&work, &region);
+    assert(statistics.calls(CoinFactorizationStatistics::btranR) == 1.0);
+    double methods = 0.0;
+    for (int method = 0; method < 3; method++)
+      methods += factorization.numberSolveMethod(2, method);
+    assert(methods == statistics.calls(CoinFactorizationStatistics::btranU));
+    assert(!strcmp(CoinFactorizationStatistics::phaseName(CoinFactorizationStatistics::update), "update"));
+    // copies keep setting but not counts
+    CoinFactorization copy(factorization);
+    assert(copy.statistics().timeSolves());
+    factorization.resetStatistics();
+    assert(!statistics.calls(CoinFactorizationStatistics::update));
+    assert(!statistics.numberFactorizations());
+    assert(statistics.timeSolves());
+  }
+}
+
+/*
+  Lets factory choose and factorize, then checks B x = b.
+  Returns backend chosen.
+*/
+static int factoryFactorizeAndSolve(CoinFactorizationFactory &factory,
+  const CoinPackedMatrix &matrix)
+{
+  int n = matrix.getNumCols();
+  std::vector< int > pivotVariable(n, -1);
+  CoinOtherFactorization *factorization = factory.factorization(matrix, &pivotVariable[0]);
+  assert(!factorization->status());
+  CoinIndexedVector work;
+  work.reserve(2 * n);
+  CoinIndexedVector region;
+  region.reserve(2 * n);
+  for (int i = 0; i < n; i++)
+    region.insert(i, 1.0 + i);
+  factorization->updateColumn(&work, &region);
+  std::vector< double > x(n, 0.0);
+  for (int i = 0; i < n; i++)
+    x[pivotVariable[i]] = region.denseVector()[i];
+  region.clear();
+  std::vector< double > product(n, 0.0);
+  matrix.times(&x[0], &product[0]);
+  for (int i = 0; i < n; i++)
+    assert(fabs(product[i] - (1.0 + i)) < 1.0e-8 * (1.0 + i));
+  delete factorization;
+  return factory.lastChoice();
+}
+
+static void factoryTest()
+{
+  CoinFactorizationFactory factory;
+  factory.messageHandler()->setLogLevel(0);
+  // small
+  assert(factoryFactorizeAndSolve(factory, denseTestMatrix(20, 3)) == CoinFactorizationFactory::dense);
+  // dense core
+  assert(factoryFactorizeAndSolve(factory, denseTestMatrix(200, 100)) == CoinFactorizationFactory::dense);
+  assert(factory.coreDensity() >= factory.denseDensity());
+  // moderate and sparse
+  CoinPackedMatrix matrix = denseTestMatrix(200, 3);
+  assert(factoryFactorizeAndSolve(factory, matrix) == CoinFactorizationFactory::simple);
+  assert(factory.coreRows() + factory.numberSingletons() == 200);
+  assert(factory.calibrationTime(CoinFactorizationFactory::dense) < 0.0);
+  // row ordered copy gives same answer
+  CoinPackedMatrix rowCopy;
+  rowCopy.reverseOrderedCopyOf(matrix);
+  assert(factoryFactorizeAndSolve(factory, rowCopy) == CoinFactorizationFactory::simple);
+  // large and sparse
+  assert(factoryFactorizeAndSolve(factory, denseTestMatrix(1500, 2)) == CoinFactorizationFactory::osl);
+  // calibration tries all which fit
+  factory.setCalibrate(true);
+  factory.setCalibrationSolves(5);
+  CoinFactorizationFactory copy(factory);
+  assert(copy.calibrate());
+  copy.messageHandler()->setLogLevel(1);
+  factoryFactorizeAndSolve(copy, matrix);
+  for (int backend = 0; backend < CoinFactorizationFactory::numberBackends; backend++)
+    assert(copy.calibrationTime(backend) >= 0.0);
+  copy.setMaximumDenseRows(100);
+  assert(factoryFactorizeAndSolve(copy, matrix) == CoinFactorizationFactory::osl);
+  assert(copy.calibrationTime(CoinFactorizationFactory::simple) < 0.0);
+  // every backend on its own
+  for (int backend = 0; backend < CoinFactorizationFactory::numberBackends; backend++) {
+    CoinOtherFactorization *factorization = CoinFactorizationFactory::newFactorization(backend);
+    std::vector< int > pivotVariable(200);
+    assert(!CoinFactorizationFactory::factorize(factorization, matrix, &pivotVariable[0]));
+    std::vector< int > count(200, 0);
+    for (int i = 0; i < 200; i++)
+      count[pivotVariable[i]]++;
+    for (int i = 0; i < 200; i++)
+      assert(count[i] == 1);
+    delete factorization;
+  }
+  assert(!strcmp(CoinFactorizationFactory::backendName(CoinFactorizationFactory::osl), "osl"));
+}
+
+/*
+  FTRAN of column of matrix then replaceColumn on largest pivot.
+  Returns pivot row.
+*/
+static int replaceWithColumn(CoinFactorization &factorization,
+  const CoinPackedMatrix &matrix, int iColumn, double multiplier,
+  CoinIndexedVector &work, CoinIndexedVector &region)
+{
+  int n = matrix.getNumCols();
+  CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+  int length = matrix.getVectorLengths()[iColumn];
+  region.clear();
+  for (int j = 0; j < length; j++)
+    region.insert(matrix.getIndices()[start + j],
+      matrix.getElements()[start + j] * multiplier);
+  factorization.updateColumnFT(&work, &region);
+  const double *x = region.denseVector();
+  int pivotRow = 0;
+  for (int j = 1; j < n; j++) {
+    if (fabs(x[j]) > fabs(x[pivotRow]))
+      pivotRow = j;
+  }
+  assert(!factorization.replaceColumn(&work, pivotRow, x[pivotRow]));
+  return pivotRow;
+}
+
+static void snapshotTest()
+{
+  const int n = 400;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 20);
+  for (int denseThreshold = 0; denseThreshold < 16; denseThreshold += 8) {
+    CoinFactorization factorization;
+    factorization.setDenseThreshold(denseThreshold);
+    std::vector< int > rowIsBasic(n, -1);
+    std::vector< int > columnIsBasic(n, 1);
+    double areaFactor = 0.0;
+    int status;
+    while ((status = factorization.factorize(matrix, &rowIsBasic[0],
+              &columnIsBasic[0], areaFactor))
+      == -99) {
+      areaFactor = areaFactor ? 2.0 * areaFactor : 2.0;
+      columnIsBasic.assign(n, 1);
+    }
+    assert(!status);
+    assert(!denseThreshold || factorization.numberDense());
+    CoinIndexedVector work;
+    work.reserve(2 * n);
+    CoinIndexedVector region[2];
+    region[0].reserve(2 * n);
+    region[1].reserve(2 * n);
+    // some R etas
+    for (int k = 0; k < 5; k++)
+      replaceWithColumn(factorization, matrix, (k * 89) % n, 1.0 + 0.1 * k,
+        work, region[0]);
+    size_t length = factorization.snapshotLength();
+    assert(!(length & 7));
+    std::vector< double > buffer(length / sizeof(double));
+    char *snapshot = reinterpret_cast< char * >(&buffer[0]);
+    factorization.writeSnapshot(snapshot);
+    CoinFactorization restored;
+    assert(!restored.readSnapshot(snapshot, length));
+    assert(restored.pivots() == factorization.pivots());
+    assert(restored.numberDense() == factorization.numberDense());
+    // same answers and same after more updates
+    for (int pass = 0; pass < 2; pass++) {
+      for (int transpose = 0; transpose < 2; transpose++) {
+        for (int i = 0; i < 2; i++) {
+          CoinFactorization &model = i ? restored : factorization;
+          region[i].clear();
+          for (int j = 0; j < 30; j++)
+            region[i].insert((j * 13) % n, 1.0 + 0.01 * j);
+          if (transpose)
+            model.updateColumnTranspose(&work, &region[i]);
+          else
+            model.updateColumn(&work, &region[i]);
+        }
+        for (int j = 0; j < n; j++)
+          assert(region[0].denseVector()[j] == region[1].denseVector()[j]);
+      }
+      for (int k = 5; k < 8; k++) {
+        int pivotRow0 = replaceWithColumn(factorization, matrix, (k * 89) % n,
+          1.0 + 0.1 * k, work, region[0]);
+        int pivotRow1 = replaceWithColumn(restored, matrix, (k * 89) % n,
+          1.0 + 0.1 * k, work, region[1]);
+        assert(pivotRow0 == pivotRow1);
+      }
+    }
+    // damaged or not a snapshot
+    CoinFactorization bad;
+    snapshot[length - 1] ^= 1;
+    assert(bad.readSnapshot(snapshot, length) == 3);
+    snapshot[length - 1] ^= 1;
+    assert(bad.readSnapshot(snapshot, length - 8) == 3);
+    snapshot[0] = 'X';
+    assert(bad.readSnapshot(snapshot, length) == 1);
+    assert(!bad.pivots());
+    // on file
+    factorization.setNumberThreads(2);
+    assert(!factorization.saveSnapshot("snapshot.tmp"));
+    factorization.setNumberThreads(1);
+    CoinFactorization fromFile;
+    int numberThreads = fromFile.numberThreads();
+    assert(!fromFile.restoreSnapshot("snapshot.tmp"));
+    assert(fromFile.pivots() == factorization.pivots());
+    assert(fromFile.numberThreads() == numberThreads);
+    // header claiming more than file has is refused before allocating
+    {
+      FILE *fp = fopen("snapshot.tmp", "r+b");
+      assert(fp);
+      CoinUInt64 hugeLength = static_cast< CoinUInt64 >(1) << 45;
+      // length is after magic and eight ints
+      assert(!fseek(fp, 8 + 8 * sizeof(int), SEEK_SET));
+      assert(fwrite(&hugeLength, sizeof(hugeLength), 1, fp) == 1);
+      fclose(fp);
+      assert(fromFile.restoreSnapshot("snapshot.tmp") == 3);
+    }
+    remove("snapshot.tmp");
+    assert(fromFile.restoreSnapshot("snapshot.tmp") == 4);
+  }
+}
+
+/*
+  Dense backend with both LU codes - FTRAN and BTRAN before and after
+  a replaceColumn are checked against the basis itself.
+*/
+static void checkDenseSolves(const CoinDenseFactorization &factorization,
+  const std::vector< double > &basis, int n)
+{
+  CoinIndexedVector work;
+  work.reserve(n);
+  CoinIndexedVector region;
+  region.reserve(n);
+  for (int i = 0; i < n; i++)
+    region.insert(i, 1.0 + (i % 7));
+  factorization.updateColumn(&work, &region);
+  std::vector< double > x(region.denseVector(), region.denseVector() + n);
+  for (int i = 0; i < n; i++) {
+    double value = -(1.0 + (i % 7));
+    for (int j = 0; j < n; j++)
+      value += basis[i + j * n] * x[j];
+    assert(fabs(value) < 1.0e-9);
+  }
+  region.clear();
+  for (int i = 0; i < n; i++)
+    region.insert(i, 1.0 - (i % 3));
+  factorization.updateColumnTranspose(&work, &region);
+  std::vector< double > y(region.denseVector(), region.denseVector() + n);
+  for (int j = 0; j < n; j++) {
+    double value = -(1.0 - (j % 3));
+    for (int i = 0; i < n; i++)
+      value += basis[i + j * n] * y[i];
+    assert(fabs(value) < 1.0e-9);
+  }
+  region.clear();
+}
+
+static void denseFactorizationTest()
+{
+  const int n = 150;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 40);
+  for (int solveMode = 0; solveMode < 2; solveMode++) {
+    CoinDenseFactorization factorization;
+    factorization.setSolveMode(solveMode);
+    std::vector< int > pivotVariable(n);
+    assert(!CoinFactorizationFactory::factorize(&factorization, matrix,
+      &pivotVariable[0]));
+    assert(factorization.factorCode());
+    std::vector< double > basis(n * n, 0.0);
+    for (int i = 0; i < n; i++) {
+      int iColumn = pivotVariable[i];
+      CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+      for (int j = 0; j < matrix.getVectorLengths()[iColumn]; j++)
+        basis[matrix.getIndices()[start + j] + i * n] = matrix.getElements()[start + j];
+    }
+    checkDenseSolves(factorization, basis, n);
+    // replace by multiple of another column and its neighbour
+    CoinIndexedVector work;
+    work.reserve(n);
+    CoinIndexedVector region;
+    region.reserve(n);
+    std::vector< double > column(n, 0.0);
+    for (int i = 0; i < n; i++) {
+      column[i] = 2.0 * basis[i + 7 * n] + basis[i + 8 * n];
+      if (column[i])
+        region.insert(i, column[i]);
+    }
+    factorization.updateColumnFT(&work, &region);
+    const double *alpha = region.denseVector();
+    int pivotRow = 0;
+    for (int i = 1; i < n; i++) {
+      if (fabs(alpha[i]) > fabs(alpha[pivotRow]))
+        pivotRow = i;
+    }
+    assert(!factorization.replaceColumn(&region, pivotRow, alpha[pivotRow]));
+    region.clear();
+    CoinMemcpyN(&column[0], n, &basis[pivotRow * n]);
+    checkDenseSolves(factorization, basis, n);
+    CoinDenseFactorization copy(factorization);
+    assert(copy.factorCode() == factorization.factorCode());
+    checkDenseSolves(copy, basis, n);
+  }
+  // singular - column 9 is copy of column 4
+  CoinPackedMatrix singular(true, 0, 0);
+  singular.setDimensions(n, 0);
+  for (int i = 0; i < n; i++) {
+    int iColumn = i == 9 ? 4 : i;
+    CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+    singular.appendCol(matrix.getVectorLengths()[iColumn],
+      matrix.getIndices() + start, matrix.getElements() + start);
+  }
+  CoinDenseFactorization factorization;
+  assert(CoinFactorizationFactory::factorize(&factorization, singular, NULL) == -1);
+  assert(factorization.numberGoodColumns() < n);
+  std::vector< int > sequence(n);
+  for (int i = 0; i < n; i++)
+    sequence[i] = i;
+  factorization.makeNonSingular(&sequence[0], n);
+  int numberSlacks = 0;
+  for (int i = 0; i < n; i++) {
+    if (sequence[i] >= n)
+      numberSlacks++;
+  }
+  assert(numberSlacks == n - factorization.numberGoodColumns());
+}
+
+/*
+  FTRAN and BTRAN with osl backend - returns answers by row.
+  First numberReplaced columns are each replaced by twice themselves
+  (the same column twice if three).
+*/
+static void oslSolves(const CoinPackedMatrix &matrix, int numberThreads,
+  int numberReplaced, std::vector< double > &x, std::vector< double > &y)
+{
+  int n = matrix.getNumCols();
+  CoinOslFactorization factorization;
+  factorization.setNumberThreads(numberThreads);
+  std::vector< int > pivotVariable(n);
+  assert(!CoinFactorizationFactory::factorize(&factorization, matrix,
+    &pivotVariable[0]));
+  // osl backend looks at entry after last row
+  CoinIndexedVector work;
+  work.reserve(n + 1);
+  CoinIndexedVector region;
+  region.reserve(n + 1);
+  const int replaceRow[3] = { n / 2, n / 3, n / 2 };
+  std::vector< double > scale(n, 1.0);
+  for (int k = 0; k < numberReplaced; k++) {
+    int iRow = replaceRow[k];
+    int iColumn = pivotVariable[iRow];
+    CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+    // FT update wants packed column
+    int length = matrix.getVectorLengths()[iColumn];
+    CoinMemcpyN(matrix.getIndices() + start, length, region.getIndices());
+    for (int j = 0; j < length; j++)
+      region.denseVector()[j] = 2.0 * scale[iRow] * matrix.getElements()[start + j];
+    region.setNumElements(length);
+    region.setPackedMode(true);
+    factorization.updateColumnFT(&work, &region);
+    assert(region.getNumElements() == 1);
+    assert(region.getIndices()[0] == iRow);
+    assert(fabs(region.denseVector()[0] - 2.0) < 1.0e-12);
+    // osl wants work area from FT update rather than tableau column
+    assert(!factorization.wantsTableauColumn());
+    assert(!factorization.replaceColumn(&work, iRow, 2.0));
+    scale[iRow] *= 2.0;
+    work.clear();
+    region.clear();
+    region.setPackedMode(false);
+  }
+  for (int i = 0; i < n; i++)
+    region.insert(i, 1.0 + (i % 5));
+  factorization.updateColumn(&work, &region);
+  x.assign(region.denseVector(), region.denseVector() + n);
+  region.clear();
+  for (int i = 0; i < n; i++)
+    region.insert(i, 1.0 - (i % 3));
+  factorization.updateColumnTranspose(&work, &region);
+  y.assign(region.denseVector(), region.denseVector() + n);
+  region.clear();
+  // check y B = c
+  for (int i = 0; i < n; i++) {
+    int iColumn = pivotVariable[i];
+    double value = -(1.0 - (i % 3)) / scale[i];
+    CoinBigIndex start = matrix.getVectorStarts()[iColumn];
+    for (int j = 0; j < matrix.getVectorLengths()[iColumn]; j++)
+      value += y[matrix.getIndices()[start + j]] * matrix.getElements()[start + j];
+    assert(fabs(value) < 1.0e-9);
+  }
+}
+
+/*
+  Threaded U transpose solve must give exactly the same answers as a
+  serial solve at the same SIMD level, before and after updates.
+  Vector kernels in BTRAN add in a different order so are only close
+  to scalar answers.
+*/
+static void oslSolveTest()
+{
+  // wide and shallow U as well as one with a dense part
+  CoinPackedMatrix matrix = denseTestMatrix(3000, 1);
+  CoinPackedMatrix denser = denseTestMatrix(400, 20);
+  int saveLevel = CoinSimdLevel();
+  for (int iMatrix = 0; iMatrix < 2; iMatrix++) {
+    const CoinPackedMatrix &thisMatrix = iMatrix ? denser : matrix;
+    for (int numberReplaced = 0; numberReplaced <= 3; numberReplaced++) {
+      std::vector< double > x0, y0, x1, y1, x2, y2;
+      CoinSetSimdLevel(COIN_SIMD_SCALAR);
+      oslSolves(thisMatrix, 1, numberReplaced, x0, y0);
+      oslSolves(thisMatrix, 4, numberReplaced, x1, y1);
+      for (size_t i = 0; i < x0.size(); i++) {
+        assert(x1[i] == x0[i]);
+        assert(y1[i] == y0[i]);
+      }
+      // FTRAN kernels are exact, BTRAN ones add in a different order
+      CoinSetSimdLevel(saveLevel);
+      oslSolves(thisMatrix, 1, numberReplaced, x1, y1);
+      oslSolves(thisMatrix, 4, numberReplaced, x2, y2);
+      for (size_t i = 0; i < x0.size(); i++) {
+        assert(x1[i] == x0[i]);
+        assert(x2[i] == x0[i]);
+        assert(fabs(y1[i] - y0[i]) < 1.0e-9 * (1.0 + fabs(y0[i])));
+        assert(fabs(y2[i] - y0[i]) < 1.0e-9 * (1.0 + fabs(y0[i])));
+        assert(y2[i] == y1[i]);
+      }
+    }
+  }
+  CoinSetSimdLevel(saveLevel);
+  CoinOslFactorization factorization;
+  factorization.setNumberThreads(0);
+  assert(factorization.numberThreads() >= 1);
+  CoinOslFactorization copy(factorization);
+  assert(copy.numberThreads() == factorization.numberThreads());
+}
+
+/*
+  Factorizes matrix by parts, repeating pivots of last factorization
+  if replaced given.  Solves B x = b and returns largest residual.
+*/
+static double partFactorizeAndSolve(CoinFactorization &factorization,
+  const CoinPackedMatrix &matrix, int numberReplaced, const int *replaced,
+  std::vector< double > &x)
+{
+  int n = matrix.getNumCols();
+  int numberElements = static_cast< int >(matrix.getNumElements());
+  int *indexRow;
+  int *indexColumn;
+  CoinFactorizationDouble *element;
+  std::vector< int > permutation(n);
+  factorization.factorizePart1(n, n, numberElements, &indexRow,
+    &indexColumn, &element);
+  const CoinBigIndex *start = matrix.getVectorStarts();
+  const int *length = matrix.getVectorLengths();
+  const int *row = matrix.getIndices();
+  const double *value = matrix.getElements();
+  int put = 0;
+  for (int j = 0; j < n; j++) {
+    for (CoinBigIndex k = start[j]; k < start[j] + length[j]; k++) {
+      indexRow[put] = row[k];
+      indexColumn[put] = j;
+      element[put++] = value[k];
+    }
+  }
+  int status;
+  if (replaced)
+    status = factorization.factorizePart2(&permutation[0], put,
+      numberReplaced, replaced);
+  else
+    status = factorization.factorizePart2(&permutation[0], put);
+  assert(!status);
+  CoinIndexedVector work;
+  work.reserve(n);
+  CoinIndexedVector region;
+  region.reserve(n);
+  for (int i = 0; i < n; i++)
+    region.insert(i, 1.0 + i);
+  factorization.updateColumn(&work, &region);
+  x.assign(n, 0.0);
+  for (int j = 0; j < n; j++)
+    x[j] = region.denseVector()[permutation[j]];
+  std::vector< double > product(n, 0.0);
+  matrix.times(&x[0], &product[0]);
+  double largest = 0.0;
+  for (int i = 0; i < n; i++)
+    largest = CoinMax(largest, fabs(product[i] - (1.0 + i)));
+  return largest;
+}
+
+// Refactorization repeating pivots of unchanged columns
+static void partRefactorizeTest()
+{
+  const int n = 600;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 3);
+  CoinFactorization factorization;
+  std::vector< double > x0, x1;
+  int replaced[] = { 597, 13, 450, 598 };
+  double residual = partFactorizeAndSolve(factorization, matrix, 0, NULL, x0);
+  assert(residual < 1.0e-9);
+  assert(!factorization.numberRepeatedPivots());
+  // nothing replaced - every sparse pivot repeated and same answers
+  int numberPivots = factorization.numberRows() - factorization.numberDense();
+  residual = partFactorizeAndSolve(factorization, matrix, 0, replaced, x1);
+  assert(residual < 1.0e-9);
+  assert(factorization.numberRepeatedPivots() == numberPivots);
+  for (int i = 0; i < n; i++)
+    assert(x1[i] == x0[i]);
+  // replace some columns by others
+  CoinPackedMatrix changed = denseTestMatrix(n, 5);
+  CoinPackedMatrix newMatrix(true, n, 0, 0, NULL, NULL, NULL, NULL);
+  for (int j = 0; j < n; j++) {
+    bool isReplaced = false;
+    for (int k = 0; k < 4; k++)
+      isReplaced = isReplaced || replaced[k] == j;
+    newMatrix.appendCol(isReplaced ? changed.getVector(j) : matrix.getVector(j));
+  }
+  residual = partFactorizeAndSolve(factorization, newMatrix, 4, replaced, x1);
+  assert(residual < 1.0e-9);
+  int numberRepeated = factorization.numberRepeatedPivots();
+  // only pivots on replaced columns (and any no longer acceptable) found by search
+  assert(numberRepeated > numberPivots / 2 && numberRepeated <= numberPivots - 4);
+  // same answers as from scratch
+  CoinFactorization fresh;
+  partFactorizeAndSolve(fresh, newMatrix, 0, NULL, x0);
+  assert(!fresh.numberRepeatedPivots());
+  for (int i = 0; i < n; i++)
+    assert(fabs(x1[i] - x0[i]) < 1.0e-9 * (1.0 + fabs(x0[i])));
+  // copies can repeat as well
+  CoinFactorization copy(factorization);
+  residual = partFactorizeAndSolve(copy, newMatrix, 0, replaced, x1);
+  assert(residual < 1.0e-9);
+  assert(copy.numberRepeatedPivots() == n - copy.numberDense());
+}
+
+void CoinFactorizationUnitTest()
+{
+  denseLUTest();
+  reachCacheTest();
+  multipleSolveTest();
+  floatFactorsTest();
+  statisticsTest();
+  factoryTest();
+  snapshotTest();
+  denseFactorizationTest();
+  oslSolveTest();
+  partRefactorizeTest();
+  const int n = 400;
+  CoinPackedMatrix matrix = denseTestMatrix(n, 40);
+  std::vector< double > x0, y0, x1, y1, x2, y2;
+  // default - sparse all the way
+  double residual = factorizeAndSolve(matrix, 0, 1, 1, x0, y0);
+  assert(residual < 1.0e-9);
+  // dense tail put back into L and U, built in dense LU and LAPACK
+  for (int denseCode = 0; denseCode < 3; denseCode++) {
+    residual = factorizeAndSolve(matrix, 8, denseCode, 1, x1, y1);
+    assert(residual < 1.0e-9);
+    for (int i = 0; i < n; i++) {
+      assert(fabs(x1[i] - x0[i]) < 1.0e-9 * (1.0 + fabs(x0[i])));
+      assert(fabs(y1[i] - y0[i]) < 1.0e-9 * (1.0 + fabs(y0[i])));
+    }
+    // threads must give identical answers
+    residual = factorizeAndSolve(matrix, 8, denseCode, 3, x2, y2);
+    assert(residual < 1.0e-9);
+    for (int i = 0; i < n; i++) {
+      assert(x2[i] == x1[i]);
+      assert(y2[i] == y1[i]);
+    }
+  }
+  CoinFactorization factorization;
+  factorization.setNumberThreads(0);
+  assert(factorization.numberThreads() >= 1);
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,112 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include "CoinHelperFunctions.hpp"
+
+void
+CoinHelperFunctionsUnitTest()
+{
+  // odd size so all kernels have a tail
+  const int n = 1003;
+  double *x = new double[n];
+  double *y = new double[n];
+  double *z = new double[n];
+  double *dense = new double[2 * n];
+  int *index = new int[n];
+  for (int i = 0; i < n; i++) {
+    x[i] = 1.0 / (i + 1);
+    y[i] = (i % 7) - 3.25;
+    index[i] = (i * 37) % (2 * n);
+  }
+  for (int i = 0; i < 2 * n; i++)
+    dense[i] = 0.5 * (i % 13) - 2.0;
+  // plain answers
+  double dot = 0.0;
+  double sumSquares = 0.0;
+  double gatherDot = 0.0;
+  for (int i = 0; i < n; i++) {
+    dot += x[i] * y[i];
+    sumSquares += x[i] * x[i];
+    gatherDot += x[i] * dense[index[i]];
+  }
+  int available = CoinSimdLevelAvailable();
+  assert(available >= COIN_SIMD_SCALAR && available <= COIN_SIMD_AVX512);
+  assert(CoinSetSimdLevel(COIN_SIMD_AVX512 + 1) == available);
+  // every level up to what processor has - and odd lengths
+  for (int level = COIN_SIMD_SCALAR; level <= available; level++) {
+    assert(CoinSetSimdLevel(level) == level);
+    assert(CoinSimdLevel() == level);
+    for (int size = n - 12; size <= n; size++) {
+      double dotPlain = 0.0;
+      for (int i = 0; i < size; i++)
+        dotPlain += x[i] * y[i];
+      assert(fabs(CoinDotProductN(x, y, size) - dotPlain) < 1.0e-12 * (1.0 + fabs(dotPlain)));
+    }
+    assert(fabs(CoinDotProductN(x, y, n) - dot) < 1.0e-12 * (1.0 + fabs(dot)));
+    assert(fabs(CoinSumOfSquaresN(x, n) - sumSquares) < 1.0e-12 * sumSquares);
+    assert(fabs(CoinGatherDotN(x, index, n, dense) - gatherDot) < 1.0e-12 * (1.0 + fabs(gatherDot)));
+    assert(CoinDotProductN(x, y, 0) == 0.0);
+    assert(CoinGatherDotN(x, index, 3, dense) == x[0] * dense[index[0]] + x[1] * dense[index[1]] + x[2] * dense[index[2]]);
+    // element by element kernels must be exact
+    CoinMemcpyN(y, n, z);
+    CoinAxpyN(0.3, x, n - 1, z);
+    for (int i = 0; i < n - 1; i++)
+      assert(z[i] == y[i] + 0.3 * x[i]);
+    assert(z[n - 1] == y[n - 1]);
+    CoinScaledCopyN(x, n - 2, -1.7, z);
+    for (int i = 0; i < n - 2; i++)
+      assert(z[i] == -1.7 * x[i]);
+    CoinScaledCopyN(z, n - 2, 2.0, z);
+    for (int i = 0; i < n - 2; i++)
+      assert(z[i] == -3.4 * x[i]);
+    CoinFillN(z + 1, n - 2, 4.5);
+    assert(z[0] == -3.4 * x[0] && z[n - 1] == y[n - 1]);
+    for (int i = 1; i < n - 1; i++)
+      assert(z[i] == 4.5);
+    CoinFill(z, z + 5, 1.5);
+    for (int i = 0; i < 5; i++)
+      assert(z[i] == 1.5);
+    assert(z[5] == 4.5);
+    CoinZeroN(z, n - 1);
+    for (int i = 0; i < n - 1; i++)
+      assert(!z[i]);
+    assert(z[n - 1] == y[n - 1]);
+    // index has no repeats
+    double *w = new double[2 * n];
+    CoinMemcpyN(dense, 2 * n, w);
+    CoinScatterAxpyN(-0.7, x, index, n - 1, w);
+    for (int i = 0; i < n - 1; i++)
+      assert(w[index[i]] == dense[index[i]] + -0.7 * x[i]);
+    assert(w[index[n - 1]] == dense[index[n - 1]]);
+    CoinMemcpyN(y, n, z);
+    CoinGatherAxpyN(1.3, dense, index, n - 1, z);
+    for (int i = 0; i < n - 1; i++)
+      assert(z[i] == y[i] + 1.3 * dense[index[i]]);
+    assert(z[n - 1] == y[n - 1]);
+    delete[] w;
+    // NaNs are ignored wherever they are
+    CoinMemcpyN(y, n, z);
+    double maxAbs = CoinMaxAbsN(z, n);
+    assert(maxAbs == 3.25);
+    z[0] = NAN;
+    z[n / 2] = NAN;
+    z[n - 1] = NAN;
+    assert(CoinMaxAbsN(z, n) == maxAbs);
+    assert(CoinMaxAbsN(z, n - 8) == maxAbs);
+    CoinFillN(z, n, static_cast< double >(NAN));
+    assert(CoinMaxAbsN(z, n) == 0.0);
+  }
+  CoinSetSimdLevel(-1);
+  assert(CoinSimdLevel() == available);
+  delete[] x;
+  delete[] y;
+  delete[] z;
+  delete[] dense;
+  delete[] index;
+}
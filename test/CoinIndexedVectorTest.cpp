@@ -14,10 +14,38 @@
 #endif
 
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
 
 #include "CoinFinite.hpp"
 #include "CoinIndexedVector.hpp"
 #include "CoinShallowPackedVector.hpp"
+#include "CoinWorkspacePool.hpp"
+
+// Allocator counting calls for allocation policy test
+static int numberUserArrays = 0;
+static void *userAllocate(size_t numberBytes)
+{
+  numberUserArrays++;
+  return malloc(numberBytes);
+}
+static void userRelease(void *memory)
+{
+  numberUserArrays--;
+  free(memory);
+}
+// Sum of absolute values in a partition
+static double partitionSum(const CoinPartitionedVector *vector, int partition,
+  void *)
+{
+  int start = vector->startPartition(partition);
+  const double *elements = vector->denseVector() + start;
+  double sum = 0.0;
+  for (int i = 0; i < vector->getNumElements(partition); i++)
+    sum += fabs(elements[i]);
+  return sum;
+}
 
 //--------------------------------------------------------------------------
 void
@@ -533,6 +561,333 @@ CoinIndexedVectorUnitTest()
     assert( add[4] == 40.+40. );
     
   }
+
+  {
+    // Test density tracking - index list dropped and rebuilt
+    const int n = 1000;
+    CoinIndexedVector r(n);
+    r.setDensityThreshold(0.1);
+    assert( r.densityThreshold()==0.1 );
+    double * dense = r.denseVector();
+    for ( i=n-1; i>=0; i-=3 )
+      dense[i] = i+1.0;
+    dense[500] = 1.0e-13;
+    int number = r.scan(0,n,1.0e-12);
+    assert( number==334 );
+    assert( r.bitmapMode() );
+    assert( r.getNumElements()==334 );
+    assert( !dense[500] );
+    // more added while dropped
+    r.quickInsert(1,2.0);
+    r.quickAdd(2,3.0);
+    r.quickAdd(999,-1000.0);
+    r.insert(500,5.0);
+    assert( r.getNumElements()==337 );
+    assert( r.bitmapMode() );
+    // rebuilt in increasing order
+    const int * indices = r.getIndices();
+    assert( !r.bitmapMode() );
+    for ( i=1; i<337; i++ )
+      assert( indices[i]>indices[i-1] );
+    for ( i=0; i<337; i++ )
+      assert( dense[indices[i]] );
+#ifndef NO_CHECK_CL
+    r.checkClean();
+#endif
+    // dense again by scan then cleared
+    r.clear();
+    for ( i=0; i<n; i+=2 )
+      dense[i] = 1.0;
+    r.scan();
+    assert( r.bitmapMode() );
+    assert( r.getNumElements()==n/2 );
+    CoinIndexedVector copy(r);
+    assert( copy.getNumElements()==n/2 );
+    assert( copy==r );
+    r.clear();
+    assert( !r.bitmapMode() );
+#ifndef NO_CHECK_CL
+    r.checkClear();
+#endif
+    // filled by inserts and sparse stays indexed
+    for ( i=0; i<50; i++ )
+      r.insert(i*7,1.0);
+    assert( !r.bitmapMode() );
+    for ( ; i<n/7; i++ )
+      r.insert(i*7,1.0);
+    assert( r.bitmapMode() );
+    assert( r.getNumElements()==n/7 );
+    assert( r.getMaxIndex()==7*(n/7-1) );
+    r.clear();
+    // without tracking list kept
+    r.setDensityThreshold(0.0);
+    for ( i=0; i<n; i++ )
+      dense[i] = 1.0;
+    r.scan();
+    assert( !r.bitmapMode() && r.getNumElements()==n );
+    assert( !r.checkDensity() );
+    r.setDensityThreshold(0.5);
+    assert( r.checkDensity() );
+    r.clear();
+  }
+  {
+    // vector scans and cleans give same results at every level
+    const int n = 203;
+    double pattern[n];
+    int i;
+    for ( i=0; i<n; i++ ) {
+      if ( i%5==1 )
+        pattern[i] = 0.0;
+      else if ( i%7==2 )
+        pattern[i] = -1.0e-14*i;
+      else if ( i%11==3 )
+        pattern[i] = -0.0;
+      else
+        pattern[i] = (i%2) ? 1.5*i : -0.5*i;
+    }
+    double baseDense[n];
+    int baseIndex[n];
+    int baseNumber = 0;
+    int available = CoinSimdLevelAvailable();
+    for ( int which=0; which<6; which++ ) {
+      int start = (which&1) ? 13 : 0;
+      for ( int level=COIN_SIMD_SCALAR; level<=available; level++ ) {
+        CoinSetSimdLevel(level);
+        CoinIndexedVector r(n);
+        double * dense = r.denseVector();
+        CoinMemcpyN(pattern,n,dense);
+        int number;
+        switch (which) {
+        case 0:
+        case 1:
+          number = r.scan(start,n);
+          break;
+        case 2:
+        case 3:
+          number = r.scan(start,n,1.0e-12);
+          break;
+        default:
+          number = (which==4) ? r.scanAndPack() : r.scanAndPack(start,n,1.0e-12);
+          break;
+        }
+        if ( level==COIN_SIMD_SCALAR ) {
+          assert( number>0 && number<n );
+          baseNumber = number;
+          CoinMemcpyN(r.getIndices(),number,baseIndex);
+          CoinMemcpyN(r.denseVector(),n,baseDense);
+        } else {
+          assert( number==baseNumber );
+          for ( i=0; i<number; i++ )
+            assert( r.getIndices()[i]==baseIndex[i] );
+          for ( i=0; i<n; i++ )
+            assert( r.denseVector()[i]==baseDense[i] );
+        }
+      }
+    }
+    // cleans of unsorted lists - some indices overlap packed values
+    for ( int which=0; which<4; which++ ) {
+      for ( int level=COIN_SIMD_SCALAR; level<=available; level++ ) {
+        CoinSetSimdLevel(level);
+        CoinIndexedVector r(n);
+        for ( i=0; i<n; i++ ) {
+          int j = (which<2) ? (i*37)%n : n-1-i;
+          r.quickInsert(j,(j%3) ? pattern[j]+1.0e-13 : 1.0e-13);
+        }
+        int number;
+        if ( which%2==0 )
+          number = r.clean(1.0e-12);
+        else
+          number = r.cleanAndPack(1.0e-12);
+        if ( level==COIN_SIMD_SCALAR ) {
+          assert( number>0 && number<n );
+          baseNumber = number;
+          CoinMemcpyN(r.getIndices(),number,baseIndex);
+          CoinMemcpyN(r.denseVector(),n,baseDense);
+        } else {
+          assert( number==baseNumber );
+          for ( i=0; i<number; i++ )
+            assert( r.getIndices()[i]==baseIndex[i] );
+          for ( i=0; i<n; i++ )
+            assert( r.denseVector()[i]==baseDense[i] );
+        }
+      }
+    }
+    CoinSetSimdLevel(-1);
+  }
+  {
+    // threaded partition operations give same results as serial
+    const int n = 200000;
+    const int numberPartitions = 4;
+    int starts[numberPartitions+1];
+    int i;
+    for ( i=0; i<=numberPartitions; i++ )
+      starts[i] = (i*n)/numberPartitions;
+    CoinPartitionedVector serial;
+    CoinPartitionedVector threaded;
+    serial.reserve(n);
+    threaded.reserve(n);
+    threaded.setNumberThreads(3);
+    assert( threaded.numberThreads()==3 );
+    CoinPartitionedVector * both[2] = {&serial,&threaded};
+    for ( int k=0; k<2; k++ ) {
+      CoinPartitionedVector & r = *both[k];
+      r.setPartitions(numberPartitions,starts);
+      double * dense = r.denseVector();
+      // sparse enough for partitions to move independently in compact
+      for ( i=0; i<n; i+=4 )
+        dense[i] = (i%8) ? i+1.0 : 1.0e-13;
+      r.scanPartitions();
+    }
+    assert( serial.getNumElements()==threaded.getNumElements() );
+    int number = serial.getNumElements();
+    assert( serial.cleanPartitions(1.0e-12)==threaded.cleanPartitions(1.0e-12) );
+    assert( serial.getNumElements()<number );
+    double sum = serial.reducePartitions(partitionSum,NULL);
+    assert( sum>0.0 && sum==threaded.reducePartitions(partitionSum,NULL) );
+    int counts[2][numberPartitions];
+    for ( int k=0; k<2; k++ ) {
+      int * count = counts[k];
+      both[k]->forEachPartition([count](CoinPartitionedVector & vector, int partition) {
+        count[partition] = vector.getNumElements(partition);
+      });
+    }
+    for ( i=0; i<numberPartitions; i++ ) {
+      assert( counts[0][i]==counts[1][i] );
+      assert( counts[0][i]==serial.getNumElements(i) );
+    }
+    serial.compact();
+    threaded.compact();
+    assert( serial.getNumElements()==threaded.getNumElements() );
+    assert( !serial.getNumPartitions() && !threaded.getNumPartitions() );
+    for ( i=0; i<serial.getNumElements(); i++ ) {
+      assert( serial.getIndices()[i]==threaded.getIndices()[i] );
+      assert( serial.denseVector()[i]==threaded.denseVector()[i] );
+    }
+    for ( i=0; i<n; i++ )
+      assert( serial.denseVector()[i]==threaded.denseVector()[i] );
+#ifndef NO_CHECK_CL
+    threaded.checkClean();
+#endif
+    threaded.setPartitions(numberPartitions,starts);
+    threaded.scanPartitions();
+    threaded.clearAndReset();
+    serial.clearAndReset();
+#ifndef NO_CHECK_CL
+    threaded.checkClear();
+#endif
+  }
+  {
+    // allocation policy and statistics of arrays with length
+    CoinArrayAllocationPolicy saved = CoinArrayWithLength::allocationPolicy();
+    assert( saved.alignment==6 );
+    CoinArrayStatistics before = CoinArrayWithLength::statistics(COIN_ARRAY_DOUBLE);
+    {
+      CoinDoubleArrayWithLength a(1000,1);
+      assert( a.arrayType()==COIN_ARRAY_DOUBLE );
+      assert( !(reinterpret_cast<CoinInt64>(a.array())&63) );
+      CoinArrayStatistics now = CoinArrayWithLength::statistics(COIN_ARRAY_DOUBLE);
+      assert( now.numberAllocations==before.numberAllocations+1 );
+      assert( now.currentBytes==before.currentBytes+8000 );
+      assert( now.peakBytes>=now.currentBytes );
+      CoinDoubleArrayWithLength b(a);
+      assert( b.arrayType()==COIN_ARRAY_DOUBLE );
+      assert( !(reinterpret_cast<CoinInt64>(b.array())&63) );
+      // extend keeps data
+      a.array()[999] = 3.0;
+      a.extend(16000);
+      assert( a.array()[999]==3.0 && a.getSize()==2000 );
+    }
+    assert( CoinArrayWithLength::statistics(COIN_ARRAY_DOUBLE).currentBytes
+            ==before.currentBytes );
+    // user allocator and huge pages
+    CoinArrayAllocationPolicy policy = saved;
+    policy.allocate = userAllocate;
+    policy.release = userRelease;
+    policy.hugePageBytes = 1<<20;
+    CoinArrayWithLength::setAllocationPolicy(policy);
+    CoinArrayWithLength::resetStatistics();
+    {
+      CoinIntArrayWithLength small(100,1);
+      CoinIntArrayWithLength large(1<<19,1);
+      assert( numberUserArrays==1 );
+      assert( !(reinterpret_cast<CoinInt64>(small.array())&63) );
+      assert( !(reinterpret_cast<CoinInt64>(large.array())&63) );
+      int * array = large.array();
+      for ( int i=0; i<(1<<19); i++ )
+        assert( !array[i] );
+      array[(1<<19)-1] = 1;
+      CoinArrayStatistics now = CoinArrayWithLength::statistics(COIN_ARRAY_INT);
+      assert( now.numberAllocations==2 );
+      assert( now.totalBytes==4*(100+(1<<19)) );
+#if defined(__unix__) || defined(__APPLE__)
+      assert( now.numberHugePages==1 );
+#endif
+      // freed with policy in force when allocated
+      CoinArrayWithLength::setAllocationPolicy(saved);
+    }
+    assert( !numberUserArrays );
+  }
+  {
+    // work vectors and arrays from a pool
+    CoinWorkspacePool pool(100);
+    CoinIndexedVector * a = pool.getVector();
+    CoinIndexedVector * b = pool.getVector(200);
+    assert( a!=b && pool.numberVectors()==2 && pool.numberVectorsInUse()==2 );
+    assert( a->capacity()>=100 && b->capacity()>=200 );
+    assert( !a->getNumElements() && !b->getNumElements() );
+    a->insert(5,1.0);
+    a->insert(99,2.0);
+    b->insert(150,3.0);
+    b->scanAndPack();
+    pool.returnVector(a);
+    pool.returnVector(b);
+    assert( !pool.numberVectorsInUse() );
+    // handed out again clear and unpacked
+    CoinIndexedVector * c = pool.getVector();
+    CoinIndexedVector * d = pool.getVector(300);
+    assert( pool.numberVectors()==2 );
+    assert( !c->getNumElements() && !c->packedMode() );
+    assert( !d->getNumElements() && !d->packedMode() );
+    assert( d->capacity()>=300 );
+#ifndef NO_CHECK_CL
+    c->checkClear();
+    d->checkClear();
+#endif
+    pool.returnVector(c);
+    pool.returnVector(d);
+    {
+      CoinWorkspaceVector work(pool);
+      assert( pool.numberVectorsInUse()==1 && pool.numberVectors()==2 );
+      work->insert(3,1.0);
+      assert( (*work).getNumElements()==1 );
+    }
+    assert( !pool.numberVectorsInUse() );
+    // arrays - smallest big enough is used
+    CoinArrayWithLength * small = pool.getArray(800);
+    CoinArrayWithLength * large = pool.getArray(8000);
+    assert( small->capacity()>=800 && large->capacity()>=8000 );
+    pool.returnArray(large);
+    pool.returnArray(small);
+    CoinArrayWithLength * again = pool.getArray(100);
+    assert( again==small );
+    CoinArrayWithLength * bigger = pool.getArray(20000);
+    assert( bigger==large && bigger->capacity()>=20000 );
+    assert( pool.numberArrays()==2 && pool.numberArraysInUse()==2 );
+    pool.returnArray(again);
+    pool.returnArray(bigger);
+    // each thread has its own pool
+    CoinWorkspacePool * mine = &CoinWorkspacePool::threadInstance();
+    assert( mine==&CoinWorkspacePool::threadInstance() );
+    CoinWorkspacePool * other = NULL;
+    std::thread thread([&other]() {
+      other = &CoinWorkspacePool::threadInstance();
+      CoinWorkspaceVector work;
+      work->reserve(10);
+      work->insert(1,1.0);
+    });
+    thread.join();
+    assert( other && other!=mine );
+  }
   
 }
     
@@ -505,6 +505,16 @@ CoinModelUnitTest(const std::string & mpsDir,
     model.writeMps("byColumn.mps");
   }
 
+  // Binary file must give same model
+  {
+    int numErr = model.writeBinary("byColumn.cbm");
+    assert( numErr == 0 );
+    CoinModel temp;
+    numErr = temp.readBinary("byColumn.cbm");
+    assert( numErr == 0 );
+    assert (!model.differentModel(temp,false));
+  }
+
   // model was created by column - play around
   {
     CoinModel temp;
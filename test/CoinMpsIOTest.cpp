@@ -12,6 +12,9 @@
 #endif
 
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 #include "CoinMpsIO.hpp"
 #include "CoinFloatEqual.hpp"
@@ -158,7 +161,92 @@ CoinMpsIOUnitTest(const std::string & mpsDir)
       assert( eq( dumSi.getObjCoefficients()[6],  0.0) );
       assert( eq( dumSi.getObjCoefficients()[7], -1.0) );
     }
-    
+
+    // Read just written file using several threads - must be identical
+    {
+      CoinMpsIO serial;
+      serial.readMps("CoinMpsIoTest");
+      CoinMpsIO parallel;
+      parallel.setNumberThreads(3);
+      assert( parallel.numberThreads() == 3 );
+      int numErr = parallel.readMps("CoinMpsIoTest");
+      assert( numErr == 0 );
+      int nc = parallel.getNumCols();
+      assert( nc == serial.getNumCols() );
+      assert( parallel.getNumRows() == serial.getNumRows() );
+      assert( parallel.getNumElements() == serial.getNumElements() );
+      for (int i = 0; i < nc; i++) {
+        assert( !strcmp(parallel.columnName(i), serial.columnName(i)) );
+        assert( parallel.getObjCoefficients()[i] == serial.getObjCoefficients()[i] );
+        assert( parallel.getColLower()[i] == serial.getColLower()[i] );
+        assert( parallel.getColUpper()[i] == serial.getColUpper()[i] );
+        assert( parallel.isInteger(i) == serial.isInteger(i) );
+      }
+      assert( parallel.getMatrixByCol()->isEquivalent2(*serial.getMatrixByCol()) );
+    }
+
+    // Binary file must give same problem
+    {
+      CoinMpsIO binary;
+      assert( m.writeBinary("CoinMpsIoTest.cbm") == 0 );
+      int numErr = binary.readBinary("CoinMpsIoTest");
+      assert( numErr == 0 );
+      int nr = binary.getNumRows();
+      int nc = binary.getNumCols();
+      assert( nr == m.getNumRows() );
+      assert( nc == m.getNumCols() );
+      assert( !strcmp(binary.getProblemName(), m.getProblemName()) );
+      for (int i = 0; i < nr; i++) {
+        assert( !strcmp(binary.rowName(i), m.rowName(i)) );
+        assert( binary.getRowLower()[i] == m.getRowLower()[i] );
+        assert( binary.getRowUpper()[i] == m.getRowUpper()[i] );
+      }
+      for (int i = 0; i < nc; i++) {
+        assert( !strcmp(binary.columnName(i), m.columnName(i)) );
+        assert( binary.getObjCoefficients()[i] == m.getObjCoefficients()[i] );
+        assert( binary.getColLower()[i] == m.getColLower()[i] );
+        assert( binary.getColUpper()[i] == m.getColUpper()[i] );
+        assert( binary.isInteger(i) == m.isInteger(i) );
+      }
+      assert( binary.getMatrixByCol()->isEquivalent2(*m.getMatrixByCol()) );
+      assert( binary.columnIndex(m.columnName(nc - 1)) == nc - 1 );
+      // MPS file is not binary
+      assert( binary.readBinary("CoinMpsIoTest.mps", "") == -2 );
+      // Truncated file or silly counts in header are damaged
+      std::vector<char> file;
+      FILE *fp = fopen("CoinMpsIoTest.cbm", "rb");
+      assert( fp );
+      char buffer[4096];
+      size_t n;
+      while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+        file.insert(file.end(), buffer, buffer + n);
+      fclose(fp);
+      fp = fopen("CoinMpsIoTestBad.cbm", "wb");
+      fwrite(&file[0], 1, file.size() - 16, fp);
+      fclose(fp);
+      assert( binary.readBinary("CoinMpsIoTestBad") == -3 );
+      assert( binary.getNumRows() == 0 && binary.getNumCols() == 0 );
+      // number of elements follows magic, version, endian and dimensions
+      CoinInt64 numberElements = 2000000000;
+      memcpy(&file[24], &numberElements, sizeof(numberElements));
+      fp = fopen("CoinMpsIoTestBad.cbm", "wb");
+      fwrite(&file[0], 1, file.size(), fp);
+      fclose(fp);
+      assert( binary.readBinary("CoinMpsIoTestBad") == -3 );
+      remove("CoinMpsIoTestBad.cbm");
+      assert( binary.readBinary("CoinMpsIoTest") == 0 );
+      assert( binary.getNumRows() == m.getNumRows() );
+      // Compressed file is uncompressed before length is checked
+      if (CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_GZIP)) {
+        assert( m.writeBinary("CoinMpsIoTestGz.cbm", 1) == 0 );
+        CoinMpsIO compressed;
+        assert( compressed.readBinary("CoinMpsIoTestGz.cbm.gz", "") == 0 );
+        assert( compressed.getNumRows() == m.getNumRows() );
+        assert( compressed.getMatrixByCol()->isEquivalent2(*m.getMatrixByCol()) );
+        remove("CoinMpsIoTestGz.cbm.gz");
+      }
+    }
+
     // Test matrixByRow method
     { 
       const CoinMpsIO si(m);
@@ -12,6 +12,8 @@
 #endif
 
 #include <cassert>
+#include <thread>
+#include <vector>
 
 #include "CoinFloatEqual.hpp"
 #include "CoinPackedVector.hpp"
@@ -632,6 +634,98 @@ CoinPackedMatrixUnitTest()
     
     delete globalP;
   }
+
+  {
+    // Test threaded times and transposeTimes against serial
+    const int numberRows = 2000;
+    const int numberColumns = 3000;
+    const int perColumn = 12;
+    CoinBigIndex numberElements = numberColumns * perColumn;
+    int *rowIndex = new int[numberElements];
+    CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+    double *element = new double[numberElements];
+    CoinBigIndex k = 0;
+    start[0] = 0;
+    for (int i = 0; i < numberColumns; i++) {
+      // uneven column lengths so blocks differ
+      int length = (i % 3 == 0) ? 2 * perColumn - 1 : (i % 3 == 1) ? 1 : perColumn;
+      for (int j = 0; j < length; j++) {
+        rowIndex[k] = (i * 7 + j * 131) % numberRows;
+        element[k] = 1.0 + ((i + j) % 13) * 0.25 - ((i * j) % 5) * 0.125;
+        k++;
+      }
+      start[i + 1] = k;
+    }
+    CoinPackedMatrix serial(true, numberRows, numberColumns, k,
+      element, rowIndex, start, NULL);
+    CoinPackedMatrix threaded(serial);
+    threaded.setNumberThreads(3);
+    assert(threaded.numberThreads() == 3);
+    CoinPackedMatrix copy(threaded);
+    assert(copy.numberThreads() == 3);
+    double *x = new double[numberColumns];
+    double *y = new double[numberRows];
+    double *ySerial = new double[numberColumns];
+    double *yThreaded = new double[numberColumns];
+    for (int i = 0; i < numberColumns; i++)
+      x[i] = (i % 4) ? 0.5 * (i % 17) - 3.0 : 0.0;
+    for (int i = 0; i < numberRows; i++)
+      y[i] = 1.0 - 0.125 * (i % 11);
+    // times on column ordered matrix scatters
+    serial.times(x, ySerial);
+    threaded.times(x, yThreaded);
+    for (int i = 0; i < numberRows; i++)
+      assert(eq(ySerial[i], yThreaded[i]));
+    // transposeTimes is one dot product per column so must be identical
+    serial.transposeTimes(y, ySerial);
+    threaded.transposeTimes(y, yThreaded);
+    for (int i = 0; i < numberColumns; i++)
+      assert(ySerial[i] == yThreaded[i]);
+    // and same again row ordered
+    serial.reverseOrdering();
+    threaded.reverseOrdering();
+    assert(threaded.numberThreads() == 3);
+    serial.times(x, ySerial);
+    threaded.times(x, yThreaded);
+    for (int i = 0; i < numberRows; i++)
+      assert(ySerial[i] == yThreaded[i]);
+    serial.transposeTimes(y, ySerial);
+    threaded.transposeTimes(y, yThreaded);
+    for (int i = 0; i < numberColumns; i++)
+      assert(eq(ySerial[i], yThreaded[i]));
+    {
+      // const products from several threads at once on one matrix
+      const CoinPackedMatrix &shared = threaded;
+      std::vector< std::vector< double > > answer(4, std::vector< double >(numberColumns));
+      std::vector< std::thread > workers;
+      for (int t = 0; t < 4; t++)
+        workers.push_back(std::thread([&shared, &answer, y, t]() {
+          for (int pass = 0; pass < 20; pass++)
+            shared.transposeTimes(y, &answer[t][0]);
+        }));
+      for (int t = 0; t < 4; t++)
+        workers[t].join();
+      for (int t = 0; t < 4; t++) {
+        for (int i = 0; i < numberColumns; i++)
+          assert(eq(ySerial[i], answer[t][i]));
+      }
+    }
+    // threads go with matrix when swapped
+    CoinPackedMatrix other;
+    other.swap(threaded);
+    assert(other.numberThreads() == 3);
+    assert(threaded.numberThreads() == 1);
+    other.transposeTimes(y, yThreaded);
+    for (int i = 0; i < numberColumns; i++)
+      assert(eq(ySerial[i], yThreaded[i]));
+    delete[] x;
+    delete[] y;
+    delete[] ySerial;
+    delete[] yThreaded;
+    delete[] rowIndex;
+    delete[] start;
+    delete[] element;
+  }
   
 #if 0
   {
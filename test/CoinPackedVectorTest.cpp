@@ -7,10 +7,13 @@
 #endif
 
 #include <cassert>
+#include <utility>
+#include <vector>
 
 #include "CoinPragma.hpp"
 #include "CoinFloatEqual.hpp"
 #include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
 #include "CoinPackedVector.hpp"
 #include "CoinShallowPackedVector.hpp"
 
@@ -1048,5 +1051,104 @@ CoinPackedVectorUnitTest()
 
   } 
 
+  {
+    // Test inline storage, single allocation and move
+    const int nBig = 3 * COIN_PACKED_VECTOR_SMALL;
+    int inxBig[nBig];
+    double elBig[nBig];
+    for ( i=0; i<nBig; i++ ) {
+      inxBig[i] = 2*i+1;
+      elBig[i] = 0.5*i+1.0;
+    }
+    CoinPackedVector small(4,inxBig,elBig);
+    assert( small.elements_==small.smallElements_ );
+    assert( small.capacity()==4 );
+    // grow within object then onto heap
+    for ( i=4; i<nBig; i++ ) {
+      small.insert(inxBig[i],elBig[i]);
+      assert( (small.capacity()<=COIN_PACKED_VECTOR_SMALL)==
+              (small.elements_==small.smallElements_) );
+    }
+    assert( small.capacity()>COIN_PACKED_VECTOR_SMALL );
+    assert( small.getIndices()==reinterpret_cast<int *>(small.elements_+small.capacity()) );
+    assert( small.getOriginalPosition()==small.getIndices()+small.capacity() );
+    for ( i=0; i<nBig; i++ ) {
+      assert( small.getIndices()[i]==inxBig[i] );
+      assert( small.getElements()[i]==elBig[i] );
+      assert( small.getOriginalPosition()[i]==i );
+    }
+
+    // move of heap vector hands over storage
+    const double * elements = small.getElements();
+    CoinPackedVector big(std::move(small));
+    assert( big.getElements()==elements );
+    assert( big.getNumElements()==nBig );
+    assert( small.getNumElements()==0 );
+    assert( small.capacity()==0 );
+    assert( small.elements_==NULL );
+    small.insert(3,3.0);
+    assert( small.getNumElements()==1 && small[3]==3.0 );
+
+    // move of inline vector copies entries
+    CoinPackedVector r(5,inxBig,elBig,true);
+    r.sortDecrIndex();
+    CoinPackedVector r2(std::move(r));
+    assert( r2.elements_==r2.smallElements_ );
+    assert( r2.getNumElements()==5 );
+    assert( r2.testForDuplicateIndex() );
+    assert( r2.getMaxIndex()==inxBig[4] );
+    r2.sortOriginalOrder();
+    for ( i=0; i<5; i++ ) {
+      assert( r2.getIndices()[i]==inxBig[i] );
+      assert( r2.getElements()[i]==elBig[i] );
+    }
+    bool errorThrown = false;
+    try {
+      r2.insert(inxBig[2],1.0);
+    }
+    catch (CoinError& e) {
+      errorThrown = true;
+    }
+    assert( errorThrown );
+    assert( r.getNumElements()==0 );
+
+    // move assignment both ways
+    r = std::move(big);
+    assert( r.getElements()==elements );
+    assert( r.getNumElements()==nBig );
+    assert( r.testForDuplicateIndex()==COIN_DEFAULT_VALUE_FOR_DUPLICATE );
+    big = std::move(r2);
+    assert( big.elements_==big.smallElements_ );
+    assert( big.getNumElements()==5 );
+    assert( big[inxBig[4]]==elBig[4] );
+
+    // assignVector copies and frees arrays
+    int * inds = new int[nBig];
+    double * elems = new double[nBig];
+    CoinCopyN(inxBig,nBig,inds);
+    CoinCopyN(elBig,nBig,elems);
+    CoinPackedVector r3(nBig+1,nBig,inds,elems);
+    assert( inds==NULL && elems==NULL );
+    assert( r3==r );
+    assert( r3.capacity()==nBig+1 );
+    inds = new int[2];
+    elems = new double[2];
+    inds[0] = 7; inds[1] = 2;
+    elems[0] = 1.0; elems[1] = 2.0;
+    r3.assignVector(2,inds,elems);
+    assert( inds==NULL && elems==NULL );
+    assert( r3.getNumElements()==2 && r3[7]==1.0 && r3[2]==2.0 );
+
+    // vectors of short vectors
+    std::vector<CoinPackedVector> cuts;
+    for ( i=0; i<100; i++ )
+      cuts.push_back(CoinPackedVector(1+i%COIN_PACKED_VECTOR_SMALL,inxBig,elBig));
+    for ( i=0; i<100; i++ ) {
+      assert( cuts[i].elements_==cuts[i].smallElements_ );
+      assert( cuts[i].getNumElements()==1+i%COIN_PACKED_VECTOR_SMALL );
+      assert( cuts[i].sum()>0.0 );
+    }
+  }
+
 }
 
@@ -0,0 +1,874 @@
+// Copyright (C) 2026, COIN-OR.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+/*
+  Timings of the core sparse data structures so that changes in speed
+  between releases can be spotted.  Not part of unitTest - build and run
+  with make benchmark.
+
+  CoinUtilsBenchmark [-mpsDir=dir] [-model=file[,file...]] [-size=n]
+    [-time=seconds] [-only=string] [-output=file]
+    [-baseline=file] [-tolerance=ratio]
+
+  Each benchmark is repeated until it has taken at least -time seconds
+  (default 0.2).  Results are written (to stdout or -output) as comma
+  separated values with one header line:
+
+    benchmark,problem,rows,columns,elements,repeats,seconds,seconds_per_repeat,check
+
+  check is a number computed from the results so that a change in answers
+  shows up as well as a change in speed.  If -baseline names an earlier
+  output file, any benchmark more than -tolerance (default 1.25) times
+  slower than before is reported on stderr and the exit code is 1.
+
+  Problems are generated (size given by -size, default 20000) and also
+  read from any of a few standard models found in -mpsDir and from
+  -model.
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinFactorization.hpp"
+#include "CoinSimpFactorization.hpp"
+#include "CoinFactorizationFactory.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinTime.hpp"
+
+// Same numbers on every platform
+class BenchmarkRandom {
+public:
+  BenchmarkRandom(unsigned int seed)
+    : seed_(seed)
+  {
+  }
+  // 0 <= value < 1
+  double randomDouble()
+  {
+    seed_ = 1664525 * seed_ + 1013904223;
+    return static_cast< double >(seed_) / 4294967296.0;
+  }
+  // 0 <= value < n
+  int randomInt(int n)
+  {
+    return static_cast< int >(randomDouble() * n);
+  }
+
+private:
+  unsigned int seed_;
+};
+
+// A problem to time operations on
+struct BenchmarkProblem {
+  std::string name;
+  CoinPackedMatrix matrix;
+  // Basis for factorization (values >= 0 are basic)
+  std::vector< int > rowIsBasic;
+  std::vector< int > columnIsBasic;
+};
+
+// One timed operation
+class BenchmarkCase {
+public:
+  virtual ~BenchmarkCase() {}
+  /// Does operation once and returns a number to check results by
+  virtual double run() = 0;
+};
+
+// Runs cases and writes results
+class Benchmarker {
+public:
+  Benchmarker(FILE *fp, double minimumTime, const std::string &only)
+    : fp_(fp)
+    , minimumTime_(minimumTime)
+    , only_(only)
+  {
+    fprintf(fp_, "benchmark,problem,rows,columns,elements,repeats,seconds,seconds_per_repeat,check\n");
+  }
+  /// True if benchmark wanted
+  bool wanted(const char *name) const
+  {
+    return only_.empty() || strstr(name, only_.c_str()) != NULL;
+  }
+  void time(const char *name, const std::string &problem, int rows,
+    int columns, CoinBigIndex elements, BenchmarkCase &test)
+  {
+    if (!wanted(name))
+      return;
+    // once to warm caches
+    double check = test.run();
+    int repeats = 1;
+    double seconds;
+    while (true) {
+      double start = CoinGetTimeOfDay();
+      for (int i = 0; i < repeats; i++)
+        check = test.run();
+      seconds = CoinGetTimeOfDay() - start;
+      if (seconds >= minimumTime_ || repeats >= 1 << 24)
+        break;
+      // aim a bit over minimum next time
+      if (seconds * 8.0 < minimumTime_)
+        repeats *= 8;
+      else
+        repeats = static_cast< int >(repeats * 1.2 * minimumTime_ / seconds) + 1;
+    }
+    double perRepeat = seconds / repeats;
+    fprintf(fp_, "%s,%s,%d,%d,%ld,%d,%.6f,%.9g,%.12g\n", name, problem.c_str(),
+      rows, columns, static_cast< long >(elements), repeats, seconds,
+      perRepeat, check);
+    fflush(fp_);
+    timings_[std::string(name) + "," + problem] = perRepeat;
+  }
+  /// Timings so far keyed by "benchmark,problem"
+  const std::map< std::string, double > &timings() const
+  {
+    return timings_;
+  }
+
+private:
+  FILE *fp_;
+  double minimumTime_;
+  std::string only_;
+  std::map< std::string, double > timings_;
+};
+
+//#############################################################################
+// CoinIndexedVector
+//#############################################################################
+
+class IndexedVectorScan : public BenchmarkCase {
+public:
+  CoinIndexedVector vector;
+  virtual double run()
+  {
+    return vector.scan();
+  }
+};
+
+class IndexedVectorClean : public BenchmarkCase {
+public:
+  CoinIndexedVector vector;
+  std::vector< int > index;
+  std::vector< double > value;
+  // Refills then cleans (so time includes refill)
+  virtual double run()
+  {
+    vector.clear();
+    int n = static_cast< int >(index.size());
+    for (int i = 0; i < n; i++)
+      vector.quickAdd(index[i], value[i]);
+    return vector.clean(1.0e-3);
+  }
+};
+
+class IndexedVectorAdd : public BenchmarkCase {
+public:
+  CoinIndexedVector vector;
+  std::vector< int > index;
+  std::vector< double > value;
+  // Adds entries (many to the same place) then clears
+  virtual double run()
+  {
+    int n = static_cast< int >(index.size());
+    for (int i = 0; i < n; i++)
+      vector.add(index[i], value[i]);
+    double check = vector.getNumElements();
+    vector.clear();
+    return check;
+  }
+};
+
+class IndexedVectorSort : public BenchmarkCase {
+public:
+  CoinIndexedVector vector;
+  std::vector< int > shuffled;
+  // Puts indices back in random order then sorts
+  virtual double run()
+  {
+    CoinMemcpyN(&shuffled[0], static_cast< int >(shuffled.size()), vector.getIndices());
+    vector.sort();
+    return vector.getIndices()[vector.getNumElements() / 2];
+  }
+};
+
+static void indexedVectorBenchmarks(Benchmarker &benchmarker, int size)
+{
+  BenchmarkRandom random(987654321);
+  int numberNonZero = size / 10;
+  char problem[40];
+  sprintf(problem, "generated_%d", size);
+  std::vector< int > index;
+  std::vector< double > value;
+  for (int i = 0; i < numberNonZero; i++) {
+    index.push_back(random.randomInt(size));
+    value.push_back(random.randomDouble() - 0.5);
+  }
+  {
+    IndexedVectorScan test;
+    test.vector.reserve(size);
+    for (int i = 0; i < numberNonZero; i++)
+      test.vector.denseVector()[index[i]] = value[i] + 1.0;
+    benchmarker.time("CoinIndexedVector::scan", problem, size, 1,
+      numberNonZero, test);
+  }
+  {
+    IndexedVectorClean test;
+    test.vector.reserve(size);
+    // no duplicates for quickAdd
+    std::set< int > used;
+    for (int i = 0; i < numberNonZero; i++) {
+      if (used.insert(index[i]).second) {
+        test.index.push_back(index[i]);
+        test.value.push_back((i % 4) ? value[i] + 1.0 : 1.0e-5);
+      }
+    }
+    benchmarker.time("CoinIndexedVector::clean", problem, size, 1,
+      static_cast< CoinBigIndex >(test.index.size()), test);
+  }
+  {
+    IndexedVectorAdd test;
+    test.vector.reserve(size);
+    test.index = index;
+    test.value = value;
+    // and again so half are additions to existing entries
+    test.index.insert(test.index.end(), index.begin(), index.end());
+    test.value.insert(test.value.end(), value.begin(), value.end());
+    benchmarker.time("CoinIndexedVector::add", problem, size, 1,
+      2 * numberNonZero, test);
+  }
+  {
+    IndexedVectorSort test;
+    test.vector.reserve(size);
+    for (int i = 0; i < numberNonZero; i++)
+      test.vector.add(index[i], value[i] + 1.0);
+    int n = test.vector.getNumElements();
+    test.shuffled.assign(test.vector.getIndices(), test.vector.getIndices() + n);
+    benchmarker.time("CoinIndexedVector::sort", problem, size, 1, n, test);
+  }
+}
+
+//#############################################################################
+// CoinPackedMatrix
+//#############################################################################
+
+class MatrixTimes : public BenchmarkCase {
+public:
+  const CoinPackedMatrix *matrix;
+  std::vector< double > x;
+  std::vector< double > y;
+  virtual double run()
+  {
+    matrix->times(&x[0], &y[0]);
+    double sum = 0.0;
+    for (size_t i = 0; i < y.size(); i++)
+      sum += y[i];
+    return sum;
+  }
+};
+
+class MatrixTransposeTimes : public BenchmarkCase {
+public:
+  const CoinPackedMatrix *matrix;
+  std::vector< double > x;
+  std::vector< double > y;
+  virtual double run()
+  {
+    matrix->transposeTimes(&x[0], &y[0]);
+    double sum = 0.0;
+    for (size_t i = 0; i < y.size(); i++)
+      sum += y[i];
+    return sum;
+  }
+};
+
+class MatrixReverseOrderedCopy : public BenchmarkCase {
+public:
+  const CoinPackedMatrix *matrix;
+  CoinPackedMatrix copy;
+  virtual double run()
+  {
+    copy.reverseOrderedCopyOf(*matrix);
+    return copy.getVectorStarts()[copy.getMajorDim() / 2];
+  }
+};
+
+class MatrixSubmatrix : public BenchmarkCase {
+public:
+  const CoinPackedMatrix *matrix;
+  std::vector< int > which;
+  CoinPackedMatrix copy;
+  virtual double run()
+  {
+    copy.submatrixOf(*matrix, static_cast< int >(which.size()), &which[0]);
+    return copy.getNumElements();
+  }
+};
+
+class MatrixAppendRows : public BenchmarkCase {
+public:
+  const CoinPackedMatrix *matrix;
+  std::vector< CoinBigIndex > rowStart;
+  std::vector< int > column;
+  std::vector< double > element;
+  // Copies matrix then appends (so time includes copy)
+  virtual double run()
+  {
+    CoinPackedMatrix copy(*matrix);
+    copy.appendRows(static_cast< int >(rowStart.size()) - 1, &rowStart[0],
+      &column[0], &element[0]);
+    return copy.getNumElements() + copy.getNumRows();
+  }
+};
+
+static void packedMatrixBenchmarks(Benchmarker &benchmarker,
+  const BenchmarkProblem &problem)
+{
+  const CoinPackedMatrix &matrix = problem.matrix;
+  int numberRows = matrix.getNumRows();
+  int numberColumns = matrix.getNumCols();
+  CoinBigIndex numberElements = matrix.getNumElements();
+  if (!numberRows || !numberColumns)
+    return;
+  BenchmarkRandom random(123456789);
+  {
+    MatrixTimes test;
+    test.matrix = &matrix;
+    test.y.resize(numberRows);
+    for (int i = 0; i < numberColumns; i++)
+      test.x.push_back((i % 3) ? random.randomDouble() : 0.0);
+    benchmarker.time("CoinPackedMatrix::times", problem.name, numberRows,
+      numberColumns, numberElements, test);
+  }
+  {
+    MatrixTransposeTimes test;
+    test.matrix = &matrix;
+    test.y.resize(numberColumns);
+    for (int i = 0; i < numberRows; i++)
+      test.x.push_back(random.randomDouble() - 0.5);
+    benchmarker.time("CoinPackedMatrix::transposeTimes", problem.name,
+      numberRows, numberColumns, numberElements, test);
+  }
+  {
+    MatrixReverseOrderedCopy test;
+    test.matrix = &matrix;
+    benchmarker.time("CoinPackedMatrix::reverseOrderedCopyOf", problem.name,
+      numberRows, numberColumns, numberElements, test);
+  }
+  {
+    MatrixSubmatrix test;
+    test.matrix = &matrix;
+    for (int i = 0; i < numberColumns; i += 2)
+      test.which.push_back(i);
+    benchmarker.time("CoinPackedMatrix::submatrixOf", problem.name,
+      numberRows, numberColumns, numberElements, test);
+  }
+  {
+    MatrixAppendRows test;
+    test.matrix = &matrix;
+    int numberAppend = CoinMax(numberRows / 10, 1);
+    test.rowStart.push_back(0);
+    for (int i = 0; i < numberAppend; i++) {
+      int first = random.randomInt(numberColumns);
+      int length = CoinMin(5, numberColumns);
+      for (int j = 0; j < length; j++) {
+        test.column.push_back((first + j) % numberColumns);
+        test.element.push_back(random.randomDouble() + 0.5);
+      }
+      test.rowStart.push_back(static_cast< CoinBigIndex >(test.column.size()));
+    }
+    benchmarker.time("CoinPackedMatrix::appendRows", problem.name,
+      numberRows, numberColumns, numberElements, test);
+  }
+}
+
+//#############################################################################
+// CoinFactorization
+//#############################################################################
+
+class FactorizationFactorize : public BenchmarkCase {
+public:
+  const BenchmarkProblem *problem;
+  CoinFactorization factorization;
+  std::vector< int > rowIsBasic;
+  std::vector< int > columnIsBasic;
+  virtual double run()
+  {
+    // factorize overwrites status arrays
+    rowIsBasic = problem->rowIsBasic;
+    columnIsBasic = problem->columnIsBasic;
+    factorization.factorize(problem->matrix, &rowIsBasic[0], &columnIsBasic[0]);
+    return factorization.numberElementsL() + factorization.numberElementsU();
+  }
+};
+
+// Works for CoinFactorization and CoinOtherFactorization backends
+template < class Factorization >
+class FactorizationUpdate : public BenchmarkCase {
+public:
+  Factorization *factorization;
+  const CoinPackedMatrix *matrix;
+  // Nonbasic columns to FTRAN (or rows to BTRAN)
+  std::vector< int > which;
+  bool transpose;
+  CoinIndexedVector region;
+  CoinIndexedVector work;
+  virtual double run()
+  {
+    double check = 0.0;
+    const CoinBigIndex *columnStart = matrix->getVectorStarts();
+    const int *columnLength = matrix->getVectorLengths();
+    const int *row = matrix->getIndices();
+    const double *element = matrix->getElements();
+    for (size_t k = 0; k < which.size(); k++) {
+      int iColumn = which[k];
+      if (!transpose) {
+        for (CoinBigIndex j = columnStart[iColumn];
+             j < columnStart[iColumn] + columnLength[iColumn]; j++)
+          region.insert(row[j], element[j]);
+        factorization->updateColumnFT(&work, &region);
+      } else {
+        region.insert(iColumn, 1.0);
+        factorization->updateColumnTranspose(&work, &region);
+      }
+      check += region.getNumElements();
+      region.clear();
+    }
+    return check;
+  }
+};
+
+// Dense right hand sides (as for ranging) - in double or with float factors
+class FactorizationDenseUpdate : public BenchmarkCase {
+public:
+  CoinFactorization *factorization;
+  bool transpose;
+  int numberSolves;
+  CoinIndexedVector region;
+  CoinIndexedVector work;
+  virtual double run()
+  {
+    int numberRows = factorization->numberRows();
+    double check = 0.0;
+    for (int k = 0; k < numberSolves; k++) {
+      for (int i = 0; i < numberRows; i++)
+        region.insert(i, 1.0 + ((i + k) % 7));
+      if (!transpose)
+        factorization->updateColumn(&work, &region);
+      else
+        factorization->updateColumnTranspose(&work, &region);
+      check += region.getNumElements();
+      region.clear();
+    }
+    return check;
+  }
+};
+
+//#############################################################################
+// CoinSimpFactorization - same bases and columns as CoinFactorization
+//#############################################################################
+
+class SimpFactorizationFactorize : public BenchmarkCase {
+public:
+  CoinPackedMatrix basis;
+  CoinSimpFactorization factorization;
+  std::vector< int > pivotVariable;
+  virtual double run()
+  {
+    CoinFactorizationFactory::factorize(&factorization, basis, &pivotVariable[0]);
+    return factorization.numberElements();
+  }
+};
+
+static void simpFactorizationBenchmarks(Benchmarker &benchmarker,
+  const BenchmarkProblem &problem, const std::vector< int > &ftranWhich,
+  const std::vector< int > &btranWhich)
+{
+  const CoinPackedMatrix &matrix = problem.matrix;
+  int numberRows = matrix.getNumRows();
+  int numberColumns = matrix.getNumCols();
+  // basic columns then slacks (with same sign as CoinFactorization)
+  SimpFactorizationFactorize factorize;
+  CoinPackedMatrix &basis = factorize.basis;
+  basis.setDimensions(numberRows, 0);
+  for (int i = 0; i < numberColumns; i++) {
+    if (problem.columnIsBasic[i] >= 0) {
+      CoinBigIndex start = matrix.getVectorStarts()[i];
+      basis.appendCol(matrix.getVectorLengths()[i], matrix.getIndices() + start,
+        matrix.getElements() + start);
+    }
+  }
+  double slackValue = -1.0;
+  for (int i = 0; i < numberRows; i++) {
+    if (problem.rowIsBasic[i] >= 0)
+      basis.appendCol(1, &i, &slackValue);
+  }
+  if (basis.getNumCols() != numberRows)
+    return;
+  factorize.pivotVariable.resize(numberRows);
+  factorize.run();
+  if (factorize.factorization.status()) {
+    fprintf(stderr, "Basis of %s is singular for CoinSimpFactorization (status %d)\n",
+      problem.name.c_str(), factorize.factorization.status());
+    return;
+  }
+  benchmarker.time("CoinSimpFactorization::factorize", problem.name, numberRows,
+    numberRows, factorize.factorization.numberElements(), factorize);
+  CoinSimpFactorization &factorization = factorize.factorization;
+  FactorizationUpdate< CoinOtherFactorization > ftran;
+  ftran.factorization = &factorization;
+  ftran.matrix = &matrix;
+  ftran.transpose = false;
+  ftran.which = ftranWhich;
+  ftran.region.reserve(numberRows);
+  ftran.work.reserve(numberRows);
+  if (ftran.which.size())
+    benchmarker.time("CoinSimpFactorization::updateColumnFT", problem.name,
+      numberRows, static_cast< int >(ftran.which.size()),
+      factorization.numberElements(), ftran);
+  FactorizationUpdate< CoinOtherFactorization > btran;
+  btran.factorization = &factorization;
+  btran.matrix = &matrix;
+  btran.transpose = true;
+  btran.which = btranWhich;
+  btran.region.reserve(numberRows);
+  btran.work.reserve(numberRows);
+  benchmarker.time("CoinSimpFactorization::updateColumnTranspose", problem.name,
+    numberRows, static_cast< int >(btran.which.size()),
+    factorization.numberElements(), btran);
+}
+
+static void factorizationBenchmarks(Benchmarker &benchmarker,
+  const BenchmarkProblem &problem)
+{
+  const CoinPackedMatrix &matrix = problem.matrix;
+  int numberRows = matrix.getNumRows();
+  int numberColumns = matrix.getNumCols();
+  if (!numberRows || problem.rowIsBasic.empty())
+    return;
+  FactorizationFactorize factorize;
+  factorize.problem = &problem;
+  factorize.run();
+  if (factorize.factorization.status()) {
+    fprintf(stderr, "Basis of %s is singular (status %d) - no factorization benchmarks\n",
+      problem.name.c_str(), factorize.factorization.status());
+    return;
+  }
+  int numberBasic = 0;
+  for (int i = 0; i < numberColumns; i++)
+    if (problem.columnIsBasic[i] >= 0)
+      numberBasic++;
+  benchmarker.time("CoinFactorization::factorize", problem.name, numberRows,
+    numberBasic, factorize.factorization.numberElements(), factorize);
+  CoinFactorization &factorization = factorize.factorization;
+  // at most 100 updates per repeat
+  FactorizationUpdate< CoinFactorization > ftran;
+  ftran.factorization = &factorization;
+  ftran.matrix = &matrix;
+  ftran.transpose = false;
+  for (int i = 0; i < numberColumns; i++) {
+    if (problem.columnIsBasic[i] < 0 && matrix.getVectorSize(i))
+      ftran.which.push_back(i);
+  }
+  if (ftran.which.size() > 100) {
+    std::vector< int > which;
+    for (int i = 0; i < 100; i++)
+      which.push_back(ftran.which[(i * ftran.which.size()) / 100]);
+    ftran.which = which;
+  }
+  ftran.region.reserve(factorization.maximumRowsExtra());
+  ftran.work.reserve(factorization.maximumRowsExtra());
+  if (ftran.which.size())
+    benchmarker.time("CoinFactorization::updateColumnFT", problem.name,
+      numberRows, static_cast< int >(ftran.which.size()),
+      factorization.numberElements(), ftran);
+  FactorizationUpdate< CoinFactorization > btran;
+  btran.factorization = &factorization;
+  btran.matrix = &matrix;
+  btran.transpose = true;
+  for (int i = 0; i < CoinMin(numberRows, 100); i++)
+    btran.which.push_back(static_cast< int >((static_cast< double >(i) * numberRows) / CoinMin(numberRows, 100)));
+  btran.region.reserve(factorization.maximumRowsExtra());
+  btran.work.reserve(factorization.maximumRowsExtra());
+  benchmarker.time("CoinFactorization::updateColumnTranspose", problem.name,
+    numberRows, static_cast< int >(btran.which.size()),
+    factorization.numberElements(), btran);
+  // same basis with float copies of factors and one refinement step
+  FactorizationFactorize floatFactorize;
+  floatFactorize.problem = &problem;
+  floatFactorize.factorization.setFloatFactors(1);
+  floatFactorize.run();
+  const char *denseName[4] = { "CoinFactorization::updateColumnDense",
+    "CoinFactorization::updateColumnDenseFloat",
+    "CoinFactorization::updateColumnTransposeDense",
+    "CoinFactorization::updateColumnTransposeDenseFloat" };
+  for (int i = 0; i < 4; i++) {
+    FactorizationDenseUpdate dense;
+    dense.factorization = (i & 1) ? &floatFactorize.factorization : &factorization;
+    dense.transpose = i >= 2;
+    dense.numberSolves = 10;
+    dense.region.reserve(factorization.maximumRowsExtra());
+    dense.work.reserve(factorization.maximumRowsExtra());
+    benchmarker.time(denseName[i], problem.name, numberRows, dense.numberSolves,
+      factorization.numberElements(), dense);
+  }
+  simpFactorizationBenchmarks(benchmarker, problem, ftran.which, btran.which);
+}
+
+//#############################################################################
+// Problems
+//#############################################################################
+
+/* Generated problem - first numberRows columns have a dominant diagonal so
+   basis of them (with some swapped for slacks) is not singular. */
+static void generateProblem(BenchmarkProblem &problem, int numberRows)
+{
+  BenchmarkRandom random(192837465);
+  int numberColumns = 2 * numberRows;
+  std::vector< CoinBigIndex > start;
+  std::vector< int > row;
+  std::vector< double > element;
+  start.push_back(0);
+  for (int i = 0; i < numberColumns; i++) {
+    if (i < numberRows) {
+      row.push_back(i);
+      element.push_back(4.0 + random.randomDouble());
+    }
+    /* off diagonal entries in distinct rows - mostly near diagonal (as in
+       staircase models) with a few long links so fill is realistic */
+    int length = 1 + random.randomInt(6);
+    int first = (i % numberRows) + random.randomInt(81) - 40;
+    if (!random.randomInt(20))
+      first = random.randomInt(numberRows);
+    first = (first + numberRows) % numberRows;
+    for (int j = 0; j < length; j++) {
+      int iRow = (first + j * 7) % numberRows;
+      if (iRow != i) {
+        row.push_back(iRow);
+        element.push_back(random.randomDouble() - 0.5);
+      }
+    }
+    start.push_back(static_cast< CoinBigIndex >(row.size()));
+  }
+  char name[40];
+  sprintf(name, "generated_%d", numberRows);
+  problem.name = name;
+  problem.matrix = CoinPackedMatrix(true, numberRows, numberColumns,
+    start[numberColumns], &element[0], &row[0], &start[0], NULL);
+  problem.rowIsBasic.assign(numberRows, -1);
+  problem.columnIsBasic.assign(numberColumns, -1);
+  for (int i = 0; i < numberRows; i++) {
+    if (i % 4 == 3)
+      problem.rowIsBasic[i] = 1;
+    else
+      problem.columnIsBasic[i] = 1;
+  }
+}
+
+/* Basis from simple triangular crash - a column is taken if it has an
+   entry in a row not touched by earlier columns, all its rows are then
+   touched.  Rows not pivoted on have slacks basic. */
+static void crashBasis(BenchmarkProblem &problem)
+{
+  const CoinPackedMatrix &matrix = problem.matrix;
+  int numberRows = matrix.getNumRows();
+  int numberColumns = matrix.getNumCols();
+  const CoinBigIndex *columnStart = matrix.getVectorStarts();
+  const int *columnLength = matrix.getVectorLengths();
+  const int *row = matrix.getIndices();
+  const double *element = matrix.getElements();
+  std::vector< char > touched(numberRows, 0);
+  problem.rowIsBasic.assign(numberRows, 1);
+  problem.columnIsBasic.assign(numberColumns, -1);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+    double largest = 0.0;
+    for (CoinBigIndex j = columnStart[iColumn]; j < end; j++)
+      largest = CoinMax(largest, fabs(element[j]));
+    int pivotRow = -1;
+    for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+      if (!touched[row[j]] && fabs(element[j]) >= 0.1 * largest) {
+        pivotRow = row[j];
+        break;
+      }
+    }
+    if (pivotRow >= 0) {
+      problem.columnIsBasic[iColumn] = 1;
+      problem.rowIsBasic[pivotRow] = -1;
+      for (CoinBigIndex j = columnStart[iColumn]; j < end; j++)
+        touched[row[j]] = 1;
+    }
+  }
+}
+
+static bool readProblem(BenchmarkProblem &problem, const std::string &fileName)
+{
+  CoinMpsIO reader;
+  reader.messageHandler()->setLogLevel(-1);
+  if (reader.readMps(fileName.c_str(), "") != 0)
+    return false;
+  problem.matrix = *reader.getMatrixByCol();
+  problem.matrix.removeGaps();
+  std::string::size_type slash = fileName.find_last_of("/\\");
+  problem.name = (slash == std::string::npos) ? fileName : fileName.substr(slash + 1);
+  crashBasis(problem);
+  return true;
+}
+
+//#############################################################################
+
+// Reads earlier output - returns false if it can not be read
+static bool readBaseline(const std::string &fileName,
+  std::map< std::string, double > &timings)
+{
+  FILE *fp = fopen(fileName.c_str(), "r");
+  if (!fp)
+    return false;
+  char line[1024];
+  while (fgets(line, sizeof(line), fp)) {
+    // benchmark,problem,rows,columns,elements,repeats,seconds,perRepeat,check
+    std::vector< std::string > fields;
+    char *field = line;
+    while (true) {
+      char *comma = strchr(field, ',');
+      if (comma)
+        *comma = '\0';
+      fields.push_back(field);
+      if (!comma)
+        break;
+      field = comma + 1;
+    }
+    if (fields.size() < 9 || fields[0] == "benchmark")
+      continue;
+    timings[fields[0] + "," + fields[1]] = atof(fields[7].c_str());
+  }
+  fclose(fp);
+  return true;
+}
+
+int main(int argc, const char *argv[])
+{
+  std::set< std::string > definedKeyWords;
+  definedKeyWords.insert("-mpsDir");
+  definedKeyWords.insert("-model");
+  definedKeyWords.insert("-size");
+  definedKeyWords.insert("-time");
+  definedKeyWords.insert("-only");
+  definedKeyWords.insert("-output");
+  definedKeyWords.insert("-baseline");
+  definedKeyWords.insert("-tolerance");
+  std::map< std::string, std::string > parms;
+  for (int i = 1; i < argc; i++) {
+    std::string parm(argv[i]);
+    std::string key, value;
+    std::string::size_type eqPos = parm.find('=');
+    if (eqPos == std::string::npos) {
+      key = parm;
+    } else {
+      key = parm.substr(0, eqPos);
+      value = parm.substr(eqPos + 1);
+    }
+    if (definedKeyWords.find(key) == definedKeyWords.end()) {
+      std::cerr
+        << "Undefined parameter \"" << key << "\".\n"
+        << "Correct usage: \n"
+        << "  CoinUtilsBenchmark [-mpsDir=dir] [-model=file[,file...]] [-size=n]\n"
+        << "    [-time=seconds] [-only=string] [-output=file]\n"
+        << "    [-baseline=file] [-tolerance=ratio]\n";
+      return 1;
+    }
+    parms[key] = value;
+  }
+  int size = parms.count("-size") ? atoi(parms["-size"].c_str()) : 20000;
+  // generated problems need a few rows (zero means none)
+  if (size > 0)
+    size = CoinMax(size, 100);
+  double minimumTime = parms.count("-time") ? atof(parms["-time"].c_str()) : 0.2;
+  double tolerance = parms.count("-tolerance") ? atof(parms["-tolerance"].c_str()) : 1.25;
+  std::map< std::string, double > baseline;
+  if (parms.count("-baseline") && !readBaseline(parms["-baseline"], baseline)) {
+    std::cerr << "Unable to read baseline " << parms["-baseline"] << "\n";
+    return 1;
+  }
+  FILE *fp = stdout;
+  if (parms.count("-output")) {
+    fp = fopen(parms["-output"].c_str(), "w");
+    if (!fp) {
+      std::cerr << "Unable to open " << parms["-output"] << "\n";
+      return 1;
+    }
+  }
+  // Models - standard ones from mpsDir and any given
+  std::vector< std::string > modelNames;
+  if (parms.count("-mpsDir")) {
+    const char dirsep = CoinFindDirSeparator();
+    std::string mpsDir = parms["-mpsDir"];
+    if (mpsDir.size() && mpsDir[mpsDir.size() - 1] != dirsep)
+      mpsDir += dirsep;
+    const char *standard[] = { "exmip1.mps", "p0201.mps", "brandy.mps",
+      "finnis.mps", "e226.mps" };
+    for (int i = 0; i < static_cast< int >(sizeof(standard) / sizeof(standard[0])); i++) {
+      std::string name = mpsDir + standard[i];
+      if (fileCoinReadable(name))
+        modelNames.push_back(name);
+    }
+  }
+  if (parms.count("-model")) {
+    std::string models = parms["-model"];
+    std::string::size_type start = 0;
+    while (start < models.size()) {
+      std::string::size_type comma = models.find(',', start);
+      if (comma == std::string::npos)
+        comma = models.size();
+      modelNames.push_back(models.substr(start, comma - start));
+      start = comma + 1;
+    }
+  }
+
+  Benchmarker benchmarker(fp, minimumTime, parms["-only"]);
+  if (size > 0) {
+    indexedVectorBenchmarks(benchmarker, 10 * size);
+    BenchmarkProblem problem;
+    generateProblem(problem, size);
+    packedMatrixBenchmarks(benchmarker, problem);
+    factorizationBenchmarks(benchmarker, problem);
+  }
+  for (size_t i = 0; i < modelNames.size(); i++) {
+    BenchmarkProblem problem;
+    if (!readProblem(problem, modelNames[i])) {
+      std::cerr << "Unable to read " << modelNames[i] << "\n";
+      continue;
+    }
+    packedMatrixBenchmarks(benchmarker, problem);
+    factorizationBenchmarks(benchmarker, problem);
+  }
+  if (fp != stdout)
+    fclose(fp);
+
+  int numberSlower = 0;
+  const std::map< std::string, double > &timings = benchmarker.timings();
+  for (std::map< std::string, double >::const_iterator it = timings.begin();
+       it != timings.end(); ++it) {
+    std::map< std::string, double >::const_iterator old = baseline.find(it->first);
+    if (old != baseline.end() && old->second > 0.0
+      && it->second > tolerance * old->second) {
+      fprintf(stderr, "%s took %.2f times baseline\n",
+        it->first.c_str(), it->second / old->second);
+      numberSlower++;
+    }
+  }
+  return numberSlower ? 1 : 0;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -29,6 +29,8 @@
 #include "CoinMessageHandler.hpp"
 #include "CoinKnapsackRow.hpp"
 
+void CoinFactorizationUnitTest();
+void CoinHelperFunctionsUnitTest();
 void CoinKnapsackRowUnitTest();
 void CoinModelUnitTest(const std::string & mpsDir,
                        const std::string & netlibDir, const std::string & testModel);
@@ -131,8 +133,8 @@ int main (int argc, const char *argv[])
   bool allOK = true ;
 
   // *FIXME* : these tests should be written...
-  //  testingMessage( "Testing CoinHelperFunctions\n" );
-  //  CoinHelperFunctionsUnitTest();
+  testingMessage( "Testing CoinHelperFunctions\n" );
+  CoinHelperFunctionsUnitTest();
   //  testingMessage( "Testing CoinSort\n" );
   //  tripleCompareUnitTest();
 
@@ -218,6 +220,9 @@ int main (int argc, const char *argv[])
   testingMessage( "Testing CoinKnapsackRow\n" );
   CoinKnapsackRowUnitTest();
 
+  testingMessage( "Testing CoinFactorization\n" );
+  CoinFactorizationUnitTest();
+
 // At moment CoinDenseVector is not compiling with MS V C++ V6
 #if 1
   testingMessage( "Testing CoinDenseVector\n" );